@@ -0,0 +1,50 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "synthetic.hpp"
+
+namespace {
+
+/// Every query falls in the cell cached by the accelerator: measures the
+/// cost of the bilinear weights and of the constituent gather alone.
+void BM_CartesianInterpolateCacheHit(benchmark::State& state) {
+  static const auto model = fes::benchmarks::make_cartesian_model();
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto quality = fes::Quality();
+  // Warm the cell cache.
+  model.interpolate({5.005, 5.005}, quality, acc.get());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        model.interpolate({5.005, 5.005}, quality, acc.get()));
+  }
+}
+
+/// Consecutive queries land in different cells: every iteration pays the
+/// axis searches and reloads the four corners.
+void BM_CartesianInterpolateCacheMiss(benchmark::State& state) {
+  static const auto model = fes::benchmarks::make_cartesian_model();
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto quality = fes::Quality();
+  auto x = 0.0;
+  for (auto _ : state) {
+    // Steps of more than one cell (1/30 of a degree) across the tile.
+    x += 0.21;
+    if (x > 18.0) {
+      x = 0.0;
+    }
+    benchmark::DoNotOptimize(
+        model.interpolate({x, 18.0 - x}, quality, acc.get()));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_CartesianInterpolateCacheHit);
+BENCHMARK(BM_CartesianInterpolateCacheMiss);
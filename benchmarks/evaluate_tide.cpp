@@ -0,0 +1,47 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "fes/tide.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+/// Per-point prediction kernel as driven by the fes::evaluate_tide worker:
+/// one angle-cache lookup, one interpolation and one harmonic summation per
+/// iteration. With a zero time tolerance every epoch recomputes the angles;
+/// a positive tolerance measures the cache-served path.
+void BM_DetailEvaluateTide(benchmark::State& state) {
+  static const auto model = fes::benchmarks::make_cartesian_model();
+  const auto settings = fes::Settings();
+  const auto time_tolerance = static_cast<double>(state.range(0));
+  auto wave_table = fes::detail::build_wave_table(&model, settings.excluded());
+  auto lpe = fes::wave::LongPeriodEquilibrium(wave_table);
+  auto kernel = fes::detail::BasicHarmonicSummationKernel<double>(
+      wave_table, settings.fast_sincos());
+  auto acc = std::unique_ptr<fes::Accelerator>(model.accelerator(
+      settings.astronomic_formulae(), time_tolerance));
+
+  auto epoch = 1577836800.0;
+  auto x = 0.0;
+  for (auto _ : state) {
+    epoch += 1.0;
+    x += 0.21;
+    if (x > 18.0) {
+      x = 0.0;
+    }
+    benchmark::DoNotOptimize(
+        fes::detail::evaluate_tide(&model, epoch, uint16_t(27), x, 18.0 - x,
+                                   wave_table, lpe, kernel, acc.get()));
+  }
+}
+
+}  // namespace
+
+// 0: the angles are recomputed at every iteration; 3600: the one-second
+// steps are served by the angle cache.
+BENCHMARK(BM_DetailEvaluateTide)->Arg(0)->Arg(3600);
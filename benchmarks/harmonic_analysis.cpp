@@ -0,0 +1,83 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include "fes/wave/harmonic_analysis.hpp"
+#include "fes/wave/table.hpp"
+
+namespace {
+
+constexpr auto kEpochStart = 1577836800.0;
+
+/// One month of hourly sea level observations analysed for the major
+/// constituents, the typical workload of an altimetric crossover.
+void BM_HarmonicAnalysis(benchmark::State& state) {
+  auto table = fes::wave::Table(
+      {"M2", "S2", "N2", "K2", "K1", "O1", "P1", "Q1"});
+  const auto n_times = state.range(0);
+  auto epoch = Eigen::VectorXd(n_times);
+  for (Eigen::Index ix = 0; ix < n_times; ++ix) {
+    epoch(ix) = kEpochStart + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n_times, 27);
+
+  Eigen::MatrixXd f;
+  Eigen::MatrixXd vu;
+  std::tie(f, vu) = table.compute_nodal_modulations(
+      epoch, leap_seconds, fes::angle::Formulae::kSchuremanOrder3);
+
+  // Synthetic sea level series built from known tidal constants.
+  auto h = Eigen::VectorXd(n_times);
+  for (Eigen::Index jx = 0; jx < n_times; ++jx) {
+    h(jx) = 0.0;
+    for (Eigen::Index kx = 0; kx < f.rows(); ++kx) {
+      h(jx) += f(kx, jx) *
+               ((1.0 + kx) * std::cos(vu(kx, jx)) + 2.0 * std::sin(vu(kx, jx)));
+    }
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fes::wave::Table::harmonic_analysis(h, f, vu));
+  }
+}
+
+/// The factorized context amortizes the normal equations over the points of
+/// a batch sharing the same time base.
+void BM_HarmonicAnalysisContext(benchmark::State& state) {
+  auto table = fes::wave::Table(
+      {"M2", "S2", "N2", "K2", "K1", "O1", "P1", "Q1"});
+  const auto n_times = state.range(0);
+  auto epoch = Eigen::VectorXd(n_times);
+  for (Eigen::Index ix = 0; ix < n_times; ++ix) {
+    epoch(ix) = kEpochStart + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n_times, 27);
+
+  Eigen::MatrixXd f;
+  Eigen::MatrixXd vu;
+  std::tie(f, vu) = table.compute_nodal_modulations(
+      epoch, leap_seconds, fes::angle::Formulae::kSchuremanOrder3);
+  auto analysis = fes::wave::HarmonicAnalysis(f, vu);
+
+  auto h = Eigen::VectorXd(n_times);
+  for (Eigen::Index jx = 0; jx < n_times; ++jx) {
+    h(jx) = 0.0;
+    for (Eigen::Index kx = 0; kx < f.rows(); ++kx) {
+      h(jx) += f(kx, jx) *
+               ((1.0 + kx) * std::cos(vu(kx, jx)) + 2.0 * std::sin(vu(kx, jx)));
+    }
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(analysis.solve(h));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_HarmonicAnalysis)->Arg(744)->Arg(8760);
+BENCHMARK(BM_HarmonicAnalysisContext)->Arg(744)->Arg(8760);
@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 CNES
+#
+# All rights reserved. Use of this source code is governed by a BSD-style
+# license that can be found in the LICENSE file.
+"""Performance regression harness.
+
+Runs a fixed battery of end-to-end prediction scenarios against the small
+tidal atlas bundled with the test suite and records throughput, latency and
+peak memory to a machine-readable report::
+
+    python benchmarks/harness.py run --output baseline.json
+
+Two reports, typically taken before and after a change, are compared with a
+configurable tolerance; the command exits with a non-zero status when a
+scenario slowed down beyond the threshold, so it can gate a CI job::
+
+    python benchmarks/harness.py diff baseline.json candidate.json \\
+        --threshold 0.10
+
+The scenarios exercise the paths that regressed in the past: a global grid
+evaluated at one epoch (spatial search and interpolation bound), a fixed
+station evaluated over a long series (astronomic angles and harmonic
+summation bound) and shuffled crossover points (cache-defeating, binding
+conversion bound).
+"""
+from __future__ import annotations
+
+import argparse
+import json
+import os
+import pathlib
+import platform
+import resource
+import sys
+import time
+
+#: Default model configuration: the atlas bundled with the test suite.
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+CONFIG = ROOT / 'examples' / 'fes_slev.yml'
+DATASET = ROOT / 'tests' / 'python' / 'dataset'
+
+#: Epoch shared by the scenarios.
+EPOCH = '1983-01-01T00:00:00'
+
+# numpy and pyfes are imported by the run command only: diffing reports must
+# work on machines without the prediction stack installed.
+
+
+def scenario_global_grid() -> tuple['numpy.ndarray', 'numpy.ndarray',
+                                    'numpy.ndarray']:
+    """Global one-degree grid evaluated at one epoch."""
+    import numpy
+    lon = numpy.arange(-180.0, 180.0, 1.0)
+    lat = numpy.arange(-89.5, 90.0, 1.0)
+    mx, my = numpy.meshgrid(lon, lat, indexing='ij')
+    dates = numpy.full(mx.size, numpy.datetime64(EPOCH))
+    return dates, mx.ravel(), my.ravel()
+
+
+def scenario_fixed_station() -> tuple['numpy.ndarray', 'numpy.ndarray',
+                                      'numpy.ndarray']:
+    """One year of hourly predictions at a tide gauge position."""
+    import numpy
+    epoch = numpy.datetime64(EPOCH)
+    dates = numpy.arange(epoch, epoch + numpy.timedelta64(365, 'D'),
+                         numpy.timedelta64(1, 'h'))
+    lon = numpy.full(dates.shape, -7.688)
+    lat = numpy.full(dates.shape, 59.195)
+    return dates, lon, lat
+
+
+def scenario_shuffled_crossover() -> tuple['numpy.ndarray', 'numpy.ndarray',
+                                           'numpy.ndarray']:
+    """Shuffled positions and dates defeating the accelerator caches."""
+    import numpy
+    generator = numpy.random.default_rng(0)
+    size = 50_000
+    dates = numpy.datetime64(EPOCH) + numpy.timedelta64(
+        1, 's') * generator.integers(0, 30 * 86400, size)
+    lon = generator.uniform(-180.0, 180.0, size)
+    lat = generator.uniform(-66.0, 66.0, size)
+    return dates, lon, lat
+
+
+SCENARIOS = {
+    'global_grid': scenario_global_grid,
+    'fixed_station': scenario_fixed_station,
+    'shuffled_crossover': scenario_shuffled_crossover,
+}
+
+
+def max_rss_kib() -> int:
+    """Peak resident set size of the process in KiB."""
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # ru_maxrss is in bytes on macOS and in KiB on Linux.
+    return rss // 1024 if sys.platform == 'darwin' else rss
+
+
+def run(args: argparse.Namespace) -> int:
+    """Runs the battery of scenarios and writes the report."""
+    import numpy
+    import pyfes
+
+    os.environ.setdefault('DATASET_DIR', str(DATASET))
+    handlers = pyfes.load_config(args.config)
+    model = handlers['tide']
+
+    report: dict = {
+        'meta': {
+            'config': str(args.config),
+            'date': time.strftime('%Y-%m-%dT%H:%M:%SZ', time.gmtime()),
+            'hostname': platform.node(),
+            'num_threads': args.num_threads,
+            'pyfes': pyfes.__version__,
+            'python': platform.python_version(),
+            'repeat': args.repeat,
+        },
+        'scenarios': {},
+    }
+
+    for name in args.scenario:
+        dates, lon, lat = SCENARIOS[name]()
+        # One untimed pass warms the file cache and the thread pool.
+        pyfes.evaluate_tide(model, dates, lon, lat,
+                            num_threads=args.num_threads)
+        seconds = []
+        for _ in range(args.repeat):
+            start = time.perf_counter()
+            pyfes.evaluate_tide(model, dates, lon, lat,
+                                num_threads=args.num_threads)
+            seconds.append(time.perf_counter() - start)
+        median = float(numpy.median(seconds))
+        report['scenarios'][name] = {
+            'points': int(dates.size),
+            'runs_seconds': seconds,
+            'median_seconds': median,
+            'throughput_points_per_second': dates.size / median,
+            'max_rss_kib': max_rss_kib(),
+        }
+        print(f'{name}: {dates.size} points, median {median:.3f} s, '
+              f'{dates.size / median:,.0f} points/s')
+
+    with open(args.output, 'w', encoding='utf-8') as stream:
+        json.dump(report, stream, indent=2, sort_keys=True)
+        stream.write('\n')
+    print(f'report written to {args.output}')
+    return 0
+
+
+def diff(args: argparse.Namespace) -> int:
+    """Compares two reports and flags the regressions."""
+    with open(args.baseline, encoding='utf-8') as stream:
+        baseline = json.load(stream)
+    with open(args.candidate, encoding='utf-8') as stream:
+        candidate = json.load(stream)
+
+    status = 0
+    names = sorted(
+        set(baseline['scenarios']) & set(candidate['scenarios']))
+    if not names:
+        print('the reports have no scenario in common', file=sys.stderr)
+        return 1
+    for name in names:
+        before = baseline['scenarios'][name]
+        after = candidate['scenarios'][name]
+        ratio = after['median_seconds'] / before['median_seconds']
+        rss_ratio = after['max_rss_kib'] / max(before['max_rss_kib'], 1)
+        flag = ''
+        if ratio > 1.0 + args.threshold:
+            flag = '  << REGRESSION'
+            status = 1
+        elif ratio < 1.0 - args.threshold:
+            flag = '  improved'
+        print(f'{name}: {before["median_seconds"]:.3f} s -> '
+              f'{after["median_seconds"]:.3f} s ({ratio - 1.0:+.1%}), '
+              f'rss x{rss_ratio:.2f}{flag}')
+        if rss_ratio > 1.0 + args.memory_threshold:
+            print(f'{name}: peak memory grew beyond the threshold '
+                  f'({before["max_rss_kib"]} KiB -> '
+                  f'{after["max_rss_kib"]} KiB)')
+            status = 1
+    for name in sorted(
+            set(baseline['scenarios']) ^ set(candidate['scenarios'])):
+        print(f'{name}: present in only one report, ignored')
+    return status
+
+
+def usage() -> argparse.ArgumentParser:
+    """Command line syntax."""
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    runner = subparsers.add_parser('run', help='run the scenarios')
+    runner.add_argument('--config',
+                        type=pathlib.Path,
+                        default=CONFIG,
+                        help='model configuration file (default: the atlas '
+                        'bundled with the test suite)')
+    runner.add_argument('--output',
+                        type=pathlib.Path,
+                        default=pathlib.Path('report.json'),
+                        help='path of the report to write')
+    runner.add_argument('--scenario',
+                        nargs='+',
+                        choices=sorted(SCENARIOS),
+                        default=sorted(SCENARIOS),
+                        help='subset of scenarios to run')
+    runner.add_argument('--repeat',
+                        type=int,
+                        default=5,
+                        help='number of timed runs per scenario')
+    runner.add_argument('--num-threads',
+                        type=int,
+                        default=0,
+                        help='number of worker threads (0: all CPUs)')
+    runner.set_defaults(handler=run)
+
+    differ = subparsers.add_parser('diff', help='compare two reports')
+    differ.add_argument('baseline', type=pathlib.Path)
+    differ.add_argument('candidate', type=pathlib.Path)
+    differ.add_argument('--threshold',
+                        type=float,
+                        default=0.10,
+                        help='relative slowdown tolerated before a scenario '
+                        'is flagged as a regression')
+    differ.add_argument('--memory-threshold',
+                        type=float,
+                        default=0.25,
+                        help='relative peak memory growth tolerated')
+    differ.set_defaults(handler=diff)
+    return parser
+
+
+def main() -> int:
+    args = usage().parse_args()
+    return args.handler(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,59 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include "synthetic.hpp"
+
+namespace {
+
+auto make_index(const fes::mesh::Index::Backend backend) -> fes::mesh::Index {
+  auto lon = Eigen::VectorXd();
+  auto lat = Eigen::VectorXd();
+  auto triangles = Eigen::Matrix<int, Eigen::Dynamic, 3>();
+  std::tie(lon, lat, triangles) = fes::benchmarks::make_triangulation();
+  return {lon, lat, triangles, backend};
+}
+
+/// Point location over the whole tile: consecutive queries land in distant
+/// triangles, so the search cannot be served by any locality.
+void BM_IndexSearch(benchmark::State& state) {
+  static const auto rtree = make_index(fes::mesh::Index::kRTree);
+  static const auto grid = make_index(fes::mesh::Index::kUniformGrid);
+  const auto& index =
+      state.range(0) == fes::mesh::Index::kRTree ? rtree : grid;
+  auto x = 0.1;
+  for (auto _ : state) {
+    x += 0.17;
+    if (x > 8.0) {
+      x = 0.1;
+    }
+    benchmark::DoNotOptimize(index.search({x, 8.0 - x}, 0));
+  }
+}
+
+/// Point location hinted with the previous answer, as done by the walk used
+/// for track-ordered queries.
+void BM_IndexSearchFrom(benchmark::State& state) {
+  static const auto index = make_index(fes::mesh::Index::kRTree);
+  auto x = 0.1;
+  auto hint = int32_t(-1);
+  for (auto _ : state) {
+    // Steps of about one cell: the walk crosses a few triangles.
+    x += 0.03;
+    if (x > 8.0) {
+      x = 0.1;
+    }
+    const auto query = index.search_from({x, 4.0}, hint, 0);
+    hint = query.index;
+    benchmark::DoNotOptimize(query);
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_IndexSearch)
+    ->Arg(fes::mesh::Index::kRTree)
+    ->Arg(fes::mesh::Index::kUniformGrid);
+BENCHMARK(BM_IndexSearchFrom);
@@ -0,0 +1,50 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "synthetic.hpp"
+
+namespace {
+
+/// Every query falls in the triangle cached by the accelerator: measures
+/// the interpolation weights and the constituent gather alone.
+void BM_LGP1InterpolateCacheHit(benchmark::State& state) {
+  static const auto model = fes::benchmarks::make_lgp1_model();
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto quality = fes::Quality();
+  // Warm the triangle cache.
+  model.interpolate({4.005, 4.005}, quality, acc.get());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        model.interpolate({4.005, 4.005}, quality, acc.get()));
+  }
+}
+
+/// Consecutive queries land in distant triangles: every iteration pays the
+/// spatial search in addition to the interpolation.
+void BM_LGP1InterpolateCacheMiss(benchmark::State& state) {
+  static const auto model = fes::benchmarks::make_lgp1_model();
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto quality = fes::Quality();
+  auto x = 0.1;
+  for (auto _ : state) {
+    // Steps of several cells across the tile.
+    x += 0.17;
+    if (x > 8.0) {
+      x = 0.1;
+    }
+    benchmark::DoNotOptimize(
+        model.interpolate({x, 8.0 - x}, quality, acc.get()));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_LGP1InterpolateCacheHit);
+BENCHMARK(BM_LGP1InterpolateCacheMiss);
@@ -0,0 +1,46 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include "fes/angle/astronomic.hpp"
+#include "fes/wave/table.hpp"
+
+namespace {
+
+/// Nodal corrections of the full wave table, refreshed at every epoch as
+/// done by the prediction loop when the angle cache misses.
+void BM_ComputeNodalCorrections(benchmark::State& state) {
+  auto table = fes::wave::Table();
+  auto angles = fes::angle::Astronomic(
+      fes::angle::Formulae::kSchuremanOrder3, 1577836800.0, 27);
+  auto epoch = 1577836800.0;
+  for (auto _ : state) {
+    epoch += 3600.0;
+    angles.update(epoch, 27);
+    table.compute_nodal_corrections(angles);
+    benchmark::ClobberMemory();
+  }
+}
+
+/// The astronomic angles alone, to separate their cost from the waves'
+/// corrections.
+void BM_AstronomicUpdate(benchmark::State& state) {
+  auto angles = fes::angle::Astronomic(
+      static_cast<fes::angle::Formulae>(state.range(0)), 1577836800.0, 27);
+  auto epoch = 1577836800.0;
+  for (auto _ : state) {
+    epoch += 3600.0;
+    angles.update(epoch, 27);
+    benchmark::ClobberMemory();
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_ComputeNodalCorrections);
+BENCHMARK(BM_AstronomicUpdate)
+    ->Arg(static_cast<int>(fes::angle::Formulae::kSchuremanOrder1))
+    ->Arg(static_cast<int>(fes::angle::Formulae::kSchuremanOrder3))
+    ->Arg(static_cast<int>(fes::angle::Formulae::kMeeus));
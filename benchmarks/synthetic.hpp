@@ -0,0 +1,121 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file benchmarks/synthetic.hpp
+/// @brief Synthetic models shared by the microbenchmarks.
+#pragma once
+#include <Eigen/Core>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <tuple>
+
+#include "fes/axis.hpp"
+#include "fes/mesh/index.hpp"
+#include "fes/tidal_model/cartesian.hpp"
+#include "fes/tidal_model/lgp.hpp"
+
+namespace fes {
+namespace benchmarks {
+
+/// The major constituents distributed with the FES products.
+constexpr Constituent kMajorConstituents[] = {kM2, kS2, kN2, kK2,
+                                              kK1, kO1, kP1, kQ1};
+
+/// Smooth synthetic constituent field: spatially coherent like a real tidal
+/// atlas, so the interpolation reads neighbouring values of similar
+/// magnitude.
+inline auto synthetic_value(const double lon, const double lat,
+                            const int harmonic) -> std::complex<double> {
+  const auto amplitude = 50.0 / (1.0 + harmonic);
+  return {amplitude * std::cos(0.1 * (harmonic + 1) * lon + 0.2 * lat),
+          amplitude * std::sin(0.2 * (harmonic + 1) * lat - 0.1 * lon)};
+}
+
+/// Builds a Cartesian model at the resolution of the FES2022 gridded
+/// product (1/30 of a degree) over a regional tile of n x n points, with
+/// the major constituents.
+inline auto make_cartesian_model(const Eigen::Index n = 600)
+    -> tidal_model::Cartesian<double> {
+  constexpr auto step = 1.0 / 30.0;
+  auto points = Eigen::VectorXd(n);
+  for (Eigen::Index ix = 0; ix < n; ++ix) {
+    points(ix) = ix * step;
+  }
+  auto axis = Axis(points);
+  auto model = tidal_model::Cartesian<double>(axis, axis, kTide);
+  auto values = Eigen::VectorXcd(n * n);
+  auto harmonic = 0;
+  for (const auto ident : kMajorConstituents) {
+    for (Eigen::Index ix = 0; ix < n; ++ix) {
+      for (Eigen::Index jx = 0; jx < n; ++jx) {
+        values(ix * n + jx) =
+            synthetic_value(points(ix), points(jx), harmonic);
+      }
+    }
+    model.add_constituent(ident, values);
+    ++harmonic;
+  }
+  return model;
+}
+
+/// Builds a structured triangulation of a regional tile: m x m nodes at the
+/// nominal coastal resolution of the FES2022 mesh, two triangles per cell.
+inline auto make_triangulation(const Eigen::Index m = 256)
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd,
+                  Eigen::Matrix<int, Eigen::Dynamic, 3>> {
+  constexpr auto step = 1.0 / 30.0;
+  auto lon = Eigen::VectorXd(m * m);
+  auto lat = Eigen::VectorXd(m * m);
+  for (Eigen::Index ix = 0; ix < m; ++ix) {
+    for (Eigen::Index jx = 0; jx < m; ++jx) {
+      // A slight modulation avoids the degenerate regularity of a perfect
+      // grid without changing the topology.
+      lon(ix * m + jx) = jx * step + 0.1 * step * std::sin(0.5 * ix);
+      lat(ix * m + jx) = ix * step + 0.1 * step * std::cos(0.5 * jx);
+    }
+  }
+  auto triangles =
+      Eigen::Matrix<int, Eigen::Dynamic, 3>(2 * (m - 1) * (m - 1), 3);
+  auto row = Eigen::Index(0);
+  for (Eigen::Index ix = 0; ix + 1 < m; ++ix) {
+    for (Eigen::Index jx = 0; jx + 1 < m; ++jx) {
+      const auto p00 = static_cast<int>(ix * m + jx);
+      const auto p01 = static_cast<int>(ix * m + jx + 1);
+      const auto p10 = static_cast<int>((ix + 1) * m + jx);
+      const auto p11 = static_cast<int>((ix + 1) * m + jx + 1);
+      triangles.row(row++) << p00, p01, p11;
+      triangles.row(row++) << p00, p11, p10;
+    }
+  }
+  return std::make_tuple(lon, lat, triangles);
+}
+
+/// Builds an LGP1 model on the synthetic triangulation with the major
+/// constituents (continuous discretization: the codes are the vertex
+/// indices).
+inline auto make_lgp1_model(const Eigen::Index m = 256)
+    -> tidal_model::LGP1<double> {
+  auto lon = Eigen::VectorXd();
+  auto lat = Eigen::VectorXd();
+  auto triangles = Eigen::Matrix<int, Eigen::Dynamic, 3>();
+  std::tie(lon, lat, triangles) = make_triangulation(m);
+
+  auto index = std::make_shared<mesh::Index>(lon, lat, triangles);
+  auto model =
+      tidal_model::LGP1<double>(std::move(index), triangles, kTide);
+  auto values = Eigen::VectorXcd(lon.size());
+  auto harmonic = 0;
+  for (const auto ident : kMajorConstituents) {
+    for (Eigen::Index ix = 0; ix < lon.size(); ++ix) {
+      values(ix) = synthetic_value(lon(ix), lat(ix), harmonic);
+    }
+    model.add_constituent(ident, values);
+    ++harmonic;
+  }
+  return model;
+}
+
+}  // namespace benchmarks
+}  // namespace fes
@@ -0,0 +1,145 @@
+/* Copyright (c) 2024 CNES
+ *
+ * All rights reserved. Use of this source code is governed by a
+ * BSD-style license that can be found in the LICENSE file.
+ */
+/** @file include/fes.h
+ *  @brief C interface of the tidal prediction library.
+ *
+ *  Batch-oriented interface for native pipelines that cannot depend on the
+ *  Python layer. A model is loaded once from its netCDF constituent files, a
+ *  prediction session is built from it, and fes_evaluate() computes whole
+ *  batches directly on caller-owned arrays, without any copy or conversion.
+ *
+ *  All the functions returning a status report the detail of a failure
+ *  through fes_last_error(); the message is kept per thread.
+ */
+#ifndef FES_H
+#define FES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Status of an operation. */
+typedef enum fes_status {
+  FES_SUCCESS = 0,          /**< The operation succeeded. */
+  FES_INVALID_ARGUMENT = 1, /**< An argument is invalid. */
+  FES_RUNTIME_ERROR = 2     /**< The operation failed. */
+} fes_status_t;
+
+/** Type of tide handled by a model. */
+typedef enum fes_tide_type {
+  FES_TIDE = 0x01,  /**< Ocean tide. */
+  FES_RADIAL = 0x02 /**< Radial tide. */
+} fes_tide_type_t;
+
+/** Quality of one evaluated value, written to the quality array of
+ *  fes_evaluate(). */
+typedef enum fes_quality {
+  FES_UNDEFINED = 0,     /**< The position is outside the model domain. */
+  FES_EXTRAPOLATED_1 = 1, /**< Extrapolated from one data point. */
+  FES_EXTRAPOLATED_2 = 2, /**< Extrapolated from two data points. */
+  FES_EXTRAPOLATED_3 = 3, /**< Extrapolated from three data points. */
+  FES_INTERPOLATED = 4    /**< Correctly interpolated. */
+} fes_quality_t;
+
+/** Opaque handle on a tidal model. */
+typedef struct fes_model fes_model_t;
+
+/** Opaque handle on a prediction session. */
+typedef struct fes_predictor fes_predictor_t;
+
+/** @brief Returns the message of the last error raised in the calling
+ *  thread, or NULL if no error was raised.
+ *
+ *  The string is owned by the library and is valid until the next failing
+ *  call from the same thread. */
+const char* fes_last_error(void);
+
+/** @brief Builds a Cartesian tidal model from a set of netCDF constituent
+ *  files, reading them concurrently.
+ *
+ *  The files must be in the netCDF classic format (CDF-1 or CDF-2). The
+ *  precision of the model is chosen from the stored amplitudes: grids packed
+ *  as 16-bit integers or 32-bit floating point values are held in single
+ *  precision.
+ *
+ *  @param n_constituents Number of constituent files.
+ *  @param constituents Names of the constituents, e.g. "M2".
+ *  @param paths Paths of the constituent files, in the same order.
+ *  @param longitude Name of the longitude variable.
+ *  @param latitude Name of the latitude variable.
+ *  @param amplitude Name of the amplitude variable.
+ *  @param phase Name of the phase variable, in degrees or radians according
+ *  to its units attribute.
+ *  @param tide_type Type of tide handled by the model.
+ *  @param num_threads Number of threads reading the files. 0 uses all the
+ *  available cores.
+ *  @return The model, to release with fes_model_free(), or NULL on error.
+ */
+fes_model_t* fes_load_cartesian(size_t n_constituents,
+                                const char* const* constituents,
+                                const char* const* paths,
+                                const char* longitude, const char* latitude,
+                                const char* amplitude, const char* phase,
+                                fes_tide_type_t tide_type, size_t num_threads);
+
+/** @brief Releases a model. NULL is ignored. */
+void fes_model_free(fes_model_t* model);
+
+/** @brief Builds a prediction session on a model.
+ *
+ *  The session owns the per-worker state of the prediction (wave tables,
+ *  accelerators) and keeps it warm across calls, so repeated invocations of
+ *  fes_evaluate() on small batches only pay for the computation itself. The
+ *  model must outlive the session. A session must not be used from several
+ *  threads at the same time.
+ *
+ *  @param model The tidal model interpolated by the session.
+ *  @param time_tolerance Time in seconds during which the astronomical
+ *  angles are considered constant. 0 recomputes them at every epoch.
+ *  @param num_threads Number of threads used by fes_evaluate(). 0 uses all
+ *  the available cores.
+ *  @return The session, to release with fes_predictor_free(), or NULL on
+ *  error.
+ */
+fes_predictor_t* fes_predictor_new(const fes_model_t* model,
+                                   double time_tolerance, size_t num_threads);
+
+/** @brief Releases a prediction session. NULL is ignored. */
+void fes_predictor_free(fes_predictor_t* predictor);
+
+/** @brief Evaluates the tide for a batch of points.
+ *
+ *  The input and output arrays are caller-owned and hold n items each; they
+ *  are read and written in place. The epochs are UTC times in seconds since
+ *  1970-01-01T00:00:00Z; the leap seconds are resolved internally from the
+ *  table embedded in the library.
+ *
+ *  @param predictor The prediction session.
+ *  @param n Number of points in the batch.
+ *  @param epoch UTC times in seconds since 1970-01-01T00:00:00Z.
+ *  @param longitude Longitudes in degrees.
+ *  @param latitude Latitudes in degrees.
+ *  @param tide Receives the height of the diurnal and semi-diurnal
+ *  constituents of the tidal spectrum, in the unit of the model. NaN where
+ *  the quality is FES_UNDEFINED.
+ *  @param long_period Receives the height of the long period wave
+ *  constituents of the tidal spectrum.
+ *  @param quality Receives the quality of each value, one of fes_quality_t.
+ *  @return FES_SUCCESS, or an error status detailed by fes_last_error().
+ */
+fes_status_t fes_evaluate(fes_predictor_t* predictor, size_t n,
+                          const double* epoch, const double* longitude,
+                          const double* latitude, double* tide,
+                          double* long_period, uint8_t* quality);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FES_H */
@@ -5,15 +5,27 @@
 /// @file include/fes/abstract_tidal_model.hpp
 /// @brief Abstract tidal model.
 #pragma once
+#include <algorithm>
+#include <atomic>
 #include <complex>
-#include <map>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "fes/angle/astronomic.hpp"
+#include "fes/constituent_map.hpp"
+#include "fes/data_vector.hpp"
+#include "fes/detail/isviewstream.hpp"
+#include "fes/detail/mapped_file.hpp"
+#include "fes/detail/quantized.hpp"
+#include "fes/detail/serialize.hpp"
 #include "fes/eigen.hpp"
 #include "fes/geometry/point.hpp"
+#include "fes/perf_counters.hpp"
 #include "fes/wave.hpp"
 #include "fes/wave/table.hpp"
 
@@ -54,14 +66,16 @@ class Accelerator {
   /// model.
   Accelerator(const angle::Formulae& formulae, const double time_tolerance,
               const size_t n_constituents)
-      : time_tolerance_(time_tolerance),
+      : formulae_(formulae),
+        time_tolerance_(time_tolerance),
         angle_{std::numeric_limits<double>::max(),
                angle::Astronomic(formulae)} {
     values_.reserve(n_constituents);
   }
 
-  /// Default destructor
-  virtual ~Accelerator() = default;
+  /// Destructor. Folds the counters accumulated by this accelerator into
+  /// the process-wide aggregate read by fes::perf_counters().
+  virtual ~Accelerator() { detail::flush_perf_counters(counters_); }
 
   /// @brief Casts the object to a pointer of type T.
   ///
@@ -88,12 +102,46 @@ class Accelerator {
   auto clear() noexcept -> void { values_.clear(); }
 
   /// @brief Appends a tidal constituent value to the cached interpolated
-  /// values.
+  /// values, or writes it straight into the bound wave table slot.
   auto emplace_back(const Constituent& constituent,
                     const std::complex<double>& value) noexcept -> void {
+    if (!slots_.empty()) {
+      slots_[static_cast<size_t>(constituent)]->tide(value);
+      return;
+    }
     values_.emplace_back(constituent, value);
   }
 
+  /// @brief Bind the accelerator to a wave table for direct-write
+  /// interpolation.
+  ///
+  /// Every interpolated value is normally appended to an intermediate
+  /// vector, then copied into the wave table by the table-filling overload
+  /// of AbstractTidalModel::interpolate. A bound accelerator resolves each
+  /// constituent to its wave table slot once and writes the interpolated
+  /// values straight into the slots, removing the intermediate vector and
+  /// the copy pass from the hottest boundary of the prediction.
+  ///
+  /// Once bound, the values() buffer stays empty and the table-filling
+  /// overload must be called with the bound table. The table must outlive
+  /// the accelerator.
+  ///
+  /// @param[in] wave_table The wave table receiving the interpolated values.
+  virtual auto bind(wave::Table& wave_table) -> void {
+    auto size = size_t{0};
+    for (const auto& wave : wave_table) {
+      size = std::max(size, static_cast<size_t>(wave->ident()) + 1);
+    }
+    slots_.assign(size, nullptr);
+    for (const auto& wave : wave_table) {
+      slots_[static_cast<size_t>(wave->ident())] = wave.get();
+    }
+  }
+
+  /// @brief True if the interpolated values are written straight into a
+  /// bound wave table.
+  inline auto bound() const noexcept -> bool { return !slots_.empty(); }
+
   /// @brief Calculates the astronomic angle used to evaluate the tidal
   /// constituents at the given UTC time.
   ///
@@ -103,14 +151,41 @@ class Accelerator {
   /// @return The astronomic angle corresponding to the given UTC time.
   auto calculate_angle(const double epoch, const uint16_t leap_seconds) noexcept
       -> const angle::Astronomic& {
-    if (std::abs(epoch - angle_.first) > time_tolerance_) {
+    angle_updated_ = std::abs(epoch - angle_.first) > time_tolerance_;
+    if (angle_updated_) {
+      ++counters_.angle_recomputes;
       angle_.first = epoch;
-      angle_.second.update(epoch, leap_seconds);
+      // The default formulae is dispatched statically so the evaluation is
+      // inlined here instead of going through the member function pointer;
+      // the other formulae keep the runtime dispatch.
+      if (formulae_ == angle::Formulae::kSchuremanOrder1) {
+        angle_.second.update<angle::Formulae::kSchuremanOrder1>(epoch,
+                                                                leap_seconds);
+      } else {
+        angle_.second.update(epoch, leap_seconds);
+      }
+    } else {
+      ++counters_.angle_cache_hits;
     }
     return angle_.second;
   }
 
+  /// @brief True if the last call to calculate_angle updated the angle, false
+  /// if it was served from the cache. Quantities that only depend on the
+  /// astronomic angle, like the nodal corrections, are unchanged on a cache
+  /// hit and do not need to be recomputed.
+  constexpr auto angle_updated() const noexcept -> bool {
+    return angle_updated_;
+  }
+
+  /// @brief Returns the performance counters of this accelerator. They are
+  /// incremented without synchronization: each worker owns its accelerator.
+  constexpr auto counters() noexcept -> PerfCounters& { return counters_; }
+
  protected:
+  /// @brief The formulae used to calculate the astronomic angle.
+  angle::Formulae formulae_;
+
   /// @brief Time in seconds for which astronomical angles are considered
   /// constant
   double time_tolerance_;
@@ -118,8 +193,18 @@ class Accelerator {
   /// @brief The last angle used to evaluate the tidal constituents.
   std::pair<double, angle::Astronomic> angle_;
 
+  /// @brief True if the last call to calculate_angle updated the angle.
+  bool angle_updated_{true};
+
   /// @brief The tidal constituent values interpolated at the last point.
   ConstituentValues values_;
+
+  /// @brief The wave table slots of a bound accelerator, indexed by
+  /// constituent; empty when the accelerator is not bound.
+  std::vector<Wave*> slots_{};
+
+  /// @brief Hot path counters, flushed by the destructor.
+  PerfCounters counters_{};
 };
 
 /// @brief Abstract class for a model of tidal constituents.
@@ -156,17 +241,21 @@ class AbstractTidalModel
   /// Add a tidal constituent to the model.
   ///
   /// @param[in] ident The tidal constituent identifier.
-  /// @param[in] wave The tidal constituent modelled.
+  /// @param[in] wave The tidal constituent modelled: either a vector of
+  /// samples the model takes ownership of, or a view over a caller-owned
+  /// buffer adopted without copying the samples.
   virtual auto add_constituent(const Constituent ident,
-                               Vector<std::complex<T>> wave) -> void = 0;
+                               DataVector<std::complex<T>> wave) -> void = 0;
 
   /// Add a tidal constituent to the model.
   ///
   /// @param[in] name The tidal constituent name. Search is not case sensitive.
   /// So  "Msqm", "MSQM" and "msqm" are equivalent.
-  /// @param[in] wave The tidal constituent modelled.
+  /// @param[in] wave The tidal constituent modelled: either a vector of
+  /// samples the model takes ownership of, or a view over a caller-owned
+  /// buffer adopted without copying the samples.
   inline auto add_constituent(const std::string& name,
-                              Vector<std::complex<T>> wave) -> void {
+                              DataVector<std::complex<T>> wave) -> void {
     add_constituent(constituents::parse(name), std::move(wave));
   }
 
@@ -193,6 +282,39 @@ class AbstractTidalModel
                            Accelerator* acc) const
       -> const ConstituentValues& = 0;
 
+  /// @brief True if this model selects the same grid cell or mesh triangle
+  /// as the other model for any query point.
+  ///
+  /// When two models agree, the spatial search cached by an accelerator of
+  /// one model is valid for an accelerator of the other, so a caller
+  /// evaluating both models at the same points can pay the search once (see
+  /// seed_spatial_cache and fes::evaluate_tide_group). The base
+  /// implementation declines the sharing.
+  ///
+  /// @param[in] other The model to compare with.
+  /// @return True if the search results of the two models are
+  /// interchangeable.
+  virtual auto shares_spatial_cache(
+      const AbstractTidalModel<T>& /*other*/) const noexcept -> bool {
+    return false;
+  }
+
+  /// @brief Seed the spatial cache of an accelerator with the search result
+  /// cached by an accelerator of another model.
+  ///
+  /// Both models must agree on shares_spatial_cache(). The seeding is
+  /// skipped when the target cache already covers the point or when the
+  /// source cache does not, so calling it before every interpolation is
+  /// safe. The base implementation does nothing.
+  ///
+  /// @param[in] point The point about to be interpolated.
+  /// @param[in] source The accelerator holding the search result, created by
+  /// the model the search was paid by.
+  /// @param[inout] target The accelerator to seed, created by this model.
+  virtual auto seed_spatial_cache(const geometry::Point& /*point*/,
+                                  const Accelerator& /*source*/,
+                                  Accelerator* /*target*/) const -> void {}
+
   /// Interpolate the tidal constituent at a given point.
   ///
   /// @param[in] point The point to interpolate at.
@@ -203,22 +325,204 @@ class AbstractTidalModel
   inline auto interpolate(const geometry::Point& point, wave::Table& wave_table,
                           Accelerator* acc) const -> Quality {
     Quality quality;
+    if (acc->bound()) {
+      // The accelerator is bound to the wave table: the values were written
+      // straight into its slots, there is nothing to copy.
+      this->interpolate(point, quality, acc);
+      return quality;
+    }
     for (const auto& item : this->interpolate(point, quality, acc)) {
       wave_table[std::get<0>(item)]->tide(std::get<1>(item));
     }
     return quality;
   }
 
+  /// @brief Interpolate the tidal constituents at a run of points.
+  ///
+  /// The scalar interpolation pays the virtual dispatch and the accelerator
+  /// bookkeeping per point. This entry point hands a whole run to the model
+  /// at once: the generic implementation amortizes the setup over the run,
+  /// and the concrete models override it to share the spatial stage across
+  /// the points — the cell cache for clustered Cartesian queries, a
+  /// warm-started batch search for %LGP meshes.
+  ///
+  /// @param[in] points The points to interpolate at.
+  /// @param[out] values The interpolated constituents, one row per
+  /// constituent handled by the model, in identifiers() order, and one
+  /// column per point. Resized by the call.
+  /// @param[out] quality One flag per point. Resized by the call.
+  /// @param[inout] acc The accelerator to use. It must not be bound to a
+  /// wave table: the values are gathered into the matrix, not written into
+  /// table slots.
+  virtual auto interpolate_many(const std::vector<geometry::Point>& points,
+                                Matrix<std::complex<double>>& values,
+                                Vector<Quality>& quality,
+                                Accelerator* acc) const -> void {
+    if (acc->bound()) {
+      throw std::invalid_argument(
+          "interpolate_many requires an accelerator that is not bound to a "
+          "wave table");
+    }
+    const auto size = static_cast<Eigen::Index>(points.size());
+    values.resize(static_cast<Eigen::Index>(data_.size()), size);
+    quality.resize(size);
+    for (Eigen::Index ix = 0; ix < size; ++ix) {
+      auto flag = Quality();
+      const auto& interpolated =
+          this->interpolate(points[static_cast<size_t>(ix)], flag, acc);
+      quality(ix) = flag;
+      for (Eigen::Index jx = 0; jx < values.rows(); ++jx) {
+        values(jx, ix) = interpolated[static_cast<size_t>(jx)].second;
+      }
+    }
+  }
+
   /// Get the tidal constituents handled by the model.
   constexpr auto data() const
-      -> const std::map<Constituent, Vector<std::complex<T>>>& {
+      -> const ConstituentMap<DataVector<std::complex<T>>>& {
     return data_;
   }
 
+  /// @brief Quantize the tidal constituents to 16-bit integers.
+  ///
+  /// The floating-point storage is released and replaced by int16 samples
+  /// scaled by a per-constituent factor, halving (float) or quartering
+  /// (double) the model footprint. Dequantization is fused into the
+  /// interpolation inner loops. The quantization is lossy: the error per
+  /// component is bounded by half the scale factor, i.e. the largest
+  /// magnitude of the constituent divided by 65534. Adding a constituent
+  /// restores the floating-point storage.
+  virtual auto quantize() -> void {
+    if (quantized()) {
+      return;
+    }
+    // A lazily loaded model is materialized first: the quantized samples
+    // replace the resident storage.
+    materialize();
+    auto placeholders = ConstituentMap<DataVector<std::complex<T>>>();
+    for (const auto& item : data_) {
+      quantized_.emplace(item.first, detail::QuantizedVector::encode(
+                                         item.second));
+      placeholders.emplace(item.first, DataVector<std::complex<T>>());
+    }
+    data_ = std::move(placeholders);
+  }
+
+  /// @brief Restore the floating-point storage of a quantized model.
+  ///
+  /// The restored values carry the quantization error; the original samples
+  /// are not recoverable. This method is a no-op if the model is not
+  /// quantized.
+  virtual auto dequantize() -> void {
+    if (!quantized()) {
+      return;
+    }
+    auto data = ConstituentMap<DataVector<std::complex<T>>>();
+    for (const auto& item : quantized_) {
+      data.emplace(item.first, item.second.template decode<T>());
+    }
+    data_ = std::move(data);
+    quantized_.clear();
+  }
+
+  /// True if the model stores its constituents quantized.
+  constexpr auto quantized() const -> bool { return !quantized_.empty(); }
+
+  /// @brief True if some constituents are backed by a mapped file and read on
+  /// demand.
+  inline auto lazy() const noexcept -> bool { return backing_.file != nullptr; }
+
+  /// @brief Load the backed constituents that are not resident.
+  ///
+  /// Called by interpolate() before reading the constituent values, so the
+  /// grids of a lazily loaded model are faulted in by the first interpolation
+  /// that needs them. Thread safe: concurrent interpolations serialize their
+  /// faults, and the check is free once every backed constituent is resident.
+  auto fault_in() const -> void {
+    if (backing_.file == nullptr ||
+        backing_.complete.load(std::memory_order_acquire)) {
+      return;
+    }
+    auto idents = std::vector<Constituent>();
+    idents.reserve(backing_.offsets.size());
+    for (const auto& item : backing_.offsets) {
+      idents.push_back(item.first);
+    }
+    fault_in(idents);
+  }
+
+  /// @brief Load the given backed constituents.
+  ///
+  /// Lets a caller warm the working set of a prediction up front. If a
+  /// residency budget was given when the model was loaded, the least recently
+  /// used grids beyond the budget are evicted, sparing the ones just
+  /// requested.
+  ///
+  /// @param[in] idents The constituents to load. The ones that are not backed
+  /// are ignored.
+  auto fault_in(const std::vector<Constituent>& idents) const -> void {
+    if (backing_.file == nullptr) {
+      return;
+    }
+    // interpolate() is const: faulting a grid in changes the residency of the
+    // storage, not the observable state of the model.
+    auto* self = const_cast<AbstractTidalModel<T>*>(this);
+    std::lock_guard<std::mutex> lock(self->backing_.mutex);
+    const auto stamp = ++self->backing_.clock;
+    for (const auto ident : idents) {
+      if (!backing_.offsets.contains(ident)) {
+        continue;
+      }
+      self->backing_.use.at(ident) = stamp;
+      auto& grid = self->data_.at(ident);
+      if (grid.size() != 0) {
+        continue;
+      }
+      // The extents were validated when the backing file was scanned, so the
+      // read cannot run past the mapped pages unless the file changed
+      // underneath.
+      detail::isviewstream ss(backing_.file->view());
+      ss.seekg(static_cast<std::streamoff>(backing_.offsets.at(ident)));
+      grid = detail::serialize::read_vector<std::complex<T>>(ss);
+    }
+    self->apply_residency_budget(stamp);
+  }
+
+  /// @brief Release the grids of the backed constituents.
+  ///
+  /// The memory is handed back and the next interpolation faults the grids in
+  /// again. Must not be called while another thread interpolates the model.
+  /// No-op unless the model was lazily loaded.
+  auto unload() -> void {
+    if (backing_.file == nullptr) {
+      return;
+    }
+    for (const auto& item : backing_.offsets) {
+      data_.at(item.first) = Vector<std::complex<T>>();
+    }
+    backing_.complete.store(false, std::memory_order_release);
+  }
+
+  /// @brief Get the backed constituents currently resident in memory.
+  ///
+  /// @return The resident constituents; empty if the model was not lazily
+  /// loaded.
+  auto resident() const -> std::vector<Constituent> {
+    auto result = std::vector<Constituent>();
+    for (const auto& item : backing_.offsets) {
+      if (data_.at(item.first).size() != 0) {
+        result.push_back(item.first);
+      }
+    }
+    return result;
+  }
+
   /// Clear all tidal constituents.
   inline auto clear() -> void {
     data_.clear();
+    quantized_.clear();
     dynamic_.clear();
+    backing_ = LazyBacking();
   }
 
   /// True if no tidal constituent is handled by the model.
@@ -241,8 +545,165 @@ class AbstractTidalModel
   constexpr auto tide_type() const -> TideType { return tide_type_; }
 
  protected:
+  /// @brief Backing store of a lazily loaded model.
+  ///
+  /// The synchronization members are per instance: copies of a model share
+  /// the mapped file but fault their own grids in.
+  struct LazyBacking {
+    /// The mapped file holding the serialized state of the model.
+    std::shared_ptr<detail::MappedFile> file{};
+    /// Byte offset of each backed constituent in the file.
+    ConstituentMap<std::size_t> offsets{};
+    /// Stamp of the last fault that used each backed constituent.
+    ConstituentMap<uint64_t> use{};
+    /// Number of faults issued.
+    uint64_t clock{0};
+    /// Maximum number of resident grids, 0 if unbounded.
+    std::size_t max_resident{0};
+    /// True when every backed constituent is resident.
+    std::atomic<bool> complete{false};
+    /// Serializes the faults issued by concurrent interpolations.
+    std::mutex mutex{};
+
+    LazyBacking() = default;
+    ~LazyBacking() = default;
+    /// Copies get a fresh mutex: each model instance synchronizes its own
+    /// faults.
+    LazyBacking(const LazyBacking& rhs)
+        : file(rhs.file),
+          offsets(rhs.offsets),
+          use(rhs.use),
+          clock(rhs.clock),
+          max_resident(rhs.max_resident),
+          complete(rhs.complete.load()) {}
+    /// Moved-from instances keep a fresh mutex as well.
+    LazyBacking(LazyBacking&& rhs) noexcept
+        : file(std::move(rhs.file)),
+          offsets(std::move(rhs.offsets)),
+          use(std::move(rhs.use)),
+          clock(rhs.clock),
+          max_resident(rhs.max_resident),
+          complete(rhs.complete.load()) {}
+    /// Copy assignment operator.
+    auto operator=(const LazyBacking& rhs) -> LazyBacking& {
+      file = rhs.file;
+      offsets = rhs.offsets;
+      use = rhs.use;
+      clock = rhs.clock;
+      max_resident = rhs.max_resident;
+      complete.store(rhs.complete.load());
+      return *this;
+    }
+    /// Move assignment operator.
+    auto operator=(LazyBacking&& rhs) noexcept -> LazyBacking& {
+      file = std::move(rhs.file);
+      offsets = std::move(rhs.offsets);
+      use = std::move(rhs.use);
+      clock = rhs.clock;
+      max_resident = rhs.max_resident;
+      complete.store(rhs.complete.load());
+      return *this;
+    }
+  };
+
+  /// @brief Back the given constituents with a serialized model state.
+  ///
+  /// The entries are registered with released vectors: the grids are faulted
+  /// in from the mapped file on first use. Called by the lazy setstate of the
+  /// concrete models.
+  ///
+  /// @param[in] file The mapped file holding the serialized model state.
+  /// @param[in] offsets The byte offset of each constituent in the file.
+  /// @param[in] max_resident The maximum number of grids kept resident, 0 to
+  /// keep every loaded grid.
+  auto attach_backing(std::shared_ptr<detail::MappedFile> file,
+                      ConstituentMap<std::size_t> offsets,
+                      const std::size_t max_resident) -> void {
+    backing_.file = std::move(file);
+    backing_.offsets = std::move(offsets);
+    backing_.max_resident = max_resident;
+    backing_.complete.store(false, std::memory_order_release);
+    for (const auto& item : backing_.offsets) {
+      backing_.use.emplace(item.first, 0);
+      data_.emplace(item.first, Vector<std::complex<T>>());
+    }
+  }
+
+  /// @brief Fault every backed constituent in and detach the backing file.
+  ///
+  /// Called by the mutators, which rewrite the resident storage: the model
+  /// becomes an ordinary, fully resident one.
+  auto materialize() -> void {
+    if (backing_.file == nullptr) {
+      return;
+    }
+    // The budget no longer applies: everything becomes resident.
+    backing_.max_resident = 0;
+    fault_in();
+    backing_ = LazyBacking();
+  }
+
+  /// @brief Evict the least recently used resident grids beyond the
+  /// residency budget.
+  ///
+  /// Must be called with the backing mutex held. The grids used by the
+  /// current fault, identified by the given stamp, are never evicted.
+  ///
+  /// @param[in] stamp The stamp of the current fault.
+  auto apply_residency_budget(const uint64_t stamp) -> void {
+    auto resident_count = std::size_t{0};
+    auto evictable = std::vector<Constituent>();
+    for (const auto& item : backing_.offsets) {
+      if (data_.at(item.first).size() == 0) {
+        continue;
+      }
+      ++resident_count;
+      if (backing_.use.at(item.first) < stamp) {
+        evictable.push_back(item.first);
+      }
+    }
+    if (backing_.max_resident != 0 && resident_count > backing_.max_resident) {
+      std::sort(evictable.begin(), evictable.end(),
+                [this](const Constituent lhs, const Constituent rhs) -> bool {
+                  return backing_.use.at(lhs) < backing_.use.at(rhs);
+                });
+      for (const auto ident : evictable) {
+        if (resident_count <= backing_.max_resident) {
+          break;
+        }
+        data_.at(ident) = Vector<std::complex<T>>();
+        --resident_count;
+      }
+    }
+    backing_.complete.store(resident_count == backing_.offsets.size(),
+                            std::memory_order_release);
+  }
+
+  /// @brief Widen the quantized constituents to floating-point values.
+  ///
+  /// Used to serialize a quantized model with the same layout as an
+  /// unquantized one.
+  ///
+  /// @return The dequantized constituents.
+  auto dequantized_data() const -> ConstituentMap<Vector<std::complex<T>>> {
+    auto result = ConstituentMap<Vector<std::complex<T>>>();
+    for (const auto& item : quantized_) {
+      result.emplace(item.first, item.second.template decode<T>());
+    }
+    return result;
+  }
+
   /// Tidal constituents handled by the model.
-  std::map<Constituent, Vector<std::complex<T>>> data_{};
+  ConstituentMap<DataVector<std::complex<T>>> data_{};
+
+  /// Quantized tidal constituents; empty if the model is not quantized. The
+  /// entries of data_ are kept, with released vectors, so the constituent
+  /// set exposed by the model does not depend on the storage mode.
+  ConstituentMap<detail::QuantizedVector> quantized_{};
+
+  /// Backing store of the constituents read on demand; detached if the model
+  /// was loaded eagerly.
+  LazyBacking backing_{};
 
   /// List of tidal constituents handled by the model but not interpolated.
   std::vector<Constituent> dynamic_{};
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 #include "fes/detail/math.hpp"
 
@@ -24,6 +25,8 @@ enum class Formulae {
   kMeeus
 };
 
+class BatchedAstronomic;
+
 /// @brief Astronomical angles.
 ///
 /// In tidal work the only celestial bodies that need to be considered are the
@@ -80,6 +83,23 @@ class Astronomic {
   auto FES_MATH_CONSTEXPR update(const double epoch,
                                  const uint16_t leap_seconds) noexcept -> void;
 
+  /// @brief Updates astronomic angles for a given UTC time, with the formulae
+  /// selected at compile time.
+  ///
+  /// The runtime update() reaches the polynomial series through a member
+  /// function pointer, which the compiler cannot inline. This overload binds
+  /// the series statically, so callers that know the formulae at compile
+  /// time, like TypedAstronomic, get the whole evaluation inlined and
+  /// constant-folded.
+  ///
+  /// @tparam F Astronomic formulae used to calculate the astronomic angles.
+  /// @param[in] epoch Desired UTC time in seconds since 1970-01-01T00:00:00Z.
+  /// @param[in] leap_seconds The number of leap seconds since
+  /// 1970-01-01T00:00:00Z.
+  template <Formulae F>
+  auto FES_MATH_CONSTEXPR update(const double epoch,
+                                 const uint16_t leap_seconds) noexcept -> void;
+
   /// @brief @f$T@f$
   ///
   /// @returns Hour angle of mean sun.
@@ -330,6 +350,10 @@ class Astronomic {
     return (sin_i - (5.0 / 4.0) * detail::math::pow<3>(sin_i)) * factor;
   }
 
+  /// The batched evaluator writes the precomputed angles of one epoch
+  /// directly into the members.
+  friend class BatchedAstronomic;
+
  protected:
   /// @f$T@f$: hour angle of mean sun.
   double t_{std::numeric_limits<double>::quiet_NaN()};
@@ -386,6 +410,30 @@ class Astronomic {
   FES_MATH_CONSTEXPR auto meeus(const double epoch,
                                 const uint16_t leap_seconds) noexcept -> void;
 
+  /// Evaluates the polynomial series selected at compile time; the overload
+  /// set mirrors the dispatch of the member function pointer.
+  FES_MATH_CONSTEXPR auto evaluate_series(
+      std::integral_constant<Formulae, Formulae::kSchuremanOrder1> /*tag*/,
+      const double epoch, const uint16_t leap_seconds) noexcept -> void {
+    schureman_order1(epoch, leap_seconds);
+  }
+  FES_MATH_CONSTEXPR auto evaluate_series(
+      std::integral_constant<Formulae, Formulae::kSchuremanOrder3> /*tag*/,
+      const double epoch, const uint16_t leap_seconds) noexcept -> void {
+    schureman_order3(epoch, leap_seconds);
+  }
+  FES_MATH_CONSTEXPR auto evaluate_series(
+      std::integral_constant<Formulae, Formulae::kMeeus> /*tag*/,
+      const double epoch, const uint16_t leap_seconds) noexcept -> void {
+    meeus(epoch, leap_seconds);
+  }
+
+  /// Derives the hour angle of the mean sun and the trigonometric angles
+  /// shared by every formulae from the polynomial series.
+  ///
+  /// @param[in] epoch Desired UTC time in seconds since 1970-01-01T00:00:00Z.
+  FES_MATH_CONSTEXPR auto complete_update(const double epoch) noexcept -> void;
+
   /// Pointer to the function that calculates the astronomic angles.
   void (Astronomic::*update_)(const double epoch,
                               const uint16_t leap_seconds) noexcept {
@@ -525,7 +573,20 @@ auto FES_MATH_CONSTEXPR Astronomic::update(const double epoch,
                                            const uint16_t leap_seconds) noexcept
     -> void {
   ((*this).*update_)(epoch, leap_seconds);
+  complete_update(epoch);
+}
+
+template <Formulae F>
+auto FES_MATH_CONSTEXPR Astronomic::update(const double epoch,
+                                           const uint16_t leap_seconds) noexcept
+    -> void {
+  evaluate_series(std::integral_constant<Formulae, F>{}, epoch, leap_seconds);
+  complete_update(epoch);
+}
 
+// /////////////////////////////////////////////////////////////////////////////
+auto FES_MATH_CONSTEXPR Astronomic::complete_update(const double epoch) noexcept
+    -> void {
   // T mean solar angle relative to Greenwich
   t_ = std::remainder(180.0 + 15.0 * (std::fmod(epoch, 86400) / 3600), 360.0);
 
@@ -583,5 +644,45 @@ auto FES_MATH_CONSTEXPR Astronomic::update(const double epoch,
           (detail::math::pow<2>(std::sin(i_)) * std::cos(2.0 * nu_) + 0.0727));
 }
 
+/// @brief Astronomical angles with the formulae selected at compile time.
+///
+/// The runtime class reaches the polynomial series through a member function
+/// pointer, so the evaluation is an indirect call the compiler cannot inline
+/// into the callers. This variant fixes the formulae as a template parameter:
+/// update() binds the series statically and the whole evaluation is inlined
+/// and constant-folded into the prediction hot path. The class derives from
+/// Astronomic and only shadows update(), so an instance can be handed to
+/// every consumer of the runtime class, which remains the API boundary.
+///
+/// @tparam F Astronomic formulae used to calculate the astronomic angles.
+template <Formulae F>
+class TypedAstronomic : public Astronomic {
+ public:
+  /// @brief Default constructor.
+  constexpr TypedAstronomic() : Astronomic(F) {}
+
+  /// @brief Create astronomic angles for a given UTC time.
+  ///
+  /// @param[in] epoch Desired UTC time in seconds since 1970-01-01T00:00:00Z.
+  /// @param[in] leap_seconds The number of leap seconds since
+  /// 1970-01-01T00:00:00Z.
+  FES_MATH_CONSTEXPR TypedAstronomic(const double epoch,
+                                     const uint16_t leap_seconds)
+      : TypedAstronomic() {
+    update(epoch, leap_seconds);
+  }
+
+  /// @brief Updates astronomic angles for a given UTC time, with the series
+  /// statically bound to the formulae.
+  ///
+  /// @param[in] epoch Desired UTC time in seconds since 1970-01-01T00:00:00Z.
+  /// @param[in] leap_seconds The number of leap seconds since
+  /// 1970-01-01T00:00:00Z.
+  auto FES_MATH_CONSTEXPR update(const double epoch,
+                                 const uint16_t leap_seconds) noexcept -> void {
+    Astronomic::update<F>(epoch, leap_seconds);
+  }
+};
+
 }  // namespace angle
 }  // namespace fes
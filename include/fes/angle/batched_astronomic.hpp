@@ -0,0 +1,367 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/angle/batched_astronomic.hpp
+/// @brief Astronomic angles evaluated over a batch of epochs.
+#pragma once
+#include <Eigen/Core>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "fes/angle/astronomic.hpp"
+#include "fes/detail/broadcast.hpp"
+#include "fes/detail/math.hpp"
+#include "fes/eigen.hpp"
+
+namespace fes {
+namespace angle {
+
+/// @brief Astronomic angles evaluated over a batch of epochs.
+///
+/// Astronomic::update() evaluates one epoch at a time through a member
+/// function pointer, so a harmonic analysis over a long time series pays one
+/// scalar pass through the polynomial series and the Schureman trigonometric
+/// corrections per epoch. This class evaluates the same series for a whole
+/// epoch vector at once: each angle is stored as a contiguous array indexed
+/// by the epoch, so the polynomial and trigonometric stages compile to
+/// vectorized sweeps over the batch instead of a chain of scalar calls.
+///
+/// The arrays can be consumed directly by stages working epoch-major, or
+/// scattered one epoch at a time into a scalar Astronomic with fill() for
+/// the stages, such as the nodal corrections, that are written against the
+/// scalar interface. The angles of a given epoch are bit-for-bit candidates
+/// of the scalar evaluation up to the rounding of the vectorized angle
+/// normalization.
+class BatchedAstronomic {
+ public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] formulae Astronomic formulae used to calculate the
+  /// astronomic angles.
+  explicit BatchedAstronomic(
+      const Formulae formulae = Formulae::kSchuremanOrder1)
+      : formulae_(formulae) {}
+
+  /// @brief Updates the astronomic angles for a batch of UTC times.
+  ///
+  /// @param[in] epoch Desired UTC times in seconds since
+  /// 1970-01-01T00:00:00Z.
+  /// @param[in] leap_seconds The number of leap seconds since
+  /// 1970-01-01T00:00:00Z, for each provided epoch.
+  /// @throw std::invalid_argument if the size of the epoch vector is not
+  /// equal to the size of the leap seconds vector.
+  auto update(const Eigen::Ref<const Eigen::VectorXd>& epoch,
+              const Eigen::Ref<const Vector<uint16_t>>& leap_seconds) -> void;
+
+  /// @brief Number of epochs held by the batch.
+  auto size() const noexcept -> Eigen::Index { return t_.size(); }
+
+  /// @brief Scatters the angles of one epoch into a scalar instance.
+  ///
+  /// @param[in] ix Index of the epoch in the batch.
+  /// @param[out] angles Scalar instance updated with the angles of the
+  /// selected epoch.
+  auto fill(const Eigen::Index ix, Astronomic& angles) const noexcept -> void {
+    angles.t_ = t_(ix);
+    angles.n_ = n_(ix);
+    angles.h_ = h_(ix);
+    angles.s_ = s_(ix);
+    angles.p1_ = p1_(ix);
+    angles.p_ = p_(ix);
+    angles.i_ = i_(ix);
+    angles.xi_ = xi_(ix);
+    angles.nu_ = nu_(ix);
+    angles.x1ra_ = x1ra_(ix);
+    angles.r_ = r_(ix);
+    angles.nuprim_ = nuprim_(ix);
+    angles.nusec_ = nusec_(ix);
+  }
+
+  /// @brief @f$T@f$
+  ///
+  /// @returns Hour angle of mean sun, per epoch (radians).
+  auto t() const noexcept -> const Eigen::ArrayXd& { return t_; }
+
+  /// @brief @f$N@f$
+  ///
+  /// @returns Longitude of moon's node, per epoch (radians).
+  auto n() const noexcept -> const Eigen::ArrayXd& { return n_; }
+
+  /// @brief @f$h@f$
+  ///
+  /// @returns Mean longitude of sun, per epoch (radians).
+  auto h() const noexcept -> const Eigen::ArrayXd& { return h_; }
+
+  /// @brief @f$s@f$
+  ///
+  /// @returns Mean longitude of moon, per epoch (radians).
+  auto s() const noexcept -> const Eigen::ArrayXd& { return s_; }
+
+  /// @brief @f$p_1@f$
+  ///
+  /// @returns Mean longitude of solar perigee, per epoch (radians).
+  auto p1() const noexcept -> const Eigen::ArrayXd& { return p1_; }
+
+  /// @brief @f$p@f$
+  ///
+  /// @returns Mean longitude of lunar perigee, per epoch (radians).
+  auto p() const noexcept -> const Eigen::ArrayXd& { return p_; }
+
+  /// @brief @f$I@f$
+  ///
+  /// @returns Obliquity of lunar orbit with respect to earth's equator, per
+  /// epoch (radians).
+  auto i() const noexcept -> const Eigen::ArrayXd& { return i_; }
+
+  /// @brief @f$\xi@f$
+  ///
+  /// @returns Longitude in the moon's orbit of lunar intersection, per epoch
+  /// (radians).
+  auto xi() const noexcept -> const Eigen::ArrayXd& { return xi_; }
+
+  /// @brief @f$\nu@f$
+  ///
+  /// @returns Right ascension of lunar intersection, per epoch (radians).
+  auto nu() const noexcept -> const Eigen::ArrayXd& { return nu_; }
+
+  /// @brief @f$1/R_a@f$
+  ///
+  /// @returns Factor in amplitude of constituent @f$L_2@f$, per epoch.
+  auto x1ra() const noexcept -> const Eigen::ArrayXd& { return x1ra_; }
+
+  /// @brief @f$R@f$
+  ///
+  /// @returns Term in argument of constituent @f$L_2@f$, per epoch
+  /// (radians).
+  auto r() const noexcept -> const Eigen::ArrayXd& { return r_; }
+
+  /// @brief @f$\nu'@f$
+  ///
+  /// @returns Term in argument of lunisolar constituent @f$K_1@f$, per epoch
+  /// (radians).
+  auto nuprim() const noexcept -> const Eigen::ArrayXd& { return nuprim_; }
+
+  /// @brief @f$\nu''@f$
+  ///
+  /// @returns Term in argument of lunisolar constituent @f$K_2@f$, per epoch
+  /// (radians).
+  auto nusec() const noexcept -> const Eigen::ArrayXd& { return nusec_; }
+
+ private:
+  /// Astronomic formulae used for the polynomial series.
+  Formulae formulae_;
+
+  /// @f$T@f$: hour angle of mean sun.
+  Eigen::ArrayXd t_{};
+  /// @f$N@f$: longitude of moon's node.
+  Eigen::ArrayXd n_{};
+  /// @f$h@f$: mean longitude of sun.
+  Eigen::ArrayXd h_{};
+  /// @f$s@f$: mean longitude of moon.
+  Eigen::ArrayXd s_{};
+  /// @f$p_1@f$: mean longitude of solar perigee.
+  Eigen::ArrayXd p1_{};
+  /// @f$p@f$: mean longitude of lunar perigee.
+  Eigen::ArrayXd p_{};
+  /// @f$I@f$: obliquity of lunar orbit with respect to earth's equator.
+  Eigen::ArrayXd i_{};
+  /// @f$\xi@f$: longitude in the moon's orbit of lunar intersection.
+  Eigen::ArrayXd xi_{};
+  /// @f$\nu@f$: right ascension of lunar intersection.
+  Eigen::ArrayXd nu_{};
+  /// @f$1/R_a@f$: factor in amplitude of constituent @f$L_2@f$.
+  Eigen::ArrayXd x1ra_{};
+  /// @f$R@f$: term in argument of constituent @f$L_2@f$.
+  Eigen::ArrayXd r_{};
+  /// @f$\nu'@f$: term in argument of lunisolar constituent @f$K_1@f$.
+  Eigen::ArrayXd nuprim_{};
+  /// @f$\nu''@f$: term in argument of lunisolar constituent @f$K_2@f$.
+  Eigen::ArrayXd nusec_{};
+
+  /// Evaluates the Schureman polynomial series limited to order 1 over the
+  /// batch. The series are written in degrees; update() normalizes them.
+  auto schureman_order1(const Eigen::Ref<const Eigen::VectorXd>& epoch)
+      -> void;
+
+  /// Evaluates the Schureman polynomial series over the batch.
+  auto schureman_order3(const Eigen::Ref<const Eigen::VectorXd>& epoch)
+      -> void;
+
+  /// Evaluates the Meeus polynomial series over the batch.
+  auto meeus(const Eigen::Ref<const Eigen::VectorXd>& epoch,
+             const Eigen::Ref<const Vector<uint16_t>>& leap_seconds) -> void;
+};
+
+// /////////////////////////////////////////////////////////////////////////////
+inline auto BatchedAstronomic::schureman_order1(
+    const Eigen::Ref<const Eigen::VectorXd>& epoch) -> void {
+  const auto jc =
+      (((epoch.array() / 86400.0) + 25567.5) / 36525.0).eval();
+
+  // Schureman, P. 162
+  n_ = detail::math::dms_to_degrees(259.0, 10.0, 57.12) +
+       jc * -(5 * 360 + detail::math::dms_to_degrees(0.0, 0.0, 482'912.63));
+  h_ = detail::math::dms_to_degrees(279.0, 41.0, 48.04) +
+       jc * detail::math::dms_to_degrees(0.0, 0.0, 129'602'768.13);
+  s_ = detail::math::dms_to_degrees(270.0, 26.0, 14.72) +
+       jc * (1336 * 360 + detail::math::dms_to_degrees(0.0, 0.0,
+                                                       1'108'411.20));
+  p1_ = detail::math::dms_to_degrees(281.0, 13.0, 15.0) +
+        jc * detail::math::dms_to_degrees(0.0, 0.0, 6'189.03);
+  p_ = detail::math::dms_to_degrees(334.0, 19.0, 40.87) +
+       jc * (11 * 360 + detail::math::dms_to_degrees(0.0, 0.0, 392'515.94));
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+inline auto BatchedAstronomic::schureman_order3(
+    const Eigen::Ref<const Eigen::VectorXd>& epoch) -> void {
+  const auto jc =
+      (((epoch.array() / 86400.0) + 25567.5) / 36525.0).eval();
+
+  // Schureman, P. 162; each series is the Horner form of the scalar
+  // evaluation, expanded on the batch.
+  n_ = detail::math::dms_to_degrees(259.0, 10.0, 57.12) +
+       jc * (-(5 * 360 + detail::math::dms_to_degrees(0.0, 0.0, 482'912.63)) +
+             jc * (detail::math::dms_to_degrees(0.0, 0.0, 7.58) +
+                   jc * detail::math::dms_to_degrees(0.0, 0.0, 0.008)));
+  h_ = detail::math::dms_to_degrees(279.0, 41.0, 48.04) +
+       jc * (detail::math::dms_to_degrees(0.0, 0.0, 129'602'768.13) +
+             jc * detail::math::dms_to_degrees(0.0, 0.0, 1.089));
+  s_ = detail::math::dms_to_degrees(270.0, 26.0, 14.72) +
+       jc * ((1336 * 360 + detail::math::dms_to_degrees(0.0, 0.0,
+                                                        1'108'411.20)) +
+             jc * (detail::math::dms_to_degrees(0.0, 0.0, 9.09) +
+                   jc * detail::math::dms_to_degrees(0.0, 0.0, 0.006'8)));
+  p1_ = detail::math::dms_to_degrees(281.0, 13.0, 15.0) +
+        jc * (detail::math::dms_to_degrees(0.0, 0.0, 6'189.03) +
+              jc * (detail::math::dms_to_degrees(0.0, 0.0, 1.63) +
+                    jc * detail::math::dms_to_degrees(0.0, 0.0, 0.012)));
+  p_ = detail::math::dms_to_degrees(334.0, 19.0, 40.87) +
+       jc * ((11 * 360 + detail::math::dms_to_degrees(0.0, 0.0, 392'515.94)) +
+             jc * (-detail::math::dms_to_degrees(0.0, 0.0, 37.24) +
+                   jc * -detail::math::dms_to_degrees(0.0, 0.0, 0.045)));
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+inline auto BatchedAstronomic::meeus(
+    const Eigen::Ref<const Eigen::VectorXd>& epoch,
+    const Eigen::Ref<const Vector<uint16_t>>& leap_seconds) -> void {
+  // Number of seconds elapsed since 2000-01-01T12:00:00Z (J2000) to epoch
+  constexpr auto j2000 = 946728000.0;
+  // Julian Ephemeris Millennium
+  const auto jc = ((epoch.array() + leap_seconds.array().cast<double>() +
+                    32.184 - j2000) /
+                   3155760000.0)
+                      .eval();
+
+  // Jean Meeus, Astronomical Algorithms, 2nd ed., 1998., Willmann-Bell, Inc.
+  // Formulae 47.7, 47.1, 47.2 and 47.3; same coefficients as the scalar
+  // evaluation, in Horner form.
+  n_ = 125.0445479 +
+       jc * (-1934.1362891 +
+             jc * (0.0020754 +
+                   jc * (1.0 / 467441.0 + jc * (-1.0 / 60616000.0))));
+  s_ = 218.3164477 +
+       jc * (481267.88123421 +
+             jc * (-0.0015786 +
+                   jc * (1.0 / 538841.0 + jc * (-1.0 / 65194000.0))));
+  const auto d =
+      (297.8501921 +
+       jc * (445267.1114034 +
+             jc * (-0.0018819 +
+                   jc * (-1.0 / 545868.0 + jc * (1.0 / 113065000.0)))))
+          .eval();
+  h_ = s_ - d;
+  const auto g =
+      (357.5291092 +
+       jc * (35999.0502909 + jc * (-0.0001536 + jc * (1.0 / 24490000.0))))
+          .eval();
+  p1_ = h_ - g;
+  p_ = 83.3532465 +
+       jc * (4069.0137287 +
+             jc * (-0.0103200 +
+                   jc * (-1.0 / 80053.0 + jc * (1.0 / 18999000.0))));
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+inline auto BatchedAstronomic::update(
+    const Eigen::Ref<const Eigen::VectorXd>& epoch,
+    const Eigen::Ref<const Vector<uint16_t>>& leap_seconds) -> void {
+  detail::check_eigen_shape("epoch", epoch, "leap_seconds", leap_seconds);
+
+  switch (formulae_) {
+    case Formulae::kSchuremanOrder1:
+      schureman_order1(epoch);
+      break;
+    case Formulae::kSchuremanOrder3:
+      schureman_order3(epoch);
+      break;
+    case Formulae::kMeeus:
+      meeus(epoch, leap_seconds);
+      break;
+    default:
+      throw std::runtime_error("unknown formulae");
+  }
+
+  // T mean solar angle relative to Greenwich
+  t_ = epoch.array().unaryExpr([](const double x) {
+    return detail::math::radians(
+        std::remainder(180.0 + 15.0 * (std::fmod(x, 86400) / 3600), 360.0));
+  });
+
+  // Normalize the series to [0, 360) degrees, then convert to radians; the
+  // floor based reduction is the vectorized form of
+  // detail::math::normalize_angle(x, 0).
+  const auto normalize = [](Eigen::ArrayXd& x) {
+    x -= 360.0 * (x / 360.0).floor();
+    x *= detail::math::pi<double>() / 180.0;
+  };
+  normalize(n_);
+  normalize(s_);
+  normalize(h_);
+  normalize(p_);
+  normalize(p1_);
+
+  // SCHUREMAN FORMULAE P. 156
+  i_ = (0.91370 - 0.03569 * n_.cos()).acos();
+
+  // SCHUREMAN FORMULAE P. 156
+  const auto tgn2 = (n_ * 0.5).tan().eval();
+  const auto at1 = (1.01883 * tgn2).atan().eval();
+  const auto at2 = (0.64412 * tgn2).atan().eval();
+
+  // Longitude in the moon's orbit of lunar intersection
+  xi_ = -at1 - at2 + n_;
+  xi_ = (n_ > detail::math::pi<double>())
+            .select(xi_ - detail::math::two_pi<double>(), xi_);
+
+  // Right ascension of lunar intersection
+  nu_ = at1 - at2;
+
+  // for constituents l2, k1, k2
+  const auto tgi2 = (i_ * 0.5).tan().square().eval();
+
+  // SCHUREMAN P. 41 (191)
+  const auto p = (p_ - xi_).eval();
+
+  // SCHUREMAN P. 44 (213)
+  x1ra_ = (1.0 + tgi2 * (36.0 * tgi2 - 12.0 * (2.0 * p).cos())).sqrt();
+
+  // SCHUREMAN P. 41 (196)
+  r_ = ((2.0 * p).sin() / (1.0 / (6.0 * tgi2) - (2.0 * p).cos())).atan();
+
+  // SCHUREMAN P. 45 (224)
+  nuprim_ = ((2.0 * i_).sin() * nu_.sin() /
+             ((2.0 * i_).sin() * nu_.cos() + 0.3347))
+                .atan();
+
+  // SCHUREMAN P. 46 (232)
+  nusec_ = 0.5 * (i_.sin().square() * (2.0 * nu_).sin() /
+                  (i_.sin().square() * (2.0 * nu_).cos() + 0.0727))
+                     .atan();
+}
+
+}  // namespace angle
+}  // namespace fes
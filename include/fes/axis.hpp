@@ -7,6 +7,7 @@
 #pragma once
 #include <Eigen/Core>
 #include <boost/optional.hpp>
+#include <iosfwd>
 #include <limits>
 #include <memory>
 #include <tuple>
@@ -141,10 +142,21 @@ class Axis : public std::enable_shared_from_this<Axis> {
   /// @return The serialized axis.
   auto getstate() const -> std::string;
 
+  /// @brief Serialize the axis into a stream.
+  /// @param[in] ss The stream to write to.
+  auto getstate(std::ostream& ss) const -> void;
+
   /// @brief Deserialize the axis.
   /// @param[in] data The serialized axis.
   static auto setstate(const string_view& data) -> Axis;
 
+  /// @brief Deserialize the axis from a stream.
+  ///
+  /// The stream is configured to throw on read failures.
+  ///
+  /// @param[in] ss The stream to read from.
+  static auto setstate(std::istream& ss) -> Axis;
+
  private:
   /// True if the axis is circular.
   bool is_circular_{};
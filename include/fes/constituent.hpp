@@ -90,6 +90,9 @@ enum Constituent : uint8_t {
   kMf2 = 74,      //!< @f$Mf_2@f$
 };
 
+/// Number of tidal constituents known by the library.
+constexpr auto kConstituentSize = static_cast<size_t>(kMf2) + 1;
+
 namespace constituents {
 
 /// Parses the tidal constituent from a string. Parsing is case not sensitive.
@@ -0,0 +1,129 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/constituent_map.hpp
+/// @brief Flat container of values indexed by tidal constituent.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fes/constituent.hpp"
+
+namespace fes {
+
+/// @brief Flat associative container keyed by tidal constituent.
+///
+/// Replacement for the std::map previously used to store the constituents
+/// handled by a tidal model: the entries are kept sorted by identifier in one
+/// contiguous vector, so the interpolation hot loops scan contiguous memory
+/// instead of chasing tree nodes, and a fixed-size array indexed by the dense
+/// constituent enum gives constant-time lookups.
+///
+/// @tparam V The type of the values stored.
+template <typename V>
+class ConstituentMap {
+ public:
+  /// Type of the keys.
+  using key_type = Constituent;
+  /// Type of the mapped values.
+  using mapped_type = V;
+  /// Type of the entries.
+  using value_type = std::pair<Constituent, V>;
+  /// Constant iterator on the entries.
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  /// Default constructor.
+  ConstituentMap() { index_.fill(-1); }
+
+  /// Insert a value if its constituent is not already present, like
+  /// std::map::emplace.
+  ///
+  /// @param[in] ident The tidal constituent identifier.
+  /// @param[in] value The value stored for the constituent.
+  auto emplace(const Constituent ident, V value) -> void {
+    if (index_[static_cast<size_t>(ident)] != -1) {
+      return;
+    }
+    auto it = std::lower_bound(items_.begin(), items_.end(), ident,
+                               [](const value_type& item,
+                                  const Constituent rhs) -> bool {
+                                 return item.first < rhs;
+                               });
+    it = items_.emplace(it, ident, std::move(value));
+    // The entries located after the insertion point moved by one slot.
+    for (auto jx = static_cast<size_t>(it - items_.begin());
+         jx < items_.size(); ++jx) {
+      index_[static_cast<size_t>(items_[jx].first)] = static_cast<int16_t>(jx);
+    }
+  }
+
+  /// Get the value stored for a constituent.
+  ///
+  /// @param[in] ident The tidal constituent identifier.
+  /// @return The value stored for the constituent.
+  /// @throw std::out_of_range if the constituent is not present.
+  auto at(const Constituent ident) const -> const V& {
+    const auto jx = index_[static_cast<size_t>(ident)];
+    if (jx == -1) {
+      throw std::out_of_range(std::string("constituent not found: ") +
+                              constituents::name(ident));
+    }
+    return items_[static_cast<size_t>(jx)].second;
+  }
+
+  /// Get a mutable reference to the value stored for a constituent.
+  ///
+  /// @param[in] ident The tidal constituent identifier.
+  /// @return The value stored for the constituent.
+  /// @throw std::out_of_range if the constituent is not present.
+  auto at(const Constituent ident) -> V& {
+    const auto jx = index_[static_cast<size_t>(ident)];
+    if (jx == -1) {
+      throw std::out_of_range(std::string("constituent not found: ") +
+                              constituents::name(ident));
+    }
+    return items_[static_cast<size_t>(jx)].second;
+  }
+
+  /// Check if a constituent is present.
+  ///
+  /// @param[in] ident The tidal constituent identifier.
+  /// @return True if the constituent is present.
+  constexpr auto contains(const Constituent ident) const noexcept -> bool {
+    return index_[static_cast<size_t>(ident)] != -1;
+  }
+
+  /// Returns an iterator to the beginning of the entries.
+  inline auto begin() const noexcept -> const_iterator {
+    return items_.begin();
+  }
+
+  /// Returns an iterator to the end of the entries.
+  inline auto end() const noexcept -> const_iterator { return items_.end(); }
+
+  /// Get the number of entries.
+  constexpr auto size() const noexcept -> size_t { return items_.size(); }
+
+  /// True if no entry is stored.
+  constexpr auto empty() const noexcept -> bool { return items_.empty(); }
+
+  /// Remove all the entries.
+  inline auto clear() noexcept -> void {
+    items_.clear();
+    index_.fill(-1);
+  }
+
+ private:
+  /// Entries sorted by constituent identifier.
+  std::vector<value_type> items_{};
+  /// Position of each constituent in the entries, -1 if absent.
+  std::array<int16_t, kConstituentSize> index_{};
+};
+
+}  // namespace fes
@@ -0,0 +1,130 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/data_vector.hpp
+/// @brief Constituent samples owned by the model or viewed in place.
+#pragma once
+#include <memory>
+#include <utility>
+
+#include "fes/eigen.hpp"
+
+namespace fes {
+
+/// @brief Samples of one tidal constituent.
+///
+/// The samples are either owned by the instance or viewed in place in a
+/// buffer owned by someone else, typically a file or a shared-memory segment
+/// mapped in the process. Both cases expose the same read interface, so the
+/// interpolation inner loops do not depend on where the samples live.
+/// Writing always goes through the assignment of a freshly owned vector.
+///
+/// @tparam T The type of the samples.
+template <typename T>
+class DataVector {
+ public:
+  /// The type of the samples.
+  using Scalar = T;
+
+  /// Build an empty vector.
+  DataVector() = default;
+
+  /// Take ownership of a vector of samples.
+  ///
+  /// @param[in] owned The samples owned by the instance.
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  DataVector(Vector<T> owned)
+      : owned_(std::move(owned)), data_(owned_.data()), size_(owned_.size()) {}
+
+  /// Take ownership of the evaluation of an Eigen expression.
+  ///
+  /// @param[in] expression The expression evaluated into the owned samples.
+  template <typename Derived>
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  DataVector(const Eigen::EigenBase<Derived>& expression)
+      : DataVector(Vector<T>(expression.derived())) {}
+
+  /// View samples stored in a buffer owned by someone else.
+  ///
+  /// @param[in] data The first sample of the view.
+  /// @param[in] size The number of samples viewed.
+  /// @param[in] keep_alive Handle keeping the viewed buffer alive as long as
+  /// the view exists.
+  DataVector(const T* data, const Eigen::Index size,
+             std::shared_ptr<const void> keep_alive)
+      : data_(data), size_(size), keep_alive_(std::move(keep_alive)) {}
+
+  /// Default destructor.
+  ~DataVector() = default;
+
+  /// Copy constructor. Copying an owning vector copies the samples; copying
+  /// a view shares the viewed buffer.
+  DataVector(const DataVector& rhs)
+      : owned_(rhs.owned_),
+        data_(rhs.owns() ? owned_.data() : rhs.data_),
+        size_(rhs.size_),
+        keep_alive_(rhs.keep_alive_) {}
+
+  /// Move constructor.
+  DataVector(DataVector&& rhs) noexcept { *this = std::move(rhs); }
+
+  /// Copy assignment operator.
+  auto operator=(const DataVector& rhs) -> DataVector& {
+    owned_ = rhs.owned_;
+    data_ = rhs.owns() ? owned_.data() : rhs.data_;
+    size_ = rhs.size_;
+    keep_alive_ = rhs.keep_alive_;
+    return *this;
+  }
+
+  /// Move assignment operator.
+  auto operator=(DataVector&& rhs) noexcept -> DataVector& {
+    const auto owns = rhs.owns();
+    owned_ = std::move(rhs.owned_);
+    data_ = owns ? owned_.data() : rhs.data_;
+    size_ = rhs.size_;
+    keep_alive_ = std::move(rhs.keep_alive_);
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+    return *this;
+  }
+
+  /// Read one sample.
+  ///
+  /// @param[in] ix The index of the sample.
+  /// @return The sample.
+  inline auto operator()(const Eigen::Index ix) const -> const T& {
+    return data_[ix];
+  }
+
+  /// Get the number of samples.
+  constexpr auto size() const noexcept -> Eigen::Index { return size_; }
+
+  /// Get a pointer to the first sample.
+  constexpr auto data() const noexcept -> const T* { return data_; }
+
+  /// True if the samples are owned by the instance, false if they are viewed
+  /// in a buffer owned by someone else. An empty vector owns its (absent)
+  /// samples.
+  constexpr auto owns() const noexcept -> bool {
+    return owned_.size() != 0 || data_ == nullptr;
+  }
+
+  /// Get a view of the samples usable in Eigen expressions.
+  inline auto map() const noexcept -> Eigen::Map<const Vector<T>> {
+    return {data_, size_};
+  }
+
+ private:
+  /// The owned samples; released when the instance is a view.
+  Vector<T> owned_{};
+  /// The first sample, owned or viewed.
+  const T* data_{nullptr};
+  /// The number of samples.
+  Eigen::Index size_{0};
+  /// Handle keeping a viewed buffer alive.
+  std::shared_ptr<const void> keep_alive_{};
+};
+
+}  // namespace fes
@@ -5,6 +5,7 @@
 /// @file include/fes/detail/broadcast.hpp
 /// @brief Broadcasting utilities.
 #pragma once
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -69,5 +70,79 @@ void check_eigen_shape(const std::string& name1, const Matrix1& v1,
   check_eigen_shape(name1, v1, args...);
 }
 
+/// @brief Compute the common size of a list of vectors allowing size-1
+/// vectors to be broadcast against the others.
+///
+/// @tparam Vector1 type of the vector
+/// @param[in] name1 name of the variable containing the vector
+/// @param[in] v1 vector to process
+/// @return the size of the vector
+template <typename Vector1>
+auto broadcast_eigen_shape(const std::string& name1, const Vector1& v1)
+    -> Eigen::Index {
+  static_cast<void>(name1);
+  return v1.size();
+}
+
+/// @brief Compute the common size of a list of vectors allowing size-1
+/// vectors to be broadcast against the others.
+///
+/// @tparam Vector1 type of the first vector
+/// @tparam Args list of vectors to process
+/// @param[in] name1 name of the variable containing the first vector
+/// @param[in] v1 first vector
+/// @param[in] args other vectors to process
+/// @return the common size of the vectors
+/// @throw std::invalid_argument if a vector is neither of the common size
+/// nor of size one
+template <typename Vector1, typename... Args>
+auto broadcast_eigen_shape(const std::string& name1, const Vector1& v1,
+                           Args... args) -> Eigen::Index {
+  static_assert(sizeof...(Args) % 2 == 0,
+                "an even number of parameters is expected");
+  auto size = broadcast_eigen_shape(args...);
+  if (v1.size() != size && v1.size() != 1 && size != 1) {
+    std::stringstream ss;
+    ss << "(" << size << ")";
+    throw std::invalid_argument(name1 +
+                                " could not be broadcast together with shape " +
+                                eigen_shape(v1) + ", " + ss.str());
+  }
+  return std::max(v1.size(), size);
+}
+
+/// @brief View over a vector whose size is either the broadcast size or one.
+///
+/// A size-1 vector behaves as if its single element were repeated over the
+/// whole range, without materializing the repeated values.
+///
+/// @tparam Vector type of the wrapped vector
+template <typename Vector>
+class BroadcastView {
+ public:
+  /// Build a view over the given vector.
+  ///
+  /// @param[in] vector vector to wrap. The caller keeps ownership and must
+  /// keep it alive for the lifetime of the view.
+  explicit BroadcastView(const Vector& vector)
+      : vector_(vector), scalar_(vector.size() == 1) {}
+
+  /// @brief Get the element at the given index.
+  ///
+  /// @param[in] index index of the element to read
+  /// @return the element at the given index, or the single element if the
+  /// wrapped vector is of size one.
+  inline auto operator()(const Eigen::Index index) const ->
+      typename Vector::Scalar {
+    return scalar_ ? vector_(0) : vector_(index);
+  }
+
+ private:
+  /// Wrapped vector.
+  const Vector& vector_;
+  /// True if the wrapped vector is of size one.
+  bool scalar_;
+};
+
 }  // namespace detail
 }  // namespace fes
@@ -39,6 +39,16 @@ class Grid {
     return data_[(this->*get_index_)(x, y)];
   }
 
+  /// Get the index in the underlying flat array of the element at the given
+  /// coordinates.
+  /// @param[in] x The x coordinate.
+  /// @param[in] y The y coordinate.
+  /// @return The index of the element.
+  constexpr auto index(const Eigen::Index x, const Eigen::Index y) const
+      noexcept -> Eigen::Index {
+    return (this->*get_index_)(x, y);
+  }
+
   /// Get the number of rows in the grid.
   /// @return The number of rows in the grid.
   constexpr auto nx() const noexcept -> size_t { return nx_; }
@@ -0,0 +1,69 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/detail/mapped_file.hpp
+/// @brief Read-only memory mapping of a file.
+#pragma once
+#include <string>
+
+#include "fes/string_view.hpp"
+
+namespace fes {
+namespace detail {
+
+/// @brief Read-only view of a file mapped in memory.
+///
+/// On POSIX systems the file is mapped with mmap: the pages are loaded
+/// lazily by the kernel and shared read-only between the processes mapping
+/// the same file, so parsing a serialized model does not materialize a
+/// second copy of the file in memory. On other systems the file is read
+/// into a private buffer.
+class MappedFile {
+ public:
+  /// Map a file in memory.
+  ///
+  /// @param[in] path The path of the file to map.
+  /// @throw std::invalid_argument if the file cannot be opened or mapped.
+  explicit MappedFile(const std::string& path);
+
+  /// Unmap the file.
+  ~MappedFile();
+
+  /// The mapping is not copyable.
+  MappedFile(const MappedFile&) = delete;
+  /// The mapping is not copyable.
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+  /// Move constructor.
+  MappedFile(MappedFile&& other) noexcept
+      : data_(other.data_), size_(other.size_), mapped_(other.mapped_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = false;
+  }
+
+  /// Move assignment operator.
+  auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+  /// Get a view of the mapped file.
+  ///
+  /// @return The view of the mapped file.
+  constexpr auto view() const noexcept -> string_view {
+    return {data_, size_};
+  }
+
+ private:
+  /// The mapped data.
+  const char* data_{nullptr};
+  /// The size of the mapped data.
+  std::size_t size_{0};
+  /// True if the data is a mapping, false if it is a private buffer.
+  bool mapped_{false};
+
+  /// Release the mapping or the private buffer.
+  auto release() noexcept -> void;
+};
+
+}  // namespace detail
+}  // namespace fes
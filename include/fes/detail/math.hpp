@@ -8,6 +8,7 @@
 #include <array>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <tuple>
@@ -171,6 +172,65 @@ constexpr auto sincosd(const T& x) noexcept -> std::tuple<T, T> {
   }
 }
 
+/// Evaluate simultaneously the sine and cosine of an angle in radians with a
+/// polynomial approximation.
+///
+/// The angle is reduced to \f$[-\pi/4, \pi/4]\f$ with a Cody-Waite three-part
+/// subtraction and the kernels are evaluated with the minimax polynomials of
+/// fdlibm, so the result is accurate to a few ulps of the reduced argument.
+/// One call replaces the two libm invocations and inlines into the caller's
+/// loop, where the compiler applies the SIMD instruction set selected at
+/// build time. To be used where the accuracy requirements of the products
+/// tolerate it (see Settings).
+///
+/// @tparam T The type of the result.
+/// @param[in] x Angle, in radians.
+/// @return a tuple that contains sin(x) and cos(x)
+template <typename T>
+inline auto fast_sincos(const T& x) noexcept -> std::tuple<T, T> {
+  // Cody-Waite split of π/2.
+  constexpr auto pio2_1 = T(1.57079632673412561417e+00);
+  constexpr auto pio2_2 = T(6.07710050650619224932e-11);
+  constexpr auto pio2_3 = T(2.02226624879595063154e-21);
+  constexpr auto two_over_pi = T(6.36619772367581382433e-01);
+
+  const auto k = std::nearbyint(x * two_over_pi);
+  const auto r = ((x - k * pio2_1) - k * pio2_2) - k * pio2_3;
+  const auto r2 = r * r;
+
+  // Minimax polynomials of fdlibm's __kernel_sin and __kernel_cos on
+  // [-π/4, π/4].
+  const auto s =
+      r + r * r2 *
+              (T(-1.66666666666666324348e-01) +
+               r2 * (T(8.33333333332248946124e-03) +
+                     r2 * (T(-1.98412698298579493134e-04) +
+                           r2 * (T(2.75573137070700676789e-06) +
+                                 r2 * (T(-2.50507602534068634195e-08) +
+                                       r2 * T(1.58969099521155010221e-10))))));
+  const auto c =
+      T(1) - T(0.5) * r2 +
+      r2 * r2 *
+          (T(4.16666666666666019037e-02) +
+           r2 * (T(-1.38888888888741095749e-03) +
+                 r2 * (T(2.48015872894767294178e-05) +
+                       r2 * (T(-2.75573143513906633035e-07) +
+                             r2 * (T(2.08757232129817482790e-09) +
+                                   r2 * T(-1.13596475577881948265e-11))))));
+
+  switch (static_cast<int64_t>(k) & 3) {
+    case 0:
+      return std::make_tuple(s, c);
+    case 1:
+      return std::make_tuple(c, -s);
+    case 2:
+      return std::make_tuple(-s, -c);
+    // case 3
+    default:
+      return std::make_tuple(-c, s);
+  }
+}
+
 /// True if a is almost zero to epsilon
 ///
 /// @tparam T Data type
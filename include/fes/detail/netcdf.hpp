@@ -0,0 +1,141 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/detail/netcdf.hpp
+/// @brief Reader for files in the netCDF classic format.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fes/detail/mapped_file.hpp"
+#include "fes/eigen.hpp"
+#include "fes/string_view.hpp"
+
+namespace fes {
+namespace detail {
+namespace netcdf {
+
+/// @brief Type of a netCDF variable or attribute.
+enum Type : int32_t {
+  kByte = 1,    //!< 8-bit signed integers
+  kChar = 2,    //!< Text
+  kShort = 3,   //!< 16-bit signed integers
+  kInt = 4,     //!< 32-bit signed integers
+  kFloat = 5,   //!< 32-bit floating-point values
+  kDouble = 6,  //!< 64-bit floating-point values
+};
+
+/// @brief Attribute of a netCDF variable or file.
+struct Attribute {
+  /// The name of the attribute.
+  std::string name{};
+  /// The type of the attribute.
+  Type type{kChar};
+  /// The value of a text attribute.
+  std::string text{};
+  /// The values of a numeric attribute, widened to double.
+  std::vector<double> values{};
+};
+
+/// @brief Dimension of a netCDF file.
+struct Dimension {
+  /// The name of the dimension.
+  std::string name{};
+  /// The size of the dimension; 0 for the record dimension.
+  std::int64_t size{0};
+};
+
+/// @brief Variable of a netCDF file.
+struct Variable {
+  /// The name of the variable.
+  std::string name{};
+  /// The type of the stored values.
+  Type type{kDouble};
+  /// The dimensions of the variable, as indices in File::dimensions().
+  std::vector<std::int32_t> dimensions{};
+  /// The attributes of the variable.
+  std::vector<Attribute> attributes{};
+  /// The number of stored values.
+  std::int64_t size{0};
+  /// The byte offset of the first stored value.
+  std::int64_t begin{0};
+
+  /// Find an attribute of the variable.
+  ///
+  /// @param[in] name The name of the attribute.
+  /// @return The attribute, or nullptr if the variable does not have it.
+  auto attribute(const string_view& name) const -> const Attribute*;
+};
+
+/// @brief File in the netCDF classic format, mapped in memory.
+///
+/// Handles the CDF-1 and CDF-2 variants of the classic format, which cover
+/// the distributed tidal atlases. Files in the netCDF-4 (HDF5) format are
+/// rejected with an error: the caller is expected to fall back to a library
+/// understanding them. Record variables are not handled either.
+class File {
+ public:
+  /// Map a file in memory and parse its header.
+  ///
+  /// @param[in] path The path of the file to read.
+  /// @throw std::invalid_argument if the file cannot be opened or is not in
+  /// the netCDF classic format.
+  explicit File(const std::string& path);
+
+  /// Get the dimensions of the file.
+  constexpr auto dimensions() const noexcept -> const std::vector<Dimension>& {
+    return dimensions_;
+  }
+
+  /// Get the global attributes of the file.
+  constexpr auto attributes() const noexcept -> const std::vector<Attribute>& {
+    return attributes_;
+  }
+
+  /// Get the variables of the file.
+  constexpr auto variables() const noexcept -> const std::vector<Variable>& {
+    return variables_;
+  }
+
+  /// True if the file holds the given variable.
+  ///
+  /// @param[in] name The name of the variable.
+  auto has_variable(const std::string& name) const -> bool;
+
+  /// Get a variable of the file.
+  ///
+  /// @param[in] name The name of the variable.
+  /// @return The variable.
+  /// @throw std::invalid_argument if the file does not hold the variable.
+  auto variable(const std::string& name) const -> const Variable&;
+
+  /// Read the values of a variable, widened to double.
+  ///
+  /// The scale_factor and add_offset attributes, if any, are applied and
+  /// the samples equal to the _FillValue (or missing_value) attribute are
+  /// replaced by NaN, mirroring what the netCDF libraries do.
+  ///
+  /// @param[in] variable The variable to read.
+  /// @return The values of the variable, in storage order.
+  /// @throw std::invalid_argument if the variable is a text variable or its
+  /// values lie outside the mapped file.
+  auto values(const Variable& variable) const -> Vector<double>;
+
+ private:
+  /// The mapped file.
+  MappedFile file_;
+  /// The index of the record dimension, or -1 if the file has none.
+  std::int32_t record_dimension_{-1};
+  /// The dimensions of the file.
+  std::vector<Dimension> dimensions_{};
+  /// The global attributes of the file.
+  std::vector<Attribute> attributes_{};
+  /// The variables of the file.
+  std::vector<Variable> variables_{};
+};
+
+}  // namespace netcdf
+}  // namespace detail
+}  // namespace fes
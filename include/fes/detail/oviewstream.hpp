@@ -0,0 +1,111 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/detail/oviewstream.hpp
+/// @brief Output streams over preallocated memory.
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+
+namespace fes {
+namespace detail {
+
+/// Buffer discarding the characters written to it, only keeping their count.
+/// Written to be used via ocountstream.
+class ocountbuf : public std::streambuf {
+ public:
+  /// Get the number of characters written.
+  constexpr auto count() const noexcept -> std::streamsize { return count_; }
+
+ protected:
+  /// @brief Discard a sequence of characters.
+  /// @param[in] s The characters to discard.
+  /// @param[in] n The number of characters to discard.
+  /// @return The number of characters discarded.
+  auto xsputn(const char* /*s*/, std::streamsize n)
+      -> std::streamsize override {
+    count_ += n;
+    return n;
+  }
+
+  /// @brief Discard one character.
+  /// @param[in] c The character to discard.
+  /// @return The character discarded.
+  auto overflow(int_type c) -> int_type override {
+    if (c != traits_type::eof()) {
+      ++count_;
+    }
+    return c;
+  }
+
+  /// @brief Report the write position, i.e. the number of characters
+  /// written. Only relative queries are supported.
+  auto seekoff(off_type off, std::ios_base::seekdir dir,
+               std::ios_base::openmode /*which*/) -> pos_type override {
+    if (dir != std::ios_base::cur || off != 0) {
+      return {off_type(-1)};
+    }
+    return {static_cast<off_type>(count_)};
+  }
+
+ private:
+  /// The number of characters written.
+  std::streamsize count_{0};
+};
+
+/// A std::ostream discarding its output, only keeping the number of
+/// characters written. Used to measure the size of a serialized state
+/// before writing it to a preallocated buffer.
+class ocountstream : private virtual ocountbuf, public std::ostream {
+ public:
+  /// Construct a counting stream.
+  ocountstream() : std::ostream(static_cast<std::streambuf*>(this)) {}
+
+  /// Get the number of characters written.
+  constexpr auto count() const noexcept -> std::streamsize {
+    return ocountbuf::count();
+  }
+};
+
+/// Buffer writing the characters to a preallocated memory area. Written to
+/// be used via oviewstream.
+///
+/// @warning oviewbuf does not own memory. If the lifetime of the area ends
+/// before this buffer, writing to it invokes undefined behavior. Writing
+/// past the end of the area sets the stream in error.
+class oviewbuf : public std::streambuf {
+ public:
+  /// @brief Construct a buffer over a preallocated memory area.
+  /// @param[in] s The first character of the area.
+  /// @param[in] count The size of the area.
+  oviewbuf(char* s, std::size_t count) { this->setp(s, s + count); }
+
+ protected:
+  /// @brief Report the write position. Only relative queries are supported.
+  auto seekoff(off_type off, std::ios_base::seekdir dir,
+               std::ios_base::openmode /*which*/) -> pos_type override {
+    if (dir != std::ios_base::cur || off != 0) {
+      return {off_type(-1)};
+    }
+    return {static_cast<off_type>(pptr() - pbase())};
+  }
+};
+
+/// A std::ostream writing to a preallocated memory area, typically a mapped
+/// file or a shared-memory segment.
+///
+/// @warning oviewstream does not own memory. If the lifetime of the area
+/// ends before this stream, writing to it invokes undefined behavior.
+class oviewstream : private virtual oviewbuf, public std::ostream {
+ public:
+  /// @brief Construct a stream over a preallocated memory area.
+  /// @param[in] s The first character of the area.
+  /// @param[in] count The size of the area.
+  oviewstream(char* s, std::size_t count)
+      : oviewbuf(s, count), std::ostream(static_cast<std::streambuf*>(this)) {}
+};
+
+}  // namespace detail
+}  // namespace fes
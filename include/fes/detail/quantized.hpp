@@ -0,0 +1,103 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/detail/quantized.hpp
+/// @brief Quantized storage of tidal constituent values.
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+
+#include "fes/data_vector.hpp"
+#include "fes/eigen.hpp"
+
+namespace fes {
+namespace detail {
+
+/// Sentinel stored in the real part to encode an undefined sample. It lies
+/// outside the range produced by the quantization, which is symmetric around
+/// zero.
+constexpr int16_t kQuantizedUndefined = std::numeric_limits<int16_t>::min();
+
+/// Largest magnitude representable by the quantization.
+constexpr double kQuantizedMax = std::numeric_limits<int16_t>::max();
+
+/// @brief Tidal constituent values quantized to 16-bit integers.
+///
+/// The real and imaginary parts are stored as int16 samples scaled by a
+/// common factor chosen so that the largest magnitude of the vector maps to
+/// the largest representable value. Undefined samples are encoded with a
+/// sentinel. The quantization is lossy: the error per component is bounded
+/// by half the scale factor.
+struct QuantizedVector {
+  /// Quantized real parts.
+  Vector<int16_t> real{};
+  /// Quantized imaginary parts.
+  Vector<int16_t> imag{};
+  /// Factor converting a quantized sample to its physical value.
+  double scale{1};
+
+  /// Quantize a vector of complex values.
+  ///
+  /// @param[in] wave The values to quantize.
+  /// @return The quantized values.
+  template <typename T>
+  static auto encode(const DataVector<std::complex<T>>& wave)
+      -> QuantizedVector {
+    auto result = QuantizedVector();
+    result.real.resize(wave.size());
+    result.imag.resize(wave.size());
+    auto max_abs = double{0};
+    for (Eigen::Index ix = 0; ix < wave.size(); ++ix) {
+      const auto re = static_cast<double>(wave(ix).real());
+      const auto im = static_cast<double>(wave(ix).imag());
+      if (std::isnan(re) || std::isnan(im)) {
+        continue;
+      }
+      max_abs = std::max({max_abs, std::abs(re), std::abs(im)});
+    }
+    result.scale = max_abs != 0 ? max_abs / kQuantizedMax : 1;
+    for (Eigen::Index ix = 0; ix < wave.size(); ++ix) {
+      const auto re = static_cast<double>(wave(ix).real());
+      const auto im = static_cast<double>(wave(ix).imag());
+      if (std::isnan(re) || std::isnan(im)) {
+        result.real(ix) = kQuantizedUndefined;
+        result.imag(ix) = 0;
+        continue;
+      }
+      result.real(ix) = static_cast<int16_t>(std::llround(re / result.scale));
+      result.imag(ix) = static_cast<int16_t>(std::llround(im / result.scale));
+    }
+    return result;
+  }
+
+  /// Widen one quantized sample to its physical value.
+  ///
+  /// @param[in] ix The index of the sample.
+  /// @return The physical value, NaN if the sample is undefined.
+  inline auto dequantize(const Eigen::Index ix) const -> std::complex<double> {
+    if (real(ix) == kQuantizedUndefined) {
+      return {std::numeric_limits<double>::quiet_NaN(),
+              std::numeric_limits<double>::quiet_NaN()};
+    }
+    return {real(ix) * scale, imag(ix) * scale};
+  }
+
+  /// Widen all the quantized samples to their physical values.
+  ///
+  /// @return The physical values.
+  template <typename T>
+  auto decode() const -> Vector<std::complex<T>> {
+    auto result = Vector<std::complex<T>>(real.size());
+    for (Eigen::Index ix = 0; ix < real.size(); ++ix) {
+      result(ix) = static_cast<std::complex<T>>(dequantize(ix));
+    }
+    return result;
+  }
+};
+
+}  // namespace detail
+}  // namespace fes
@@ -6,39 +6,47 @@
 /// @brief Serialization utilities.
 #pragma once
 #include <Eigen/Core>
+#include <algorithm>
+#include <cstddef>
+#include <istream>
 #include <map>
+#include <memory>
+#include <ostream>
 #include <sstream>
+#include <string>
+#include <vector>
 
+#include "fes/constituent_map.hpp"
 #include "fes/detail/isviewstream.hpp"
 
 namespace fes {
 namespace detail {
 namespace serialize {
 
-/// @brief Write data to a stringstream
+/// @brief Write data to a stream
 /// @tparam T The type of the data to write
-/// @param[in] ss The stringstream to write to
+/// @param[in] ss The stream to write to
 /// @param[in] data The data to write
 template <typename T>
-auto write_data(std::stringstream& ss, const T& data) -> void {
+auto write_data(std::ostream& ss, const T& data) -> void {
   ss.write(reinterpret_cast<const char*>(&data), sizeof(data));
 }
 
-/// @brief Read data from a stringstream
+/// @brief Read data from a stream
 /// @tparam T The type of the data to read
-/// @param[in] ss The stringstream to read from
+/// @param[in] ss The stream to read from
 /// @return The data read
 template <typename T>
-auto read_data(detail::isviewstream& ss) -> T {
+auto read_data(std::istream& ss) -> T {
   auto data = T{};
   ss.read(reinterpret_cast<char*>(&data), sizeof(data));
   return data;
 }
 
-/// @brief Write a string to a stringstream
-/// @param[in] ss The stringstream to write to
+/// @brief Write a string to a stream
+/// @param[in] ss The stream to write to
 /// @param[in] data The string to write
-inline auto write_string(std::stringstream& ss, const std::string& data)
+inline auto write_string(std::ostream& ss, const std::string& data)
     -> void {
   auto size = data.size();
   write_data(ss, size);
@@ -47,19 +55,28 @@ inline auto write_string(std::stringstream& ss, const std::string& data)
 
 /// @brief Read a string from a stringstream
 /// @param[in] ss The stringstream to read from
-/// @return The string read
+/// @return A view over the string read, borrowed from the stream buffer
 inline auto read_string(detail::isviewstream& ss) -> fes::string_view {
   return ss.readview(read_data<size_t>(ss));
 }
 
+/// @brief Read a string from a stream
+/// @param[in] ss The stream to read from
+/// @return The string read
+inline auto read_string(std::istream& ss) -> std::string {
+  auto result = std::string(read_data<size_t>(ss), '\0');
+  ss.read(&result[0], static_cast<std::streamsize>(result.size()));
+  return result;
+}
+
 /// @brief Write an Eigen matrix to a stringstream
 /// @tparam T The type of the matrix
 /// @tparam ROWS The number of rows in the matrix
 /// @tparam COLS The number of columns in the matrix
-/// @param[in] ss The stringstream to write to
+/// @param[in] ss The stream to write to
 /// @param[in] data The matrix to write
 template <typename T, int ROWS, int COLS>
-auto write_matrix(std::stringstream& ss,
+auto write_matrix(std::ostream& ss,
                   const Eigen::Matrix<T, ROWS, COLS>& data) -> void {
   write_data(ss, data.rows());
   write_data(ss, data.cols());
@@ -70,10 +87,10 @@ auto write_matrix(std::stringstream& ss,
 /// @tparam T The type of the matrix
 /// @tparam ROWS The number of rows in the matrix
 /// @tparam COLS The number of columns in the matrix
-/// @param[in] ss The stringstream to read from
+/// @param[in] ss The stream to read from
 /// @return The matrix read
 template <typename T, int ROWS, int COLS>
-auto read_matrix(detail::isviewstream& ss) -> Eigen::Matrix<T, ROWS, COLS> {
+auto read_matrix(std::istream& ss) -> Eigen::Matrix<T, ROWS, COLS> {
   auto rows = read_data<Eigen::Index>(ss);
   auto cols = read_data<Eigen::Index>(ss);
   auto data = Eigen::Matrix<T, ROWS, COLS>(rows, cols);
@@ -81,40 +98,198 @@ auto read_matrix(detail::isviewstream& ss) -> Eigen::Matrix<T, ROWS, COLS> {
   return data;
 }
 
+/// @brief Pad a stream up to the next aligned offset.
+///
+/// The padding is measured from the beginning of the stream: a reader
+/// mapping the stream in memory at an aligned address can view the bytes
+/// following the padding in place.
+///
+/// @param[in] ss The stream to pad.
+/// @param[in] alignment The alignment, in bytes, of the next write.
+inline auto write_padding(std::ostream& ss, const std::size_t alignment)
+    -> void {
+  static constexpr char zeros[alignof(std::max_align_t)] = {};
+  const auto pos = static_cast<std::size_t>(ss.tellp());
+  ss.write(zeros,
+           static_cast<std::streamsize>((alignment - pos % alignment) %
+                                        alignment));
+}
+
+/// @brief Skip the padding written by write_padding().
+///
+/// @param[in] ss The stream to read from.
+/// @param[in] alignment The alignment, in bytes, of the next read.
+inline auto skip_padding(std::istream& ss, const std::size_t alignment)
+    -> void {
+  const auto pos = static_cast<std::size_t>(ss.tellg());
+  ss.ignore(
+      static_cast<std::streamsize>((alignment - pos % alignment) % alignment));
+}
+
+/// @brief Write a vector of samples to a stream.
+///
+/// The layout is the one of write_matrix() with a single column, except that
+/// the sample bytes are aligned on the scalar alignment: a reader mapping
+/// the stream in memory can view the samples in place.
+///
+/// @tparam V The type of the vector; anything exposing Scalar, size() and
+/// data().
+/// @param[in] ss The stream to write to.
+/// @param[in] data The vector to write.
+template <typename V>
+auto write_vector(std::ostream& ss, const V& data) -> void {
+  using scalar_t = typename V::Scalar;
+  write_data(ss, static_cast<Eigen::Index>(data.size()));
+  write_data(ss, static_cast<Eigen::Index>(1));
+  write_padding(ss, alignof(scalar_t));
+  ss.write(reinterpret_cast<const char*>(data.data()),
+           data.size() * static_cast<Eigen::Index>(sizeof(scalar_t)));
+}
+
+/// @brief Read a vector written with write_vector().
+///
+/// @tparam T The type of the samples.
+/// @param[in] ss The stream to read from.
+/// @return The vector read.
+template <typename T>
+auto read_vector(std::istream& ss) -> Eigen::Matrix<T, Eigen::Dynamic, 1> {
+  auto rows = read_data<Eigen::Index>(ss);
+  read_data<Eigen::Index>(ss);
+  skip_padding(ss, alignof(T));
+  auto data = Eigen::Matrix<T, Eigen::Dynamic, 1>(rows);
+  ss.read(reinterpret_cast<char*>(data.data()), data.size() * sizeof(T));
+  return data;
+}
+
 /// @brief Write the map of constituents to a stringstream
-/// @tparam T The type of the constituents
-/// @tparam U The type of the data
-/// @param[in] ss The stringstream to write to
+/// @tparam Map The type of the constituent container
+/// @param[in] ss The stream to write to
 /// @param[in] data The map of constituents to write
-template <typename T, typename U>
-auto write_constituent_map(
-    std::stringstream& ss,
-    const std::map<T, Eigen::Matrix<U, Eigen::Dynamic, 1>>& data) -> void {
+template <typename Map>
+auto write_constituent_map(std::ostream& ss, const Map& data) -> void {
   write_data(ss, data.size());
   for (const auto& item : data) {
     write_data(ss, item.first);
-    write_matrix<U, Eigen::Dynamic, 1>(ss, item.second);
+    write_vector(ss, item.second);
   }
 }
 
+/// @brief Check whether a constituent is selected by a subset filter.
+/// @param[in] wanted The identifiers of the selected constituents; an empty
+/// list selects every constituent.
+/// @param[in] constituent The constituent to check.
+/// @return True if the constituent is selected.
+inline auto is_wanted(const std::vector<Constituent>& wanted,
+                      const Constituent constituent) -> bool {
+  return wanted.empty() ||
+         std::find(wanted.begin(), wanted.end(), constituent) != wanted.end();
+}
+
 /// @brief Read the map of constituents from a stringstream
-/// @tparam T The type of the constituents
-/// @tparam U The type of the data
-/// @param[in] ss The stringstream to read from
+/// @tparam Map The type of the constituent container
+/// @param[in] ss The stream to read from
+/// @param[in] wanted The identifiers of the constituents to read; an empty
+/// list reads every constituent. The samples of the other constituents are
+/// skipped without being read.
 /// @return The map of constituents read
-template <typename T, typename U>
-auto read_constituent_map(detail::isviewstream& ss)
-    -> std::map<T, Eigen::Matrix<U, Eigen::Dynamic, 1>> {
+template <typename Map>
+auto read_constituent_map(std::istream& ss,
+                          const std::vector<Constituent>& wanted = {}) -> Map {
+  using key_t = typename Map::key_type;
+  using scalar_t = typename Map::mapped_type::Scalar;
   auto size = read_data<Eigen::Index>(ss);
-  auto data = std::map<T, Eigen::Matrix<U, Eigen::Dynamic, 1>>{};
+  auto data = Map{};
   for (auto ix = 0; ix < size; ++ix) {
-    auto constituent = read_data<T>(ss);
-    auto map = read_matrix<U, Eigen::Dynamic, 1>(ss);
+    auto constituent = read_data<key_t>(ss);
+    if (!is_wanted(wanted, constituent)) {
+      const auto rows = read_data<Eigen::Index>(ss);
+      read_data<Eigen::Index>(ss);
+      skip_padding(ss, alignof(scalar_t));
+      ss.ignore(rows * static_cast<Eigen::Index>(sizeof(scalar_t)));
+      continue;
+    }
+    auto map = read_vector<scalar_t>(ss);
     data.emplace(constituent, map);
   }
   return data;
 }
 
+/// @brief View the entries of a constituent map in place.
+///
+/// The mapped values are built as views over the stream buffer: no sample is
+/// copied. The stream is advanced past the map, as if it had been read with
+/// read_constituent_map().
+///
+/// @tparam Map The type of the constituent container; the mapped type is
+/// constructible from a pointer, a size and a keep-alive handle.
+/// @param[in] ss The stream to read from.
+/// @param[in] keep_alive Handle keeping the stream buffer alive as long as
+/// the views exist.
+/// @param[in] wanted The identifiers of the constituents to view; an empty
+/// list views every constituent.
+/// @return The map of constituents viewed.
+template <typename Map>
+auto view_constituent_map(detail::isviewstream& ss,
+                          const std::shared_ptr<const void>& keep_alive,
+                          const std::vector<Constituent>& wanted = {}) -> Map {
+  using key_t = typename Map::key_type;
+  using scalar_t = typename Map::mapped_type::Scalar;
+  auto size = read_data<Eigen::Index>(ss);
+  auto data = Map{};
+  for (auto ix = 0; ix < size; ++ix) {
+    auto constituent = read_data<key_t>(ss);
+    const auto rows = read_data<Eigen::Index>(ss);
+    read_data<Eigen::Index>(ss);
+    skip_padding(ss, alignof(scalar_t));
+    const auto bytes =
+        ss.readview(rows * static_cast<Eigen::Index>(sizeof(scalar_t)));
+    if (!is_wanted(wanted, constituent)) {
+      continue;
+    }
+    data.emplace(constituent,
+                 typename Map::mapped_type(
+                     reinterpret_cast<const scalar_t*>(bytes.data()), rows,
+                     keep_alive));
+  }
+  return data;
+}
+
+/// @brief Locate the entries of a constituent map in a stream without reading
+/// the samples.
+///
+/// The stream is advanced past the map, as if it had been read with
+/// read_constituent_map().
+///
+/// @tparam Map The type of the constituent container
+/// @param[in] ss The stream to read from
+/// @param[in] wanted The identifiers of the constituents to locate; an empty
+/// list locates every constituent.
+/// @return The byte offset of each matrix record, relative to the beginning
+/// of the stream.
+template <typename Map>
+auto scan_constituent_map(std::istream& ss,
+                          const std::vector<Constituent>& wanted = {})
+    -> ConstituentMap<std::size_t> {
+  using key_t = typename Map::key_type;
+  using scalar_t = typename Map::mapped_type::Scalar;
+  auto size = read_data<Eigen::Index>(ss);
+  auto result = ConstituentMap<std::size_t>();
+  for (auto ix = 0; ix < size; ++ix) {
+    auto constituent = read_data<key_t>(ss);
+    const auto offset = static_cast<std::size_t>(ss.tellg());
+    const auto rows = read_data<Eigen::Index>(ss);
+    const auto cols = read_data<Eigen::Index>(ss);
+    skip_padding(ss, alignof(scalar_t));
+    ss.seekg(static_cast<std::streamoff>(ss.tellg()) +
+             static_cast<std::streamoff>(rows * cols) *
+                 static_cast<std::streamoff>(sizeof(scalar_t)));
+    if (is_wanted(wanted, constituent)) {
+      result.emplace(constituent, offset);
+    }
+  }
+  return result;
+}
+
 }  // namespace serialize
 }  // namespace detail
 }  // namespace fes
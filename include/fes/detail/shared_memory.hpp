@@ -0,0 +1,88 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/detail/shared_memory.hpp
+/// @brief Named shared-memory segment.
+#pragma once
+#include <cstddef>
+#include <string>
+
+#include "fes/string_view.hpp"
+
+namespace fes {
+namespace detail {
+
+/// @brief Named shared-memory segment mapped in the process.
+///
+/// On POSIX systems the segment is backed by shm_open: its pages are shared
+/// between all the processes mapping the same name, and the segment persists
+/// after the creating process exits, until it is unlinked. On other systems
+/// shared memory is not supported and the constructors throw.
+class SharedMemory {
+ public:
+  /// Create a segment, or replace an existing one, and map it read-write.
+  ///
+  /// @param[in] name The name of the segment; must start with a slash.
+  /// @param[in] size The size of the segment, in bytes.
+  /// @throw std::invalid_argument if the segment cannot be created or
+  /// mapped.
+  SharedMemory(const std::string& name, std::size_t size);
+
+  /// Attach an existing segment read-only.
+  ///
+  /// @param[in] name The name of the segment; must start with a slash.
+  /// @throw std::invalid_argument if the segment cannot be opened or mapped.
+  explicit SharedMemory(const std::string& name);
+
+  /// Unmap the segment. The segment itself persists until it is unlinked.
+  ~SharedMemory();
+
+  /// The mapping is not copyable.
+  SharedMemory(const SharedMemory&) = delete;
+  /// The mapping is not copyable.
+  auto operator=(const SharedMemory&) -> SharedMemory& = delete;
+
+  /// Move constructor.
+  SharedMemory(SharedMemory&& other) noexcept
+      : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  /// Move assignment operator.
+  auto operator=(SharedMemory&& other) noexcept -> SharedMemory&;
+
+  /// Remove a segment. The mappings held by the attached processes remain
+  /// valid; the name becomes available again. Removing a segment that does
+  /// not exist is a no-op.
+  ///
+  /// @param[in] name The name of the segment; must start with a slash.
+  static auto unlink(const std::string& name) -> void;
+
+  /// Get a read-only view of the segment.
+  ///
+  /// @return The view of the segment.
+  constexpr auto view() const noexcept -> string_view {
+    return {data_, size_};
+  }
+
+  /// Get a writable pointer to the segment. Only valid for a segment mapped
+  /// with the creating constructor.
+  constexpr auto data() const noexcept -> char* { return data_; }
+
+  /// Get the size of the segment, in bytes.
+  constexpr auto size() const noexcept -> std::size_t { return size_; }
+
+ private:
+  /// The mapped segment.
+  char* data_{nullptr};
+  /// The size of the mapped segment.
+  std::size_t size_{0};
+
+  /// Unmap the segment.
+  auto release() noexcept -> void;
+};
+
+}  // namespace detail
+}  // namespace fes
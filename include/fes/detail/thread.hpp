@@ -5,68 +5,227 @@
 /// @file include/fes/detail/thread.hpp
 /// @brief Parallelization
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "fes/detail/thread_pool.hpp"
+#include "fes/detail/trace.hpp"
+#include "fes/perf_counters.hpp"
+
 namespace fes {
+
+/// @brief Chunk size selecting the adaptive scheduler of
+/// detail::parallel_for.
+///
+/// The best chunk granularity depends on the workload: large chunks suit
+/// uniform open-ocean queries, small chunks suit coastal mixes where the
+/// cost per index is uneven. The adaptive scheduler measures the completion
+/// time of each chunk and steers the chunk size toward a fixed time quantum,
+/// so neither case has to be tuned by hand. The granularity it converges to
+/// is reported through fes::perf_counters() and can be pinned as a regular
+/// chunk size in a production configuration.
+constexpr size_t kAdaptiveChunkSize = static_cast<size_t>(-1);
+
 namespace detail {
 
+/// Wall-clock time one chunk of the adaptive scheduler should take. Large
+/// enough to amortize the per-chunk rebuild of the worker state, small
+/// enough to leave every thread several chunks before the join.
+constexpr double kAdaptiveChunkQuantum = 5e-3;
+
+/// Smallest chunk the adaptive scheduler claims: below this, the per-chunk
+/// setup cost dominates whatever balance smaller chunks would buy.
+constexpr size_t kAdaptiveMinChunkSize = 64;
+
 /// Automates the cutting of vectors to be processed in thread.
 ///
+/// The chunks are executed by the process-wide ThreadPool instead of freshly
+/// spawned threads, so repeated calls on small batches do not pay the thread
+/// creation cost. The calling thread executes one of the chunks itself while
+/// the pool processes the others.
+///
+/// By default the index range is split into one equal chunk per thread. When
+/// the cost per index is uneven (for example positions over land paying a
+/// full mesh search while open-ocean positions hit the accelerator cache),
+/// the static split leaves threads idle at the join; passing a non-zero
+/// chunk size switches to dynamic scheduling, where the workers claim
+/// fixed-size chunks from an atomic counter until the range is exhausted, so
+/// straggler chunks are redistributed over the remaining threads.
+///
 /// @tparam Lambda Lambda function
 /// @param[in] callable Lambda function called in each thread launched
 /// @param[in] size Size of all vectors to be processed
 /// @param[in] num_threads The number of threads to use for the computation. If
 /// 0 all CPUs are used. If 1 is given, no parallel computing code is used at
 /// all, which is useful for debugging.
+/// @param[in] chunk_size Number of indexes claimed at once by a worker. If 0,
+/// the range is split into one static chunk per thread. If
+/// fes::kAdaptiveChunkSize, the workers start with a moderate chunk, time
+/// each chunk they complete and steer the granularity toward
+/// kAdaptiveChunkQuantum; the granularity the run converged to is reported
+/// through fes::perf_counters().
+/// @param[in] pin_threads If true, the pool workers are pinned to one CPU
+/// each before the chunks are submitted. See ThreadPool::pin_workers().
+/// @note With dynamic scheduling the callable is invoked once per claimed
+/// chunk, so any state it builds is rebuilt per chunk: the chunk size should
+/// be large enough to amortize this setup cost.
+/// @note Calls compose: a thread waiting for its chunks executes queued
+/// tasks instead of blocking, so nested parallel sections and concurrent
+/// top-level calls share the same pool and num_threads acts as a concurrency
+/// limit, not a hard thread count.
 template <typename Lambda>
 void parallel_for(const Lambda& callable, const size_t size,
-                  size_t num_threads) {
+                  size_t num_threads, const size_t chunk_size = 0,
+                  const bool pin_threads = false) {
   // If num_threads is 0, use all CPUs
   if (num_threads == 0) {
-    num_threads = std::thread::hardware_concurrency();
+    num_threads = ThreadPool::instance().size();
   }
 
   // Adjust num_threads to not exceed the size
   num_threads = std::min(num_threads, static_cast<size_t>(size));
 
   // If num_threads is 1, no parallel computing code is used
-  if (num_threads == 1) {
-    callable(0, size);
+  if (num_threads <= 1) {
+    if (size != 0) {
+      trace::Scope span("parallel_for.worker");
+      callable(0, size);
+    }
     return;
   }
 
-  // List of threads responsible for parallelizing the calculation
-  std::vector<std::thread> threads;
-  std::exception_ptr exception = nullptr;
+  auto& pool = ThreadPool::instance();
+  if (pin_threads) {
+    pool.pin_workers();
+  }
 
-  // Access index to the vectors required for calculation
-  size_t start = 0;
-  size_t shift = size / num_threads;
+  // Completion state shared with the submitted chunks. Capturing it by
+  // reference is safe: parallel_for waits for all the chunks it submitted
+  // before returning.
+  std::mutex mutex;
+  std::condition_variable done;
+  size_t remaining = num_threads - 1;
+  std::exception_ptr exception = nullptr;
+  std::atomic<size_t> next(0);
 
-  threads.reserve(num_threads);
+  // Granularity shared by the adaptive scheduler. Each worker claims the
+  // current value, times its chunk and publishes an adjusted value without
+  // synchronization: the last writer wins, which is enough to steer the
+  // granularity.
+  const auto adaptive = chunk_size == kAdaptiveChunkSize;
+  const auto max_chunk =
+      std::max(size / num_threads, kAdaptiveMinChunkSize);
+  std::atomic<size_t> adaptive_chunk(std::min(
+      std::max(size / (num_threads * 8), kAdaptiveMinChunkSize), max_chunk));
+  std::atomic<uint64_t> adaptive_chunks(0);
 
-  // Launch threads
-  for (size_t ix = 0; ix < num_threads; ++ix) {
-    size_t end = (ix == num_threads - 1) ? size : start + shift;
-    threads.emplace_back([&callable, start, end, &exception]() {
-      try {
+  // Work assigned to one thread: either its static range, or a scheduling
+  // loop claiming chunks until the range is exhausted.
+  auto work = [&callable, &next, &mutex, &exception, &adaptive_chunk,
+               &adaptive_chunks, adaptive, max_chunk, size,
+               chunk_size](const size_t start, const size_t end) {
+    // One span per thread: with dynamic scheduling it covers the whole
+    // claim loop of the thread, not the individual chunks.
+    trace::Scope span("parallel_for.worker");
+    try {
+      if (adaptive) {
+        while (true) {
+          const auto claim = adaptive_chunk.load(std::memory_order_relaxed);
+          const auto chunk_start = next.fetch_add(claim);
+          if (chunk_start >= size) {
+            break;
+          }
+          const auto chunk_end = std::min(chunk_start + claim, size);
+          const auto begin = std::chrono::steady_clock::now();
+          callable(chunk_start, chunk_end);
+          const auto elapsed = std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - begin)
+                                   .count();
+          adaptive_chunks.fetch_add(1, std::memory_order_relaxed);
+          if (elapsed <= 0.0) {
+            continue;
+          }
+          // Steer the granularity toward the target quantum, one octave at
+          // a time: the timing of a single chunk is noisy.
+          auto ideal = static_cast<double>(chunk_end - chunk_start) *
+                       (kAdaptiveChunkQuantum / elapsed);
+          ideal = std::min(ideal, static_cast<double>(claim) * 2.0);
+          ideal = std::max(ideal, static_cast<double>(claim) * 0.5);
+          adaptive_chunk.store(
+              std::min(max_chunk, std::max(kAdaptiveMinChunkSize,
+                                           static_cast<size_t>(ideal))),
+              std::memory_order_relaxed);
+        }
+      } else if (chunk_size != 0) {
+        while (true) {
+          const auto chunk_start = next.fetch_add(chunk_size);
+          if (chunk_start >= size) {
+            break;
+          }
+          callable(chunk_start, std::min(chunk_start + chunk_size, size));
+        }
+      } else {
         callable(start, end);
-      } catch (...) {
-        exception = std::current_exception();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      exception = std::current_exception();
+    }
+  };
+
+  // Submit all chunks but the last one to the pool.
+  const size_t shift = size / num_threads;
+  for (size_t ix = 0; ix < num_threads - 1; ++ix) {
+    pool.submit([&work, &mutex, &done, &remaining, ix, shift]() {
+      work(ix * shift, (ix + 1) * shift);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--remaining == 0) {
+        done.notify_one();
       }
     });
-    start += shift;
   }
 
-  // Join threads
-  for (auto&& thread : threads) {
-    if (thread.joinable()) {
-      thread.join();
+  // The calling thread handles the last chunk itself.
+  work((num_threads - 1) * shift, size);
+
+  // While our chunks are pending, execute queued tasks instead of blocking:
+  // a thread never parks while the queue is non-empty, so a nested parallel
+  // section can submit its own chunks and wait for them without deadlock,
+  // and concurrent calls share the pool instead of oversubscribing the
+  // machine.
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (remaining == 0) {
+        break;
+      }
+    }
+    if (!pool.try_run_one()) {
+      // The queue is empty: the remaining chunks are executing on other
+      // threads, parking until they complete is safe.
+      std::unique_lock<std::mutex> lock(mutex);
+      done.wait(lock, [&remaining]() { return remaining == 0; });
+      break;
     }
   }
 
+  // Publish the parameters the adaptive scheduler settled on, so they can
+  // be read back and pinned as a regular chunk size.
+  if (adaptive) {
+    auto counters = PerfCounters();
+    counters.adaptive_chunks = adaptive_chunks.load();
+    counters.adaptive_chunk_size =
+        static_cast<uint64_t>(adaptive_chunk.load());
+    flush_perf_counters(counters);
+  }
+
   // Rethrow the last exception caught
   if (exception) {
     std::rethrow_exception(exception);
@@ -0,0 +1,184 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/detail/thread_pool.hpp
+/// @brief Persistent pool of worker threads.
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace fes {
+namespace detail {
+
+/// @brief Persistent pool of worker threads.
+///
+/// Spawning and joining fresh std::thread instances at every parallel call is
+/// cheap for large batches but dominates the runtime when the prediction is
+/// invoked many times on small ones. The pool keeps its workers alive for the
+/// whole process lifetime: while no task is pending they are parked on a
+/// condition variable, and parallel_for submits its chunks to the pool
+/// instead of creating threads.
+///
+/// The pool composes: a thread waiting for its chunks executes queued tasks
+/// through try_run_one() instead of blocking, so nested parallel sections and
+/// concurrent top-level calls all share the same workers and the machine is
+/// never oversubscribed beyond the pool size.
+class ThreadPool {
+ public:
+  /// Build a pool.
+  ///
+  /// @param[in] num_threads Number of worker threads. If 0, one worker per
+  /// available CPU is created.
+  explicit ThreadPool(size_t num_threads = 0) {
+    if (num_threads == 0) {
+      num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(num_threads);
+    for (size_t ix = 0; ix < num_threads; ++ix) {
+      workers_.emplace_back([this]() { run(); });
+    }
+  }
+
+  /// Wake the workers up and join them.
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    pending_.notify_all();
+    for (auto&& worker : workers_) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+  auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+  /// Get the number of worker threads.
+  auto size() const noexcept -> size_t { return workers_.size(); }
+
+  /// Enqueue a task for execution by one of the workers.
+  ///
+  /// @param[in] task Task to execute.
+  auto submit(std::function<void()> task) -> void {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace_back(std::move(task));
+    }
+    pending_.notify_one();
+  }
+
+  /// Execute one queued task on the calling thread, if any is pending.
+  ///
+  /// Threads waiting for the completion of submitted tasks call this in a
+  /// loop instead of blocking: as long as a waiter never parks while the
+  /// queue is non-empty, a parallel section reached from a pool worker can
+  /// safely submit its own chunks and wait for them, because the chunks it
+  /// depends on are either queued (and will be picked up here) or already
+  /// executing on another thread.
+  ///
+  /// @return True if a task was executed, false if the queue was empty.
+  auto try_run_one() -> bool {
+    std::function<void()> task;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (tasks_.empty()) {
+        return false;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+    return true;
+  }
+
+  /// Pin each worker to one CPU, round-robin over the available CPUs.
+  ///
+  /// By default the scheduler is free to migrate the workers across cores
+  /// and, on multi-socket machines, across NUMA nodes; a worker migrated to
+  /// the remote socket then pays remote-memory stalls for every access to
+  /// the constituent grids. Pinning keeps each worker on its core so the
+  /// static partition of parallel_for keeps touching the same caches and
+  /// NUMA node from one call to the next.
+  ///
+  /// The call is idempotent and cannot be undone: pinning is a process-wide
+  /// decision, like the pool itself. On platforms without thread affinity
+  /// support this is a no-op.
+  auto pin_workers() -> void {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pinned_) {
+      return;
+    }
+    pinned_ = true;
+#if defined(__linux__)
+    const auto num_cpus =
+        static_cast<size_t>(std::max(1U, std::thread::hardware_concurrency()));
+    for (size_t ix = 0; ix < workers_.size(); ++ix) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(ix % num_cpus, &cpu_set);
+      pthread_setaffinity_np(workers_[ix].native_handle(), sizeof(cpu_set_t),
+                             &cpu_set);
+    }
+#endif
+  }
+
+  /// Get the process-wide pool shared by the parallel code paths.
+  ///
+  /// The pool is created on first use and lives until the process exits.
+  static auto instance() -> ThreadPool& {
+    static ThreadPool pool;
+    return pool;
+  }
+
+ private:
+  /// Worker threads.
+  std::vector<std::thread> workers_;
+  /// Tasks waiting for a worker.
+  std::deque<std::function<void()>> tasks_;
+  /// Protects the task queue and the shutdown flag.
+  std::mutex mutex_;
+  /// Signaled when a task is submitted or the pool is destroyed.
+  std::condition_variable pending_;
+  /// True when the pool is being destroyed.
+  bool shutdown_{false};
+  /// True once the workers have been pinned to their CPU.
+  bool pinned_{false};
+
+  /// Worker loop: execute the pending tasks, park while there is none.
+  auto run() -> void {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pending_.wait(lock, [this]() { return shutdown_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+};
+
+}  // namespace detail
+}  // namespace fes
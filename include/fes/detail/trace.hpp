@@ -0,0 +1,116 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/detail/trace.hpp
+/// @brief Scoped instrumentation emitting chrome://tracing spans.
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fes {
+namespace detail {
+namespace trace {
+
+/// One completed span, the "complete event" of the chrome://tracing format.
+struct Event {
+  /// Name of the span. Points to a string literal and is not owned.
+  const char* name;
+  /// Start of the span in microseconds since the recorder was created.
+  double ts;
+  /// Duration of the span in microseconds.
+  double dur;
+  /// Identifier of the thread that recorded the span.
+  size_t tid;
+};
+
+/// @brief Collects the spans of a process and writes them as a
+/// chrome://tracing JSON file.
+///
+/// Tracing is enabled by setting the environment variable FES_TRACE to the
+/// path of the file to write; the file is written when the process exits and
+/// can be opened in chrome://tracing or Perfetto. When the variable is unset
+/// the spans reduce to one predictable branch, so the instrumentation can
+/// stay compiled into the hot paths.
+///
+/// Each thread appends to its own buffer: the recorder mutex is only taken
+/// when a thread records its first span and when the file is written.
+class Recorder {
+ public:
+  /// Returns the process-wide recorder.
+  static auto instance() -> Recorder&;
+
+  /// Writes the collected spans to the requested file.
+  ~Recorder();
+
+  Recorder(const Recorder&) = delete;
+  auto operator=(const Recorder&) -> Recorder& = delete;
+
+  /// True if tracing was requested via the environment.
+  auto enabled() const noexcept -> bool { return enabled_; }
+
+  /// Microseconds elapsed since the recorder was created.
+  auto now() const noexcept -> double {
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - origin_)
+        .count();
+  }
+
+  /// Appends a span started at the given timestamp to the buffer of the
+  /// calling thread.
+  auto record(const char* name, double start) -> void;
+
+ private:
+  /// Spans recorded by one thread.
+  struct ThreadBuffer {
+    size_t tid;
+    std::vector<Event> events;
+  };
+
+  /// Reads the environment to decide whether tracing is enabled.
+  Recorder();
+
+  bool enabled_{false};
+  std::string path_{};
+  std::chrono::steady_clock::time_point origin_{};
+  std::mutex mutex_{};
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_{};
+};
+
+/// @brief Records the lifetime of a scope as one span.
+///
+/// The name must be a string literal: it is referenced, not copied, until
+/// the trace is written.
+class Scope {
+ public:
+  /// Opens a span if tracing is enabled, otherwise does nothing.
+  explicit Scope(const char* const name) {
+    auto& recorder = Recorder::instance();
+    if (recorder.enabled()) {
+      name_ = name;
+      start_ = recorder.now();
+    }
+  }
+
+  /// Closes the span.
+  ~Scope() {
+    if (name_ != nullptr) {
+      Recorder::instance().record(name_, start_);
+    }
+  }
+
+  Scope(const Scope&) = delete;
+  auto operator=(const Scope&) -> Scope& = delete;
+
+ private:
+  const char* name_{nullptr};
+  double start_{0};
+};
+
+}  // namespace trace
+}  // namespace detail
+}  // namespace fes
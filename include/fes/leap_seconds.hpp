@@ -0,0 +1,74 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/leap_seconds.hpp
+/// @brief Leap seconds resolved from the embedded IERS table.
+#pragma once
+#include <Eigen/Core>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#include "fes/eigen.hpp"
+
+namespace fes {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace detail {
+
+/// UTC times, in seconds since 1970-01-01T00:00:00Z, at which the UTC-TAI
+/// difference changes. The values mirror the IERS table vendored in
+/// src/python/pyfes/data/leap-seconds.txt; both must be updated together
+/// when the IERS announces a new leap second.
+static constexpr double kLeapSecondEpoch[] = {
+    63072000.0,   78796800.0,   94694400.0,   126230400.0,  157766400.0,
+    189302400.0,  220924800.0,  252460800.0,  283996800.0,  315532800.0,
+    362793600.0,  394329600.0,  425865600.0,  489024000.0,  567993600.0,
+    631152000.0,  662688000.0,  709948800.0,  741484800.0,  773020800.0,
+    820454400.0,  867715200.0,  915148800.0,  1136073600.0, 1230768000.0,
+    1341100800.0, 1435708800.0, 1483228800.0};
+
+/// UTC-TAI difference, in seconds, effective from the matching entry of
+/// kLeapSecondEpoch.
+static constexpr uint16_t kLeapSecondOffset[] = {
+    10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23,
+    24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37};
+
+}  // namespace detail
+
+#endif
+
+/// @brief Returns the UTC-TAI difference at the given UTC time.
+///
+/// The difference is resolved from the IERS leap second table embedded in
+/// the library, so callers do not need to assemble a leap second vector
+/// themselves.
+///
+/// @param[in] epoch UTC time in seconds since 1970-01-01T00:00:00Z.
+/// @return The number of leap seconds elapsed since 1970-01-01T00:00:00Z.
+/// @note Epochs before 1972-01-01, where UTC was not yet defined by leap
+/// seconds, resolve to the first entry of the table.
+inline auto leap_seconds(const double epoch) noexcept -> uint16_t {
+  const auto* first = std::begin(detail::kLeapSecondEpoch);
+  const auto* it =
+      std::upper_bound(first, std::end(detail::kLeapSecondEpoch), epoch);
+  return detail::kLeapSecondOffset[it == first ? 0 : (it - first) - 1];
+}
+
+/// @brief Returns the UTC-TAI difference for each given UTC time.
+///
+/// @param[in] epoch UTC times in seconds since 1970-01-01T00:00:00Z.
+/// @return The number of leap seconds elapsed since 1970-01-01T00:00:00Z,
+/// for each provided epoch.
+inline auto leap_seconds(const Eigen::Ref<const Eigen::VectorXd>& epoch)
+    -> Vector<uint16_t> {
+  auto result = Vector<uint16_t>(epoch.size());
+  for (Eigen::Index ix = 0; ix < epoch.size(); ++ix) {
+    result(ix) = leap_seconds(epoch(ix));
+  }
+  return result;
+}
+
+}  // namespace fes
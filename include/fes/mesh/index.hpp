@@ -8,8 +8,9 @@
 #include <Eigen/Core>
 #include <boost/geometry.hpp>
 #include <cstdint>
+#include <iosfwd>
 #include <memory>
-#include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -58,13 +59,28 @@ struct SelectedTriangle {
 /// %Index the triangles of a mesh.
 class Index : public std::enable_shared_from_this<Index> {
  public:
+  /// Spatial structure answering the point-in-triangle queries.
+  enum Backend : std::uint8_t {
+    /// R*Tree over the triangle vertices in ECEF coordinates. Handles any
+    /// mesh, at the cost of a tree traversal per query.
+    kRTree = 0,
+    /// Uniform longitude/latitude cell grid over the triangles, in CSR
+    /// layout: one array lookup yields the candidate triangles of the cell
+    /// holding the query. Suited to quasi-uniform meshes.
+    kUniformGrid = 1,
+  };
+
   /// Default constructor.
   ///
   /// @param[in] lon The longitude coordinates of the mesh vertices.
   /// @param[in] lat The latitude coordinates of the mesh vertices.
   /// @param[in] triangles The mesh triangles.
+  /// @param[in] backend The spatial structure answering the queries.
   Index(Eigen::VectorXd lon, Eigen::VectorXd lat,
-        Eigen::Matrix<int32_t, -1, 3> triangles);
+        Eigen::Matrix<int32_t, -1, 3> triangles, Backend backend = kRTree);
+
+  /// Get the spatial structure answering the queries.
+  constexpr auto backend() const noexcept -> Backend { return backend_; }
 
   /// Search the triangle that contains a point. If such a triangle is not
   /// found, it returns the nearest triangle if it's within a given
@@ -76,6 +92,66 @@ class Index : public std::enable_shared_from_this<Index> {
   auto search(const geometry::Point& point, const double max_distance) const
       -> SelectedTriangle;
 
+  /// @brief Search the triangles that contain a batch of points.
+  ///
+  /// The queries are processed along a space-filling curve instead of in the
+  /// given order, so that consecutive searches hit the same part of the
+  /// spatial structure, and each query first probes the triangle selected by
+  /// the previous one. The results are returned in the order of the input
+  /// points.
+  ///
+  /// @param[in] points The points.
+  /// @param[in] max_distance The maximum distance to the nearest triangle.
+  /// @return The selected triangle of each point.
+  auto search_many(const std::vector<geometry::Point>& points,
+                   const double max_distance) const
+      -> std::vector<SelectedTriangle>;
+
+  /// @brief Search the triangle that contains a point, starting from a known
+  /// nearby triangle.
+  ///
+  /// The search walks the triangle adjacency from the hint, crossing the
+  /// edge separating the current triangle from the point, and resorts to a
+  /// full search when the walk leaves the mesh or does not converge. For a
+  /// query close to the hint, the walk replaces the spatial query with a few
+  /// orientation tests.
+  ///
+  /// @param[in] point The point.
+  /// @param[in] hint The index of a triangle close to the point, or -1 when
+  /// no such triangle is known.
+  /// @param[in] max_distance The maximum distance to the nearest triangle.
+  /// @return The selected triangle.
+  auto search_from(const geometry::Point& point, const int32_t hint,
+                   const double max_distance) const -> SelectedTriangle;
+
+  /// @brief Test if a point is inside or on the border of a triangle.
+  ///
+  /// The test applies the affine barycentric transform of the triangle,
+  /// cached when the index was built, followed by three sign tests: no
+  /// geometry is rebuilt per query.
+  ///
+  /// @param[in] triangle_index The triangle index.
+  /// @param[in] point The point.
+  /// @return True if the point is inside of or on the border of the
+  /// triangle, else false.
+  auto contains(const int32_t triangle_index, const geometry::Point& point)
+      const -> bool;
+
+  /// @brief Compute the angles @f$\xi@f$ and @f$\eta@f$ of the reference
+  /// right-angled triangle for a point inside a triangle.
+  ///
+  /// Same result as geometry::Triangle::reference_right_angled(), computed
+  /// from the affine barycentric transform cached when the index was built.
+  ///
+  /// @param[in] triangle_index The triangle index.
+  /// @param[in] point The point.
+  /// @return A tuple containing the angles @f$\xi@f$ and @f$\eta@f$.
+  /// @warning The given point must be inside the triangle otherwise the
+  /// result is undefined.
+  auto reference_right_angled(const int32_t triangle_index,
+                              const geometry::Point& point) const
+      -> std::tuple<double, double>;
+
   /// Get the number of positions in the index
   inline auto n_positions() const noexcept -> size_t { return lon_.size(); }
 
@@ -101,12 +177,38 @@ class Index : public std::enable_shared_from_this<Index> {
   /// @return The string representation of the index state.
   auto getstate() const -> std::string;
 
+  /// @brief Serialize the index state into a stream.
+  ///
+  /// Besides the mesh geometry, the state carries the ECEF coordinates of
+  /// the vertices, precomputed when the R*Tree was built: setstate()
+  /// bulk-loads the tree from this flat buffer without converting or
+  /// validating the geometry again.
+  ///
+  /// @param[in] ss The stream to write to.
+  auto getstate(std::ostream& ss) const -> void;
+
+  /// @brief Get the number of bytes written by getstate().
+  ///
+  /// Lets a caller length-prefix the index state without building it in
+  /// memory first.
+  ///
+  /// @return The size of the serialized index state.
+  auto state_size() const noexcept -> std::size_t;
+
   /// @brief Build an index from serialized state.
   ///
   /// @param[in] data The serialized state.
   /// @return The index.
   static auto setstate(const string_view& data) -> Index;
 
+  /// @brief Build an index from a stream of serialized state.
+  ///
+  /// The stream is configured to throw on read failures.
+  ///
+  /// @param[in] ss The stream to read from.
+  /// @return The index.
+  static auto setstate(std::istream& ss) -> Index;
+
  private:
   /// Values stored in the R*Tree : Vertex of the triangle in ECEF coordinates,
   /// index of vertex (0, 1 or 2) and index of triangle.
@@ -126,9 +228,108 @@ class Index : public std::enable_shared_from_this<Index> {
   /// The indices of the mesh vertices that form each triangle.
   Eigen::Matrix<int32_t, -1, 3> triangles_;
 
-  /// The R*Tree
+  /// The edge-neighbor table: item (ix, jx) is the triangle sharing the edge
+  /// between the vertices jx and (jx + 1) % 3 of the triangle ix, or -1 when
+  /// the edge lies on the mesh boundary.
+  Eigen::Matrix<int32_t, -1, 3> adjacency_;
+
+  /// The affine barycentric transform of each triangle: the origin vertex
+  /// (lon, lat) followed by the four items of the inverted Jacobian mapping
+  /// an offset from the origin to the reference right-angled triangle. The
+  /// Jacobian items of a degenerate triangle are NaN.
+  Eigen::Matrix<double, -1, 6> barycentric_;
+
+  /// Uniform-cell bucket grid over the triangles, in CSR layout.
+  struct CellGrid {
+    /// The western edge of the grid, in degrees.
+    double lon_min{};
+    /// The southern edge of the grid, in degrees.
+    double lat_min{};
+    /// The width of one cell, in degrees.
+    double cell_width{};
+    /// The height of one cell, in degrees.
+    double cell_height{};
+    /// The number of cells along the longitude axis.
+    int32_t nx{};
+    /// The number of cells along the latitude axis.
+    int32_t ny{};
+    /// True if the grid covers the whole longitude circle: the cell rings
+    /// wrap around the seam.
+    bool circular{};
+    /// The first candidate of each cell in the candidates array (nx * ny + 1
+    /// items).
+    std::vector<int32_t> offsets{};
+    /// The candidate triangles of every cell, cell by cell.
+    std::vector<int32_t> candidates{};
+    /// The Chebyshev distance, in cells, from each cell to the nearest
+    /// non-empty cell, saturated at 255. Zero for a non-empty cell.
+    std::vector<uint8_t> distance{};
+  };
+
+  /// The R*Tree, built when the backend is kRTree.
   rtree_t rtree_{};
 
+  /// The cell grid. It answers the queries when the backend is kUniformGrid
+  /// and carries, for both backends, a precomputed distance-to-mesh field: a
+  /// query provably farther from the mesh than the extrapolation distance
+  /// returns without a spatial search.
+  CellGrid grid_{};
+
+  /// The spatial structure answering the queries.
+  Backend backend_{kRTree};
+
+  /// The ECEF coordinates of the mesh vertices: kept to compute the
+  /// distance from a query to the candidate vertices and to serialize the
+  /// state without converting the geometry again.
+  Eigen::Matrix<double, -1, 3> ecef_{};
+
+  /// Build an index from deserialized state: the geometry was validated and
+  /// normalized when the state was written and the ECEF coordinates of the
+  /// vertices are read back instead of being recomputed.
+  Index(Eigen::VectorXd lon, Eigen::VectorXd lat,
+        Eigen::Matrix<int32_t, -1, 3> triangles,
+        Eigen::Matrix<double, -1, 3> ecef, Backend backend);
+
+  /// Build the spatial structure selected by the backend.
+  auto build_backend() -> void;
+
+  /// Build the edge-neighbor table of the triangles.
+  auto build_adjacency() -> void;
+
+  /// Build the affine barycentric transform of each triangle.
+  auto build_barycentric() -> void;
+
+  /// Bulk-load the R*Tree from the ECEF coordinates of the mesh vertices.
+  auto build_rtree() -> void;
+
+  /// Bin the triangles into the uniform cell grid.
+  auto build_grid() -> void;
+
+  /// Visit the cells covered by the bounding box of a triangle.
+  template <typename Callable>
+  auto for_each_cell(int32_t triangle_index, const Callable& callable) const
+      -> void;
+
+  /// True if a triangle may lie within the given distance of the point:
+  /// false guarantees that the search would select nothing. One lookup in
+  /// the precomputed distance-to-mesh field of the cell grid.
+  auto maybe_inside(const geometry::Point& point, double max_distance) const
+      -> bool;
+
+  /// Answer a query with the R*Tree.
+  auto search_rtree(const geometry::Point& point, double max_distance) const
+      -> SelectedTriangle;
+
+  /// Answer a query with the cell grid.
+  auto search_grid(const geometry::Point& point, double max_distance) const
+      -> SelectedTriangle;
+
+  /// Select, among the candidate triangles, the one covering the query or,
+  /// within the given distance, the nearest one.
+  auto resolve(const geometry::Point& point, const int32_t* candidates,
+               int32_t count, double min_distance, double max_distance) const
+      -> SelectedTriangle;
+
   /// Build the selected triangle.
   inline auto build_triangle(const int triangle_index) const
       -> geometry::Triangle {
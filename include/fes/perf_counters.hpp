@@ -0,0 +1,107 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/perf_counters.hpp
+/// @brief Performance counters of the prediction hot paths.
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace fes {
+
+/// @brief Counters describing how the prediction hot paths behaved.
+///
+/// Each accelerator accumulates its own instance without any
+/// synchronization: the workers of a prediction never share an accelerator.
+/// The per-worker counters are folded into a process-wide aggregate when the
+/// accelerator is destroyed, at the end of the calculation, where one mutex
+/// acquisition per worker is negligible. The aggregate is read with
+/// fes::perf_counters() and cleared with fes::reset_perf_counters().
+struct PerfCounters {
+  /// Number of times the astronomic angles were recomputed.
+  uint64_t angle_recomputes{0};
+  /// Number of times the astronomic angles were served by the cache
+  /// governed by the time tolerance.
+  uint64_t angle_cache_hits{0};
+  /// Number of queries served by the cell or triangle cached by the last
+  /// interpolation.
+  uint64_t interpolation_cache_hits{0};
+  /// Number of queries that could not reuse the cached cell or triangle.
+  uint64_t interpolation_cache_misses{0};
+  /// Number of spatial searches (axis lookups or mesh point locations).
+  uint64_t searches{0};
+  /// Number of queries answered by extrapolation.
+  uint64_t extrapolations{0};
+  /// Number of queries outside the domain of the model.
+  uint64_t undefined{0};
+  /// Number of chunks claimed by the adaptive scheduler of
+  /// detail::parallel_for.
+  uint64_t adaptive_chunks{0};
+  /// Chunk size the adaptive scheduler converged to during the most recent
+  /// adaptive run; zero when no adaptive run has completed. Pass it as the
+  /// chunk size of fes::Settings to pin the granularity in a production
+  /// configuration.
+  uint64_t adaptive_chunk_size{0};
+
+  /// Folds the counters of another instance into this one.
+  auto operator+=(const PerfCounters& other) noexcept -> PerfCounters& {
+    angle_recomputes += other.angle_recomputes;
+    angle_cache_hits += other.angle_cache_hits;
+    interpolation_cache_hits += other.interpolation_cache_hits;
+    interpolation_cache_misses += other.interpolation_cache_misses;
+    searches += other.searches;
+    extrapolations += other.extrapolations;
+    undefined += other.undefined;
+    adaptive_chunks += other.adaptive_chunks;
+    if (other.adaptive_chunk_size != 0) {
+      // Not a sum: the converged granularity of the most recent run is the
+      // one worth pinning.
+      adaptive_chunk_size = other.adaptive_chunk_size;
+    }
+    return *this;
+  }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace detail {
+
+/// The process-wide aggregate and the mutex guarding it.
+inline auto perf_counters_registry()
+    -> std::pair<std::mutex, PerfCounters>& {
+  static std::pair<std::mutex, PerfCounters> registry;
+  return registry;
+}
+
+/// Folds per-worker counters into the process-wide aggregate. Called once
+/// per accelerator, outside the hot path.
+inline auto flush_perf_counters(const PerfCounters& counters) -> void {
+  auto& registry = perf_counters_registry();
+  std::lock_guard<std::mutex> lock(registry.first);
+  registry.second += counters;
+}
+
+}  // namespace detail
+
+#endif
+
+/// @brief Returns a snapshot of the process-wide performance counters.
+///
+/// The counters cover the calculations whose accelerators have been
+/// destroyed; a calculation still in progress is not visible yet.
+inline auto perf_counters() -> PerfCounters {
+  auto& registry = detail::perf_counters_registry();
+  std::lock_guard<std::mutex> lock(registry.first);
+  return registry.second;
+}
+
+/// @brief Clears the process-wide performance counters.
+inline auto reset_perf_counters() -> void {
+  auto& registry = detail::perf_counters_registry();
+  std::lock_guard<std::mutex> lock(registry.first);
+  registry.second = PerfCounters();
+}
+
+}  // namespace fes
@@ -0,0 +1,174 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// @file include/fes/pipeline.hpp
+/// @brief Streaming chunked evaluation of the tide.
+#pragma once
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "fes/predictor.hpp"
+
+namespace fes {
+
+/// @brief Streaming chunked evaluation of the tide with double buffering.
+///
+/// Processing a large dataset with fes::evaluate_tide serializes three
+/// phases: reading the inputs, computing the tide and writing the results,
+/// with the whole dataset resident in memory at once. This pipeline consumes
+/// input chunks from a producer callback and hands result chunks to a
+/// consumer callback, keeping only two fixed-size buffers alive: while one
+/// chunk is being computed, the caller fills the next one and writes the
+/// previous results, so the computation is overlapped with the caller's I/O.
+/// The computation of a chunk is itself parallelized over the configured
+/// number of threads as the inner stage of the pipeline.
+///
+/// @tparam T The type of tidal constituents modelled.
+/// @warning A TidePipeline instance must not be used from several threads at
+/// the same time.
+template <typename T>
+class TidePipeline {
+ public:
+  /// A fixed-capacity slice of the stream.
+  ///
+  /// The producer fills the first elements of the input vectors (epoch,
+  /// leap_seconds, longitude and latitude) and returns the number of valid
+  /// elements; the consumer reads the same number of elements from the
+  /// output vectors (tide, long_period and quality).
+  struct Chunk {
+    /// Date of the tide calculation expressed in number of seconds elapsed
+    /// since 1970-01-01T00:00:00Z.
+    Eigen::VectorXd epoch;
+    /// Number of leap seconds elapsed since 1970-01-01T00:00:00Z.
+    Vector<uint16_t> leap_seconds;
+    /// Longitude in degrees for the position at which the tide is
+    /// calculated.
+    Eigen::VectorXd longitude;
+    /// Latitude in degrees for the position at which the tide is calculated.
+    Eigen::VectorXd latitude;
+    /// Height of the diurnal and semi-diurnal constituents of the tidal
+    /// spectrum.
+    Eigen::VectorXd tide;
+    /// Height of the long period wave constituents of the tidal spectrum.
+    Eigen::VectorXd long_period;
+    /// Quality of the tide calculation.
+    Vector<Quality> quality;
+    /// Number of valid elements of the chunk.
+    Eigen::Index size{0};
+
+    /// Build a chunk able to hold the given number of elements.
+    explicit Chunk(const Eigen::Index capacity)
+        : epoch(capacity),
+          leap_seconds(capacity),
+          longitude(capacity),
+          latitude(capacity),
+          tide(capacity),
+          long_period(capacity),
+          quality(capacity) {}
+
+    /// Get the number of elements the chunk is able to hold.
+    auto capacity() const noexcept -> Eigen::Index { return epoch.size(); }
+  };
+
+  /// Build a pipeline.
+  ///
+  /// @param[in] tidal_model Tidal model used to interpolate the modelized
+  /// waves. The pipeline keeps a reference on the model for its whole
+  /// lifetime.
+  /// @param[in] settings Settings for the tide computation.
+  /// @param[in] chunk_size Number of elements of each of the two buffers of
+  /// the pipeline.
+  /// @param[in] num_threads Number of threads used to compute one chunk. If
+  /// 0, the number of threads is automatically determined.
+  /// @throw std::invalid_argument if the chunk size is not positive.
+  explicit TidePipeline(
+      std::shared_ptr<const AbstractTidalModel<T>> tidal_model,
+      Settings settings = Settings(), const Eigen::Index chunk_size = 65536,
+      const size_t num_threads = 0)
+      : predictor_(std::move(tidal_model), std::move(settings), num_threads),
+        front_(check_chunk_size(chunk_size)),
+        back_(chunk_size) {}
+
+  /// Drive the stream until the producer is exhausted.
+  ///
+  /// @tparam Producer Callable with the signature
+  /// `auto (Chunk&) -> Eigen::Index`, filling the input vectors of the given
+  /// chunk and returning the number of valid elements. Returning 0 ends the
+  /// stream.
+  /// @tparam Consumer Callable with the signature `auto (const Chunk&) ->
+  /// void`, reading the results of the given chunk. Chunks are consumed in
+  /// the order they were produced.
+  /// @param[in] producer The producer callback.
+  /// @param[in] consumer The consumer callback.
+  /// @throw std::invalid_argument if the producer returns more elements than
+  /// the chunk capacity.
+  template <typename Producer, typename Consumer>
+  auto run(const Producer& producer, const Consumer& consumer) -> void {
+    auto* front = &front_;
+    auto* back = &back_;
+
+    fill(producer, *front);
+    if (front->size == 0) {
+      return;
+    }
+    auto pending = submit(front);
+
+    while (true) {
+      // Read the next chunk while the previous one is being computed.
+      fill(producer, *back);
+      pending.get();
+      if (back->size != 0) {
+        auto next = submit(back);
+        // Write the computed chunk while the next one is being computed.
+        consumer(*front);
+        std::swap(front, back);
+        pending = std::move(next);
+      } else {
+        consumer(*front);
+        break;
+      }
+    }
+  }
+
+ private:
+  /// Validate the chunk size before allocating the buffers.
+  static auto check_chunk_size(const Eigen::Index chunk_size) -> Eigen::Index {
+    if (chunk_size <= 0) {
+      throw std::invalid_argument("chunk_size must be positive");
+    }
+    return chunk_size;
+  }
+
+  /// Session keeping the prediction state warm from one chunk to the next.
+  Predictor<T> predictor_;
+  /// The two buffers of the pipeline.
+  Chunk front_;
+  Chunk back_;
+
+  /// Fill a chunk from the producer and validate the returned size.
+  template <typename Producer>
+  auto fill(const Producer& producer, Chunk& chunk) -> void {
+    chunk.size = producer(chunk);
+    if (chunk.size < 0 || chunk.size > chunk.capacity()) {
+      throw std::invalid_argument(
+          "the producer returned more elements than the chunk capacity");
+    }
+  }
+
+  /// Launch the computation of a chunk.
+  auto submit(Chunk* chunk) -> std::future<void> {
+    return std::async(std::launch::async, [this, chunk]() {
+      const auto n = chunk->size;
+      predictor_.predict(chunk->epoch.head(n), chunk->leap_seconds.head(n),
+                         chunk->longitude.head(n), chunk->latitude.head(n),
+                         chunk->tide.head(n), chunk->long_period.head(n),
+                         chunk->quality.head(n));
+    });
+  }
+};
+
+}  // namespace fes
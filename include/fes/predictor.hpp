@@ -0,0 +1,231 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// @file include/fes/predictor.hpp
+/// @brief Reusable tide prediction session.
+#pragma once
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "fes/abstract_tidal_model.hpp"
+#include "fes/settings.hpp"
+#include "fes/tide.hpp"
+
+namespace fes {
+
+/// @brief Reusable tide prediction session.
+///
+/// Every call to fes::evaluate_tide rebuilds the wave table, the long period
+/// equilibrium handler and one accelerator per thread. This setup cost is
+/// negligible for large batches but dominates when the prediction is invoked
+/// many times on small ones. A Predictor is constructed once from a model and
+/// settings, owns this state per worker and keeps it warm across calls, so
+/// repeated invocations of predict() only pay for the computation itself.
+///
+/// @tparam T The type of tidal constituents modelled.
+/// @warning A Predictor instance must not be used from several threads at the
+/// same time: the cached state is distributed over the workers of a single
+/// call.
+template <typename T>
+class Predictor {
+ public:
+  /// Build a prediction session.
+  ///
+  /// @param[in] tidal_model Tidal model used to interpolate the modelized
+  /// waves. The session keeps a reference on the model for its whole
+  /// lifetime.
+  /// @param[in] settings Settings for the tide computation.
+  /// @param[in] num_threads Number of threads used by predict(). If 0, the
+  /// number of threads is automatically determined.
+  explicit Predictor(std::shared_ptr<const AbstractTidalModel<T>> tidal_model,
+                     Settings settings = Settings(),
+                     const size_t num_threads = 0)
+      : tidal_model_(std::move(tidal_model)), settings_(std::move(settings)) {
+    if (!tidal_model_) {
+      throw std::invalid_argument("tidal_model is null");
+    }
+    num_threads_ = num_threads == 0
+                       ? static_cast<size_t>(std::max(
+                             1U, std::thread::hardware_concurrency()))
+                       : num_threads;
+    slots_.reserve(num_threads_);
+    // The wave table is prepared once and cloned per slot: the clone places
+    // all its wave objects in one contiguous block allocated in a single
+    // call.
+    const auto wave_table_prototype =
+        detail::build_wave_table(tidal_model_.get(), settings_.excluded());
+    for (size_t ix = 0; ix < num_threads_; ++ix) {
+      slots_.emplace_back(
+          new Slot(tidal_model_.get(), settings_, wave_table_prototype));
+    }
+  }
+
+  /// Get the settings used for the tide computation.
+  constexpr auto settings() const noexcept -> const Settings& {
+    return settings_;
+  }
+
+  /// Ocean tide calculation writing the results into caller-provided buffers.
+  ///
+  /// Same semantics as the in-place overload of fes::evaluate_tide: a size-1
+  /// input vector is broadcast against the others and the output vectors must
+  /// have the broadcast size.
+  ///
+  /// @param[in] epoch Date of the tide calculation expressed in number of
+  /// seconds elapsed since 1970-01-01T00:00:00Z
+  /// @param[in] leap_seconds Number of leap seconds elapsed since
+  /// 1970-01-01T00:00:00Z
+  /// @param[in] longitude Longitude in degrees for the position at which the
+  /// tide is calculated
+  /// @param[in] latitude Latitude in degrees for the position at which the
+  /// tide is calculated
+  /// @param[out] tide The height of the the diurnal and semi-diurnal
+  /// constituents of the tidal spectrum.
+  /// @param[out] long_period The height of the long period wave constituents
+  /// of the tidal spectrum.
+  /// @param[out] quality The quality of the tide calculation.
+  /// @throw std::invalid_argument if the input vectors could not be broadcast
+  /// together or if the output vectors do not have the broadcast size.
+  auto predict(const Eigen::Ref<const Eigen::VectorXd>& epoch,
+               const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+               const Eigen::Ref<const Eigen::VectorXd>& longitude,
+               const Eigen::Ref<const Eigen::VectorXd>& latitude,
+               Eigen::Ref<Eigen::VectorXd> tide,
+               Eigen::Ref<Eigen::VectorXd> long_period,
+               Eigen::Ref<Vector<Quality>> quality) -> void {
+    // Checks the input parameters
+    const auto size = detail::broadcast_eigen_shape(
+        "epoch", epoch, "leap_seconds", leap_seconds, "longitude", longitude,
+        "latitude", latitude);
+    detail::check_eigen_shape("tide", tide, "long_period", long_period,
+                              "quality", quality);
+    if (tide.size() != size) {
+      throw std::invalid_argument(
+          "tide could not be broadcast together with shape " +
+          detail::eigen_shape(tide) + ", (" + std::to_string(size) + ")");
+    }
+
+    // Size-1 vectors are broadcast against the others.
+    auto epoch_view =
+        detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(epoch);
+    auto leap_seconds_view =
+        detail::BroadcastView<Eigen::Ref<const fes::Vector<uint16_t>>>(
+            leap_seconds);
+    auto longitude_view =
+        detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(longitude);
+    auto latitude_view =
+        detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(latitude);
+
+    // Each invocation of the worker borrows one of the cached slots instead
+    // of rebuilding the prediction state. Under dynamic or adaptive
+    // scheduling the callable runs once per claimed chunk, not once per
+    // thread, so the slots are handed out through a free list: at most
+    // num_threads_ invocations run at the same time, hence the list is never
+    // empty when a borrower arrives.
+    auto mutex = std::mutex();
+    auto free_slots = std::vector<Slot*>();
+    free_slots.reserve(slots_.size());
+    for (const auto& slot : slots_) {
+      free_slots.push_back(slot.get());
+    }
+    auto worker = [&](const int64_t start, const int64_t end) {
+      Slot* slot;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot = free_slots.back();
+        free_slots.pop_back();
+      }
+      for (auto ix = start; ix < end; ++ix) {
+        std::tie(tide(ix), long_period(ix), quality(ix)) =
+            detail::evaluate_tide(tidal_model_.get(), epoch_view(ix),
+                                  leap_seconds_view(ix), longitude_view(ix),
+                                  latitude_view(ix), slot->wave_table,
+                                  slot->lpe, slot->kernel, slot->acc.get());
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      free_slots.push_back(slot);
+    };
+
+    detail::parallel_for(worker, size, num_threads_, settings_.chunk_size(),
+                         settings_.pin_threads());
+  }
+
+  /// Ocean tide calculation.
+  ///
+  /// Same semantics as fes::evaluate_tide: a size-1 input vector is broadcast
+  /// against the others.
+  ///
+  /// @param[in] epoch Date of the tide calculation expressed in number of
+  /// seconds elapsed since 1970-01-01T00:00:00Z
+  /// @param[in] leap_seconds Number of leap seconds elapsed since
+  /// 1970-01-01T00:00:00Z
+  /// @param[in] longitude Longitude in degrees for the position at which the
+  /// tide is calculated
+  /// @param[in] latitude Latitude in degrees for the position at which the
+  /// tide is calculated
+  /// @return A tuple that contains:
+  /// - The height of the the diurnal and semi-diurnal constituents of the
+  ///   tidal spectrum.
+  /// - The height of the long period wave constituents of the tidal
+  ///   spectrum.
+  /// - The quality of the tide calculation. Could be kUndefined if the
+  ///   point is not defined by the model, kInterpolated if the model is
+  ///   interpolated, kExtrapolated if the model is extrapolated.
+  auto predict(const Eigen::Ref<const Eigen::VectorXd>& epoch,
+               const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+               const Eigen::Ref<const Eigen::VectorXd>& longitude,
+               const Eigen::Ref<const Eigen::VectorXd>& latitude)
+      -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<Quality>> {
+    const auto size = detail::broadcast_eigen_shape(
+        "epoch", epoch, "leap_seconds", leap_seconds, "longitude", longitude,
+        "latitude", latitude);
+    auto tide = Eigen::VectorXd(size);
+    auto long_period = Eigen::VectorXd(size);
+    auto quality = Vector<Quality>(size);
+
+    predict(epoch, leap_seconds, longitude, latitude, tide, long_period,
+            quality);
+    return {tide, long_period, quality};
+  }
+
+ private:
+  /// Prediction state owned by one worker.
+  struct Slot {
+    /// List of tidal constituents used for the tidal prediction.
+    wave::Table wave_table;
+    /// Handler to compute the long-period equilibrium ocean tides.
+    wave::LongPeriodEquilibrium lpe;
+    /// Kernel used to evaluate the harmonic summation.
+    detail::HarmonicSummationKernel kernel;
+    /// Accelerator used to speed up the computation.
+    std::unique_ptr<Accelerator> acc;
+
+    /// Build the state for one worker.
+    Slot(const AbstractTidalModel<T>* const tidal_model,
+         const Settings& settings, const wave::Table& wave_table_prototype)
+        : wave_table(wave_table_prototype.clone()),
+          lpe(wave_table),
+          kernel(wave_table, settings.fast_sincos()),
+          acc(tidal_model->accelerator(settings.astronomic_formulae(),
+                                       settings.time_tolerance())) {}
+  };
+
+  /// Tidal model used to interpolate the modelized waves.
+  std::shared_ptr<const AbstractTidalModel<T>> tidal_model_;
+  /// Settings for the tide computation.
+  Settings settings_;
+  /// Number of threads used by predict().
+  size_t num_threads_;
+  /// Cached prediction state, one slot per worker.
+  std::vector<std::unique_ptr<Slot>> slots_;
+};
+
+}  // namespace fes
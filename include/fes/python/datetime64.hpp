@@ -9,8 +9,12 @@
 #include <pybind11/pybind11.h>
 
 #include <Eigen/Core>
+#include <cstdint>
 #include <string>
 
+#include "fes/detail/thread.hpp"
+#include "fes/eigen.hpp"
+
 namespace fes {
 namespace python {
 
@@ -59,19 +63,59 @@ static inline auto npdatetime64_scale(const pybind11::dtype& dtype) -> double {
       units);
 }
 
-static inline auto npdatetime64_to_epoch(const pybind11::array& array)
+/// Converts a numpy datetime64 array into an epoch vector in seconds.
+///
+/// The datetime64 buffer is read in place — the integral ticks are never
+/// copied into an intermediate array — and the scale conversion is a
+/// vectorized sweep split over the worker threads, so converting a large
+/// swath does not dominate short predictions.
+///
+/// @param[in] array The numpy datetime64 array to convert.
+/// @param[in] num_threads The number of threads to use for the conversion.
+/// If 0, the number of threads is automatically determined.
+/// @return The epoch vector in seconds since 1970-01-01T00:00:00Z.
+static inline auto npdatetime64_to_epoch(const pybind11::array& array,
+                                         const size_t num_threads = 0)
     -> Eigen::VectorXd {
   auto scale = npdatetime64_scale(array.dtype());
-  auto ptr = array.unchecked<int64_t, 1>();
-  auto result = Eigen::VectorXd(ptr.size());
+  if (array.ndim() != 1) {
+    throw std::invalid_argument("date must be a one-dimensional array");
+  }
+  const auto* data = static_cast<const int64_t*>(array.data());
+  const auto stride =
+      array.strides(0) / static_cast<pybind11::ssize_t>(sizeof(int64_t));
+  auto result = Eigen::VectorXd(array.shape(0));
   {
     pybind11::gil_scoped_release release;
-    for (pybind11::ssize_t ix = 0; ix < ptr.size(); ++ix) {
-      result(ix) = ptr(ix) * scale;
-    }
+    auto worker = [&](const size_t start, const size_t end) {
+      const auto n = static_cast<Eigen::Index>(end - start);
+      const auto offset = static_cast<Eigen::Index>(start);
+      if (stride == 1) {
+        auto ticks = Eigen::Map<const Vector<int64_t>>(data + offset, n);
+        result.segment(offset, n) = ticks.cast<double>() * scale;
+      } else {
+        // Non-contiguous views (slices, reversed arrays) fall back to a
+        // strided scalar sweep.
+        for (Eigen::Index ix = 0; ix < n; ++ix) {
+          result(offset + ix) = data[(offset + ix) * stride] * scale;
+        }
+      }
+    };
+    detail::parallel_for(worker, static_cast<size_t>(result.size()),
+                         num_threads);
   }
   return result;
 }
 
+static inline auto npdatetime64_scalar_to_epoch(const pybind11::object& date)
+    -> double {
+  auto array = pybind11::array::ensure(date);
+  if (!array || array.ndim() != 0) {
+    throw std::invalid_argument("date must be a numpy datetime64 scalar");
+  }
+  auto scale = npdatetime64_scale(array.dtype());
+  return *static_cast<const int64_t*>(array.data()) * scale;
+}
+
 }  // namespace python
 }  // namespace fes
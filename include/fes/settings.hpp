@@ -29,6 +29,50 @@ class Settings {
   /// from the model. Constituents included in this list will be processed
   /// through admittance calculations and in the long-period equilibrium wave
   /// calculation routine (`lpe_minus_n_waves`).
+  /// @param[in] chunk_size The number of indexes claimed at once by a worker
+  /// thread. The default value 0 splits the work into one static chunk per
+  /// thread. A non-zero value enables dynamic scheduling, where the workers
+  /// claim fixed-size chunks until the work is exhausted: this redistributes
+  /// straggler chunks (for example coastal positions paying a full mesh
+  /// search) over the remaining threads, at the cost of rebuilding the
+  /// per-worker state once per chunk. The special value
+  /// fes::kAdaptiveChunkSize lets the workers time each chunk and steer the
+  /// granularity toward a fixed time quantum; the granularity the run
+  /// converged to is reported through fes::perf_counters() and can be pinned
+  /// here in a production configuration.
+  /// @param[in] pin_threads If true, the workers of the process-wide thread
+  /// pool are pinned to one CPU each before the computation starts. Pinning
+  /// prevents the scheduler from migrating the workers across cores and, on
+  /// multi-socket machines, across NUMA nodes, where every access to the
+  /// constituent grids would pay remote-memory stalls. Pinning is a
+  /// process-wide decision: once a computation has requested it, it stays in
+  /// effect for the lifetime of the process.
+  /// @param[in] fast_sincos If true, the sine and cosine terms of the
+  /// harmonic summation are evaluated with a polynomial approximation
+  /// (detail::math::fast_sincos) instead of libm. The approximation is
+  /// accurate to a few ulps of the reduced argument — far below the 1e-9
+  /// relative error tolerated by the tide products — and removes the libm
+  /// calls that dominate the profile of the summation.
+  /// @param[in] single_precision If true, the harmonic summation is evaluated
+  /// in single precision: the summation arrays shrink to half their size and
+  /// each SIMD instruction processes twice as many constituents. The nodal
+  /// corrections are still evaluated in double and rounded once, so the
+  /// error stays on the order of the float epsilon of the tide — ample for
+  /// quick-look products with centimetric accuracy requirements. The flag is
+  /// honoured by fes::evaluate_tide, fes::evaluate_tide_grid and the fixed
+  /// position time series overload; the uniform series recurrence and the
+  /// outer product evaluation keep double precision.
+  /// @param[in] group_by_epoch If true, fes::evaluate_tide groups the input
+  /// indices by epoch before partitioning them across threads. When the
+  /// inputs are sorted by position, consecutive indices jump between epochs
+  /// and the per-worker angle cache governed by <tt>time_tolerance</tt>
+  /// thrashes even if the dataset only spans a few distinct epochs, as in
+  /// crossover analyses. Grouping hands each worker a monotonic sequence of
+  /// epochs, so the angles and the nodal corrections are evaluated once per
+  /// distinct epoch per worker. The results are written at their original
+  /// indices; only the evaluation order changes. Position-derived caches see
+  /// less locality in exchange, so leave the flag off when the dataset spans
+  /// as many epochs as positions.
   /// @warning
   /// The parameter <tt>time_tolerance</tt> allows for the adjustment of
   /// astronomical angle calculations. When its value is set to zero, the angles
@@ -44,10 +88,18 @@ class Settings {
   Settings(const angle::Formulae& astronomic_formulae =
                angle::Formulae::kSchuremanOrder1,
            const double time_tolerance = 0.0,
-           std::vector<fes::Constituent> excluded = {})
+           std::vector<fes::Constituent> excluded = {},
+           const size_t chunk_size = 0, const bool pin_threads = false,
+           const bool fast_sincos = false, const bool single_precision = false,
+           const bool group_by_epoch = false)
       : astronomic_formulae_(astronomic_formulae),
         time_tolerance_(time_tolerance),
-        excluded_(std::move(excluded)) {}
+        excluded_(std::move(excluded)),
+        chunk_size_(chunk_size),
+        pin_threads_(pin_threads),
+        fast_sincos_(fast_sincos),
+        single_precision_(single_precision),
+        group_by_epoch_(group_by_epoch) {}
 
   /// @brief Returns the astronomic formulae used to calculate the astronomic
   /// angles.
@@ -74,6 +126,40 @@ class Settings {
     return excluded_;
   }
 
+  /// @brief Returns the number of indexes claimed at once by a worker thread.
+  ///
+  /// @return The number of indexes claimed at once by a worker thread, or 0
+  /// if the work is split into one static chunk per thread.
+  constexpr auto chunk_size() const noexcept -> size_t { return chunk_size_; }
+
+  /// @brief Returns whether the workers of the thread pool are pinned to one
+  /// CPU each before the computation starts.
+  ///
+  /// @return True if the workers are pinned to one CPU each.
+  constexpr auto pin_threads() const noexcept -> bool { return pin_threads_; }
+
+  /// @brief Returns whether the sine and cosine terms of the harmonic
+  /// summation are evaluated with a polynomial approximation instead of libm.
+  ///
+  /// @return True if the polynomial approximation is used.
+  constexpr auto fast_sincos() const noexcept -> bool { return fast_sincos_; }
+
+  /// @brief Returns whether the harmonic summation is evaluated in single
+  /// precision.
+  ///
+  /// @return True if the harmonic summation is evaluated in single precision.
+  constexpr auto single_precision() const noexcept -> bool {
+    return single_precision_;
+  }
+
+  /// @brief Returns whether the input indices are grouped by epoch before
+  /// being partitioned across threads.
+  ///
+  /// @return True if the input indices are grouped by epoch.
+  constexpr auto group_by_epoch() const noexcept -> bool {
+    return group_by_epoch_;
+  }
+
  private:
   /// @brief Astronomic formulae used to calculate the astronomic angles.
   angle::Formulae astronomic_formulae_;
@@ -82,6 +168,20 @@ class Settings {
   double time_tolerance_;
   /// @brief List of equilibrium long period tidal constituents.
   std::vector<Constituent> excluded_;
+  /// @brief Number of indexes claimed at once by a worker thread (0 for one
+  /// static chunk per thread).
+  size_t chunk_size_;
+  /// @brief True if the workers of the thread pool are pinned to one CPU
+  /// each before the computation starts.
+  bool pin_threads_;
+  /// @brief True if the sine and cosine terms of the harmonic summation are
+  /// evaluated with a polynomial approximation instead of libm.
+  bool fast_sincos_;
+  /// @brief True if the harmonic summation is evaluated in single precision.
+  bool single_precision_;
+  /// @brief True if the input indices are grouped by epoch before being
+  /// partitioned across threads.
+  bool group_by_epoch_;
 };
 
 }  // namespace fes
@@ -5,6 +5,7 @@
 /// @file include/fes/tidal_model/cartesian.hpp
 /// @brief Cartesian tidal model
 #pragma once
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -15,12 +16,86 @@
 #include "fes/axis.hpp"
 #include "fes/detail/grid.hpp"
 #include "fes/detail/isviewstream.hpp"
+#include "fes/detail/mapped_file.hpp"
 #include "fes/detail/serialize.hpp"
+#include "fes/detail/shared_memory.hpp"
 #include "fes/string_view.hpp"
 
 namespace fes {
 namespace tidal_model {
 
+/// @brief A class representing an accelerator for Cartesian tidal models.
+///
+/// This class is used to accelerate the interpolation of Cartesian tidal
+/// models by caching the grid cell selected by the last query: consecutive
+/// points falling in the same cell skip the axis searches and reuse the
+/// corner indices and coordinates. The bilinear weights depend on the query
+/// point itself and are recomputed from the cached corners.
+class CartesianAccelerator : public Accelerator {
+ public:
+  /// Properties of a grid cell.
+  struct Cell {
+    /// Index of the first corner on the longitude axis.
+    int64_t i1{-1};
+    /// Index of the second corner on the longitude axis.
+    int64_t i2{-1};
+    /// Index of the first corner on the latitude axis.
+    int64_t j1{-1};
+    /// Index of the second corner on the latitude axis.
+    int64_t j2{-1};
+    /// Longitude of the first corner.
+    double x1{};
+    /// Longitude of the second corner, normalized around x1.
+    double x2{};
+    /// Latitude of the first corner.
+    double y1{};
+    /// Latitude of the second corner.
+    double y2{};
+  };
+
+  /// Default constructor.
+  /// @param[in] formulae The formulae used to calculate the astronomic angle.
+  /// @param[in] time_tolerance The time in seconds during which astronomical
+  /// angles are considered constant. The default value is 0 seconds, indicating
+  /// that astronomical angles do not remain constant with time.
+  /// @param[in] n_constituents The number of tidal constituents handled by the
+  /// tidal model.
+  CartesianAccelerator(const angle::Formulae& formulae,
+                       const double time_tolerance,
+                       const size_t n_constituents)
+      : Accelerator(formulae, time_tolerance, n_constituents) {}
+
+  /// Default destructor.
+  virtual ~CartesianAccelerator() = default;
+
+  /// Set the selected cell for the accelerator.
+  ///
+  /// @param[in] cell The selected cell.
+  auto set(const Cell& cell) noexcept -> void { cell_ = cell; }
+
+  /// Get the selected cell for the accelerator.
+  ///
+  /// @return The selected cell.
+  auto get() const noexcept -> const Cell& { return cell_; }
+
+  /// Check if a point falls in the cached cell.
+  ///
+  /// @param[in] point The point to check.
+  /// @return True if the point is in the cache, false otherwise.
+  inline auto in_cache(const geometry::Point& point) const -> bool {
+    if (cell_.i1 == -1) {
+      return false;
+    }
+    const auto x = detail::math::normalize_angle(point.lon(), cell_.x1);
+    return x >= cell_.x1 && x <= cell_.x2 && point.lat() >= cell_.y1 &&
+           point.lat() <= cell_.y2;
+  }
+
+ private:
+  /// The cell selected by the last query.
+  Cell cell_{};
+};
+
 /// @brief %Cartesian tidal model.
 ///
 /// @tparam T The type of the tidal model.
@@ -45,25 +120,100 @@ class Cartesian : public AbstractTidalModel<T> {
   /// @param[in] ident The tidal constituent identifier.
   /// @param[in] wave The tidal constituent modelled.
   inline auto add_constituent(const Constituent ident,
-                              Vector<std::complex<T>> wave) -> void override {
+                              DataVector<std::complex<T>> wave)
+      -> void override {
     if (wave.size() != lon_.size() * lat_.size()) {
       throw std::invalid_argument("wave size does not match expected size");
     }
+    // The constituent set changes: a lazily loaded model is materialized and
+    // a quantized one restored to floating-point storage, so the model keeps
+    // a single storage mode.
+    this->materialize();
+    this->dequantize();
     this->data_.emplace(ident, std::move(wave));
+    // The packed buffer no longer matches the constituent set.
+    interleaved_.resize(0);
+    interleaved_idents_.clear();
+  }
+
+  /// @copydoc AbstractTidalModel::quantize
+  auto quantize() -> void override {
+    AbstractTidalModel<T>::quantize();
+    // The packed buffer duplicates the released storage.
+    interleaved_.resize(0);
+    interleaved_idents_.clear();
+  }
+
+  /// Pack the constituent values in an interleaved buffer.
+  ///
+  /// The canonical storage holds one grid per constituent, so one
+  /// interpolation gathers the same four corner cells from as many distant
+  /// arrays as there are constituents. The interleaved layout stores all the
+  /// constituent values of one grid node contiguously (node-major,
+  /// constituent-minor): the four corner reads of a query then touch four
+  /// contiguous runs of memory instead of scattered cache lines. Adding a
+  /// constituent invalidates the packed buffer.
+  auto interleave() -> void {
+    if (this->quantized()) {
+      throw std::invalid_argument(
+          "the interleaved layout is not available for a quantized model");
+    }
+    // The packed buffer duplicates every grid: a lazily loaded model is
+    // materialized first.
+    this->materialize();
+    const auto stride = static_cast<Eigen::Index>(this->data_.size());
+    const auto nodes = lon_.size() * lat_.size();
+    interleaved_idents_.clear();
+    interleaved_idents_.reserve(static_cast<size_t>(stride));
+    interleaved_.resize(stride * nodes);
+    auto jx = Eigen::Index{0};
+    for (const auto& item : this->data_) {
+      interleaved_idents_.push_back(item.first);
+      for (Eigen::Index node = 0; node < nodes; ++node) {
+        interleaved_(node * stride + jx) = item.second(node);
+      }
+      ++jx;
+    }
   }
 
-  /// @brief Returns a null pointer as this tidal model does not use an
-  /// accelerator to speed up the calculation.
+  /// True if interpolate() reads the interleaved layout.
+  inline auto interleaved() const noexcept -> bool {
+    return interleaved_.size() != 0;
+  }
+
+  /// @brief Shrink the model to a geographical bounding box.
+  ///
+  /// Only the axis points covering the box are kept, padded with one point
+  /// on each side so the box boundary remains interpolable, and the
+  /// constituent grids are sliced accordingly. The whole longitude axis is
+  /// kept when the box crosses the axis seam. The packed buffer built by
+  /// interleave(), if any, is invalidated.
+  ///
+  /// @param[in] min_lon The minimum longitude, in degrees, of the box.
+  /// @param[in] max_lon The maximum longitude, in degrees, of the box.
+  /// @param[in] min_lat The minimum latitude, in degrees, of the box.
+  /// @param[in] max_lat The maximum latitude, in degrees, of the box.
+  /// @throw std::invalid_argument if the box is empty or does not intersect
+  /// the model grid.
+  auto crop(double min_lon, double max_lon, double min_lat, double max_lat)
+      -> void;
+
+  /// @brief Create a new instance of the CartesianAccelerator class to speed
+  /// up the interpolation of the tidal model.
+  ///
+  /// The accelerator caches the grid cell selected by the last query, so
+  /// consecutive points falling in the same cell skip the axis searches.
   ///
   /// @param[in] formulae The formulae used to calculate the astronomic angle.
   /// @param[in] time_tolerance The time in seconds during which astronomical
   /// angles are considered constant. The default value is 0 seconds, indicating
   /// that astronomical angles do not remain constant with time.
-  /// @return A null pointer
+  /// @return A pointer to the newly created CartesianAccelerator instance.
   constexpr auto accelerator(const angle::Formulae& formulae,
                              const double time_tolerance) const
       -> Accelerator* override {
-    return new Accelerator(formulae, time_tolerance, this->data_.size());
+    return new CartesianAccelerator(formulae, time_tolerance,
+                                    this->data_.size());
   }
 
   /// Interpolate the tidal model at a given point.
@@ -75,6 +225,54 @@ class Cartesian : public AbstractTidalModel<T> {
   auto interpolate(const geometry::Point& point, Quality& quality,
                    Accelerator* acc) const -> const ConstituentValues& override;
 
+  /// @brief Interpolate the tidal model at a run of points.
+  ///
+  /// The points are processed with a single, non-virtual interpolation loop:
+  /// the dispatch is paid once per run and the cell cached by the accelerator
+  /// is carried from one point to the next, so clustered queries resolve the
+  /// axis lookups once per cell instead of once per point.
+  ///
+  /// @param[in] points The points to interpolate at.
+  /// @param[out] values The interpolated constituents, one row per
+  /// constituent and one column per point. Resized by the call.
+  /// @param[out] quality One flag per point. Resized by the call.
+  /// @param[inout] acc The accelerator to use.
+  auto interpolate_many(const std::vector<geometry::Point>& points,
+                        Matrix<std::complex<double>>& values,
+                        Vector<Quality>& quality, Accelerator* acc) const
+      -> void override;
+
+  /// @brief True if the other model is a Cartesian model defined on the same
+  /// axes: the cell selected for a point is then identical for both models.
+  ///
+  /// @param[in] other The model to compare with.
+  /// @return True if the search results of the two models are
+  /// interchangeable.
+  auto shares_spatial_cache(const AbstractTidalModel<T>& other) const noexcept
+      -> bool override {
+    const auto* cartesian = dynamic_cast<const Cartesian<T>*>(&other);
+    return cartesian != nullptr && lon_ == cartesian->lon_ &&
+           lat_ == cartesian->lat_;
+  }
+
+  /// @brief Seed the cell cache of an accelerator with the cell cached by an
+  /// accelerator of another model defined on the same axes.
+  ///
+  /// @param[in] point The point about to be interpolated.
+  /// @param[in] source The accelerator holding the selected cell.
+  /// @param[inout] target The accelerator to seed.
+  auto seed_spatial_cache(const geometry::Point& point,
+                          const Accelerator& source,
+                          Accelerator* target) const -> void override {
+    const auto& cartesian_source =
+        dynamic_cast<const CartesianAccelerator&>(source);
+    auto* cartesian_target = dynamic_cast<CartesianAccelerator*>(target);
+    if (!cartesian_target->in_cache(point) &&
+        cartesian_source.in_cache(point)) {
+      cartesian_target->set(cartesian_source.get());
+    }
+  }
+
   /// Get the longitude axis.
   ///
   /// @return The longitude axis.
@@ -89,19 +287,89 @@ class Cartesian : public AbstractTidalModel<T> {
   ///
   auto getstate() const -> std::string;
 
+  /// Serialize the tidal model into a stream.
+  ///
+  /// The constituent grids are written directly to the stream: the state is
+  /// never built in memory.
+  ///
+  /// @param[in] ss The stream to write to.
+  auto getstate(std::ostream& ss) const -> void;
+
   /// Deserialize the tidal model.
   ///
   /// @param[in] data The serialized tidal model.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent. The grids of the other constituents are
+  /// skipped in the stream, cutting the load time and the memory footprint:
+  /// the skipped constituents are inferred by admittance during the
+  /// prediction.
   /// @return The tidal model.
-  static auto setstate(const string_view& data) -> Cartesian<T>;
+  static auto setstate(const string_view& data,
+                       const std::vector<Constituent>& wanted = {})
+      -> Cartesian<T>;
+
+  /// Deserialize the tidal model from a stream.
+  ///
+  /// The stream is configured to throw on read failures.
+  ///
+  /// @param[in] ss The stream to read from.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  /// @return The tidal model.
+  static auto setstate(std::istream& ss,
+                       const std::vector<Constituent>& wanted = {})
+      -> Cartesian<T>;
+
+  /// Deserialize the tidal model from a mapped file, reading the constituent
+  /// grids on demand.
+  ///
+  /// Only the axes and the grid properties are read eagerly; the grids stay
+  /// in the mapped file and are faulted in by the first interpolation that
+  /// needs them.
+  ///
+  /// @param[in] file The mapped file holding the serialized model state. The
+  /// model keeps a reference to the mapping.
+  /// @param[in] max_resident The maximum number of grids kept resident: the
+  /// least recently used grids beyond this budget are evicted and faulted in
+  /// again on their next use. 0 keeps every loaded grid resident.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  /// @return The tidal model.
+  static auto setstate(const std::shared_ptr<detail::MappedFile>& file,
+                       std::size_t max_resident,
+                       const std::vector<Constituent>& wanted = {})
+      -> Cartesian<T>;
+
+  /// Deserialize the tidal model from a shared-memory segment, viewing the
+  /// constituent grids in place.
+  ///
+  /// The axes and the grid properties are read eagerly; the grids are not
+  /// copied, they are viewed in the segment, whose pages stay shared with
+  /// the other processes attached to it.
+  ///
+  /// @param[in] segment The segment holding the serialized model state. The
+  /// model keeps a reference to the mapping.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  /// @return The tidal model.
+  static auto setstate(const std::shared_ptr<detail::SharedMemory>& segment,
+                       const std::vector<Constituent>& wanted = {})
+      -> Cartesian<T>;
 
  private:
+  /// Read everything but the constituent map from a stream.
+  static auto setstate_partial(std::istream& ss) -> Cartesian<T>;
+
   /// Whether the data is stored in longitude-major order.
   bool row_major_;
   /// Longitude axis.
   Axis lon_;
   /// Latitude axis.
   Axis lat_;
+  /// Interleaved constituent values (node-major, constituent-minor).
+  Vector<std::complex<T>> interleaved_{};
+  /// Identifiers of the packed constituents, in storage order.
+  std::vector<Constituent> interleaved_idents_{};
 };
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -109,47 +377,99 @@ template <typename T>
 auto Cartesian<T>::interpolate(const geometry::Point& point, Quality& quality,
                                Accelerator* acc) const
     -> const ConstituentValues& {
+  auto* cartesian_acc = reinterpret_cast<CartesianAccelerator*>(acc);
   // Remove all previous values interpolated.
-  acc->clear();
-  // Find the nearest point in the grid
-  auto lon_index = lon_.find_indices(point.lon());
-  auto lat_index = lat_.find_indices(point.lat());
+  cartesian_acc->clear();
 
-  if (!lon_index || !lat_index) {
-    for (const auto& item : this->data_) {
-      acc->emplace_back(
-          item.first,
-          std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
-                               std::numeric_limits<double>::quiet_NaN()));
+  auto& counters = cartesian_acc->counters();
+
+  // The axis searches are skipped when the point falls in the cell selected
+  // by the last query.
+  if (!cartesian_acc->in_cache(point)) {
+    ++counters.interpolation_cache_misses;
+    ++counters.searches;
+    // Find the nearest point in the grid
+    auto lon_index = lon_.find_indices(point.lon());
+    auto lat_index = lat_.find_indices(point.lat());
+
+    if (!lon_index || !lat_index) {
+      ++counters.undefined;
+      for (const auto& item : this->data_) {
+        cartesian_acc->emplace_back(
+            item.first,
+            std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
+                                 std::numeric_limits<double>::quiet_NaN()));
+      }
+      quality = Quality::kUndefined;
+      return cartesian_acc->values();
     }
-    quality = Quality::kUndefined;
-    return acc->values();
-  }
-  int64_t i1;
-  int64_t i2;
-  int64_t j1;
-  int64_t j2;
-  std::tie(i1, i2) = *lon_index;
-  std::tie(j1, j2) = *lat_index;
-  const auto x1 = lon_(i1);
-  const auto x2 = lon_(i2);
-  const auto y1 = lat_(j1);
-  const auto y2 = lat_(j2);
+    auto cell = CartesianAccelerator::Cell();
+    std::tie(cell.i1, cell.i2) = *lon_index;
+    std::tie(cell.j1, cell.j2) = *lat_index;
+    cell.x1 = lon_(cell.i1);
+    cell.x2 = detail::math::normalize_angle(lon_(cell.i2), cell.x1);
+    cell.y1 = lat_(cell.j1);
+    cell.y2 = lat_(cell.j2);
+    cartesian_acc->set(cell);
+  } else {
+    ++counters.interpolation_cache_hits;
+  }
+  // Grids read on demand are loaded before the first access. Out of range
+  // queries return before this point without faulting anything in.
+  this->fault_in();
+
+  const auto& cell = cartesian_acc->get();
+  const auto i1 = cell.i1;
+  const auto i2 = cell.i2;
+  const auto j1 = cell.j1;
+  const auto j2 = cell.j2;
   auto n = int64_t{0};
 
+  // The bilinear weights depend on the query point and are recomputed from
+  // the cached corners.
   auto wxy = detail::math::bilinear_weights(
-      detail::math::normalize_angle(point.lon(), x1), point.lat(), x1, y1,
-      detail::math::normalize_angle(x2, x1), y2);
+      detail::math::normalize_angle(point.lon(), cell.x1), point.lat(),
+      cell.x1, cell.y1, cell.x2, cell.y2);
 
   auto grid = detail::Grid<std::complex<T>>(
       nullptr, static_cast<size_t>(lon_.size()),
       static_cast<size_t>(lat_.size()), row_major_);
-  for (const auto& item : this->data_) {
-    grid.data(item.second.data());
-    auto value = detail::math::bilinear_interpolation<std::complex<double>>(
-        std::get<0>(wxy), std::get<1>(wxy), std::get<2>(wxy), std::get<3>(wxy),
-        grid(i1, j1), grid(i1, j2), grid(i2, j1), grid(i2, j2), n);
-    acc->emplace_back(item.first, value);
+  if (interleaved_.size() != 0) {
+    // All the constituent values of one node are contiguous: the query reads
+    // four contiguous runs instead of four cells per constituent grid.
+    const auto stride = static_cast<Eigen::Index>(interleaved_idents_.size());
+    const auto* z11 = interleaved_.data() + grid.index(i1, j1) * stride;
+    const auto* z12 = interleaved_.data() + grid.index(i1, j2) * stride;
+    const auto* z21 = interleaved_.data() + grid.index(i2, j1) * stride;
+    const auto* z22 = interleaved_.data() + grid.index(i2, j2) * stride;
+    for (Eigen::Index kx = 0; kx < stride; ++kx) {
+      auto value = detail::math::bilinear_interpolation<std::complex<double>>(
+          std::get<0>(wxy), std::get<1>(wxy), std::get<2>(wxy),
+          std::get<3>(wxy), z11[kx], z12[kx], z21[kx], z22[kx], n);
+      cartesian_acc->emplace_back(interleaved_idents_[kx], value);
+    }
+  } else if (this->quantized()) {
+    // The 16-bit samples are widened on the fly: only the four corner cells
+    // of the query are dequantized.
+    for (const auto& item : this->quantized_) {
+      const auto& wave = item.second;
+      auto value = detail::math::bilinear_interpolation<std::complex<double>>(
+          std::get<0>(wxy), std::get<1>(wxy), std::get<2>(wxy),
+          std::get<3>(wxy), wave.dequantize(grid.index(i1, j1)),
+          wave.dequantize(grid.index(i1, j2)),
+          wave.dequantize(grid.index(i2, j1)),
+          wave.dequantize(grid.index(i2, j2)), n);
+      cartesian_acc->emplace_back(item.first, value);
+    }
+  } else {
+    for (const auto& item : this->data_) {
+      grid.data(item.second.data());
+      auto value = detail::math::bilinear_interpolation<std::complex<double>>(
+          std::get<0>(wxy), std::get<1>(wxy), std::get<2>(wxy),
+          std::get<3>(wxy), grid(i1, j1), grid(i1, j2), grid(i2, j1),
+          grid(i2, j2), n);
+      cartesian_acc->emplace_back(item.first, value);
+    }
   }
 
   quality = (n == 4)   ? Quality::kInterpolated
@@ -157,40 +477,222 @@ auto Cartesian<T>::interpolate(const geometry::Point& point, Quality& quality,
             : (n == 2) ? Quality::kExtrapolated2
             : (n == 1) ? Quality::kExtrapolated1
                        : Quality::kUndefined;
-  return acc->values();
+  if (n != 4) {
+    ++(n == 0 ? counters.undefined : counters.extrapolations);
+  }
+  return cartesian_acc->values();
 }
 
 template <typename T>
-auto Cartesian<T>::getstate() const -> std::string {
-  auto ss = std::stringstream();
-  ss.exceptions(std::stringstream::failbit);
+auto Cartesian<T>::interpolate_many(const std::vector<geometry::Point>& points,
+                                    Matrix<std::complex<double>>& values,
+                                    Vector<Quality>& quality,
+                                    Accelerator* acc) const -> void {
+  if (acc->bound()) {
+    throw std::invalid_argument(
+        "interpolate_many requires an accelerator that is not bound to a "
+        "wave table");
+  }
+  const auto size = static_cast<Eigen::Index>(points.size());
+  values.resize(static_cast<Eigen::Index>(this->data_.size()), size);
+  quality.resize(size);
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    auto flag = Quality();
+    // The qualified call skips the per-point virtual dispatch; the cell
+    // cached by the accelerator survives from one iteration to the next.
+    const auto& interpolated =
+        Cartesian<T>::interpolate(points[static_cast<size_t>(ix)], flag, acc);
+    quality(ix) = flag;
+    for (Eigen::Index jx = 0; jx < values.rows(); ++jx) {
+      values(jx, ix) = interpolated[static_cast<size_t>(jx)].second;
+    }
+  }
+}
+
+template <typename T>
+auto Cartesian<T>::crop(const double min_lon, const double max_lon,
+                        const double min_lat, const double max_lat) -> void {
+  if (min_lon > max_lon || min_lat > max_lat) {
+    throw std::invalid_argument(
+        "the minimum corner of the bounding box must not exceed the maximum "
+        "corner");
+  }
+  // The grids are rewritten: a lazily loaded model is materialized first.
+  this->materialize();
+  // Indices of the axis points covering an interval, padded with one point on
+  // each side so the interval boundary remains interpolable.
+  auto axis_range = [](const Axis& axis, const double min_value,
+                       const double max_value,
+                       const bool circular) -> std::pair<int64_t, int64_t> {
+    auto first = int64_t{-1};
+    auto last = int64_t{-1};
+    for (int64_t ix = 0; ix < axis.size(); ++ix) {
+      auto value = axis(ix);
+      if (circular) {
+        value = detail::math::normalize_angle(value, min_value);
+      }
+      if (value >= min_value && value <= max_value) {
+        if (first == -1) {
+          first = ix;
+        } else if (ix != last + 1) {
+          // The selection wraps around the axis seam: keep the whole axis.
+          return {0, axis.size() - 1};
+        }
+        last = ix;
+      }
+    }
+    if (first == -1) {
+      throw std::invalid_argument(
+          "the bounding box does not intersect the model grid");
+    }
+    return {std::max<int64_t>(first - 1, 0),
+            std::min<int64_t>(last + 1, axis.size() - 1)};
+  };
+  const auto lon_range = axis_range(lon_, min_lon, max_lon, lon_.is_circular());
+  const auto lat_range = axis_range(lat_, min_lat, max_lat, false);
+  const auto ni = lon_range.second - lon_range.first + 1;
+  const auto nj = lat_range.second - lat_range.first + 1;
+  if (ni == lon_.size() && nj == lat_.size()) {
+    return;
+  }
+  // The grids are sliced in floating-point storage; the quantization, if
+  // any, is rebuilt on the cropped grids.
+  const auto was_quantized = this->quantized();
+  this->dequantize();
+  auto lon_points = Eigen::VectorXd(ni);
+  for (Eigen::Index ix = 0; ix < ni; ++ix) {
+    lon_points(ix) = lon_(lon_range.first + ix);
+  }
+  auto lat_points = Eigen::VectorXd(nj);
+  for (Eigen::Index jx = 0; jx < nj; ++jx) {
+    lat_points(jx) = lat_(lat_range.first + jx);
+  }
+  const auto source = detail::Grid<std::complex<T>>(
+      nullptr, static_cast<size_t>(lon_.size()),
+      static_cast<size_t>(lat_.size()), row_major_);
+  const auto target =
+      detail::Grid<std::complex<T>>(nullptr, static_cast<size_t>(ni),
+                                    static_cast<size_t>(nj), row_major_);
+  auto data = ConstituentMap<DataVector<std::complex<T>>>();
+  for (const auto& item : this->data_) {
+    auto wave = Vector<std::complex<T>>(ni * nj);
+    for (Eigen::Index ix = 0; ix < ni; ++ix) {
+      for (Eigen::Index jx = 0; jx < nj; ++jx) {
+        wave(target.index(ix, jx)) = item.second(
+            source.index(lon_range.first + ix, lat_range.first + jx));
+      }
+    }
+    data.emplace(item.first, std::move(wave));
+  }
+  lon_ = Axis(lon_points, 1e-6, lon_.is_circular());
+  lat_ = Axis(lat_points, 1e-6, lat_.is_circular());
+  this->data_ = std::move(data);
+  // The packed buffer no longer matches the grid.
+  interleaved_.resize(0);
+  interleaved_idents_.clear();
+  if (was_quantized) {
+    this->quantize();
+  }
+}
+
+template <typename T>
+auto Cartesian<T>::getstate(std::ostream& ss) const -> void {
+  // The state holds every constituent: the grids of a lazily loaded model
+  // are faulted in first.
+  this->fault_in();
   detail::serialize::write_data(ss, row_major_);
   detail::serialize::write_string(ss, lon_.getstate());
   detail::serialize::write_string(ss, lat_.getstate());
   detail::serialize::write_data(ss, this->tide_type_);
-  detail::serialize::write_constituent_map(ss, this->data_);
-  return ss.str();
+  // A quantized model is serialized with the same layout as an unquantized
+  // one, carrying the quantization error.
+  this->quantized()
+      ? detail::serialize::write_constituent_map(ss, this->dequantized_data())
+      : detail::serialize::write_constituent_map(ss, this->data_);
 }
 
 template <typename T>
-auto Cartesian<T>::setstate(const string_view& data) -> Cartesian<T> {
-  detail::isviewstream ss(data);
+auto Cartesian<T>::getstate() const -> std::string {
+  auto ss = std::stringstream();
   ss.exceptions(std::stringstream::failbit);
+  getstate(ss);
+  return ss.str();
+}
+
+template <typename T>
+auto Cartesian<T>::setstate_partial(std::istream& ss) -> Cartesian<T> {
+  auto row_major = detail::serialize::read_data<bool>(ss);
+  // The axis states are length-prefixed.
+  detail::serialize::read_data<size_t>(ss);
+  auto lon = Axis::setstate(ss);
+  detail::serialize::read_data<size_t>(ss);
+  auto lat = Axis::setstate(ss);
+  auto tide_type = detail::serialize::read_data<TideType>(ss);
+  return Cartesian<T>(std::move(lon), std::move(lat), tide_type, row_major);
+}
+
+template <typename T>
+auto Cartesian<T>::setstate(std::istream& ss,
+                            const std::vector<Constituent>& wanted)
+    -> Cartesian<T> {
+  ss.exceptions(std::istream::failbit);
   try {
-    auto row_major = detail::serialize::read_data<bool>(ss);
-    auto lon = Axis::setstate(detail::serialize::read_string(ss));
-    auto lat = Axis::setstate(detail::serialize::read_string(ss));
-    auto tide_type = detail::serialize::read_data<TideType>(ss);
-    auto model =
-        Cartesian<T>(std::move(lon), std::move(lat), tide_type, row_major);
-    model.data_ =
-        detail::serialize::read_constituent_map<Constituent, std::complex<T>>(
-            ss);
+    auto model = setstate_partial(ss);
+    model.data_ = detail::serialize::read_constituent_map<
+        ConstituentMap<DataVector<std::complex<T>>>>(ss, wanted);
     return model;
   } catch (const std::exception&) {
     throw std::invalid_argument("invalid tidal model state");
   }
 }
 
+template <typename T>
+auto Cartesian<T>::setstate(const std::shared_ptr<detail::MappedFile>& file,
+                            const std::size_t max_resident,
+                            const std::vector<Constituent>& wanted)
+    -> Cartesian<T> {
+  detail::isviewstream ss(file->view());
+  ss.exceptions(std::istream::failbit);
+  try {
+    auto model = setstate_partial(ss);
+    // The constituent map is scanned, not read: only the byte offsets of the
+    // grids are kept.
+    model.attach_backing(
+        file,
+        detail::serialize::scan_constituent_map<
+            ConstituentMap<DataVector<std::complex<T>>>>(ss, wanted),
+        max_resident);
+    return model;
+  } catch (const std::exception&) {
+    throw std::invalid_argument("invalid tidal model state");
+  }
+}
+
+template <typename T>
+auto Cartesian<T>::setstate(const std::shared_ptr<detail::SharedMemory>& segment,
+                            const std::vector<Constituent>& wanted)
+    -> Cartesian<T> {
+  detail::isviewstream ss(segment->view());
+  ss.exceptions(std::istream::failbit);
+  try {
+    auto model = setstate_partial(ss);
+    // The grids are viewed in place in the segment: no sample is copied and
+    // the pages stay shared with the other processes attached to it.
+    model.data_ = detail::serialize::view_constituent_map<
+        ConstituentMap<DataVector<std::complex<T>>>>(ss, segment, wanted);
+    return model;
+  } catch (const std::exception&) {
+    throw std::invalid_argument("invalid tidal model state");
+  }
+}
+
+template <typename T>
+auto Cartesian<T>::setstate(const string_view& data,
+                            const std::vector<Constituent>& wanted)
+    -> Cartesian<T> {
+  detail::isviewstream ss(data);
+  return setstate(ss, wanted);
+}
+
 }  // namespace tidal_model
 }  // namespace fes
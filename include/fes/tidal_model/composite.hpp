@@ -0,0 +1,217 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/tidal_model/composite.hpp
+/// @brief Composite tidal model.
+#pragma once
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fes/abstract_tidal_model.hpp"
+
+namespace fes {
+namespace tidal_model {
+
+/// @brief A class representing an accelerator for composite tidal models.
+///
+/// It holds one accelerator per member model, so that each member keeps its
+/// own interpolation cache while the astronomic angle is cached once.
+class CompositeAccelerator : public Accelerator {
+ public:
+  /// Default constructor.
+  /// @param[in] formulae The formulae used to calculate the astronomic angle.
+  /// @param[in] time_tolerance The time in seconds during which astronomical
+  /// angles are considered constant. The default value is 0 seconds, indicating
+  /// that astronomical angles do not remain constant with time.
+  /// @param[in] n_constituents The number of tidal constituents handled by the
+  /// tidal model.
+  CompositeAccelerator(const angle::Formulae& formulae,
+                       const double time_tolerance,
+                       const size_t n_constituents)
+      : Accelerator(formulae, time_tolerance, n_constituents) {}
+
+  /// Default destructor.
+  virtual ~CompositeAccelerator() = default;
+
+  using Accelerator::emplace_back;
+
+  /// Append the accelerator of a member model.
+  ///
+  /// @param[in] child The accelerator, owned by this instance.
+  auto emplace_back(Accelerator* child) -> void {
+    children_.emplace_back(child);
+  }
+
+  /// Get the accelerator of a member model.
+  ///
+  /// @param[in] ix The index of the member model.
+  /// @return The accelerator of the member model.
+  inline auto child(const size_t ix) const -> Accelerator* {
+    return children_[ix].get();
+  }
+
+  /// @brief A composite accelerator declines the direct-write binding.
+  ///
+  /// The cascade arbitrates between the member results after the fact: an
+  /// extrapolating member is kept as a fallback while the later members are
+  /// tried, so the per-member value buffers must survive until the winner
+  /// is known. The values are copied into the wave table by the
+  /// table-filling overload, as for an unbound accelerator.
+  auto bind(wave::Table& /*wave_table*/) -> void override {}
+
+ private:
+  /// The accelerators of the member models.
+  std::vector<std::unique_ptr<Accelerator>> children_{};
+};
+
+/// @brief Cascade of tidal models evaluated in priority order.
+///
+/// Hold an ordered list of models — typically a regional high-resolution
+/// model followed by a global one. Each query is answered by the first model
+/// defining the point; a model that only extrapolates the point is kept as a
+/// fallback, but a later model interpolating it properly wins. The whole
+/// cascade shares one wave table, one astronomic angle cache and one output
+/// pass, so overlaying a regional model no longer costs a second evaluation
+/// and a merge.
+///
+/// @tparam T The type of tidal constituents modelled.
+template <typename T>
+class Composite : public AbstractTidalModel<T> {
+ public:
+  /// Build a composite tidal model.
+  ///
+  /// @param[in] models The member models, ordered from the highest to the
+  /// lowest priority. They must handle the same tide type and the same
+  /// constituent set, so that one wave table covers every member.
+  explicit Composite(
+      std::vector<std::shared_ptr<const AbstractTidalModel<T>>> models)
+      : AbstractTidalModel<T>(), models_(std::move(models)) {
+    if (models_.empty()) {
+      throw std::invalid_argument(
+          "a composite model requires at least one member model");
+    }
+    this->tide_type_ = models_.front()->tide_type();
+    this->dynamic_ = models_.front()->dynamic();
+    for (const auto& model : models_) {
+      if (model == nullptr) {
+        throw std::invalid_argument("member models must not be null");
+      }
+      if (model->tide_type() != this->tide_type_) {
+        throw std::invalid_argument(
+            "member models must handle the same tide type");
+      }
+      if (model->identifiers() != models_.front()->identifiers()) {
+        throw std::invalid_argument(
+            "member models must handle the same constituent set");
+      }
+    }
+    // The constituent set is exposed through placeholder entries, like a
+    // quantized model does: the samples stay in the member models.
+    for (const auto ident : models_.front()->identifiers()) {
+      this->data_.emplace(ident, DataVector<std::complex<T>>());
+    }
+  }
+
+  /// Default destructor.
+  virtual ~Composite() override = default;
+
+  /// A composite model does not store samples itself.
+  ///
+  /// @throw std::invalid_argument always: constituents are added to the
+  /// member models.
+  auto add_constituent(const Constituent /*ident*/,
+                       DataVector<std::complex<T>> /*wave*/) -> void override {
+    throw std::invalid_argument(
+        "a composite model is read-only; add constituents to its member "
+        "models");
+  }
+
+  /// @brief Create a new instance of the CompositeAccelerator class, holding
+  /// one accelerator per member model.
+  ///
+  /// @param[in] formulae The formulae used to calculate the astronomic angle.
+  /// @param[in] time_tolerance The time in seconds during which astronomical
+  /// angles are considered constant.
+  /// @return A pointer to the newly created CompositeAccelerator instance.
+  auto accelerator(const angle::Formulae& formulae,
+                   const double time_tolerance) const -> Accelerator* override {
+    auto result = std::unique_ptr<CompositeAccelerator>(
+        new CompositeAccelerator(formulae, time_tolerance,
+                                 this->data_.size()));
+    for (const auto& model : models_) {
+      result->emplace_back(model->accelerator(formulae, time_tolerance));
+    }
+    return result.release();
+  }
+
+  /// @brief Interpolate the tidal constituents at a given point.
+  ///
+  /// The member models are tried in priority order: the first one
+  /// interpolating the point answers the query. A member that only
+  /// extrapolates the point is remembered and used when no later member
+  /// interpolates it.
+  ///
+  /// @param[in] point The point to interpolate at.
+  /// @param[out] quality A flag indicating if the point was extrapolated,
+  /// interpolated or if the model is undefined.
+  /// @param[inout] acc The accelerator to use.
+  /// @return A list of interpolated tidal constituents.
+  auto interpolate(const geometry::Point& point, Quality& quality,
+                   Accelerator* acc) const -> const ConstituentValues& override;
+
+  /// Get the member models, ordered from the highest to the lowest priority.
+  constexpr auto models() const
+      -> const std::vector<std::shared_ptr<const AbstractTidalModel<T>>>& {
+    return models_;
+  }
+
+ private:
+  /// The member models, ordered from the highest to the lowest priority.
+  std::vector<std::shared_ptr<const AbstractTidalModel<T>>> models_;
+};
+
+// /////////////////////////////////////////////////////////////////////////////
+template <typename T>
+auto Composite<T>::interpolate(const geometry::Point& point, Quality& quality,
+                               Accelerator* acc) const
+    -> const ConstituentValues& {
+  auto* composite_acc = reinterpret_cast<CompositeAccelerator*>(acc);
+
+  const ConstituentValues* fallback = nullptr;
+  auto fallback_quality = Quality::kUndefined;
+
+  for (size_t ix = 0; ix < models_.size(); ++ix) {
+    auto* child = composite_acc->child(ix);
+    const auto& values = models_[ix]->interpolate(point, quality, child);
+    if (quality == Quality::kInterpolated) {
+      return values;
+    }
+    if (quality != Quality::kUndefined && fallback == nullptr) {
+      // The member only extrapolates the point: a later member may still
+      // interpolate it properly.
+      fallback = &values;
+      fallback_quality = quality;
+    }
+  }
+  if (fallback != nullptr) {
+    quality = fallback_quality;
+    return *fallback;
+  }
+  quality = Quality::kUndefined;
+  composite_acc->clear();
+  for (const auto& item : this->data_) {
+    composite_acc->emplace_back(
+        item.first,
+        std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
+                             std::numeric_limits<double>::quiet_NaN()));
+  }
+  return composite_acc->values();
+}
+
+}  // namespace tidal_model
+}  // namespace fes
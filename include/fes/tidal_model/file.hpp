@@ -0,0 +1,158 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/tidal_model/file.hpp
+/// @brief Persistence of tidal models on disk.
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fes/constituent.hpp"
+#include "fes/detail/mapped_file.hpp"
+#include "fes/detail/oviewstream.hpp"
+#include "fes/detail/shared_memory.hpp"
+
+namespace fes {
+namespace tidal_model {
+
+/// @brief Write the serialized state of a tidal model to a file.
+///
+/// The file holds the bytes produced by the getstate() method of the model
+/// and is read back with load(). The state is streamed to the file: it is
+/// never built in memory.
+///
+/// @tparam Model The concrete type of the tidal model.
+/// @param[in] model The tidal model to save.
+/// @param[in] path The path of the file written.
+/// @throw std::invalid_argument if the file cannot be written.
+template <typename Model>
+auto save(const Model& model, const std::string& path) -> void {
+  auto stream = std::ofstream(path, std::ios::binary | std::ios::trunc);
+  if (!stream) {
+    throw std::invalid_argument("unable to write file: " + path);
+  }
+  model.getstate(stream);
+  if (!stream) {
+    throw std::invalid_argument("unable to write file: " + path);
+  }
+}
+
+/// @brief Load a tidal model saved with save().
+///
+/// The file is mapped in memory and the state is parsed directly from the
+/// mapped pages: the file is never materialized a second time in memory,
+/// its pages are loaded lazily by the kernel and shared read-only between
+/// the processes loading the same model.
+///
+/// @tparam Model The concrete type of the tidal model.
+/// @param[in] path The path of the file to load.
+/// @param[in] wanted The identifiers of the constituents to load; an empty
+/// list loads every constituent. The other constituents are skipped in the
+/// file, cutting the load time and the memory footprint: they are inferred
+/// by admittance during the prediction.
+/// @return The tidal model.
+/// @throw std::invalid_argument if the file cannot be opened or does not
+/// hold a valid model state.
+template <typename Model>
+auto load(const std::string& path,
+          const std::vector<Constituent>& wanted = {}) -> Model {
+  const auto file = detail::MappedFile(path);
+  return Model::setstate(file.view(), wanted);
+}
+
+/// @brief Load a tidal model saved with save(), reading its constituents on
+/// demand.
+///
+/// Only the geometry of the model is read eagerly, so the model is usable in
+/// a fraction of the time and of the memory taken by load(): the constituent
+/// grids stay in the mapped file and are faulted in by the first
+/// interpolation that needs them.
+///
+/// @tparam Model The concrete type of the tidal model.
+/// @param[in] path The path of the file to load. The model keeps the file
+/// mapped for its whole lifetime.
+/// @param[in] max_resident The maximum number of constituent grids kept
+/// resident: the least recently used grids beyond this budget are evicted and
+/// faulted in again on their next use. 0 keeps every loaded grid resident.
+/// @param[in] wanted The identifiers of the constituents to load; an empty
+/// list loads every constituent.
+/// @return The tidal model.
+/// @throw std::invalid_argument if the file cannot be opened or does not
+/// hold a valid model state.
+template <typename Model>
+auto lazy_load(const std::string& path, const std::size_t max_resident = 0,
+               const std::vector<Constituent>& wanted = {}) -> Model {
+  return Model::setstate(std::make_shared<detail::MappedFile>(path),
+                         max_resident, wanted);
+}
+
+/// @brief Place the serialized state of a tidal model in a named
+/// shared-memory segment.
+///
+/// The segment holds the bytes produced by the getstate() method of the
+/// model and is attached with attach(). It persists after the publishing
+/// process exits, until unpublish() removes it: on a node running several
+/// worker processes, one worker publishes the model and the others attach
+/// it without loading or copying anything. The state is streamed into the
+/// segment: it is never built a second time in memory.
+///
+/// @tparam Model The concrete type of the tidal model.
+/// @param[in] model The tidal model to publish.
+/// @param[in] name The name of the segment; must start with a slash.
+/// @throw std::invalid_argument if the segment cannot be created.
+template <typename Model>
+auto publish(const Model& model, const std::string& name) -> void {
+  // A first pass over the state counts its bytes, a second one streams them
+  // into the segment.
+  detail::ocountstream counter;
+  model.getstate(counter);
+  auto segment = detail::SharedMemory(
+      name, static_cast<std::size_t>(counter.count()));
+  detail::oviewstream stream(segment.data(), segment.size());
+  model.getstate(stream);
+  if (!stream) {
+    throw std::invalid_argument("unable to write shared memory segment: " +
+                                name);
+  }
+}
+
+/// @brief Attach a tidal model published with publish().
+///
+/// Only the geometry of the model is read; the constituent values are viewed
+/// in place in the segment, so the model costs no memory beyond its geometry
+/// and the segment pages, which are shared between all the processes
+/// attached to it.
+///
+/// @tparam Model The concrete type of the tidal model.
+/// @param[in] name The name of the segment; must start with a slash. The
+/// model keeps the segment mapped for its whole lifetime.
+/// @param[in] wanted The identifiers of the constituents to load; an empty
+/// list loads every constituent.
+/// @return The tidal model.
+/// @throw std::invalid_argument if the segment cannot be opened or does not
+/// hold a valid model state.
+template <typename Model>
+auto attach(const std::string& name,
+            const std::vector<Constituent>& wanted = {}) -> Model {
+  return Model::setstate(
+      std::make_shared<detail::SharedMemory>(detail::SharedMemory(name)),
+      wanted);
+}
+
+/// @brief Remove a segment created by publish().
+///
+/// The models attached to the segment remain valid; the name becomes
+/// available again. Removing a segment that does not exist is a no-op.
+///
+/// @param[in] name The name of the segment; must start with a slash.
+inline auto unpublish(const std::string& name) -> void {
+  detail::SharedMemory::unlink(name);
+}
+
+}  // namespace tidal_model
+}  // namespace fes
@@ -17,7 +17,11 @@
 
 #include "fes/abstract_tidal_model.hpp"
 #include "fes/detail/isviewstream.hpp"
+#include "fes/detail/mapped_file.hpp"
+#include "fes/detail/math.hpp"
 #include "fes/detail/serialize.hpp"
+#include "fes/detail/shared_memory.hpp"
+#include "fes/detail/trace.hpp"
 #include "fes/eigen.hpp"
 #include "fes/mesh/index.hpp"
 #include "fes/string_view.hpp"
@@ -51,6 +55,8 @@ class LGPAccelerator : public Accelerator {
   /// @param[in] triangle The selected triangle.
   auto set(fes::mesh::SelectedTriangle&& triangle) -> void {
     selected_ = triangle;
+    // The quantities derived from the previous triangle are stale.
+    position_valid_ = false;
   }
 
   /// Reset the point of the selected triangle.
@@ -76,9 +82,58 @@ class LGPAccelerator : public Accelerator {
            selected_.triangle.covered_by(point);
   }
 
+  /// Check if a point is bit-identical to the last interpolated position.
+  ///
+  /// A fixed-station time series queries the same position over and over:
+  /// when it matches, the selected triangle, the vertex test and the beta
+  /// coefficients cached by the last interpolation are all reusable.
+  ///
+  /// @param[in] point The point to check.
+  /// @return True if the position-derived cache applies to the point.
+  inline auto same_position(const geometry::Point& point) const -> bool {
+    return position_valid_ && cached_position_.lon() == point.lon() &&
+           cached_position_.lat() == point.lat();
+  }
+
+  /// Cache the quantities derived from the interpolated position.
+  ///
+  /// @param[in] point The interpolated position.
+  /// @param[in] vertex_id The vertex matching the position, or -1.
+  inline auto cache_position(const geometry::Point& point,
+                             const int vertex_id) -> void {
+    cached_position_ = point;
+    cached_vertex_ = vertex_id;
+    position_valid_ = true;
+  }
+
+  /// Get the vertex matching the cached position, or -1.
+  inline auto cached_vertex() const noexcept -> int { return cached_vertex_; }
+
+  /// Get the beta coefficients of the cached position.
+  inline auto cached_beta() noexcept -> Eigen::VectorXd& {
+    return cached_beta_;
+  }
+
+  /// Get the beta coefficients of the cached position.
+  inline auto cached_beta() const noexcept -> const Eigen::VectorXd& {
+    return cached_beta_;
+  }
+
  private:
   /// The selected triangle for the accelerator.
   mesh::SelectedTriangle selected_{};
+
+  /// The last interpolated position.
+  geometry::Point cached_position_{};
+
+  /// The beta coefficients of the last interpolated position.
+  Eigen::VectorXd cached_beta_{};
+
+  /// The vertex matching the last interpolated position, or -1.
+  int cached_vertex_{-1};
+
+  /// True when the position-derived cache is usable.
+  bool position_valid_{false};
 };
 
 /// @brief %LGP tidal models.
@@ -113,7 +168,8 @@ class LGP : public fes::AbstractTidalModel<T> {
   /// @param[in] ident The wave model identifier.
   /// @param[in] wave The wave model.
   inline auto add_constituent(const Constituent ident,
-                              Vector<std::complex<T>> wave) -> void override {
+                              DataVector<std::complex<T>> wave)
+      -> void override {
     // wave is a vector of values for each LGP codes. The number of values must
     // match the number of LGP codes handled by this instance.
     if (expected_data_size_ != wave.size()) {
@@ -121,7 +177,59 @@ class LGP : public fes::AbstractTidalModel<T> {
                                   std::to_string(wave.size()) +
                                   " != " + std::to_string(expected_data_size_));
     }
+    // The constituent set changes: a lazily loaded model is materialized and
+    // a quantized one restored to floating-point storage, so the model keeps
+    // a single storage mode.
+    this->materialize();
+    this->dequantize();
     this->data_.emplace(ident, std::move(wave));
+    // The packed matrix no longer matches the constituent set.
+    interleaved_.resize(0, 0);
+    interleaved_idents_.clear();
+  }
+
+  /// @copydoc AbstractTidalModel::quantize
+  auto quantize() -> void override {
+    AbstractTidalModel<T>::quantize();
+    // The packed matrix duplicates the released storage.
+    interleaved_.resize(0, 0);
+    interleaved_idents_.clear();
+  }
+
+  /// Pack the wave models in an interleaved matrix.
+  ///
+  /// The canonical storage holds one vector per constituent, so one query
+  /// gathers the N*3 codes of the selected triangle from as many distant
+  /// arrays as there are constituents. The interleaved layout stores all the
+  /// constituent values of one %LGP code contiguously (code-major,
+  /// constituent-minor): a query then streams N*3 contiguous rows and
+  /// combines them with the beta coefficients in a single product. Adding a
+  /// constituent invalidates the packed matrix.
+  auto interleave() -> void {
+    if (this->quantized()) {
+      throw std::invalid_argument(
+          "the interleaved layout is not available for a quantized model");
+    }
+    // The packed matrix duplicates every wave model: a lazily loaded model
+    // is materialized first.
+    this->materialize();
+    const auto stride = static_cast<Eigen::Index>(this->data_.size());
+    interleaved_idents_.clear();
+    interleaved_idents_.reserve(static_cast<size_t>(stride));
+    interleaved_.resize(expected_data_size_, stride);
+    auto jx = Eigen::Index{0};
+    for (const auto& item : this->data_) {
+      interleaved_idents_.push_back(item.first);
+      for (Eigen::Index code = 0; code < expected_data_size_; ++code) {
+        interleaved_(code, jx) = item.second(code);
+      }
+      ++jx;
+    }
+  }
+
+  /// True if interpolate() reads the interleaved layout.
+  inline auto interleaved() const noexcept -> bool {
+    return interleaved_.size() != 0;
   }
 
   /// @brief Create a new instance of the LGPAccelerator class to speed up the
@@ -151,6 +259,59 @@ class LGP : public fes::AbstractTidalModel<T> {
   auto interpolate(const geometry::Point& point, Quality& quality,
                    Accelerator* acc) const -> const ConstituentValues& override;
 
+  /// @brief Interpolate the wave models loaded at a run of points.
+  ///
+  /// The triangles of the whole run are located with a single batch search:
+  /// the queries are processed along a space-filling curve and each one is
+  /// warm-started from the triangle found for the previous one. Each result
+  /// then seeds the accelerator cache before the per-point interpolation.
+  ///
+  /// @param[in] points The points to interpolate at.
+  /// @param[out] values The interpolated constituents, one row per
+  /// constituent and one column per point. Resized by the call.
+  /// @param[out] quality One flag per point. Resized by the call.
+  /// @param[inout] acc An accelerator to speed up the calculation.
+  auto interpolate_many(const std::vector<geometry::Point>& points,
+                        Matrix<std::complex<double>>& values,
+                        Vector<Quality>& quality, Accelerator* acc) const
+      -> void override;
+
+  /// @brief True if the other model is an %LGP model built on the same mesh
+  /// index: the triangle selected for a point is then identical for both
+  /// models, whatever their discretization degree.
+  ///
+  /// @param[in] other The model to compare with.
+  /// @return True if the search results of the two models are
+  /// interchangeable.
+  auto shares_spatial_cache(const AbstractTidalModel<T>& other) const noexcept
+      -> bool override {
+    const auto* lgp1 = dynamic_cast<const LGP<T, 1>*>(&other);
+    if (lgp1 != nullptr) {
+      return index_ == lgp1->index();
+    }
+    const auto* lgp2 = dynamic_cast<const LGP<T, 2>*>(&other);
+    return lgp2 != nullptr && index_ == lgp2->index();
+  }
+
+  /// @brief Seed the triangle cache of an accelerator with the triangle
+  /// cached by an accelerator of another model built on the same mesh index.
+  ///
+  /// @param[in] point The point about to be interpolated.
+  /// @param[in] source The accelerator holding the selected triangle.
+  /// @param[inout] target The accelerator to seed.
+  auto seed_spatial_cache(const geometry::Point& point,
+                          const Accelerator& source,
+                          Accelerator* target) const -> void override {
+    const auto& lgp_source = dynamic_cast<const LGPAccelerator&>(source);
+    auto* lgp_target = dynamic_cast<LGPAccelerator*>(target);
+    // Seeding invalidates the position-derived cache of the target, so it is
+    // skipped when that cache already covers the point.
+    if (!lgp_target->same_position(point) && !lgp_target->in_cache(point) &&
+        lgp_source.in_cache(point)) {
+      lgp_target->set(mesh::SelectedTriangle(lgp_source.get()));
+    }
+  }
+
   /// Get the mesh index.
   ///
   /// @return The mesh index.
@@ -158,11 +319,36 @@ class LGP : public fes::AbstractTidalModel<T> {
     return index_;
   }
 
+  /// @brief Shrink the model to a geographical bounding box.
+  ///
+  /// Only the triangles with at least one vertex inside the box are kept:
+  /// the mesh index is rebuilt from the remaining vertices, the %LGP codes
+  /// are compacted and the wave models are subset to the codes still
+  /// referenced, shrinking both the resident memory and the R*Tree searched
+  /// by the queries.
+  ///
+  /// @param[in] min_lon The minimum longitude, in degrees, of the box.
+  /// @param[in] max_lon The maximum longitude, in degrees, of the box.
+  /// @param[in] min_lat The minimum latitude, in degrees, of the box.
+  /// @param[in] max_lat The maximum latitude, in degrees, of the box.
+  /// @throw std::invalid_argument if the box is empty or does not intersect
+  /// the model mesh.
+  auto crop(double min_lon, double max_lon, double min_lat, double max_lat)
+      -> void;
+
   /// Get a string representation of the state of the tidal model.
   ///
   /// @return A string representation of the state of the tidal model.
   auto getstate() const -> std::string;
 
+  /// Serialize the tidal model into a stream.
+  ///
+  /// The mesh index, the LGP codes and the wave models are written directly
+  /// to the stream: the state is never built in memory.
+  ///
+  /// @param[in] ss The stream to write to.
+  auto getstate(std::ostream& ss) const -> void;
+
  protected:
   /// @brief Default constructor
   LGP() = default;
@@ -177,11 +363,51 @@ class LGP : public fes::AbstractTidalModel<T> {
   /// @brief Set the state of the tidal model.
   ///
   /// @param[in] data The serialized tidal model.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent. The wave models of the other constituents
+  /// are skipped in the stream, cutting the load time and the memory
+  /// footprint: the skipped constituents are inferred by admittance during
+  /// the prediction.
   /// @note As this class is abstract, this method must be overloaded by the
   /// derived classes to define the state of the tidal model.
-  auto setstate_instance(const string_view& data);
+  auto setstate_instance(const string_view& data,
+                         const std::vector<Constituent>& wanted = {});
+
+  /// @brief Set the state of the tidal model from a stream.
+  ///
+  /// The stream is configured to throw on read failures.
+  ///
+  /// @param[in] ss The stream to read from.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(std::istream& ss,
+                         const std::vector<Constituent>& wanted = {}) -> void;
+
+  /// @brief Set the state of the tidal model from a mapped file, reading the
+  /// wave models on demand.
+  ///
+  /// @param[in] file The mapped file holding the serialized model state.
+  /// @param[in] max_resident The maximum number of wave models kept resident,
+  /// 0 if unbounded.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(const std::shared_ptr<detail::MappedFile>& file,
+                         std::size_t max_resident,
+                         const std::vector<Constituent>& wanted = {}) -> void;
+
+  /// @brief Set the state of the tidal model from a shared-memory segment,
+  /// viewing the wave models in place.
+  ///
+  /// @param[in] segment The segment holding the serialized model state.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(const std::shared_ptr<detail::SharedMemory>& segment,
+                         const std::vector<Constituent>& wanted = {}) -> void;
 
  private:
+  /// Read everything but the constituent map from a stream.
+  auto setstate_partial(std::istream& ss) -> void;
+
   /// Expected data size for each data set
   int expected_data_size_{};
 
@@ -193,6 +419,15 @@ class LGP : public fes::AbstractTidalModel<T> {
 
   /// %LGP codes for each triangles in the index
   codes_t codes_{};
+
+  /// Interleaved wave models (code-major, constituent-minor): one dense row
+  /// per %LGP code.
+  Eigen::Matrix<std::complex<T>, Eigen::Dynamic, Eigen::Dynamic,
+                Eigen::RowMajor>
+      interleaved_{};
+
+  /// Identifiers of the packed constituents, in storage order.
+  std::vector<Constituent> interleaved_idents_{};
 };
 
 /// @brief %LGP1 tidal model.
@@ -210,10 +445,77 @@ class LGP1 : public LGP<T, 1> {
   /// @brief Deserialize the tidal model.
   ///
   /// @param[in] data The serialized tidal model.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent. The wave models of the other constituents
+  /// are skipped in the stream, cutting the load time and the memory
+  /// footprint: the skipped constituents are inferred by admittance during
+  /// the prediction.
+  /// @return The tidal model.
+  static auto setstate(const string_view& data,
+                       const std::vector<Constituent>& wanted = {})
+      -> LGP1<T> {
+    auto model = LGP1<T>();
+    model.setstate_instance(data, wanted);
+    return model;
+  }
+
+  /// @brief Deserialize the tidal model from a stream.
+  ///
+  /// The stream is configured to throw on read failures.
+  ///
+  /// @param[in] ss The stream to read from.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
   /// @return The tidal model.
-  static auto setstate(const string_view& data) -> LGP1<T> {
+  static auto setstate(std::istream& ss,
+                       const std::vector<Constituent>& wanted = {})
+      -> LGP1<T> {
     auto model = LGP1<T>();
-    model.setstate_instance(data);
+    model.setstate_instance(ss, wanted);
+    return model;
+  }
+
+  /// @brief Deserialize the tidal model from a mapped file, reading the wave
+  /// models on demand.
+  ///
+  /// Only the mesh index and the %LGP codes are read eagerly; the wave
+  /// models stay in the mapped file and are faulted in by the first
+  /// interpolation that needs them.
+  ///
+  /// @param[in] file The mapped file holding the serialized model state. The
+  /// model keeps a reference to the mapping.
+  /// @param[in] max_resident The maximum number of wave models kept resident:
+  /// the least recently used ones beyond this budget are evicted and faulted
+  /// in again on their next use. 0 keeps every loaded wave model resident.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  /// @return The tidal model.
+  static auto setstate(const std::shared_ptr<detail::MappedFile>& file,
+                       const std::size_t max_resident,
+                       const std::vector<Constituent>& wanted = {})
+      -> LGP1<T> {
+    auto model = LGP1<T>();
+    model.setstate_instance(file, max_resident, wanted);
+    return model;
+  }
+
+  /// @brief Deserialize the tidal model from a shared-memory segment,
+  /// viewing the wave models in place.
+  ///
+  /// The mesh index and the %LGP codes are read eagerly; the wave models are
+  /// not copied, they are viewed in the segment, whose pages stay shared
+  /// with the other processes attached to it.
+  ///
+  /// @param[in] segment The segment holding the serialized model state. The
+  /// model keeps a reference to the mapping.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  /// @return The tidal model.
+  static auto setstate(const std::shared_ptr<detail::SharedMemory>& segment,
+                       const std::vector<Constituent>& wanted = {})
+      -> LGP1<T> {
+    auto model = LGP1<T>();
+    model.setstate_instance(segment, wanted);
     return model;
   }
 
@@ -231,11 +533,59 @@ class LGP1 : public LGP<T, 1> {
   /// @brief Set the state of the tidal model.
   ///
   /// @param[in] data The serialized tidal model.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
   /// @note As the `setstate_instance` method is protected, this method must be
   /// overloaded by the derived classes to define the state of the tidal model.
-  auto setstate_instance(const string_view& data) -> void {
+  auto setstate_instance(const string_view& data,
+                         const std::vector<Constituent>& wanted = {}) -> void {
+    try {
+      LGP<T, 1>::setstate_instance(data, wanted);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("invalid LGP1 tidal model state");
+    }
+  }
+
+  /// @brief Set the state of the tidal model from a stream.
+  ///
+  /// @param[in] ss The stream to read from.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(std::istream& ss,
+                         const std::vector<Constituent>& wanted = {}) -> void {
+    try {
+      LGP<T, 1>::setstate_instance(ss, wanted);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("invalid LGP1 tidal model state");
+    }
+  }
+
+  /// @brief Set the state of the tidal model from a mapped file.
+  ///
+  /// @param[in] file The mapped file holding the serialized model state.
+  /// @param[in] max_resident The maximum number of wave models kept resident,
+  /// 0 if unbounded.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(const std::shared_ptr<detail::MappedFile>& file,
+                         const std::size_t max_resident,
+                         const std::vector<Constituent>& wanted = {}) -> void {
     try {
-      LGP<T, 1>::setstate_instance(data);
+      LGP<T, 1>::setstate_instance(file, max_resident, wanted);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("invalid LGP1 tidal model state");
+    }
+  }
+
+  /// @brief Set the state of the tidal model from a shared-memory segment.
+  ///
+  /// @param[in] segment The segment holding the serialized model state.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(const std::shared_ptr<detail::SharedMemory>& segment,
+                         const std::vector<Constituent>& wanted = {}) -> void {
+    try {
+      LGP<T, 1>::setstate_instance(segment, wanted);
     } catch (const std::exception& e) {
       throw std::runtime_error("invalid LGP1 tidal model state");
     }
@@ -257,10 +607,77 @@ class LGP2 : public LGP<T, 2> {
   /// @brief Deserialize the tidal model.
   ///
   /// @param[in] data The serialized tidal model.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent. The wave models of the other constituents
+  /// are skipped in the stream, cutting the load time and the memory
+  /// footprint: the skipped constituents are inferred by admittance during
+  /// the prediction.
+  /// @return The tidal model.
+  static auto setstate(const string_view& data,
+                       const std::vector<Constituent>& wanted = {})
+      -> LGP2<T> {
+    auto model = LGP2<T>();
+    model.setstate_instance(data, wanted);
+    return model;
+  }
+
+  /// @brief Deserialize the tidal model from a stream.
+  ///
+  /// The stream is configured to throw on read failures.
+  ///
+  /// @param[in] ss The stream to read from.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  /// @return The tidal model.
+  static auto setstate(std::istream& ss,
+                       const std::vector<Constituent>& wanted = {})
+      -> LGP2<T> {
+    auto model = LGP2<T>();
+    model.setstate_instance(ss, wanted);
+    return model;
+  }
+
+  /// @brief Deserialize the tidal model from a mapped file, reading the wave
+  /// models on demand.
+  ///
+  /// Only the mesh index and the %LGP codes are read eagerly; the wave
+  /// models stay in the mapped file and are faulted in by the first
+  /// interpolation that needs them.
+  ///
+  /// @param[in] file The mapped file holding the serialized model state. The
+  /// model keeps a reference to the mapping.
+  /// @param[in] max_resident The maximum number of wave models kept resident:
+  /// the least recently used ones beyond this budget are evicted and faulted
+  /// in again on their next use. 0 keeps every loaded wave model resident.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  /// @return The tidal model.
+  static auto setstate(const std::shared_ptr<detail::MappedFile>& file,
+                       const std::size_t max_resident,
+                       const std::vector<Constituent>& wanted = {})
+      -> LGP2<T> {
+    auto model = LGP2<T>();
+    model.setstate_instance(file, max_resident, wanted);
+    return model;
+  }
+
+  /// @brief Deserialize the tidal model from a shared-memory segment,
+  /// viewing the wave models in place.
+  ///
+  /// The mesh index and the %LGP codes are read eagerly; the wave models are
+  /// not copied, they are viewed in the segment, whose pages stay shared
+  /// with the other processes attached to it.
+  ///
+  /// @param[in] segment The segment holding the serialized model state. The
+  /// model keeps a reference to the mapping.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
   /// @return The tidal model.
-  static auto setstate(const string_view& data) -> LGP2<T> {
+  static auto setstate(const std::shared_ptr<detail::SharedMemory>& segment,
+                       const std::vector<Constituent>& wanted = {})
+      -> LGP2<T> {
     auto model = LGP2<T>();
-    model.setstate_instance(data);
+    model.setstate_instance(segment, wanted);
     return model;
   }
 
@@ -291,11 +708,59 @@ class LGP2 : public LGP<T, 2> {
   /// @brief Set the state of the tidal model.
   ///
   /// @param[in] data The serialized tidal model.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
   /// @note As the `setstate_instance` method is protected, this method must be
   /// overloaded by the derived classes to define the state of the tidal model.
-  auto setstate_instance(const string_view& data) -> void {
+  auto setstate_instance(const string_view& data,
+                         const std::vector<Constituent>& wanted = {}) -> void {
+    try {
+      LGP<T, 2>::setstate_instance(data, wanted);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("invalid LGP2 tidal model state");
+    }
+  }
+
+  /// @brief Set the state of the tidal model from a stream.
+  ///
+  /// @param[in] ss The stream to read from.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(std::istream& ss,
+                         const std::vector<Constituent>& wanted = {}) -> void {
+    try {
+      LGP<T, 2>::setstate_instance(ss, wanted);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("invalid LGP2 tidal model state");
+    }
+  }
+
+  /// @brief Set the state of the tidal model from a mapped file.
+  ///
+  /// @param[in] file The mapped file holding the serialized model state.
+  /// @param[in] max_resident The maximum number of wave models kept resident,
+  /// 0 if unbounded.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(const std::shared_ptr<detail::MappedFile>& file,
+                         const std::size_t max_resident,
+                         const std::vector<Constituent>& wanted = {}) -> void {
+    try {
+      LGP<T, 2>::setstate_instance(file, max_resident, wanted);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("invalid LGP2 tidal model state");
+    }
+  }
+
+  /// @brief Set the state of the tidal model from a shared-memory segment.
+  ///
+  /// @param[in] segment The segment holding the serialized model state.
+  /// @param[in] wanted The identifiers of the constituents to load; an empty
+  /// list loads every constituent.
+  auto setstate_instance(const std::shared_ptr<detail::SharedMemory>& segment,
+                         const std::vector<Constituent>& wanted = {}) -> void {
     try {
-      LGP<T, 2>::setstate_instance(data);
+      LGP<T, 2>::setstate_instance(segment, wanted);
     } catch (const std::exception& e) {
       throw std::runtime_error("invalid LGP2 tidal model state");
     }
@@ -335,6 +800,115 @@ LGP<T, N>::LGP(std::shared_ptr<mesh::Index> index, LGP::codes_t codes,
   expected_data_size_ = max_index + 1;
 }
 
+// /////////////////////////////////////////////////////////////////////////////
+template <typename T, int N>
+auto LGP<T, N>::crop(const double min_lon, const double max_lon,
+                     const double min_lat, const double max_lat) -> void {
+  if (min_lon > max_lon || min_lat > max_lat) {
+    throw std::invalid_argument(
+        "the minimum corner of the bounding box must not exceed the maximum "
+        "corner");
+  }
+  // The wave models are rewritten: a lazily loaded model is materialized
+  // first.
+  this->materialize();
+  const auto& lon = index_->lon();
+  const auto& lat = index_->lat();
+  const auto& triangles = index_->triangles();
+  auto inside = [&](const int32_t vertex) -> bool {
+    return detail::math::normalize_angle(lon(vertex), min_lon) <= max_lon &&
+           lat(vertex) >= min_lat && lat(vertex) <= max_lat;
+  };
+  auto kept = std::vector<int32_t>();
+  for (int32_t ix = 0; ix < static_cast<int32_t>(triangles.rows()); ++ix) {
+    if (inside(triangles(ix, 0)) || inside(triangles(ix, 1)) ||
+        inside(triangles(ix, 2))) {
+      kept.push_back(ix);
+    }
+  }
+  if (kept.empty()) {
+    throw std::invalid_argument(
+        "the bounding box does not intersect the model mesh");
+  }
+  if (kept.size() == static_cast<size_t>(triangles.rows())) {
+    return;
+  }
+  // The wave models are subset in floating-point storage; the quantization,
+  // if any, is rebuilt on the cropped models.
+  const auto was_quantized = this->quantized();
+  this->dequantize();
+  // Renumber, in ascending order, the vertices and the LGP codes still
+  // referenced by the kept triangles.
+  auto vertex_map = std::vector<int32_t>(index_->n_positions(), -1);
+  auto code_map =
+      std::vector<int>(static_cast<size_t>(expected_data_size_), -1);
+  for (const auto ix : kept) {
+    for (auto jx = 0; jx < 3; ++jx) {
+      vertex_map[static_cast<size_t>(triangles(ix, jx))] = 0;
+    }
+    for (auto jx = 0; jx < N * 3; ++jx) {
+      code_map[static_cast<size_t>(codes_(ix, jx))] = 0;
+    }
+  }
+  auto n_vertices = int32_t{0};
+  for (auto& item : vertex_map) {
+    if (item != -1) {
+      item = n_vertices++;
+    }
+  }
+  auto n_codes = 0;
+  for (auto& item : code_map) {
+    if (item != -1) {
+      item = n_codes++;
+    }
+  }
+  auto cropped_lon = Eigen::VectorXd(n_vertices);
+  auto cropped_lat = Eigen::VectorXd(n_vertices);
+  for (size_t ix = 0; ix < vertex_map.size(); ++ix) {
+    if (vertex_map[ix] != -1) {
+      cropped_lon(vertex_map[ix]) = lon(static_cast<Eigen::Index>(ix));
+      cropped_lat(vertex_map[ix]) = lat(static_cast<Eigen::Index>(ix));
+    }
+  }
+  auto cropped_triangles = Eigen::Matrix<int32_t, Eigen::Dynamic, 3>(
+      static_cast<Eigen::Index>(kept.size()), 3);
+  auto cropped_codes = codes_t(static_cast<Eigen::Index>(kept.size()), N * 3);
+  for (size_t ix = 0; ix < kept.size(); ++ix) {
+    const auto row = static_cast<Eigen::Index>(ix);
+    for (auto jx = 0; jx < 3; ++jx) {
+      cropped_triangles(row, jx) =
+          vertex_map[static_cast<size_t>(triangles(kept[ix], jx))];
+    }
+    for (auto jx = 0; jx < N * 3; ++jx) {
+      cropped_codes(row, jx) =
+          code_map[static_cast<size_t>(codes_(kept[ix], jx))];
+    }
+  }
+  auto data = ConstituentMap<DataVector<std::complex<T>>>();
+  for (const auto& item : this->data_) {
+    auto wave = Vector<std::complex<T>>(n_codes);
+    for (size_t code = 0; code < code_map.size(); ++code) {
+      if (code_map[code] != -1) {
+        wave(code_map[code]) = item.second(static_cast<Eigen::Index>(code));
+      }
+    }
+    data.emplace(item.first, std::move(wave));
+  }
+  index_ = std::make_shared<mesh::Index>(std::move(cropped_lon),
+                                         std::move(cropped_lat),
+                                         std::move(cropped_triangles));
+  codes_ = std::move(cropped_codes);
+  this->data_ = std::move(data);
+  expected_data_size_ = n_codes;
+  // The packed matrix built by interleave(), if any, no longer matches the
+  // compacted codes.
+  interleaved_.resize(0, 0);
+  interleaved_idents_.clear();
+  if (was_quantized) {
+    this->quantize();
+  }
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 template <typename T, int N>
 auto LGP<T, N>::interpolate(const geometry::Point& point, Quality& quality,
@@ -342,10 +916,26 @@ auto LGP<T, N>::interpolate(const geometry::Point& point, Quality& quality,
     -> const ConstituentValues& {
   auto* lgp_acc = reinterpret_cast<LGPAccelerator*>(acc);
 
+  // A point bit-identical to the last query reuses the selected triangle
+  // and everything derived from it.
+  const auto same_position = lgp_acc->same_position(point);
+
   // Reset the accelerator if the point is not in the cache, otherwise update
-  // the point in use.
-  lgp_acc->in_cache(point) ? lgp_acc->reset(point)
-                           : lgp_acc->set(index_->search(point, max_distance_));
+  // the point in use. On a cache miss, the cached triangle still seeds the
+  // search: an along-track point usually sits a few edges away from it.
+  auto& counters = lgp_acc->counters();
+  if (same_position || lgp_acc->in_cache(point)) {
+    ++counters.interpolation_cache_hits;
+    if (!same_position) {
+      lgp_acc->reset(point);
+    }
+  } else {
+    ++counters.interpolation_cache_misses;
+    ++counters.searches;
+    detail::trace::Scope span("triangle_search");
+    lgp_acc->set(
+        index_->search_from(point, lgp_acc->get().index, max_distance_));
+  }
 
   // Remove all the data from the previous interpolation
   lgp_acc->clear();
@@ -354,6 +944,7 @@ auto LGP<T, N>::interpolate(const geometry::Point& point, Quality& quality,
   const auto& selected_triangle = lgp_acc->get();
   if (selected_triangle.index == -1) {
     // No triangle found, return NaN
+    ++counters.undefined;
     for (const auto& item : this->data_) {
       lgp_acc->emplace_back(
           item.first,
@@ -364,6 +955,10 @@ auto LGP<T, N>::interpolate(const geometry::Point& point, Quality& quality,
     return lgp_acc->values();
   }
 
+  // Wave models read on demand are loaded before the first access. Queries
+  // outside the mesh return before this point without faulting anything in.
+  this->fault_in();
+
   // Get the LGP codes for the triangle
   const auto& codes = codes_.row(selected_triangle.index);
 
@@ -372,61 +967,209 @@ auto LGP<T, N>::interpolate(const geometry::Point& point, Quality& quality,
   // LGP code of vertex 0 is at index 0, the code of vertex 1 is at index 2 and
   // the code of vertex 3 is at index 4.
   auto vertex_id =
-      selected_triangle.triangle.is_vertex(selected_triangle.point);
+      same_position
+          ? lgp_acc->cached_vertex()
+          : selected_triangle.triangle.is_vertex(selected_triangle.point);
   if (vertex_id != -1) {
-    for (const auto& item : this->data_) {
-      const auto value = item.second(codes(vertex_id << 1));
-      lgp_acc->emplace_back(item.first, static_cast<std::complex<T>>(value));
+    lgp_acc->cache_position(point, vertex_id);
+    if (interleaved_.size() != 0) {
+      const auto code = codes(vertex_id << 1);
+      for (size_t kx = 0; kx < interleaved_idents_.size(); ++kx) {
+        lgp_acc->emplace_back(interleaved_idents_[kx],
+                              static_cast<std::complex<double>>(interleaved_(
+                                  code, static_cast<Eigen::Index>(kx))));
+      }
+    } else if (this->quantized()) {
+      for (const auto& item : this->quantized_) {
+        lgp_acc->emplace_back(item.first,
+                              static_cast<std::complex<T>>(
+                                  item.second.dequantize(codes(vertex_id << 1))));
+      }
+    } else {
+      for (const auto& item : this->data_) {
+        const auto value = item.second(codes(vertex_id << 1));
+        lgp_acc->emplace_back(item.first, static_cast<std::complex<T>>(value));
+      }
     }
     quality = Quality::kExtrapolated1;
+    ++counters.extrapolations;
     return lgp_acc->values();
   }
 
-  // Calculate ξ and η for the given point
-  const auto xy = selected_triangle.triangle.reference_right_angled(
-      selected_triangle.point);
-
-  // Calculate the beta coefficients for the given point
-  const auto beta = calculate_beta(std::get<0>(xy), std::get<1>(xy));
+  if (!same_position) {
+    // Calculate ξ and η for the given point, from the barycentric transform
+    // cached in the index, then the beta coefficients. Both are skipped when
+    // the position repeats: the cached coefficients are reused as they are.
+    const auto xy = index_->reference_right_angled(selected_triangle.index,
+                                                   selected_triangle.point);
+    lgp_acc->cached_beta() = calculate_beta(std::get<0>(xy), std::get<1>(xy));
+    lgp_acc->cache_position(point, -1);
+  }
+  const auto& beta = lgp_acc->cached_beta();
 
   // Interpolate the wave model for each data set
-  for (const auto& item : this->data_) {
-    const auto& wave = item.second;
-    auto dot = std::complex<double>(0, 0);
-
-    // Read the values for each LGP code
+  if (interleaved_.size() != 0) {
+    // One dense row per LGP code: the query streams N*3 contiguous rows and
+    // combines them with the beta coefficients in a single product that
+    // covers every constituent at once.
+    const auto stride = static_cast<Eigen::Index>(interleaved_idents_.size());
+    auto values = Eigen::Matrix<std::complex<double>, 1, Eigen::Dynamic>(
+        Eigen::Matrix<std::complex<double>, 1, Eigen::Dynamic>::Zero(stride));
     for (auto ix = 0; ix < N * 3; ++ix) {
-      dot += beta(ix) * static_cast<std::complex<double>>(wave(codes(ix)));
+      values +=
+          beta(ix) *
+          interleaved_.row(codes(ix)).template cast<std::complex<double>>();
+    }
+    for (Eigen::Index kx = 0; kx < stride; ++kx) {
+      lgp_acc->emplace_back(interleaved_idents_[kx], values(kx));
+    }
+  } else if (this->quantized()) {
+    // The 16-bit samples are widened on the fly: only the LGP codes of the
+    // selected triangle are dequantized.
+    for (const auto& item : this->quantized_) {
+      const auto& wave = item.second;
+      auto dot = std::complex<double>(0, 0);
+
+      for (auto ix = 0; ix < N * 3; ++ix) {
+        dot += beta(ix) * wave.dequantize(codes(ix));
+      }
+      lgp_acc->emplace_back(item.first, dot);
+    }
+  } else {
+    for (const auto& item : this->data_) {
+      const auto& wave = item.second;
+      auto dot = std::complex<double>(0, 0);
+
+      // Read the values for each LGP code
+      for (auto ix = 0; ix < N * 3; ++ix) {
+        dot += beta(ix) * static_cast<std::complex<double>>(wave(codes(ix)));
+      }
+      lgp_acc->emplace_back(item.first, dot);
     }
-    lgp_acc->emplace_back(item.first, dot);
   }
   quality = Quality::kInterpolated;
   return lgp_acc->values();
 }
 
 template <typename T, int N>
-auto LGP<T, N>::getstate() const -> std::string {
-  auto ss = std::stringstream();
-  ss.exceptions(std::stringstream::failbit);
+auto LGP<T, N>::interpolate_many(const std::vector<geometry::Point>& points,
+                                 Matrix<std::complex<double>>& values,
+                                 Vector<Quality>& quality,
+                                 Accelerator* acc) const -> void {
+  if (acc->bound()) {
+    throw std::invalid_argument(
+        "interpolate_many requires an accelerator that is not bound to a "
+        "wave table");
+  }
+  auto* lgp_acc = reinterpret_cast<LGPAccelerator*>(acc);
+  const auto size = static_cast<Eigen::Index>(points.size());
+  values.resize(static_cast<Eigen::Index>(this->data_.size()), size);
+  quality.resize(size);
+
+  // Locate the triangles of the whole run at once: the batch search visits
+  // the queries along a space-filling curve, each one walking the mesh from
+  // the triangle found for the previous one.
+  auto selected = index_->search_many(points, max_distance_);
+
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    const auto& point = points[static_cast<size_t>(ix)];
+    // Seed the triangle cache with the batch result, unless the cache
+    // already covers the point: seeding invalidates the position-derived
+    // cache, which is more valuable for repeated positions.
+    if (!lgp_acc->same_position(point) && !lgp_acc->in_cache(point)) {
+      lgp_acc->set(std::move(selected[static_cast<size_t>(ix)]));
+    }
+    auto flag = Quality();
+    const auto& interpolated = LGP<T, N>::interpolate(point, flag, acc);
+    quality(ix) = flag;
+    for (Eigen::Index jx = 0; jx < values.rows(); ++jx) {
+      values(jx, ix) = interpolated[static_cast<size_t>(jx)].second;
+    }
+  }
+}
+
+template <typename T, int N>
+auto LGP<T, N>::getstate(std::ostream& ss) const -> void {
+  // The state holds every constituent: the wave models of a lazily loaded
+  // model are faulted in first.
+  this->fault_in();
   detail::serialize::write_data(ss, this->tide_type_);
-  detail::serialize::write_string(ss, index_->getstate());
+  // The index state is length-prefixed: its size is known without building
+  // it in memory.
+  detail::serialize::write_data(ss, index_->state_size());
+  index_->getstate(ss);
   detail::serialize::write_data(ss, max_distance_);
   detail::serialize::write_matrix<int, Eigen::Dynamic, N * 3>(ss, codes_);
-  detail::serialize::write_constituent_map(ss, this->data_);
-  return ss.str();
+  // A quantized model is serialized with the same layout as an unquantized
+  // one, carrying the quantization error.
+  this->quantized()
+      ? detail::serialize::write_constituent_map(ss, this->dequantized_data())
+      : detail::serialize::write_constituent_map(ss, this->data_);
 }
 
 template <typename T, int N>
-auto LGP<T, N>::setstate_instance(const string_view& data) {
-  detail::isviewstream ss(data);
+auto LGP<T, N>::getstate() const -> std::string {
+  auto ss = std::stringstream();
   ss.exceptions(std::stringstream::failbit);
+  getstate(ss);
+  return ss.str();
+}
+
+template <typename T, int N>
+auto LGP<T, N>::setstate_partial(std::istream& ss) -> void {
   this->tide_type_ = detail::serialize::read_data<TideType>(ss);
-  this->index_ = std::make_shared<mesh::Index>(
-      mesh::Index::setstate(detail::serialize::read_string(ss)));
+  // The index state is length-prefixed.
+  detail::serialize::read_data<size_t>(ss);
+  this->index_ = std::make_shared<mesh::Index>(mesh::Index::setstate(ss));
   this->max_distance_ = detail::serialize::read_data<double>(ss);
   this->codes_ = detail::serialize::read_matrix<int, Eigen::Dynamic, N * 3>(ss);
-  this->data_ =
-      detail::serialize::read_constituent_map<Constituent, std::complex<T>>(ss);
+}
+
+template <typename T, int N>
+auto LGP<T, N>::setstate_instance(std::istream& ss,
+                                  const std::vector<Constituent>& wanted)
+    -> void {
+  ss.exceptions(std::istream::failbit);
+  setstate_partial(ss);
+  this->data_ = detail::serialize::read_constituent_map<
+      ConstituentMap<DataVector<std::complex<T>>>>(ss, wanted);
+}
+
+template <typename T, int N>
+auto LGP<T, N>::setstate_instance(
+    const std::shared_ptr<detail::MappedFile>& file,
+    const std::size_t max_resident, const std::vector<Constituent>& wanted)
+    -> void {
+  detail::isviewstream ss(file->view());
+  ss.exceptions(std::istream::failbit);
+  setstate_partial(ss);
+  // The constituent map is scanned, not read: only the byte offsets of the
+  // wave models are kept.
+  this->attach_backing(
+      file,
+      detail::serialize::scan_constituent_map<
+          ConstituentMap<DataVector<std::complex<T>>>>(ss, wanted),
+      max_resident);
+}
+
+template <typename T, int N>
+auto LGP<T, N>::setstate_instance(
+    const std::shared_ptr<detail::SharedMemory>& segment,
+    const std::vector<Constituent>& wanted) -> void {
+  detail::isviewstream ss(segment->view());
+  ss.exceptions(std::istream::failbit);
+  setstate_partial(ss);
+  // The wave models are viewed in place in the segment: no sample is copied
+  // and the pages stay shared with the other processes attached to it.
+  this->data_ = detail::serialize::view_constituent_map<
+      ConstituentMap<DataVector<std::complex<T>>>>(ss, segment, wanted);
+}
+
+template <typename T, int N>
+auto LGP<T, N>::setstate_instance(const string_view& data,
+                                  const std::vector<Constituent>& wanted) {
+  detail::isviewstream ss(data);
+  setstate_instance(ss, wanted);
 }
 
 }  // namespace tidal_model
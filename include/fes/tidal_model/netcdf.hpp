@@ -0,0 +1,136 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/tidal_model/netcdf.hpp
+/// @brief Loader of Cartesian tidal atlases stored in netCDF files.
+#pragma once
+#include <cctype>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fes/detail/math.hpp"
+#include "fes/detail/netcdf.hpp"
+#include "fes/detail/thread.hpp"
+#include "fes/tidal_model/cartesian.hpp"
+
+namespace fes {
+namespace tidal_model {
+namespace detail {
+
+/// True if the units attribute of a variable declares degrees.
+inline auto phase_in_degrees(const fes::detail::netcdf::Variable& variable)
+    -> bool {
+  const auto* units = variable.attribute("units");
+  if (units == nullptr) {
+    return false;
+  }
+  auto text = units->text;
+  for (auto& item : text) {
+    item = static_cast<char>(std::tolower(item));
+  }
+  return text == "degree" || text == "degrees" || text == "deg";
+}
+
+/// Read the wave model of one constituent file: the amplitude and the phase
+/// are combined into complex samples, in storage order.
+template <typename T>
+auto read_wave(const std::string& path, const std::string& amplitude,
+               const std::string& phase, const Eigen::Index size)
+    -> Vector<std::complex<T>> {
+  auto file = fes::detail::netcdf::File(path);
+  const auto& amplitude_variable = file.variable(amplitude);
+  const auto& phase_variable = file.variable(phase);
+  if (amplitude_variable.size != size || phase_variable.size != size) {
+    throw std::invalid_argument(
+        "the grid read from " + path +
+        " is inconsistent with the other constituent files");
+  }
+  auto amplitude_values = file.values(amplitude_variable);
+  auto phase_values = file.values(phase_variable);
+  if (phase_in_degrees(phase_variable)) {
+    phase_values *= fes::detail::math::pi<double>() / 180.0;
+  }
+  auto result = Vector<std::complex<T>>(size);
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    result(ix) = std::complex<T>(
+        static_cast<T>(amplitude_values(ix) * std::cos(phase_values(ix))),
+        static_cast<T>(amplitude_values(ix) * std::sin(phase_values(ix))));
+  }
+  return result;
+}
+
+}  // namespace detail
+
+/// @brief Build a Cartesian tidal model from a set of netCDF constituent
+/// files, reading them concurrently.
+///
+/// Each file holds the amplitude and the phase of one constituent on the
+/// grid shared by the whole atlas. The files must be in the netCDF classic
+/// format (CDF-1 or CDF-2); netCDF-4 files are rejected with an error.
+///
+/// @tparam T The type of the tidal model samples.
+/// @param[in] paths The constituents loaded and the paths of their files.
+/// @param[in] longitude The name of the longitude variable.
+/// @param[in] latitude The name of the latitude variable.
+/// @param[in] amplitude The name of the amplitude variable.
+/// @param[in] phase The name of the phase variable, in degrees or radians
+/// according to its units attribute.
+/// @param[in] tide_type The type of tide handled by the model.
+/// @param[in] epsilon The tolerance used to determine if the longitude axis
+/// is circular.
+/// @param[in] num_threads The number of threads reading the files. 0 uses
+/// all the available cores.
+/// @return The tidal model.
+/// @throw std::invalid_argument if a file cannot be read or its grid is
+/// inconsistent with the other files.
+template <typename T>
+auto load_cartesian(
+    const std::vector<std::pair<Constituent, std::string>>& paths,
+    const std::string& longitude, const std::string& latitude,
+    const std::string& amplitude, const std::string& phase,
+    const TideType tide_type = kTide, const double epsilon = 1e-6,
+    const size_t num_threads = 0) -> Cartesian<T> {
+  if (paths.empty()) {
+    throw std::invalid_argument("no constituent file to load");
+  }
+  // The axes and the storage order are read from the first file; the other
+  // files only need to provide grids of the same size.
+  auto first = fes::detail::netcdf::File(paths.front().second);
+  auto lon = Axis(first.values(first.variable(longitude)), epsilon, true);
+  auto lat = Axis(first.values(first.variable(latitude)));
+  const auto& amplitude_variable = first.variable(amplitude);
+  if (amplitude_variable.dimensions.empty()) {
+    throw std::invalid_argument("the amplitude variable is not a grid: " +
+                                amplitude);
+  }
+  const auto row_major =
+      first.dimensions()[static_cast<size_t>(
+                             amplitude_variable.dimensions.front())]
+          .size == lon.size();
+  const auto size = static_cast<Eigen::Index>(lon.size() * lat.size());
+  auto model = Cartesian<T>(std::move(lon), std::move(lat), tide_type,
+                            row_major);
+
+  // Each file is decoded by one task, directly into its slot of the result.
+  auto waves = std::vector<Vector<std::complex<T>>>(paths.size());
+  fes::detail::parallel_for(
+      [&](const size_t start, const size_t end) {
+        for (auto ix = start; ix < end; ++ix) {
+          waves[ix] = detail::read_wave<T>(paths[ix].second, amplitude,
+                                           phase, size);
+        }
+      },
+      paths.size(), num_threads);
+  for (size_t ix = 0; ix < paths.size(); ++ix) {
+    model.add_constituent(paths[ix].first, std::move(waves[ix]));
+  }
+  return model;
+}
+
+}  // namespace tidal_model
+}  // namespace fes
@@ -0,0 +1,470 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/tidal_model/tiled_lgp.hpp
+/// @brief Tiled out-of-core LGP tidal models.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fes/abstract_tidal_model.hpp"
+#include "fes/detail/isviewstream.hpp"
+#include "fes/detail/mapped_file.hpp"
+#include "fes/detail/math.hpp"
+#include "fes/detail/serialize.hpp"
+#include "fes/string_view.hpp"
+#include "fes/tidal_model/lgp.hpp"
+
+namespace fes {
+namespace tidal_model {
+
+/// @brief A class representing an accelerator for tiled %LGP tidal models.
+///
+/// It extends the %LGP accelerator with the identifier of the shard that
+/// produced the cached triangle: a triangle index is only meaningful within
+/// the mesh of its own shard, so the cache is discarded whenever a query
+/// moves to another shard.
+class TiledLGPAccelerator : public LGPAccelerator {
+ public:
+  using LGPAccelerator::LGPAccelerator;
+
+  /// Get the shard that produced the cached triangle, or -1.
+  inline auto shard() const noexcept -> int64_t { return shard_; }
+
+  /// Set the shard that produces the cached triangles.
+  ///
+  /// @param[in] shard The shard identifier.
+  inline auto set_shard(const int64_t shard) noexcept -> void {
+    shard_ = shard;
+  }
+
+ private:
+  /// The shard that produced the cached triangle, or -1.
+  int64_t shard_{-1};
+};
+
+/// @brief Tiled out-of-core %LGP tidal model.
+///
+/// A global unstructured mesh with its full constituent set can exceed the
+/// memory of a small node, and an %LGP model only exists fully resident.
+/// This model partitions the mesh into a regular grid of geographic tiles:
+/// each tile is serialized as an autonomous %LGP model — its own mesh index,
+/// %LGP codes and constituent slices — and faulted in from a mapped file by
+/// the first query that touches it. The least recently used shards beyond a
+/// residency budget are evicted and faulted in again on their next use, so a
+/// regional job only keeps the shards it actually queries in memory.
+///
+/// @tparam T The type of the wave models loaded.
+/// @tparam N The degree of the %LGP discretization.
+template <typename T, int N>
+class TiledLGP : public fes::AbstractTidalModel<T> {
+ public:
+  /// The type of the model handling one shard.
+  using shard_t =
+      typename std::conditional<N == 1, LGP1<T>, LGP2<T>>::type;
+
+  /// Default destructor.
+  virtual ~TiledLGP() override = default;
+
+  /// The shard registry is guarded by a mutex: the copy takes its own.
+  TiledLGP(const TiledLGP& rhs)
+      : AbstractTidalModel<T>(rhs),
+        file_(rhs.file_),
+        n_lon_(rhs.n_lon_),
+        n_lat_(rhs.n_lat_),
+        min_lon_(rhs.min_lon_),
+        max_lon_(rhs.max_lon_),
+        min_lat_(rhs.min_lat_),
+        max_lat_(rhs.max_lat_),
+        max_resident_(rhs.max_resident_),
+        shards_(rhs.shards_),
+        clock_(rhs.clock_) {}
+
+  /// The shard registry is guarded by a mutex: the copy takes its own.
+  auto operator=(const TiledLGP& rhs) -> TiledLGP& {
+    AbstractTidalModel<T>::operator=(rhs);
+    file_ = rhs.file_;
+    n_lon_ = rhs.n_lon_;
+    n_lat_ = rhs.n_lat_;
+    min_lon_ = rhs.min_lon_;
+    max_lon_ = rhs.max_lon_;
+    min_lat_ = rhs.min_lat_;
+    max_lat_ = rhs.max_lat_;
+    max_resident_ = rhs.max_resident_;
+    shards_ = rhs.shards_;
+    clock_ = rhs.clock_;
+    return *this;
+  }
+
+  /// @brief Partition an %LGP model into geographic shards and serialize the
+  /// tiled state into a stream.
+  ///
+  /// The bounding box of the mesh is split into a regular grid of
+  /// n_lon x n_lat tiles. Each tile is cut from a fresh copy of the model,
+  /// rebuilt from its serialized state, by cropping it to the tile box
+  /// enlarged by the overlap margin: a triangle is kept by crop() when one of
+  /// its vertices is inside the box, so the margin must cover the longest
+  /// triangle edge for a query near a tile boundary to find its containing
+  /// triangle in the shard answering it. Tiles that do not intersect the mesh
+  /// are recorded as empty.
+  ///
+  /// @param[in] model The model to partition.
+  /// @param[in] n_lon The number of tiles along the longitude axis.
+  /// @param[in] n_lat The number of tiles along the latitude axis.
+  /// @param[in] overlap The margin, in degrees, added around each tile box
+  /// when cropping the model.
+  /// @param[in] ss The stream to write to. One tile state is built in memory
+  /// at a time.
+  /// @throw std::invalid_argument if the tile grid is empty or the overlap
+  /// is negative.
+  static auto shard(const shard_t& model, std::size_t n_lon, std::size_t n_lat,
+                    double overlap, std::ostream& ss) -> void;
+
+  /// @brief Deserialize a tiled model from a mapped file, reading the shards
+  /// on demand.
+  ///
+  /// Only the shard directory is read eagerly; each shard stays in the
+  /// mapped file until the first query touching its tile faults it in.
+  ///
+  /// @param[in] file The mapped file holding the tiled state, written by
+  /// shard(). The model keeps a reference to the mapping.
+  /// @param[in] max_resident The maximum number of shards kept resident: the
+  /// least recently used ones beyond this budget are evicted and faulted in
+  /// again on their next use. 0 keeps every loaded shard resident.
+  /// @return The tidal model.
+  static auto setstate(const std::shared_ptr<detail::MappedFile>& file,
+                       const std::size_t max_resident) -> TiledLGP<T, N> {
+    auto model = TiledLGP<T, N>();
+    try {
+      model.setstate_instance(file, max_resident);
+    } catch (const std::exception&) {
+      throw std::runtime_error("invalid tiled LGP tidal model state");
+    }
+    return model;
+  }
+
+  /// A tiled model does not store samples itself.
+  ///
+  /// @throw std::invalid_argument always: the constituents are packed into
+  /// the shards by shard().
+  auto add_constituent(const Constituent /*ident*/,
+                       DataVector<std::complex<T>> /*wave*/) -> void override {
+    throw std::invalid_argument(
+        "a tiled model is read-only; constituents are packed into the shards "
+        "when the model is tiled");
+  }
+
+  /// @brief Create a new instance of the TiledLGPAccelerator class to speed
+  /// up the calculation.
+  ///
+  /// @param[in] formulae The formulae used to calculate the astronomic angle.
+  /// @param[in] time_tolerance The time in seconds during which astronomical
+  /// angles are considered constant. The default value is 0 seconds,
+  /// indicating that astronomical angles do not remain constant with time.
+  /// @return A pointer to the newly created TiledLGPAccelerator instance.
+  auto accelerator(const angle::Formulae& formulae,
+                   const double time_tolerance) const -> Accelerator* override {
+    return new TiledLGPAccelerator(formulae, time_tolerance,
+                                   this->data_.size());
+  }
+
+  /// Interpolate the wave models loaded at the given point.
+  ///
+  /// The query is routed to the shard whose tile contains the point,
+  /// faulting it in when it is not resident. Concurrent faults are
+  /// serialized by a mutex; a query holds a reference to its shard, so a
+  /// shard evicted while another thread interpolates from it stays alive
+  /// until that query completes.
+  ///
+  /// @param[in] point The point to interpolate at.
+  /// @param[inout] quality A flag indicating if the point was extrapolated.
+  /// @param[inout] acc An accelerator to speed up the calculation.
+  /// @return A list of interpolated wave models.
+  auto interpolate(const geometry::Point& point, Quality& quality,
+                   Accelerator* acc) const -> const ConstituentValues& override;
+
+  /// Get the number of shards of the tile grid.
+  inline auto n_shards() const noexcept -> std::size_t {
+    return shards_.size();
+  }
+
+  /// Get the number of shards currently resident in memory.
+  auto resident_shards() const -> std::size_t {
+    auto* self = const_cast<TiledLGP<T, N>*>(this);
+    std::lock_guard<std::mutex> lock(self->mutex_);
+    return static_cast<std::size_t>(std::count_if(
+        shards_.begin(), shards_.end(),
+        [](const Shard& shard) -> bool { return shard.model != nullptr; }));
+  }
+
+ private:
+  /// A shard of the tile grid.
+  struct Shard {
+    /// The byte offset of the shard state in the mapped file.
+    std::size_t offset{0};
+    /// The byte length of the shard state, 0 for an empty tile.
+    std::size_t length{0};
+    /// The resident model, or nullptr when the shard is not loaded.
+    std::shared_ptr<const shard_t> model{};
+    /// The logical time of the last query, for the LRU eviction.
+    uint64_t stamp{0};
+  };
+
+  /// @brief Default constructor.
+  TiledLGP() = default;
+
+  /// @brief Set the state of the tidal model from a mapped file.
+  ///
+  /// @param[in] file The mapped file holding the tiled state.
+  /// @param[in] max_resident The maximum number of shards kept resident, 0
+  /// if unbounded.
+  auto setstate_instance(const std::shared_ptr<detail::MappedFile>& file,
+                         std::size_t max_resident) -> void;
+
+  /// @brief Get the shard whose tile contains a point.
+  ///
+  /// A point outside the bounding box of the mesh is routed to the nearest
+  /// edge tile, whose shard handles the extrapolation.
+  ///
+  /// @param[in] point The point to locate.
+  /// @return The shard identifier.
+  auto locate(const geometry::Point& point) const -> std::size_t {
+    const auto lon = detail::math::normalize_angle(point.lon(), min_lon_);
+    auto ix = static_cast<int64_t>(static_cast<double>(n_lon_) *
+                                   (lon - min_lon_) / (max_lon_ - min_lon_));
+    auto iy = static_cast<int64_t>(static_cast<double>(n_lat_) *
+                                   (point.lat() - min_lat_) /
+                                   (max_lat_ - min_lat_));
+    ix = std::max(int64_t{0},
+                  std::min(ix, static_cast<int64_t>(n_lon_) - 1));
+    iy = std::max(int64_t{0},
+                  std::min(iy, static_cast<int64_t>(n_lat_) - 1));
+    return static_cast<std::size_t>(iy) * n_lon_ +
+           static_cast<std::size_t>(ix);
+  }
+
+  /// @brief Get a shard, faulting it in when it is not resident.
+  ///
+  /// @param[in] id The shard identifier.
+  /// @return The shard model, or nullptr for an empty tile.
+  auto acquire(std::size_t id) const -> std::shared_ptr<const shard_t>;
+
+  /// The mapped file holding the tiled state.
+  std::shared_ptr<detail::MappedFile> file_{};
+
+  /// The number of tiles along the longitude axis.
+  std::size_t n_lon_{0};
+
+  /// The number of tiles along the latitude axis.
+  std::size_t n_lat_{0};
+
+  /// The bounding box of the tiled mesh.
+  double min_lon_{0};
+  /// @copydoc min_lon_
+  double max_lon_{0};
+  /// @copydoc min_lon_
+  double min_lat_{0};
+  /// @copydoc min_lon_
+  double max_lat_{0};
+
+  /// Maximum number of resident shards, 0 if unbounded.
+  std::size_t max_resident_{0};
+
+  /// The shard registry, guarded by the mutex.
+  std::vector<Shard> shards_{};
+
+  /// The logical clock of the LRU eviction.
+  uint64_t clock_{0};
+
+  /// Serializes the shard faults and the evictions.
+  std::mutex mutex_{};
+};
+
+/// @brief Tiled out-of-core %LGP1 tidal model.
+///
+/// @tparam T The type of the wave models loaded.
+template <typename T>
+using TiledLGP1 = TiledLGP<T, 1>;
+
+/// @brief Tiled out-of-core %LGP2 tidal model.
+///
+/// @tparam T The type of the wave models loaded.
+template <typename T>
+using TiledLGP2 = TiledLGP<T, 2>;
+
+// /////////////////////////////////////////////////////////////////////////////
+template <typename T, int N>
+auto TiledLGP<T, N>::shard(const shard_t& model, const std::size_t n_lon,
+                           const std::size_t n_lat, const double overlap,
+                           std::ostream& ss) -> void {
+  if (n_lon == 0 || n_lat == 0) {
+    throw std::invalid_argument("the tile grid must hold at least one tile");
+  }
+  if (overlap < 0) {
+    throw std::invalid_argument("the tile overlap must be positive");
+  }
+  const auto& lon = model.index()->lon();
+  const auto& lat = model.index()->lat();
+  const auto min_lon = lon.minCoeff();
+  const auto max_lon = lon.maxCoeff();
+  const auto min_lat = lat.minCoeff();
+  const auto max_lat = lat.maxCoeff();
+  detail::serialize::write_data(ss, model.tide_type());
+  detail::serialize::write_data(ss, n_lon);
+  detail::serialize::write_data(ss, n_lat);
+  detail::serialize::write_data(ss, min_lon);
+  detail::serialize::write_data(ss, max_lon);
+  detail::serialize::write_data(ss, min_lat);
+  detail::serialize::write_data(ss, max_lat);
+  // The constituent set is written in the directory: the model exposes it
+  // without faulting any shard in.
+  const auto idents = model.identifiers();
+  detail::serialize::write_data(ss, idents.size());
+  for (const auto ident : idents) {
+    detail::serialize::write_data(ss, ident);
+  }
+  // Cropping is destructive: each tile is cut from a fresh copy of the
+  // model, rebuilt from its serialized state.
+  const auto state = model.getstate();
+  const auto lon_step = (max_lon - min_lon) / static_cast<double>(n_lon);
+  const auto lat_step = (max_lat - min_lat) / static_cast<double>(n_lat);
+  for (std::size_t iy = 0; iy < n_lat; ++iy) {
+    for (std::size_t ix = 0; ix < n_lon; ++ix) {
+      try {
+        auto tile =
+            shard_t::setstate(string_view(state.data(), state.size()));
+        tile.crop(min_lon + static_cast<double>(ix) * lon_step - overlap,
+                  min_lon + static_cast<double>(ix + 1) * lon_step + overlap,
+                  min_lat + static_cast<double>(iy) * lat_step - overlap,
+                  min_lat + static_cast<double>(iy + 1) * lat_step + overlap);
+        const auto tile_state = tile.getstate();
+        detail::serialize::write_data(ss, tile_state.size());
+        ss.write(tile_state.data(),
+                 static_cast<std::streamsize>(tile_state.size()));
+      } catch (const std::invalid_argument&) {
+        // The tile does not intersect the mesh.
+        detail::serialize::write_data(ss, std::size_t{0});
+      }
+    }
+  }
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+template <typename T, int N>
+auto TiledLGP<T, N>::setstate_instance(
+    const std::shared_ptr<detail::MappedFile>& file,
+    const std::size_t max_resident) -> void {
+  detail::isviewstream ss(file->view());
+  ss.exceptions(std::istream::failbit);
+  this->tide_type_ = detail::serialize::read_data<TideType>(ss);
+  n_lon_ = detail::serialize::read_data<std::size_t>(ss);
+  n_lat_ = detail::serialize::read_data<std::size_t>(ss);
+  if (n_lon_ == 0 || n_lat_ == 0) {
+    throw std::invalid_argument("the tile grid must hold at least one tile");
+  }
+  min_lon_ = detail::serialize::read_data<double>(ss);
+  max_lon_ = detail::serialize::read_data<double>(ss);
+  min_lat_ = detail::serialize::read_data<double>(ss);
+  max_lat_ = detail::serialize::read_data<double>(ss);
+  // The constituent set is exposed through placeholder entries, like a
+  // composite model does: the samples stay in the shards.
+  const auto n_idents = detail::serialize::read_data<std::size_t>(ss);
+  for (std::size_t ix = 0; ix < n_idents; ++ix) {
+    this->data_.emplace(detail::serialize::read_data<Constituent>(ss),
+                        DataVector<std::complex<T>>());
+  }
+  // Only the byte offsets of the shard states are kept: the states are read
+  // by the first query touching their tile.
+  shards_.resize(n_lon_ * n_lat_);
+  for (auto& shard : shards_) {
+    shard.length = detail::serialize::read_data<std::size_t>(ss);
+    shard.offset = static_cast<std::size_t>(ss.tellg());
+    if (shard.length != 0) {
+      ss.seekg(static_cast<std::streamoff>(shard.length), std::ios_base::cur);
+    }
+  }
+  file_ = file;
+  max_resident_ = max_resident;
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+template <typename T, int N>
+auto TiledLGP<T, N>::acquire(const std::size_t id) const
+    -> std::shared_ptr<const shard_t> {
+  auto* self = const_cast<TiledLGP<T, N>*>(this);
+  std::lock_guard<std::mutex> lock(self->mutex_);
+  auto& shard = self->shards_[id];
+  if (shard.length == 0) {
+    return {};
+  }
+  shard.stamp = ++self->clock_;
+  if (shard.model != nullptr) {
+    return shard.model;
+  }
+  shard.model = std::make_shared<const shard_t>(shard_t::setstate(
+      string_view(file_->view().data() + shard.offset, shard.length)));
+  // Evict the least recently used resident shards beyond the residency
+  // budget. The shard loaded by this fault carries the newest stamp, so it
+  // is never evicted.
+  if (max_resident_ != 0) {
+    auto resident_count = static_cast<std::size_t>(std::count_if(
+        self->shards_.begin(), self->shards_.end(),
+        [](const Shard& item) -> bool { return item.model != nullptr; }));
+    while (resident_count > max_resident_) {
+      auto* victim = static_cast<Shard*>(nullptr);
+      for (auto& item : self->shards_) {
+        if (item.model != nullptr &&
+            (victim == nullptr || item.stamp < victim->stamp)) {
+          victim = &item;
+        }
+      }
+      // A query interpolating from the victim keeps its own reference: the
+      // shard is only destroyed when the last query using it completes.
+      victim->model.reset();
+      --resident_count;
+    }
+  }
+  return shard.model;
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+template <typename T, int N>
+auto TiledLGP<T, N>::interpolate(const geometry::Point& point,
+                                 Quality& quality, Accelerator* acc) const
+    -> const ConstituentValues& {
+  auto* tiled_acc = reinterpret_cast<TiledLGPAccelerator*>(acc);
+  const auto id = locate(point);
+  if (static_cast<int64_t>(id) != tiled_acc->shard()) {
+    // The cached triangle indexes the mesh of another shard: it must not
+    // seed the search in this one.
+    tiled_acc->set(mesh::SelectedTriangle());
+    tiled_acc->set_shard(static_cast<int64_t>(id));
+  }
+  const auto shard = acquire(id);
+  if (shard == nullptr) {
+    // The tile does not intersect the mesh.
+    ++tiled_acc->counters().undefined;
+    tiled_acc->clear();
+    for (const auto& item : this->data_) {
+      tiled_acc->emplace_back(
+          item.first,
+          std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
+                               std::numeric_limits<double>::quiet_NaN()));
+    }
+    quality = Quality::kUndefined;
+    return tiled_acc->values();
+  }
+  return shard->interpolate(point, quality, acc);
+}
+
+}  // namespace tidal_model
+}  // namespace fes
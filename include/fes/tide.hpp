@@ -35,17 +35,28 @@
 /// above formula.
 #pragma once
 #include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <numeric>
+#include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "fes/abstract_tidal_model.hpp"
+#include "fes/angle/astronomic.hpp"
 #include "fes/detail/broadcast.hpp"
+#include "fes/detail/math.hpp"
 #include "fes/detail/thread.hpp"
+#include "fes/detail/trace.hpp"
 #include "fes/eigen.hpp"
+#include "fes/leap_seconds.hpp"
 #include "fes/settings.hpp"
 #include "fes/wave.hpp"
 #include "fes/wave/long_period_equilibrium.hpp"
+#include "fes/wave/soa_table.hpp"
 #include "fes/wave/table.hpp"
 
 namespace fes {
@@ -89,9 +100,543 @@ static auto build_wave_table(const AbstractTidalModel<T>* const tidal_model,
   return result;
 }
 
+/// Sum the heights of the tidal constituents stored in a wave table.
+///
+/// The wave table must have been interpolated at the requested position and
+/// the nodal corrections adjusted to the requested date before calling this
+/// function.
+///
+/// @param[in] wave_table The list of tidal constituents used for the tidal
+/// prediction.
+/// @param[inout] h The height of the diurnal and semi-diurnal constituents of
+/// the tidal spectrum.
+/// @param[inout] h_long_period The height of the long period wave constituents
+/// of the tidal spectrum.
+inline auto accumulate_tide(const wave::Table& wave_table, double& h,
+                            double& h_long_period) -> void {
+  for (const auto& wave : wave_table) {
+    auto phi = wave->vu();
+    auto tide = wave->f() * (wave->tide().real() * std::cos(phi) +
+                             wave->tide().imag() * std::sin(phi));
+    if (wave->admittance() || wave->dynamic()) {
+      wave->type() == Wave::kShortPeriod ? h += tide : h_long_period += tide;
+    }
+  }
+}
+
+/// Run a worker over the items, instantiated for the scalar type selected
+/// by the settings.
+///
+/// The worker receives a value of the scalar type of the harmonic summation
+/// (float or double) as its first argument, before the range of items it is
+/// responsible for.
+///
+/// @param[in] worker The worker, taking the scalar type tag and the range of
+/// items to process.
+/// @param[in] single_precision True to evaluate the harmonic summation in
+/// single precision.
+/// @param[in] size The number of items to process.
+/// @param[in] num_threads The number of threads to use.
+/// @param[in] chunk_size The number of items claimed at once by a worker
+/// thread (0 for one static chunk per thread).
+/// @param[in] pin_threads True to pin the workers to one CPU each.
+template <typename Worker>
+inline auto parallel_for_precision(Worker&& worker,
+                                   const bool single_precision,
+                                   const int64_t size,
+                                   const size_t num_threads,
+                                   const size_t chunk_size,
+                                   const bool pin_threads) -> void {
+  if (single_precision) {
+    parallel_for(
+        [&worker](const int64_t start, const int64_t end) {
+          worker(float{}, start, end);
+        },
+        size, num_threads, chunk_size, pin_threads);
+  } else {
+    parallel_for(
+        [&worker](const int64_t start, const int64_t end) {
+          worker(double{}, start, end);
+        },
+        size, num_threads, chunk_size, pin_threads);
+  }
+}
+
+/// @brief Vectorized evaluation of the harmonic summation.
+///
+/// Walking the wave table calls scalar `std::cos`/`std::sin` per constituent,
+/// which dominates the runtime when the summation is evaluated for a large
+/// number of epochs. This kernel gathers the per-constituent quantities into
+/// contiguous arrays and evaluates
+/// \f$f \cdot (Re \cdot \cos(vu) + Im \cdot \sin(vu))\f$ for all active waves
+/// at once with Eigen, which applies the SIMD instruction set selected at
+/// build time (SSE/AVX/NEON).
+///
+/// The active waves are mirrored into the structure-of-arrays view
+/// (wave::SoaTable) at construction; only the time and position dependent
+/// quantities are refreshed per evaluation.
+///
+/// @tparam U The scalar type of the summation arithmetic: float halves the
+/// memory traffic of the summation and doubles the number of SIMD lanes per
+/// instruction, at the cost of a relative error on the order of the float
+/// epsilon.
+template <typename U>
+class BasicHarmonicSummationKernel {
+ public:
+  /// The type of the arrays holding the summation terms.
+  using Array = Eigen::Array<U, Eigen::Dynamic, 1>;
+
+  /// Build a kernel from the wave table used for the tidal prediction.
+  ///
+  /// @param[in] wave_table The list of tidal constituents used for the tidal
+  /// prediction. The table must outlive the kernel.
+  /// @param[in] fast_sincos If true, the sine and cosine terms are evaluated
+  /// with the polynomial approximation instead of libm.
+  explicit BasicHarmonicSummationKernel(wave::Table& wave_table,
+                                        const bool fast_sincos = false)
+      : soa_(wave_table), fast_sincos_(fast_sincos) {
+    const auto size = soa_.size();
+    tide_.resize(size);
+    cos_vu_.resize(size);
+    sin_vu_.resize(size);
+  }
+
+  /// Adjust the nodal corrections of the active waves to the given date.
+  ///
+  /// @param[in] angles Astronomic angle, indicating the date on which the
+  /// tide is to be calculated.
+  inline auto update_nodal_corrections(const fes::angle::Astronomic& angles)
+      -> void {
+    soa_.update_nodal_corrections(angles);
+  }
+
+  /// Evaluate the harmonic summation for the current state of the wave table.
+  ///
+  /// @param[inout] h The height of the diurnal and semi-diurnal constituents
+  /// of the tidal spectrum.
+  /// @param[inout] h_long_period The height of the long period wave
+  /// constituents of the tidal spectrum.
+  inline auto accumulate(double& h, double& h_long_period) -> void {
+    soa_.update_tide();
+    if (fast_sincos_) {
+      for (Eigen::Index ix = 0; ix < soa_.size(); ++ix) {
+        auto sin_vu = 0.0;
+        auto cos_vu = 0.0;
+        std::tie(sin_vu, cos_vu) =
+            detail::math::fast_sincos(static_cast<double>(soa_.vu()(ix)));
+        sin_vu_(ix) = static_cast<U>(sin_vu);
+        cos_vu_(ix) = static_cast<U>(cos_vu);
+      }
+      tide_ = soa_.f() * (soa_.real() * cos_vu_ + soa_.imag() * sin_vu_);
+    } else {
+      tide_ = soa_.f() *
+              (soa_.real() * soa_.vu().cos() + soa_.imag() * soa_.vu().sin());
+    }
+    h += static_cast<double>(tide_.head(soa_.n_short()).sum());
+    h_long_period +=
+        static_cast<double>(tide_.tail(soa_.size() - soa_.n_short()).sum());
+  }
+
+ private:
+  /// Structure-of-arrays view on the active waves.
+  wave::BasicSoaTable<U> soa_;
+  /// True if the sine and cosine terms are evaluated with the polynomial
+  /// approximation.
+  bool fast_sincos_;
+  /// Scratch array holding the per-constituent heights.
+  Array tide_{};
+  /// Scratch array holding the cos(vu) terms of the approximation.
+  Array cos_vu_{};
+  /// Scratch array holding the sin(vu) terms of the approximation.
+  Array sin_vu_{};
+};
+
+/// Harmonic summation kernel evaluated in double precision.
+using HarmonicSummationKernel = BasicHarmonicSummationKernel<double>;
+
+/// @brief Harmonic summation specialized for a constituent set declared at
+/// compile time.
+///
+/// The dynamic kernel sizes its arrays and its loop bounds from the wave
+/// table at run time. A production configuration always evaluates the same
+/// constituent set, so this kernel declares the set as a template parameter
+/// pack: the number of active waves is a compile-time constant, the
+/// summation operates on fixed-size arrays held on the stack and the
+/// compiler fully unrolls and vectorizes it without any runtime bound. The
+/// declared set is checked once against the active waves of the table when
+/// the kernel is built, so a configuration drifting away from the compiled
+/// set is reported immediately instead of producing a wrong prediction.
+///
+/// @tparam U The scalar type of the summation arithmetic.
+/// @tparam Idents The identifiers of the active waves of the table, in any
+/// order.
+template <typename U, Constituent... Idents>
+class BasicFixedHarmonicSummationKernel {
+ public:
+  /// The number of active waves, fixed at compile time.
+  static constexpr Eigen::Index kSize =
+      static_cast<Eigen::Index>(sizeof...(Idents));
+
+  /// The type of the arrays holding the summation terms.
+  using Array = Eigen::Array<U, kSize, 1>;
+
+  /// Build a kernel from the wave table used for the tidal prediction.
+  ///
+  /// @param[in] wave_table The list of tidal constituents used for the tidal
+  /// prediction. Its active waves must be exactly the declared constituent
+  /// set. The table must outlive the kernel.
+  /// @param[in] fast_sincos If true, the sine and cosine terms are evaluated
+  /// with the polynomial approximation instead of libm.
+  /// @throw std::invalid_argument if the active waves of the table do not
+  /// match the declared constituent set.
+  explicit BasicFixedHarmonicSummationKernel(wave::Table& wave_table,
+                                             const bool fast_sincos = false)
+      : soa_(wave_table), fast_sincos_(fast_sincos) {
+    if (soa_.size() != kSize) {
+      throw std::invalid_argument(
+          "the wave table activates " + std::to_string(soa_.size()) +
+          " waves, but the kernel is specialized for " +
+          std::to_string(sizeof...(Idents)));
+    }
+    const std::array<Constituent, sizeof...(Idents)> idents{{Idents...}};
+    for (const auto* wave : soa_.waves()) {
+      if (std::find(idents.begin(), idents.end(), wave->ident()) ==
+          idents.end()) {
+        throw std::invalid_argument(
+            std::string(wave->name()) +
+            " is active in the wave table but is not part of the declared "
+            "constituent set");
+      }
+    }
+  }
+
+  /// Adjust the nodal corrections of the active waves to the given date.
+  ///
+  /// @param[in] angles Astronomic angle, indicating the date on which the
+  /// tide is to be calculated.
+  inline auto update_nodal_corrections(const fes::angle::Astronomic& angles)
+      -> void {
+    soa_.update_nodal_corrections(angles);
+  }
+
+  /// Evaluate the harmonic summation for the current state of the wave table.
+  ///
+  /// @param[inout] h The height of the diurnal and semi-diurnal constituents
+  /// of the tidal spectrum.
+  /// @param[inout] h_long_period The height of the long period wave
+  /// constituents of the tidal spectrum.
+  inline auto accumulate(double& h, double& h_long_period) -> void {
+    soa_.update_tide();
+    // The fixed-size heads expose the compile-time extent to Eigen: the
+    // expressions below carry no runtime loop bound.
+    const auto f = soa_.f().template head<kSize>();
+    const auto real = soa_.real().template head<kSize>();
+    const auto imag = soa_.imag().template head<kSize>();
+    if (fast_sincos_) {
+      for (Eigen::Index ix = 0; ix < kSize; ++ix) {
+        auto sin_vu = 0.0;
+        auto cos_vu = 0.0;
+        std::tie(sin_vu, cos_vu) =
+            detail::math::fast_sincos(static_cast<double>(soa_.vu()(ix)));
+        sin_vu_(ix) = static_cast<U>(sin_vu);
+        cos_vu_(ix) = static_cast<U>(cos_vu);
+      }
+      tide_ = f * (real * cos_vu_ + imag * sin_vu_);
+    } else {
+      const auto vu = soa_.vu().template head<kSize>();
+      tide_ = f * (real * vu.cos() + imag * vu.sin());
+    }
+    h += static_cast<double>(tide_.head(soa_.n_short()).sum());
+    h_long_period +=
+        static_cast<double>(tide_.tail(kSize - soa_.n_short()).sum());
+  }
+
+ private:
+  /// Structure-of-arrays view on the active waves.
+  wave::BasicSoaTable<U> soa_;
+  /// True if the sine and cosine terms are evaluated with the polynomial
+  /// approximation.
+  bool fast_sincos_;
+  /// Scratch array holding the per-constituent heights.
+  Array tide_{};
+  /// Scratch array holding the cos(vu) terms of the approximation.
+  Array cos_vu_{};
+  /// Scratch array holding the sin(vu) terms of the approximation.
+  Array sin_vu_{};
+};
+
+/// Fixed-set harmonic summation kernel evaluated in double precision.
+///
+/// @tparam Idents The identifiers of the active waves of the table, in any
+/// order.
+template <Constituent... Idents>
+using FixedHarmonicSummationKernel =
+    BasicFixedHarmonicSummationKernel<double, Idents...>;
+
+/// @brief Harmonic summation over a block of epochs at a fixed position.
+///
+/// The per-epoch evaluation interleaves the gathering of the nodal
+/// corrections with the trigonometric evaluation, one epoch at a time. This
+/// kernel separates the two: the \f$f\f$ and \f$vu\f$ values are gathered
+/// into epoch × constituent matrices for a whole block, then the summation
+/// is evaluated for the block with two dense matrix-vector products against
+/// the interpolated constituents. The arithmetic stage only touches
+/// contiguous arrays and carries no per-epoch control flow, which saturates
+/// the SIMD units and is the exact shape an accelerator offload of the
+/// summation would consume.
+///
+/// @tparam U The scalar type of the summation arithmetic: float halves the
+/// memory traffic of the block matrices and doubles the number of SIMD lanes
+/// per instruction, at the cost of a relative error on the order of the
+/// float epsilon.
+template <typename U>
+class BasicBatchedHarmonicSummationKernel {
+ public:
+  /// The type of the matrices holding the gathered blocks.
+  using Matrix = Eigen::Matrix<U, Eigen::Dynamic, Eigen::Dynamic>;
+  /// The type of the vectors holding the per-epoch sums of a block.
+  using Vector = Eigen::Matrix<U, Eigen::Dynamic, 1>;
+
+  /// Build a kernel from the wave table used for the tidal prediction.
+  ///
+  /// @param[in] wave_table The list of tidal constituents used for the tidal
+  /// prediction.
+  /// @param[in] block_capacity The maximum number of epochs evaluated per
+  /// block.
+  /// @param[in] fast_sincos If true, the sine and cosine terms are evaluated
+  /// with the polynomial approximation instead of libm.
+  BasicBatchedHarmonicSummationKernel(wave::Table& wave_table,
+                                      const Eigen::Index block_capacity,
+                                      const bool fast_sincos = false)
+      : soa_(wave_table), fast_sincos_(fast_sincos) {
+    const auto size = soa_.size();
+    f_.resize(block_capacity, size);
+    vu_.resize(block_capacity, size);
+    a_.resize(block_capacity, size);
+    b_.resize(block_capacity, size);
+    h_.resize(block_capacity);
+    h_long_period_.resize(block_capacity);
+  }
+
+  /// Load the interpolated constituents.
+  ///
+  /// The wave table must have been interpolated at the requested position
+  /// and the missing waves inferred by admittance before calling this
+  /// method. The interpolated values do not depend on time, so this is done
+  /// once per position.
+  inline auto load_constituents() -> void { soa_.update_tide(); }
+
+  /// Adjust the nodal corrections to the given date and gather them into one
+  /// row of the block.
+  ///
+  /// @param[in] row The row of the block to fill.
+  /// @param[in] angles Astronomic angle, indicating the date on which the
+  /// tide is to be calculated.
+  /// @param[in] angle_updated False if the angle was served from the cache:
+  /// the corrections are then unchanged and only gathered into the row.
+  inline auto gather(const Eigen::Index row,
+                     const fes::angle::Astronomic& angles,
+                     const bool angle_updated = true) -> void {
+    if (angle_updated) {
+      soa_.update_nodal_corrections(angles);
+    }
+    f_.row(row) = soa_.f().matrix().transpose();
+    vu_.row(row) = soa_.vu().matrix().transpose();
+  }
+
+  /// Evaluate the harmonic summation for the gathered block.
+  ///
+  /// @param[in] rows The number of gathered rows of the block.
+  /// @param[inout] h The heights of the diurnal and semi-diurnal
+  /// constituents of the tidal spectrum, one element per row of the block.
+  /// @param[inout] h_long_period The heights of the long period wave
+  /// constituents of the tidal spectrum, one element per row of the block.
+  inline auto evaluate(const Eigen::Index rows, Eigen::Ref<Eigen::VectorXd> h,
+                       Eigen::Ref<Eigen::VectorXd> h_long_period) -> void {
+    const auto size = soa_.size();
+    const auto n_short = soa_.n_short();
+    if (fast_sincos_) {
+      for (Eigen::Index jx = 0; jx < size; ++jx) {
+        for (Eigen::Index ix = 0; ix < rows; ++ix) {
+          auto sin_vu = 0.0;
+          auto cos_vu = 0.0;
+          std::tie(sin_vu, cos_vu) =
+              detail::math::fast_sincos(static_cast<double>(vu_(ix, jx)));
+          b_(ix, jx) = static_cast<U>(sin_vu);
+          a_(ix, jx) = static_cast<U>(cos_vu);
+        }
+      }
+      a_.topRows(rows).array() *= f_.topRows(rows).array();
+      b_.topRows(rows).array() *= f_.topRows(rows).array();
+    } else {
+      a_.topRows(rows) =
+          f_.topRows(rows).array() * vu_.topRows(rows).array().cos();
+      b_.topRows(rows) =
+          f_.topRows(rows).array() * vu_.topRows(rows).array().sin();
+    }
+    h_.head(rows).noalias() =
+        a_.topLeftCorner(rows, n_short) * soa_.real().head(n_short).matrix() +
+        b_.topLeftCorner(rows, n_short) * soa_.imag().head(n_short).matrix();
+    h_long_period_.head(rows).noalias() =
+        a_.topRightCorner(rows, size - n_short) *
+            soa_.real().tail(size - n_short).matrix() +
+        b_.topRightCorner(rows, size - n_short) *
+            soa_.imag().tail(size - n_short).matrix();
+    h.head(rows) += h_.head(rows).template cast<double>();
+    h_long_period.head(rows) +=
+        h_long_period_.head(rows).template cast<double>();
+  }
+
+ private:
+  /// Structure-of-arrays view on the active waves.
+  wave::BasicSoaTable<U> soa_;
+  /// True if the sine and cosine terms are evaluated with the polynomial
+  /// approximation.
+  bool fast_sincos_;
+  /// Nodal correction for amplitude, one row per epoch of the block.
+  Matrix f_{};
+  /// v (greenwich argument) + u (nodal correction for phase), one row per
+  /// epoch of the block.
+  Matrix vu_{};
+  /// Scratch matrix holding the f·cos(vu) factors of the block.
+  Matrix a_{};
+  /// Scratch matrix holding the f·sin(vu) factors of the block.
+  Matrix b_{};
+  /// Scratch vector holding the short period sums of the block.
+  Vector h_{};
+  /// Scratch vector holding the long period sums of the block.
+  Vector h_long_period_{};
+};
+
+/// Batched harmonic summation kernel evaluated in double precision.
+using BatchedHarmonicSummationKernel =
+    BasicBatchedHarmonicSummationKernel<double>;
+
+/// @brief Harmonic summation by phase rotation for uniformly sampled series.
+///
+/// For a series sampled with a constant step, the greenwich argument of each
+/// constituent advances by a constant increment per step, so the
+/// \f$\cos(vu)\f$ and \f$\sin(vu)\f$ terms of the harmonic summation can be
+/// updated with one complex multiply per constituent instead of recomputing
+/// the transcendental functions at every epoch. The nodal corrections
+/// (\f$f\f$ and \f$u\f$) vary over the 18.6-year lunar node cycle, so the
+/// kernel is periodically resynchronized against the exact evaluation of the
+/// astronomic angles to bound the drift.
+class PhaseRecurrenceKernel {
+ public:
+  /// Build a kernel from the wave table used for the tidal prediction.
+  ///
+  /// @param[in] wave_table The list of tidal constituents used for the tidal
+  /// prediction.
+  /// @param[in] step The time elapsed between two consecutive epochs of the
+  /// series, in seconds.
+  PhaseRecurrenceKernel(wave::Table& wave_table, const double step)
+      : soa_(wave_table) {
+    const auto size = soa_.size();
+    cos_vu_.resize(size);
+    sin_vu_.resize(size);
+    scratch_.resize(size);
+    tide_.resize(size);
+
+    // The wave frequencies are constant, so the per-step rotation is
+    // computed once. Wave::freq is expressed in radians per hour.
+    const auto delta = Eigen::ArrayXd(soa_.freq() * (step / 3600.0));
+    cos_delta_ = delta.cos();
+    sin_delta_ = delta.sin();
+  }
+
+  /// Resynchronize the kernel against an exact evaluation of the astronomic
+  /// angles.
+  ///
+  /// The wave table must have been interpolated at the requested position
+  /// and the missing waves inferred by admittance before calling this
+  /// method.
+  ///
+  /// @param[in] angles Astronomic angle, indicating the resynchronization
+  /// date.
+  inline auto resynchronize(const fes::angle::Astronomic& angles) -> void {
+    soa_.update_nodal_corrections(angles);
+    soa_.update_tide();
+    cos_vu_ = soa_.vu().cos();
+    sin_vu_ = soa_.vu().sin();
+  }
+
+  /// Advance the phases by one step of the series.
+  inline auto advance() -> void {
+    scratch_ = cos_vu_ * cos_delta_ - sin_vu_ * sin_delta_;
+    sin_vu_ = sin_vu_ * cos_delta_ + cos_vu_ * sin_delta_;
+    cos_vu_ = scratch_;
+  }
+
+  /// Evaluate the harmonic summation for the current phases.
+  ///
+  /// @param[inout] h The height of the diurnal and semi-diurnal constituents
+  /// of the tidal spectrum.
+  /// @param[inout] h_long_period The height of the long period wave
+  /// constituents of the tidal spectrum.
+  inline auto accumulate(double& h, double& h_long_period) -> void {
+    tide_ = soa_.f() * (soa_.real() * cos_vu_ + soa_.imag() * sin_vu_);
+    h += tide_.head(soa_.n_short()).sum();
+    h_long_period += tide_.tail(soa_.size() - soa_.n_short()).sum();
+  }
+
+ private:
+  /// Structure-of-arrays view on the active waves.
+  wave::SoaTable soa_;
+  /// Cosine of the phase of each constituent.
+  Eigen::ArrayXd cos_vu_{};
+  /// Sine of the phase of each constituent.
+  Eigen::ArrayXd sin_vu_{};
+  /// Cosine of the per-step phase increment of each constituent.
+  Eigen::ArrayXd cos_delta_{};
+  /// Sine of the per-step phase increment of each constituent.
+  Eigen::ArrayXd sin_delta_{};
+  /// Scratch array used by the phase rotation.
+  Eigen::ArrayXd scratch_{};
+  /// Scratch array holding the per-constituent heights.
+  Eigen::ArrayXd tide_{};
+};
+
+/// Per-field state of a worker of fes::evaluate_tide_group: the accelerator,
+/// wave table, long period handler and summation kernel of one model of the
+/// group. The members reference each other, so the state is built in place
+/// and never moved.
+///
+/// @tparam T The type of tidal constituents modelled.
+/// @tparam U The scalar type of the harmonic summation.
+template <typename T, typename U>
+struct GroupField {
+  /// The accelerator of the model.
+  std::unique_ptr<Accelerator> acc;
+  /// The wave table interpolated from the model.
+  wave::Table wave_table;
+  /// Handler of the long-period equilibrium ocean tides.
+  wave::LongPeriodEquilibrium lpe;
+  /// The kernel evaluating the harmonic summation.
+  BasicHarmonicSummationKernel<U> kernel;
+
+  /// Build the state of one field.
+  ///
+  /// @param[in] model The tidal model of the field.
+  /// @param[in] prototype The wave table prototype built for the model.
+  /// @param[in] settings Settings for the tide computation.
+  GroupField(const AbstractTidalModel<T>* const model,
+             const wave::Table& prototype, const Settings& settings)
+      : acc(model->accelerator(settings.astronomic_formulae(),
+                               settings.time_tolerance())),
+        wave_table(prototype.clone()),
+        lpe(wave_table),
+        kernel(wave_table, settings.fast_sincos()) {
+    acc->bind(wave_table);
+  }
+};
+
 /// Compute the tidal prediction for a given point.
 ///
 /// @tparam T The type of tidal constituents modelled.
+/// @tparam Kernel The type of the harmonic summation kernel: the dynamic
+/// kernel sized from the wave table, or a kernel specialized for a
+/// constituent set declared at compile time.
 /// @param[in] tidal_model The tidal model.
 /// @param[in] epoch The number of seconds since 1970-01-01T00:00:00Z.
 /// @param[in] leap_seconds The number of leap seconds since
@@ -102,6 +647,7 @@ static auto build_wave_table(const AbstractTidalModel<T>* const tidal_model,
 /// prediction.
 /// @param[in] long_period Handler to to compute the long-period equilibrium
 ///   ocean tides.
+/// @param[inout] kernel The kernel used to evaluate the harmonic summation.
 /// @param[inout] acc The accelerator used to speed up the computation.
 /// @return A tuple containing:
 /// - The height of the the diurnal and semi-diurnal constituents of the
@@ -109,23 +655,32 @@ static auto build_wave_table(const AbstractTidalModel<T>* const tidal_model,
 /// - The height of the long period wave constituents of the tidal
 ///   spectrum (same units as the constituents).
 /// - The quality of the interpolation (see Quality)
-template <typename T>
+template <typename T, typename Kernel>
 inline auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
                           const double epoch, const uint16_t leap_seconds,
                           const double longitude, const double latitude,
                           wave::Table& wave_table,
                           wave::LongPeriodEquilibrium& long_period,
-                          Accelerator* acc)
+                          Kernel& kernel, Accelerator* acc)
     -> std::tuple<double, double, Quality> {
   // Update the astronomic angle used to evaluate the tidal constituents.
   const auto& angles = acc->calculate_angle(epoch, leap_seconds);
-  // Adjusts nodal corrections to the tidal estimate date.
-  wave_table.compute_nodal_corrections(angles);
+  // Adjusts nodal corrections to the tidal estimate date. The corrections
+  // only depend on the angle, so they are unchanged when it was served from
+  // the cache.
+  if (acc->angle_updated()) {
+    detail::trace::Scope span("nodal_corrections");
+    kernel.update_nodal_corrections(angles);
+  }
 
   // Interpolation, at the requested position, of the waves provided by the
   // model used.
-  auto quality =
-      tidal_model->interpolate({longitude, latitude}, wave_table, acc);
+  auto quality = Quality();
+  {
+    detail::trace::Scope span("interpolate");
+    quality = tidal_model->interpolate({longitude, latitude}, wave_table, acc);
+  }
+  detail::trace::Scope span("harmonic_summation");
   // Initialization, depending on the type of tide calculated, of he long
   // period wave constituents of the tidal spectrum
   auto h_long_period = tidal_model->tide_type() == fes::kTide
@@ -138,19 +693,126 @@ inline auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
     return {std::numeric_limits<double>::quiet_NaN(), h_long_period, quality};
   }
   auto h = 0.0;
-  for (const auto& wave : wave_table) {
-    auto phi = wave->vu();
-    auto tide = wave->f() * (wave->tide().real() * std::cos(phi) +
-                             wave->tide().imag() * std::sin(phi));
-    if (wave->admittance() || wave->dynamic()) {
-      wave->type() == Wave::kShortPeriod ? h += tide : h_long_period += tide;
-    }
-  }
+  kernel.accumulate(h, h_long_period);
   return {h, h_long_period, quality};
 }
 
 }  // namespace detail
 
+/// Ocean tide calculation writing the results into caller-provided buffers.
+///
+/// This overload behaves like the allocating form of fes::evaluate_tide but
+/// reuses the given output vectors, so callers evaluating many small chunks
+/// can preallocate the buffers once and avoid the allocator churn of fresh
+/// result vectors per call.
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] epoch Date of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] leap_seconds Number of leap seconds elapsed since
+/// 1970-01-01T00:00:00Z
+/// @param[in] longitude Longitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] latitude Latitude in degrees for the position at which the tide
+/// is calculated
+/// @param[out] tide The height of the the diurnal and semi-diurnal
+/// constituents of the tidal spectrum.
+/// @param[out] long_period The height of the long period wave constituents of
+/// the tidal spectrum.
+/// @param[out] quality The quality of the tide calculation.
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @note The input vectors could not have the same size: a size-1 vector is
+/// broadcast against the others without materializing the repeated values.
+/// The output vectors must have the broadcast size.
+/// @throw std::invalid_argument if the input vectors could not be broadcast
+/// together or if the output vectors do not have the broadcast size.
+template <typename T>
+auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
+                   const Eigen::Ref<const Eigen::VectorXd>& epoch,
+                   const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+                   const Eigen::Ref<const Eigen::VectorXd>& longitude,
+                   const Eigen::Ref<const Eigen::VectorXd>& latitude,
+                   Eigen::Ref<Eigen::VectorXd> tide,
+                   Eigen::Ref<Eigen::VectorXd> long_period,
+                   Eigen::Ref<Vector<Quality>> quality,
+                   const Settings& settings = Settings(),
+                   const size_t num_threads = 0) -> void {
+  // Checks the input parameters
+  const auto size = detail::broadcast_eigen_shape(
+      "epoch", epoch, "leap_seconds", leap_seconds, "longitude", longitude,
+      "latitude", latitude);
+  detail::check_eigen_shape("tide", tide, "long_period", long_period,
+                            "quality", quality);
+  if (tide.size() != size) {
+    throw std::invalid_argument(
+        "tide could not be broadcast together with shape " +
+        detail::eigen_shape(tide) + ", (" + std::to_string(size) + ")");
+  }
+
+  // Size-1 vectors are broadcast against the others.
+  auto epoch_view = detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(
+      epoch);
+  auto leap_seconds_view =
+      detail::BroadcastView<Eigen::Ref<const fes::Vector<uint16_t>>>(
+          leap_seconds);
+  auto longitude_view =
+      detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(longitude);
+  auto latitude_view =
+      detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(latitude);
+
+  // When the inputs are sorted by position, consecutive indices jump between
+  // epochs and the per-worker angle cache governed by time_tolerance
+  // thrashes even if the dataset only spans a few distinct epochs. Grouping
+  // the indices by epoch before partitioning hands each worker a monotonic
+  // sequence of epochs, so the angles and the nodal corrections are
+  // evaluated once per distinct epoch per worker. The sort is stable to keep
+  // the original order within one epoch.
+  auto order = std::vector<int64_t>();
+  if (settings.group_by_epoch() && epoch.size() > 1) {
+    order.resize(static_cast<size_t>(size));
+    std::iota(order.begin(), order.end(), int64_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&epoch_view](const int64_t lhs, const int64_t rhs) {
+                       return epoch_view(lhs) < epoch_view(rhs);
+                     });
+  }
+
+  // Worker responsible for the calculation of the tide at a given position
+  // The wave table is prepared once and cloned per worker: the clone places
+  // all its wave objects in one contiguous block allocated in a single call.
+  const auto wave_table_prototype =
+      detail::build_wave_table(tidal_model, settings.excluded());
+  // The scalar type of the harmonic summation is a runtime choice, so the
+  // worker is instantiated for both precisions and selected below.
+  auto worker = [&](auto precision, const int64_t start, const int64_t end) {
+    using U = decltype(precision);
+    auto acc = std::unique_ptr<Accelerator>(tidal_model->accelerator(
+        settings.astronomic_formulae(), settings.time_tolerance()));
+    auto* acc_ptr = acc.get();
+    auto wave_table = wave_table_prototype.clone();
+    acc_ptr->bind(wave_table);
+    auto lpe = wave::LongPeriodEquilibrium(wave_table);
+    auto kernel = detail::BasicHarmonicSummationKernel<U>(
+        wave_table, settings.fast_sincos());
+
+    for (auto ix = start; ix < end; ++ix) {
+      // The results are written at their original indices; only the
+      // evaluation order changes.
+      const auto jx = order.empty() ? ix : order[static_cast<size_t>(ix)];
+      std::tie(tide(jx), long_period(jx), quality(jx)) = detail::evaluate_tide(
+          tidal_model, epoch_view(jx), leap_seconds_view(jx),
+          longitude_view(jx), latitude_view(jx), wave_table, lpe, kernel,
+          acc_ptr);
+    }
+  };
+
+  detail::parallel_for_precision(worker, settings.single_precision(), size,
+                                 num_threads, settings.chunk_size(),
+                                 settings.pin_threads());
+}
+
 /// Ocean tide calculation
 ///
 /// @param[in] tidal_model Tidal model used to interpolate the modelized waves
@@ -179,6 +841,8 @@ inline auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
 /// to nan if no data is available at the given position. the long period wave
 /// constituents is always computed because this value does not depend on
 /// input grids.
+/// @note The input vectors could not have the same size: a size-1 vector is
+/// broadcast against the others without materializing the repeated values.
 template <typename T>
 auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
                    const Eigen::Ref<const Eigen::VectorXd>& epoch,
@@ -188,33 +852,1085 @@ auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
                    const Settings& settings = Settings(),
                    const size_t num_threads = 0)
     -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<Quality>> {
+  // Allocates the result vectors
+  const auto size = detail::broadcast_eigen_shape(
+      "epoch", epoch, "leap_seconds", leap_seconds, "longitude", longitude,
+      "latitude", latitude);
+  auto tide = Eigen::VectorXd(size);
+  auto long_period = Eigen::VectorXd(size);
+  auto quality = Vector<Quality>(size);
+
+  evaluate_tide(tidal_model, epoch, leap_seconds, longitude, latitude, tide,
+                long_period, quality, settings, num_threads);
+  return {tide, long_period, quality};
+}
+
+/// Ocean tide calculation resolving the leap seconds internally.
+///
+/// This overload behaves like fes::evaluate_tide but resolves the number of
+/// leap seconds of each epoch from the IERS table embedded in the library
+/// (see fes::leap_seconds), so callers do not need to assemble a leap second
+/// vector parallel to the epochs.
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] epoch Date of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] longitude Longitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] latitude Latitude in degrees for the position at which the tide
+/// is calculated
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains the heights of the short and long period
+/// constituents and the quality flags, as documented in fes::evaluate_tide.
+template <typename T>
+auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
+                   const Eigen::Ref<const Eigen::VectorXd>& epoch,
+                   const Eigen::Ref<const Eigen::VectorXd>& longitude,
+                   const Eigen::Ref<const Eigen::VectorXd>& latitude,
+                   const Settings& settings = Settings(),
+                   const size_t num_threads = 0)
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<Quality>> {
+  const auto resolved = fes::leap_seconds(epoch);
+  return evaluate_tide(tidal_model, epoch, resolved, longitude, latitude,
+                       settings, num_threads);
+}
+
+/// Ocean tide calculation for a time series observed at a fixed position.
+///
+/// This overload is tailored to the prediction of long time series at a
+/// fixed location, like a tide gauge: the tidal constituents are
+/// interpolated once at the requested position, then only the time dependent
+/// part of the calculation (astronomic angles, nodal corrections and the
+/// harmonic summation) is evaluated for each epoch provided.
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] epoch Dates of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] leap_seconds Number of leap seconds elapsed since
+/// 1970-01-01T00:00:00Z
+/// @param[in] longitude Longitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] latitude Latitude in degrees for the position at which the tide
+/// is calculated
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains:
+/// - The height of the the diurnal and semi-diurnal constituents of the
+///   tidal spectrum.
+/// - The height of the long period wave constituents of the tidal
+///   spectrum.
+/// - The quality of the tide calculation. Could be kUndefined if the
+///   point is not defined by the model, kInterpolated if the model is
+///   interpolated, kExtrapolated if the model is extrapolated.
+/// @note The units of the returned tide are the same as the units of the
+/// constituents loaded in the tidal model.
+template <typename T>
+auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
+                   const Eigen::Ref<const Eigen::VectorXd>& epoch,
+                   const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+                   const double longitude, const double latitude,
+                   const Settings& settings = Settings(),
+                   const size_t num_threads = 0)
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<Quality>> {
   // Checks the input parameters
-  detail::check_eigen_shape("epoch", epoch, "leap_seconds", leap_seconds,
-                            "longitude", longitude, "latitude", latitude);
+  detail::check_eigen_shape("epoch", epoch, "leap_seconds", leap_seconds);
 
   // Allocates the result vectors
   auto tide = Eigen::VectorXd(epoch.size());
   auto long_period = Eigen::VectorXd(epoch.size());
   auto quality = Vector<Quality>(epoch.size());
 
-  // Worker responsible for the calculation of the tide at a given position
+  // Worker responsible for the calculation of the tide for a chunk of the
+  // provided time series.
+  // The wave table is prepared once and cloned per worker: the clone places
+  // all its wave objects in one contiguous block allocated in a single call.
+  const auto wave_table_prototype =
+      detail::build_wave_table(tidal_model, settings.excluded());
+  // The scalar type of the harmonic summation is a runtime choice, so the
+  // worker is instantiated for both precisions and selected below.
+  auto worker = [&](auto precision, const int64_t start, const int64_t end) {
+    using U = decltype(precision);
+    // Number of epochs evaluated per block of the batched summation.
+    constexpr Eigen::Index block_size = 512;
+    auto acc = std::unique_ptr<Accelerator>(tidal_model->accelerator(
+        settings.astronomic_formulae(), settings.time_tolerance()));
+    auto* acc_ptr = acc.get();
+    auto wave_table = wave_table_prototype.clone();
+    acc_ptr->bind(wave_table);
+    auto lpe = wave::LongPeriodEquilibrium(wave_table);
+    auto kernel = detail::BasicBatchedHarmonicSummationKernel<U>(
+        wave_table, block_size, settings.fast_sincos());
+
+    // Interpolation, at the requested position, of the waves provided by the
+    // model used. The position does not change over time, so this is done
+    // only once per worker.
+    auto interpolation_quality =
+        tidal_model->interpolate({longitude, latitude}, wave_table, acc_ptr);
+    // The interpolated constituents do not depend on time, so the missing
+    // waves of the model can also be inferred by admittance once.
+    wave_table.admittance();
+    kernel.load_constituents();
+
+    for (auto bx = start; bx < end; bx += block_size) {
+      const auto rows = std::min<Eigen::Index>(block_size, end - bx);
+      // Gather the nodal corrections for the whole block, then evaluate the
+      // summation for the block at once.
+      for (Eigen::Index kx = 0; kx < rows; ++kx) {
+        const auto ix = bx + kx;
+        const auto& angles =
+            acc_ptr->calculate_angle(epoch(ix), leap_seconds(ix));
+        kernel.gather(kx, angles, acc_ptr->angle_updated());
+        long_period(ix) = tidal_model->tide_type() == fes::kTide
+                              ? lpe.lpe_minus_n_waves(angles, latitude)
+                              : 0.0;
+        quality(ix) = interpolation_quality;
+      }
+      if (interpolation_quality == kUndefined) {
+        tide.segment(bx, rows)
+            .setConstant(std::numeric_limits<double>::quiet_NaN());
+      } else {
+        tide.segment(bx, rows).setZero();
+        kernel.evaluate(rows, tide.segment(bx, rows),
+                        long_period.segment(bx, rows));
+      }
+    }
+  };
+
+  detail::parallel_for_precision(worker, settings.single_precision(),
+                                 epoch.size(), num_threads,
+                                 settings.chunk_size(),
+                                 settings.pin_threads());
+  return {tide, long_period, quality};
+}
+
+/// Ocean tide calculation for a time series at a fixed position, resolving
+/// the leap seconds internally.
+///
+/// This overload behaves like the fixed position form of fes::evaluate_tide
+/// but resolves the number of leap seconds of each epoch from the IERS table
+/// embedded in the library (see fes::leap_seconds).
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] epoch Dates of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] longitude Longitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] latitude Latitude in degrees for the position at which the tide
+/// is calculated
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains the heights of the short and long period
+/// constituents and the quality flags, as documented in fes::evaluate_tide.
+template <typename T>
+auto evaluate_tide(const AbstractTidalModel<T>* const tidal_model,
+                   const Eigen::Ref<const Eigen::VectorXd>& epoch,
+                   const double longitude, const double latitude,
+                   const Settings& settings = Settings(),
+                   const size_t num_threads = 0)
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<Quality>> {
+  const auto resolved = fes::leap_seconds(epoch);
+  return evaluate_tide(tidal_model, epoch, resolved, longitude, latitude,
+                       settings, num_threads);
+}
+
+/// Ocean tide calculation for a set of positions at a single date.
+///
+/// This overload is tailored to the generation of tide maps: one epoch,
+/// a large number of grid points. The astronomic angles and the nodal
+/// corrections, which only depend on time, are computed exactly once per
+/// worker; only the position dependent part of the calculation
+/// (interpolation, admittance and the harmonic summation) is evaluated for
+/// each point provided. It also avoids materializing an epoch and a leap
+/// second vector the size of the grid.
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] epoch Date of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] leap_seconds Number of leap seconds elapsed since
+/// 1970-01-01T00:00:00Z
+/// @param[in] longitude Longitudes in degrees for the positions at which the
+/// tide is calculated
+/// @param[in] latitude Latitudes in degrees for the positions at which the
+/// tide is calculated
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains:
+/// - The height of the the diurnal and semi-diurnal constituents of the
+///   tidal spectrum.
+/// - The height of the long period wave constituents of the tidal
+///   spectrum.
+/// - The quality of the tide calculation. Could be kUndefined if the
+///   point is not defined by the model, kInterpolated if the model is
+///   interpolated, kExtrapolated if the model is extrapolated.
+/// @note The units of the returned tide are the same as the units of the
+/// constituents loaded in the tidal model.
+template <typename T>
+auto evaluate_tide_grid(
+    const AbstractTidalModel<T>* const tidal_model, const double epoch,
+    const uint16_t leap_seconds,
+    const Eigen::Ref<const Eigen::VectorXd>& longitude,
+    const Eigen::Ref<const Eigen::VectorXd>& latitude,
+    const Settings& settings = Settings(), const size_t num_threads = 0)
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<Quality>> {
+  // Checks the input parameters
+  detail::check_eigen_shape("longitude", longitude, "latitude", latitude);
+
+  // Allocates the result vectors
+  auto tide = Eigen::VectorXd(longitude.size());
+  auto long_period = Eigen::VectorXd(longitude.size());
+  auto quality = Vector<Quality>(longitude.size());
+
+  // Worker responsible for the calculation of the tide for a chunk of the
+  // provided positions.
+  // The wave table is prepared once and cloned per worker: the clone places
+  // all its wave objects in one contiguous block allocated in a single call.
+  const auto wave_table_prototype =
+      detail::build_wave_table(tidal_model, settings.excluded());
+  // The scalar type of the harmonic summation is a runtime choice, so the
+  // worker is instantiated for both precisions and selected below.
+  auto worker = [&](auto precision, const int64_t start, const int64_t end) {
+    using U = decltype(precision);
+    auto acc = std::unique_ptr<Accelerator>(tidal_model->accelerator(
+        settings.astronomic_formulae(), settings.time_tolerance()));
+    auto* acc_ptr = acc.get();
+    auto wave_table = wave_table_prototype.clone();
+    auto lpe = wave::LongPeriodEquilibrium(wave_table);
+    auto kernel = detail::BasicHarmonicSummationKernel<U>(
+        wave_table, settings.fast_sincos());
+
+    // Update the astronomic angle used to evaluate the tidal constituents
+    // and adjust the nodal corrections. The date does not change from one
+    // position to another, so this is done only once per worker.
+    const auto& angles = acc_ptr->calculate_angle(epoch, leap_seconds);
+    kernel.update_nodal_corrections(angles);
+
+    // The positions are handed to the model by blocks: the batched entry
+    // point shares the spatial stage across the points of a block. The rows
+    // of the result matrix follow the constituent order of the model, mapped
+    // once to the corresponding wave table entries.
+    const auto idents = tidal_model->identifiers();
+    auto slots = std::vector<Wave*>();
+    slots.reserve(idents.size());
+    for (const auto ident : idents) {
+      slots.push_back(wave_table[ident].get());
+    }
+    constexpr int64_t block_size = 256;
+    auto points = std::vector<geometry::Point>();
+    points.reserve(block_size);
+    auto values = Matrix<std::complex<double>>();
+    auto interpolation_quality = Vector<Quality>();
+
+    for (auto jx = start; jx < end; jx += block_size) {
+      const auto block = std::min<int64_t>(block_size, end - jx);
+      points.clear();
+      for (auto kx = int64_t{0}; kx < block; ++kx) {
+        points.emplace_back(longitude(jx + kx), latitude(jx + kx));
+      }
+      // Interpolation, at the requested positions, of the waves provided by
+      // the model used.
+      tidal_model->interpolate_many(points, values, interpolation_quality,
+                                    acc_ptr);
+
+      for (auto kx = int64_t{0}; kx < block; ++kx) {
+        const auto ix = jx + kx;
+        for (size_t wx = 0; wx < slots.size(); ++wx) {
+          slots[wx]->tide(values(static_cast<Eigen::Index>(wx), kx));
+        }
+        // Calculation of the missing waves of the model by admittance.
+        wave_table.admittance();
+
+        auto h = 0.0;
+        auto h_long_period = tidal_model->tide_type() == fes::kTide
+                                 ? lpe.lpe_minus_n_waves(angles, latitude(ix))
+                                 : 0.0;
+        if (interpolation_quality(kx) == kUndefined) {
+          h = std::numeric_limits<double>::quiet_NaN();
+        } else {
+          kernel.accumulate(h, h_long_period);
+        }
+        tide(ix) = h;
+        long_period(ix) = h_long_period;
+        quality(ix) = interpolation_quality(kx);
+      }
+    }
+  };
+
+  detail::parallel_for_precision(worker, settings.single_precision(),
+                                 longitude.size(), num_threads,
+                                 settings.chunk_size(),
+                                 settings.pin_threads());
+  return {tide, long_period, quality};
+}
+
+/// Ocean tide calculation for a set of positions at a single date, resolving
+/// the leap seconds internally.
+///
+/// This overload behaves like fes::evaluate_tide_grid but resolves the number
+/// of leap seconds at the given epoch from the IERS table embedded in the
+/// library (see fes::leap_seconds).
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] epoch Date of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] longitude Longitudes in degrees for the positions at which the
+/// tide is calculated
+/// @param[in] latitude Latitudes in degrees for the positions at which the
+/// tide is calculated
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains the heights of the short and long period
+/// constituents and the quality flags, as documented in
+/// fes::evaluate_tide_grid.
+template <typename T>
+auto evaluate_tide_grid(
+    const AbstractTidalModel<T>* const tidal_model, const double epoch,
+    const Eigen::Ref<const Eigen::VectorXd>& longitude,
+    const Eigen::Ref<const Eigen::VectorXd>& latitude,
+    const Settings& settings = Settings(), const size_t num_threads = 0)
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<Quality>> {
+  return evaluate_tide_grid(tidal_model, epoch, fes::leap_seconds(epoch),
+                            longitude, latitude, settings, num_threads);
+}
+
+/// Ocean tide calculation for a uniformly sampled time series observed at a
+/// fixed position.
+///
+/// The phase of each constituent advances by a constant increment between two
+/// consecutive epochs of the series, so the harmonic summation is evaluated
+/// with a phase rotation recurrence (one complex multiply per constituent and
+/// per step) instead of recomputing the astronomic angles and the
+/// transcendental functions at every epoch. The recurrence is periodically
+/// resynchronized against the exact evaluation to bound the drift of the
+/// slowly varying terms: the nodal corrections are held constant and the
+/// long period equilibrium waves are interpolated linearly within each
+/// resynchronization window. With the default Schureman formulae of order 1
+/// the greenwich argument is linear in time and the recurrence introduces no
+/// other approximation.
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] epoch Date of the first element of the series expressed in
+/// number of seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] step Time elapsed between two consecutive epochs of the series,
+/// in seconds.
+/// @param[in] size Number of epochs of the series.
+/// @param[in] leap_seconds Number of leap seconds elapsed since
+/// 1970-01-01T00:00:00Z for each epoch of the series. A size-1 vector is
+/// broadcast over the whole series.
+/// @param[in] longitude Longitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] latitude Latitude in degrees for the position at which the tide
+/// is calculated
+/// @param[in] resynchronization Time elapsed between two exact evaluations of
+/// the astronomic angles, in seconds.
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains:
+/// - The height of the the diurnal and semi-diurnal constituents of the
+///   tidal spectrum.
+/// - The height of the long period wave constituents of the tidal
+///   spectrum.
+/// - The quality of the tide calculation. Could be kUndefined if the
+///   point is not defined by the model, kInterpolated if the model is
+///   interpolated, kExtrapolated if the model is extrapolated.
+/// @note The units of the returned tide are the same as the units of the
+/// constituents loaded in the tidal model.
+/// @throw std::invalid_argument if the step or the resynchronization interval
+/// is not positive.
+template <typename T>
+auto evaluate_tide_uniform(
+    const AbstractTidalModel<T>* const tidal_model, const double epoch,
+    const double step, const Eigen::Index size,
+    const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+    const double longitude, const double latitude,
+    const double resynchronization = 3600.0,
+    const Settings& settings = Settings(), const size_t num_threads = 0)
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<Quality>> {
+  // Checks the input parameters
+  if (step <= 0.0) {
+    throw std::invalid_argument("step must be positive");
+  }
+  if (resynchronization <= 0.0) {
+    throw std::invalid_argument("resynchronization must be positive");
+  }
+  if (leap_seconds.size() != size && leap_seconds.size() != 1) {
+    throw std::invalid_argument(
+        "leap_seconds could not be broadcast together with shape " +
+        detail::eigen_shape(leap_seconds) + ", (" + std::to_string(size) +
+        ")");
+  }
+  auto leap_seconds_view =
+      detail::BroadcastView<Eigen::Ref<const fes::Vector<uint16_t>>>(
+          leap_seconds);
+
+  // Number of steps between two exact evaluations of the astronomic angles.
+  const auto resynchronization_steps = std::max<int64_t>(
+      1, static_cast<int64_t>(std::llround(resynchronization / step)));
+
+  // Allocates the result vectors
+  auto tide = Eigen::VectorXd(size);
+  auto long_period = Eigen::VectorXd(size);
+  auto quality = Vector<Quality>(size);
+
+  // Worker responsible for the calculation of the tide for a chunk of the
+  // series.
+  // The wave table is prepared once and cloned per worker: the clone places
+  // all its wave objects in one contiguous block allocated in a single call.
+  const auto wave_table_prototype =
+      detail::build_wave_table(tidal_model, settings.excluded());
   auto worker = [&](const int64_t start, const int64_t end) {
     auto acc = std::unique_ptr<Accelerator>(tidal_model->accelerator(
         settings.astronomic_formulae(), settings.time_tolerance()));
     auto* acc_ptr = acc.get();
-    auto wave_table =
-        detail::build_wave_table(tidal_model, settings.excluded());
+    auto wave_table = wave_table_prototype.clone();
+    acc_ptr->bind(wave_table);
     auto lpe = wave::LongPeriodEquilibrium(wave_table);
+    auto kernel = detail::PhaseRecurrenceKernel(wave_table, step);
+
+    // Interpolation, at the requested position, of the waves provided by the
+    // model used. The position does not change over time, so this is done
+    // only once per worker.
+    auto interpolation_quality =
+        tidal_model->interpolate({longitude, latitude}, wave_table, acc_ptr);
+    // The interpolated constituents do not depend on time, so the missing
+    // waves of the model can also be inferred by admittance once.
+    wave_table.admittance();
+
+    // Height of the long period equilibrium waves, interpolated linearly
+    // between two resynchronization points.
+    auto h_lpe = 0.0;
+    auto h_lpe_slope = 0.0;
+    auto window_start = start;
 
     for (auto ix = start; ix < end; ++ix) {
-      std::tie(tide(ix), long_period(ix), quality(ix)) = detail::evaluate_tide(
-          tidal_model, epoch(ix), leap_seconds(ix), longitude(ix), latitude(ix),
-          wave_table, lpe, acc_ptr);
+      if ((ix - start) % resynchronization_steps == 0) {
+        // Exact evaluation of the astronomic angles and of the nodal
+        // corrections, then resynchronization of the phase recurrence.
+        const auto t = epoch + static_cast<double>(ix) * step;
+        const auto& angles =
+            acc_ptr->calculate_angle(t, leap_seconds_view(ix));
+        kernel.resynchronize(angles);
+        window_start = ix;
+        if (tidal_model->tide_type() == fes::kTide) {
+          // The long period equilibrium waves vary too slowly to justify an
+          // evaluation per epoch: the value is interpolated linearly between
+          // the two ends of the resynchronization window.
+          const auto window = std::min<int64_t>(resynchronization_steps,
+                                                std::max<int64_t>(
+                                                    end - 1 - ix, 1));
+          const auto angles_end = angle::Astronomic(
+              settings.astronomic_formulae(),
+              t + static_cast<double>(window) * step, leap_seconds_view(ix));
+          h_lpe = lpe.lpe_minus_n_waves(angles, latitude);
+          h_lpe_slope = (lpe.lpe_minus_n_waves(angles_end, latitude) - h_lpe) /
+                        static_cast<double>(window);
+        } else {
+          h_lpe = 0.0;
+          h_lpe_slope = 0.0;
+        }
+      } else {
+        kernel.advance();
+      }
+
+      auto h = 0.0;
+      auto h_long_period =
+          h_lpe + h_lpe_slope * static_cast<double>(ix - window_start);
+      if (interpolation_quality == kUndefined) {
+        h = std::numeric_limits<double>::quiet_NaN();
+      } else {
+        kernel.accumulate(h, h_long_period);
+      }
+      tide(ix) = h;
+      long_period(ix) = h_long_period;
+      quality(ix) = interpolation_quality;
     }
   };
 
-  detail::parallel_for(worker, epoch.size(), num_threads);
+  detail::parallel_for(worker, size, num_threads, settings.chunk_size(),
+                       settings.pin_threads());
   return {tide, long_period, quality};
 }
 
+/// Classification of a tidal extremum found by fes::evaluate_extrema.
+enum ExtremumType : uint8_t {
+  /// Local minimum of the water level (low water).
+  kLowWater = 0,
+  /// Local maximum of the water level (high water).
+  kHighWater = 1,
+};
+
+/// Search of the high and low waters over a time window at a fixed position.
+///
+/// Deriving the tide tables by dense sampling evaluates the full harmonic
+/// summation at every sample, of which only the few samples bracketing an
+/// extremum matter. This function exploits the harmonic form of the
+/// prediction instead: within a resynchronization window the nodal
+/// corrections are held constant, so the phase of each constituent is linear
+/// in time and the time derivative of the summation
+///
+/// \f[
+///   h'(t) = \sum f \omega \left[Im \cos(\phi) - Re \sin(\phi)\right]
+/// \f]
+///
+/// is available analytically. The derivative is sampled with a coarse step
+/// to bracket its sign changes, then each bracket is refined with Newton
+/// iterations on the derivative, safeguarded by bisection, yielding the
+/// extrema times and heights directly without materializing a dense series.
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] start Beginning of the search window, expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z. The leap seconds are resolved
+/// from the IERS table embedded in the library (see fes::leap_seconds).
+/// @param[in] end End of the search window, expressed in number of seconds
+/// elapsed since 1970-01-01T00:00:00Z.
+/// @param[in] longitude Longitude in degrees for the position at which the
+/// extrema are searched
+/// @param[in] latitude Latitude in degrees for the position at which the
+/// extrema are searched
+/// @param[in] step Bracketing step, in seconds. Two extrema closer than the
+/// step may be merged; the default resolves the shallow water constituents
+/// up to the eighth-diurnal species.
+/// @param[in] resynchronization Time during which the nodal corrections are
+/// held constant and the long period equilibrium waves are interpolated
+/// linearly, in seconds.
+/// @param[in] settings Settings for the tide computation.
+/// @return A tuple that contains:
+/// - The times of the extrema, expressed in number of seconds elapsed since
+///   1970-01-01T00:00:00Z.
+/// - The heights of the extrema: the sum of the short and long period
+///   constituents of the tidal spectrum, in the units of the constituents
+///   loaded in the tidal model.
+/// - The classification of each extremum (see ExtremumType).
+/// - The quality of the interpolation at the requested position (see
+///   Quality). If the point is not defined by the model the quality is
+///   kUndefined and the other elements are empty.
+/// @throw std::invalid_argument if the window is inverted or if the step or
+/// the resynchronization interval is not positive.
+template <typename T>
+auto evaluate_extrema(const AbstractTidalModel<T>* const tidal_model,
+                      const double start, const double end,
+                      const double longitude, const double latitude,
+                      const double step = 1800.0,
+                      const double resynchronization = 3600.0,
+                      const Settings& settings = Settings())
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, Vector<ExtremumType>,
+                  Quality> {
+  // Checks the input parameters
+  if (end < start) {
+    throw std::invalid_argument("the search window is inverted");
+  }
+  if (step <= 0.0) {
+    throw std::invalid_argument("step must be positive");
+  }
+  if (resynchronization <= 0.0) {
+    throw std::invalid_argument("resynchronization must be positive");
+  }
+
+  auto wave_table = detail::build_wave_table(tidal_model, settings.excluded());
+  auto lpe = wave::LongPeriodEquilibrium(wave_table);
+  auto acc = std::unique_ptr<Accelerator>(tidal_model->accelerator(
+      settings.astronomic_formulae(), settings.time_tolerance()));
+  auto* acc_ptr = acc.get();
+  acc_ptr->bind(wave_table);
+
+  // Interpolation, at the requested position, of the waves provided by the
+  // model used, then calculation of the missing waves by admittance. The
+  // position does not change over time, so this is done only once.
+  const auto quality =
+      tidal_model->interpolate({longitude, latitude}, wave_table, acc_ptr);
+  wave_table.admittance();
+
+  auto times = std::vector<double>();
+  auto heights = std::vector<double>();
+  auto types = std::vector<ExtremumType>();
+
+  if (quality != kUndefined) {
+    auto soa = wave::SoaTable(wave_table);
+    soa.update_tide();
+    // Phase rate of each constituent, in radians per second (Wave::freq is
+    // expressed in radians per hour).
+    const auto omega = Eigen::ArrayXd(soa.freq() / 3600.0);
+    auto phi = Eigen::ArrayXd(soa.size());
+
+    // Height of the long period equilibrium waves, interpolated linearly
+    // within each resynchronization window.
+    auto h_lpe = 0.0;
+    auto h_lpe_slope = 0.0;
+    auto window_start = start;
+
+    // The phases are linear within the window: phi(t) = vu + omega·(t - t0).
+    auto phase = [&](const double t) {
+      phi = soa.vu() + omega * (t - window_start);
+    };
+    auto height = [&](const double t) -> double {
+      phase(t);
+      return (soa.f() * (soa.real() * phi.cos() + soa.imag() * phi.sin()))
+                 .sum() +
+             h_lpe + h_lpe_slope * (t - window_start);
+    };
+    auto derivative = [&](const double t) -> double {
+      phase(t);
+      return (soa.f() * omega *
+              (soa.imag() * phi.cos() - soa.real() * phi.sin()))
+                 .sum() +
+             h_lpe_slope;
+    };
+    auto second_derivative = [&](const double t) -> double {
+      phase(t);
+      return -(soa.f() * omega.square() *
+               (soa.real() * phi.cos() + soa.imag() * phi.sin()))
+                  .sum();
+    };
+
+    // Newton refinement of a bracketed sign change of the derivative. The
+    // iterate is kept inside the shrinking bracket: a Newton step escaping
+    // it falls back to a bisection step, so the convergence is at worst
+    // that of the bisection.
+    auto refine = [&](double lo, double hi, const double d_lo) -> double {
+      auto x = 0.5 * (lo + hi);
+      for (auto it = 0; it < 64 && hi - lo > 1e-3; ++it) {
+        const auto d = derivative(x);
+        if (d == 0.0) {
+          return x;
+        }
+        ((d < 0.0) == (d_lo < 0.0) ? lo : hi) = x;
+        const auto dd = second_derivative(x);
+        x = dd != 0.0 ? x - d / dd : 0.5 * (lo + hi);
+        if (x <= lo || x >= hi) {
+          x = 0.5 * (lo + hi);
+        }
+      }
+      return x;
+    };
+
+    auto t0 = start;
+    while (t0 < end) {
+      const auto wend = std::min(t0 + resynchronization, end);
+      // Exact evaluation of the astronomic angles and of the nodal
+      // corrections at the window start.
+      const auto& angles = acc_ptr->calculate_angle(t0, fes::leap_seconds(t0));
+      soa.update_nodal_corrections(angles);
+      window_start = t0;
+      if (tidal_model->tide_type() == fes::kTide) {
+        // The long period equilibrium waves vary too slowly to justify an
+        // evaluation per sample: the value is interpolated linearly between
+        // the two ends of the window.
+        const auto angles_end =
+            angle::Astronomic(settings.astronomic_formulae(), wend,
+                              fes::leap_seconds(wend));
+        h_lpe = lpe.lpe_minus_n_waves(angles, latitude);
+        h_lpe_slope = (lpe.lpe_minus_n_waves(angles_end, latitude) - h_lpe) /
+                      std::max(wend - t0, 1.0);
+      } else {
+        h_lpe = 0.0;
+        h_lpe_slope = 0.0;
+      }
+
+      // Bracket the sign changes of the derivative over the window. A root
+      // falling on a sample point is caught as the right end of its
+      // bracket, so it is not reported twice by consecutive brackets or
+      // windows.
+      auto lo = t0;
+      auto d_lo = derivative(lo);
+      while (lo < wend) {
+        const auto hi = std::min(lo + step, wend);
+        const auto d_hi = derivative(hi);
+        if ((d_lo < 0.0 && d_hi >= 0.0) || (d_lo > 0.0 && d_hi <= 0.0)) {
+          const auto t = refine(lo, hi, d_lo);
+          times.push_back(t);
+          heights.push_back(height(t));
+          // At a high water the height is a local maximum: h'' < 0.
+          types.push_back(second_derivative(t) < 0.0 ? kHighWater
+                                                     : kLowWater);
+        }
+        lo = hi;
+        d_lo = d_hi;
+      }
+      t0 = wend;
+    }
+  }
+
+  const auto size = static_cast<Eigen::Index>(times.size());
+  auto time_result = Eigen::VectorXd(size);
+  auto height_result = Eigen::VectorXd(size);
+  auto type_result = Vector<ExtremumType>(size);
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    time_result(ix) = times[static_cast<size_t>(ix)];
+    height_result(ix) = heights[static_cast<size_t>(ix)];
+    type_result(ix) = types[static_cast<size_t>(ix)];
+  }
+  return {time_result, height_result, type_result, quality};
+}
+
+/// Ocean tide calculation for the product of a set of epochs by a set of
+/// positions.
+///
+/// Flattening the product through fes::evaluate_tide repeats the
+/// interpolation of the constituents for every epoch and the evaluation of
+/// the astronomic angles for every position. This overload interpolates the
+/// constituents once per position and evaluates the angles and the nodal
+/// corrections once per epoch, then combines the two factors with blocked
+/// matrix products: the harmonic summation becomes
+/// \f$f \cos(vu)\f$ and \f$f \sin(vu)\f$ matrices (epoch × constituent)
+/// multiplied by the interpolated real and imaginary parts (constituent ×
+/// position). The long period equilibrium waves factorize the same way into
+/// a time dependent and a latitude dependent part.
+///
+/// @param[in] tidal_model Tidal model used to interpolate the modelized waves
+/// @param[in] epoch Dates of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] leap_seconds Number of leap seconds elapsed since
+/// 1970-01-01T00:00:00Z for each epoch. A size-1 vector is broadcast over
+/// all the epochs.
+/// @param[in] longitude Longitudes in degrees for the positions at which the
+/// tide is calculated
+/// @param[in] latitude Latitudes in degrees for the positions at which the
+/// tide is calculated
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains:
+/// - The height of the the diurnal and semi-diurnal constituents of the
+///   tidal spectrum, as an epoch × position matrix.
+/// - The height of the long period wave constituents of the tidal
+///   spectrum, as an epoch × position matrix.
+/// - The quality of the tide calculation for each position.
+/// @note The units of the returned tide are the same as the units of the
+/// constituents loaded in the tidal model.
+/// @note Computed height of the diurnal and semi-diurnal constituents is set
+/// to nan for the positions where no data is available. the long period wave
+/// constituents is always computed because this value does not depend on
+/// input grids.
+template <typename T>
+auto evaluate_tide_outer(
+    const AbstractTidalModel<T>* const tidal_model,
+    const Eigen::Ref<const Eigen::VectorXd>& epoch,
+    const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+    const Eigen::Ref<const Eigen::VectorXd>& longitude,
+    const Eigen::Ref<const Eigen::VectorXd>& latitude,
+    const Settings& settings = Settings(), const size_t num_threads = 0)
+    -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Vector<Quality>> {
+  // Checks the input parameters
+  detail::check_eigen_shape("longitude", longitude, "latitude", latitude);
+  if (leap_seconds.size() != epoch.size() && leap_seconds.size() != 1) {
+    throw std::invalid_argument(
+        "leap_seconds could not be broadcast together with shape " +
+        detail::eigen_shape(leap_seconds) + ", " +
+        detail::eigen_shape(epoch));
+  }
+  auto leap_seconds_view =
+      detail::BroadcastView<Eigen::Ref<const fes::Vector<uint16_t>>>(
+          leap_seconds);
+
+  const auto n_epochs = epoch.size();
+  const auto n_positions = longitude.size();
+
+  // Time phase: the angles and the nodal corrections only depend on the
+  // epoch, so the f·cos(vu) and f·sin(vu) factors of the harmonic summation
+  // and the time dependent part of the long period equilibrium waves are
+  // evaluated once per epoch.
+  auto time_table = detail::build_wave_table(tidal_model, settings.excluded());
+  auto lpe = wave::LongPeriodEquilibrium(time_table);
+  auto soa = wave::SoaTable(time_table);
+  const auto n_short = soa.n_short();
+  const auto n_waves = soa.size();
+
+  auto a = Eigen::MatrixXd(n_epochs, n_waves);
+  auto b = Eigen::MatrixXd(n_epochs, n_waves);
+  auto lpe_time = Eigen::MatrixXd(n_epochs, 2);
+  {
+    auto acc = std::unique_ptr<Accelerator>(tidal_model->accelerator(
+        settings.astronomic_formulae(), settings.time_tolerance()));
+    auto cos_vu = Eigen::ArrayXd(n_waves);
+    auto sin_vu = Eigen::ArrayXd(n_waves);
+    for (Eigen::Index ix = 0; ix < n_epochs; ++ix) {
+      const auto& angles =
+          acc->calculate_angle(epoch(ix), leap_seconds_view(ix));
+      if (acc->angle_updated()) {
+        soa.update_nodal_corrections(angles);
+        if (settings.fast_sincos()) {
+          for (Eigen::Index jx = 0; jx < n_waves; ++jx) {
+            std::tie(sin_vu(jx), cos_vu(jx)) =
+                detail::math::fast_sincos(soa.vu()(jx));
+          }
+        } else {
+          cos_vu = soa.vu().cos();
+          sin_vu = soa.vu().sin();
+        }
+      }
+      a.row(ix) = (soa.f() * cos_vu).matrix().transpose();
+      b.row(ix) = (soa.f() * sin_vu).matrix().transpose();
+      lpe_time.row(ix) =
+          tidal_model->tide_type() == fes::kTide
+              ? Eigen::RowVector2d(lpe.harmonic_factors(angles).transpose())
+              : Eigen::RowVector2d(Eigen::RowVector2d::Zero());
+    }
+  }
+
+  // Allocates the result matrices
+  auto tide = Eigen::MatrixXd(n_epochs, n_positions);
+  auto long_period = Eigen::MatrixXd(n_epochs, n_positions);
+  auto quality = Vector<Quality>(n_positions);
+
+  // Position phase: the interpolated constituents only depend on the
+  // position. Each worker interpolates a block of positions, then combines
+  // the two factors with matrix products over the block.
+  constexpr Eigen::Index block_size = 256;
+  // The wave table is prepared once and cloned per worker: the clone places
+  // all its wave objects in one contiguous block allocated in a single call.
+  const auto wave_table_prototype =
+      detail::build_wave_table(tidal_model, settings.excluded());
+  auto worker = [&](const int64_t start, const int64_t end) {
+    auto acc = std::unique_ptr<Accelerator>(tidal_model->accelerator(
+        settings.astronomic_formulae(), settings.time_tolerance()));
+    auto* acc_ptr = acc.get();
+    auto wave_table = wave_table_prototype.clone();
+    acc_ptr->bind(wave_table);
+    // The clones share the partition of the prototype, which matches the
+    // ordering of the time phase.
+    auto block_soa = wave::SoaTable(wave_table);
+
+    auto real = Eigen::MatrixXd(n_waves, block_size);
+    auto imag = Eigen::MatrixXd(n_waves, block_size);
+    auto lpe_lat = Eigen::MatrixXd(2, block_size);
+
+    for (auto jx = start; jx < end; jx += block_size) {
+      const auto block = std::min<Eigen::Index>(block_size, end - jx);
+      for (Eigen::Index kx = 0; kx < block; ++kx) {
+        const auto px = jx + kx;
+        quality(px) = tidal_model->interpolate(
+            {longitude(px), latitude(px)}, wave_table, acc_ptr);
+        wave_table.admittance();
+        if (quality(px) == kUndefined) {
+          // The undefined positions do not contribute to the products; the
+          // tide is overwritten with nan afterwards.
+          real.col(kx).setZero();
+          imag.col(kx).setZero();
+        } else {
+          block_soa.update_tide();
+          real.col(kx) = block_soa.real().matrix();
+          imag.col(kx) = block_soa.imag().matrix();
+        }
+        lpe_lat.col(kx) =
+            tidal_model->tide_type() == fes::kTide
+                ? wave::LongPeriodEquilibrium::latitude_factors(latitude(px))
+                : Eigen::Vector2d(Eigen::Vector2d::Zero());
+      }
+
+      tide.block(0, jx, n_epochs, block).noalias() =
+          a.leftCols(n_short) * real.topRows(n_short).leftCols(block) +
+          b.leftCols(n_short) * imag.topRows(n_short).leftCols(block);
+      long_period.block(0, jx, n_epochs, block).noalias() =
+          a.rightCols(n_waves - n_short) *
+              real.bottomRows(n_waves - n_short).leftCols(block) +
+          b.rightCols(n_waves - n_short) *
+              imag.bottomRows(n_waves - n_short).leftCols(block) +
+          lpe_time * lpe_lat.leftCols(block);
+
+      for (Eigen::Index kx = 0; kx < block; ++kx) {
+        if (quality(jx + kx) == kUndefined) {
+          tide.col(jx + kx).setConstant(
+              std::numeric_limits<double>::quiet_NaN());
+        }
+      }
+    }
+  };
+
+  detail::parallel_for(worker, n_positions, num_threads, settings.chunk_size(),
+                       settings.pin_threads());
+  return {tide, long_period, quality};
+}
+
+/// Ocean tide calculation for a group of models sharing the same points.
+///
+/// Evaluating the tide, radial and current fields of one solution means
+/// running fes::evaluate_tide once per field over identical coordinates,
+/// each run paying its own spatial search and astronomic angle work. This
+/// overload evaluates every model of the group per point-epoch: the
+/// astronomic angles are computed once and shared by all the fields, and
+/// when two models agree to share their spatial cache (a Cartesian model on
+/// the same axes, an LGP model on the same mesh index — see
+/// AbstractTidalModel::shares_spatial_cache) the cell or triangle selected
+/// for the first model seeds the accelerators of the others, so the search
+/// is paid once per point instead of once per field.
+///
+/// @param[in] tidal_models The tidal models of the group. The fields are
+/// evaluated in the given order; sharing is established against the first
+/// model.
+/// @param[in] epoch Date of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] leap_seconds Number of leap seconds elapsed since
+/// 1970-01-01T00:00:00Z
+/// @param[in] longitude Longitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] latitude Latitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains, as item × model matrices:
+/// - The height of the the diurnal and semi-diurnal constituents of the
+///   tidal spectrum, one column per model.
+/// - The height of the long period wave constituents of the tidal
+///   spectrum, one column per model.
+/// - The quality of the tide calculation, one column per model.
+/// @note The units of the returned tide are the same as the units of the
+/// constituents loaded in each tidal model.
+/// @note The input vectors could not have the same size: a size-1 vector is
+/// broadcast against the others without materializing the repeated values.
+/// @throw std::invalid_argument if the group is empty or contains a null
+/// model, or if the input vectors could not be broadcast together.
+template <typename T>
+auto evaluate_tide_group(
+    const std::vector<const AbstractTidalModel<T>*>& tidal_models,
+    const Eigen::Ref<const Eigen::VectorXd>& epoch,
+    const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+    const Eigen::Ref<const Eigen::VectorXd>& longitude,
+    const Eigen::Ref<const Eigen::VectorXd>& latitude,
+    const Settings& settings = Settings(), const size_t num_threads = 0)
+    -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Matrix<Quality>> {
+  // Checks the input parameters
+  if (tidal_models.empty()) {
+    throw std::invalid_argument("tidal_models must not be empty");
+  }
+  for (const auto* model : tidal_models) {
+    if (model == nullptr) {
+      throw std::invalid_argument("tidal_models must not contain null models");
+    }
+  }
+  const auto size = detail::broadcast_eigen_shape(
+      "epoch", epoch, "leap_seconds", leap_seconds, "longitude", longitude,
+      "latitude", latitude);
+  const auto n_models = tidal_models.size();
+
+  // Size-1 vectors are broadcast against the others.
+  auto epoch_view =
+      detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(epoch);
+  auto leap_seconds_view =
+      detail::BroadcastView<Eigen::Ref<const fes::Vector<uint16_t>>>(
+          leap_seconds);
+  auto longitude_view =
+      detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(longitude);
+  auto latitude_view =
+      detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(latitude);
+
+  // Allocates the result matrices
+  auto tide = Eigen::MatrixXd(size, n_models);
+  auto long_period = Eigen::MatrixXd(size, n_models);
+  auto quality = Matrix<Quality>(size, n_models);
+
+  // The models may expose different constituent sets, so one wave table
+  // prototype is prepared per model and cloned per worker.
+  auto prototypes = std::vector<wave::Table>();
+  prototypes.reserve(n_models);
+  for (const auto* model : tidal_models) {
+    prototypes.push_back(detail::build_wave_table(model, settings.excluded()));
+  }
+
+  // The models agreeing to share their spatial cache with the first one are
+  // identified once: their accelerators are seeded with the search result of
+  // the first field before their own interpolation.
+  auto shared = std::vector<bool>(n_models, false);
+  for (size_t kx = 1; kx < n_models; ++kx) {
+    shared[kx] = tidal_models[kx]->shares_spatial_cache(*tidal_models[0]);
+  }
+
+  // Worker responsible for the calculation of the fields at a given position.
+  // The scalar type of the harmonic summation is a runtime choice, so the
+  // worker is instantiated for both precisions and selected below.
+  auto worker = [&](auto precision, const int64_t start, const int64_t end) {
+    using U = decltype(precision);
+    auto fields =
+        std::vector<std::unique_ptr<detail::GroupField<T, U>>>();
+    fields.reserve(n_models);
+    for (size_t kx = 0; kx < n_models; ++kx) {
+      fields.emplace_back(new detail::GroupField<T, U>(
+          tidal_models[kx], prototypes[kx], settings));
+    }
+
+    for (auto ix = start; ix < end; ++ix) {
+      const auto point =
+          geometry::Point(longitude_view(ix), latitude_view(ix));
+      // The angles only depend on time: they are evaluated once with the
+      // accelerator of the first field and shared by every field.
+      const auto& angles = fields[0]->acc->calculate_angle(
+          epoch_view(ix), leap_seconds_view(ix));
+      const auto angle_updated = fields[0]->acc->angle_updated();
+
+      for (size_t kx = 0; kx < n_models; ++kx) {
+        auto& field = *fields[kx];
+        if (angle_updated) {
+          field.kernel.update_nodal_corrections(angles);
+        }
+        if (shared[kx]) {
+          tidal_models[kx]->seed_spatial_cache(point, *fields[0]->acc,
+                                               field.acc.get());
+        }
+        const auto interpolation_quality = tidal_models[kx]->interpolate(
+            point, field.wave_table, field.acc.get());
+        field.wave_table.admittance();
+
+        auto h = 0.0;
+        auto h_long_period =
+            tidal_models[kx]->tide_type() == fes::kTide
+                ? field.lpe.lpe_minus_n_waves(angles, latitude_view(ix))
+                : 0.0;
+        if (interpolation_quality == kUndefined) {
+          h = std::numeric_limits<double>::quiet_NaN();
+        } else {
+          field.kernel.accumulate(h, h_long_period);
+        }
+        const auto jx = static_cast<Eigen::Index>(kx);
+        tide(ix, jx) = h;
+        long_period(ix, jx) = h_long_period;
+        quality(ix, jx) = interpolation_quality;
+      }
+    }
+  };
+
+  detail::parallel_for_precision(worker, settings.single_precision(), size,
+                                 num_threads, settings.chunk_size(),
+                                 settings.pin_threads());
+  return {tide, long_period, quality};
+}
+
+/// Ocean tide calculation for a group of models, resolving the leap seconds
+/// internally.
+///
+/// This overload behaves like fes::evaluate_tide_group but resolves the
+/// number of leap seconds of each epoch from the IERS table embedded in the
+/// library (see fes::leap_seconds).
+///
+/// @param[in] tidal_models The tidal models of the group.
+/// @param[in] epoch Date of the tide calculation expressed in number of
+/// seconds elapsed since 1970-01-01T00:00:00Z
+/// @param[in] longitude Longitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] latitude Latitude in degrees for the position at which the
+/// tide is calculated
+/// @param[in] settings Settings for the tide computation.
+/// @param[in] num_threads Number of threads to use for the computation. If 0,
+/// the number of threads is automatically determined.
+/// @return A tuple that contains the heights of the short and long period
+/// constituents and the quality flags, one column per model, as documented
+/// in fes::evaluate_tide_group.
+template <typename T>
+auto evaluate_tide_group(
+    const std::vector<const AbstractTidalModel<T>*>& tidal_models,
+    const Eigen::Ref<const Eigen::VectorXd>& epoch,
+    const Eigen::Ref<const Eigen::VectorXd>& longitude,
+    const Eigen::Ref<const Eigen::VectorXd>& latitude,
+    const Settings& settings = Settings(), const size_t num_threads = 0)
+    -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Matrix<Quality>> {
+  const auto resolved = fes::leap_seconds(epoch);
+  return evaluate_tide_group(tidal_models, epoch, resolved, longitude,
+                             latitude, settings, num_threads);
+}
+
 }  // namespace fes
@@ -145,6 +145,17 @@ class Wave : public std::enable_shared_from_this<Wave> {
     return detail::math::two_pi<double>() / freq_;
   }
 
+  /// Gets the harmonic constituents
+  /// \f$(T, s, h, p, N', p_1, shift, \xi, \nu, \nu', \nu'')\f$
+  constexpr auto arguments() const noexcept -> const std::array<int8_t, 11>& {
+    return argument_;
+  }
+
+  /// Gets the function used to calculate the nodal factor
+  constexpr auto node_factor() const noexcept -> nodal_factor_t {
+    return calculate_node_factor_;
+  }
+
   /// Gets the wave name
   inline auto name() const -> const char* { return constituents::name(ident_); }
 
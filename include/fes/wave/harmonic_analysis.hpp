@@ -0,0 +1,75 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/wave/harmonic_analysis.hpp
+/// @brief Reusable harmonic analysis context.
+#pragma once
+#include <Eigen/Cholesky>
+#include <Eigen/Core>
+
+#include "fes/eigen.hpp"
+
+namespace fes {
+namespace wave {
+
+/// @brief Reusable harmonic analysis context.
+///
+/// wave::Table::harmonic_analysis rebuilds and refactorizes the design matrix
+/// for every call, although the matrix only depends on the nodal modulations
+/// of the time base, not on the sea level analyzed. When many gauges share a
+/// common time base, this context precomputes the design matrix and the
+/// factorization of its normal equations once; every subsequent solve() is
+/// then a matrix product and a triangular solve.
+class HarmonicAnalysis {
+ public:
+  /// Build an analysis context from the nodal modulations of a time base.
+  ///
+  /// @param[in] f Nodal correction coefficient applied to the amplitude of
+  /// the constituents analyzed.
+  /// @param[in] vu Astronomical argument at time \f$(t\f$) + the nodal
+  /// correction coefficient applied to the phase of the constituents
+  /// analyzed.
+  /// @throw std::invalid_argument if f and vu do not have the same shape.
+  HarmonicAnalysis(const DynamicRef<const Eigen::MatrixXd>& f,
+                   const DynamicRef<const Eigen::MatrixXd>& vu);
+
+  /// Harmonic analysis of one sea level time series.
+  ///
+  /// @param[in] h Sea level sampled on the time base of this context.
+  /// @return The tidal constants of the analyzed constituents.
+  /// @throw std::invalid_argument if the size of the series does not match
+  /// the time base of this context.
+  auto solve(const Eigen::Ref<const Eigen::VectorXd>& h) const
+      -> Eigen::VectorXcd;
+
+  /// Harmonic analysis of a block of sea level time series.
+  ///
+  /// Same semantics as wave::Table::batched_harmonic_analysis: one row per
+  /// point, a point holding undefined values only poisons its own column of
+  /// the result.
+  ///
+  /// @param[in] h Sea level, one row per point (n_points x n_times).
+  /// @param[in] num_threads Number of threads to use for the computation. If
+  /// set to 0, the number of threads is automatically determined.
+  /// @return The tidal constants, one column per point
+  /// (n_constituents x n_points).
+  /// @throw std::invalid_argument if the number of columns of the block does
+  /// not match the time base of this context.
+  auto batched_solve(const DynamicRef<const Eigen::MatrixXd>& h,
+                     size_t num_threads = 0) const -> Eigen::MatrixXcd;
+
+  /// Number of constituents analyzed.
+  constexpr auto size() const noexcept -> Eigen::Index { return w_size_; }
+
+ private:
+  /// Number of constituents analyzed.
+  Eigen::Index w_size_;
+  /// Design matrix of the time base (2 n_constituents x n_times).
+  Eigen::MatrixXd design_;
+  /// Factorization of the normal equations of the design matrix.
+  Eigen::LDLT<Eigen::MatrixXd> ldlt_;
+};
+
+}  // namespace wave
+}  // namespace fes
@@ -58,6 +58,56 @@ class LongPeriodEquilibrium {
   /// @return Computed long-period tide, in centimeters.
   auto lpe_minus_n_waves(const angle::Astronomic& angles, double lat) -> double;
 
+  /// @brief Computes the long-period equilibrium ocean tides over a vector
+  /// of epochs.
+  ///
+  /// The spectral summation only depends on the date: it is evaluated once
+  /// per distinct epoch, so consecutive points sharing an epoch reuse the
+  /// scan of the Cartwright-Tayler-Edden tables. Size-1 vectors are
+  /// broadcast against the others.
+  ///
+  /// @param[in] epoch Date of the tide calculation expressed in number of
+  /// seconds elapsed since 1970-01-01T00:00:00Z.
+  /// @param[in] leap_seconds Number of leap seconds elapsed since
+  /// 1970-01-01T00:00:00Z.
+  /// @param[in] lat Latitude in degrees (positive north) for the position at
+  /// which tide is computed.
+  /// @param[in] formulae The formulae used to compute the astronomical
+  /// angles.
+  /// @return Computed long-period tides, in centimeters.
+  /// @throw std::invalid_argument if the input vectors could not be
+  /// broadcast together.
+  auto lpe_minus_n_waves(
+      const Eigen::Ref<const Eigen::VectorXd>& epoch,
+      const Eigen::Ref<const Vector<uint16_t>>& leap_seconds,
+      const Eigen::Ref<const Eigen::VectorXd>& lat,
+      const angle::Formulae& formulae = angle::Formulae::kSchuremanOrder3)
+      const -> Eigen::VectorXd;
+
+  /// @brief Computes the time dependent part of the long-period equilibrium
+  /// ocean tides.
+  ///
+  /// The long-period tide factorizes as the dot product of this vector with
+  /// the latitude dependent part returned by latitude_factors(), a property
+  /// used to evaluate the tide on a time × position product without
+  /// evaluating the spectral summation for each pair.
+  ///
+  /// @param[in] angles the astronomic angle, indicating the date on which the
+  /// tide is to be calculated.
+  /// @return The tidal potentials V20 and V30, summed over the spectral
+  /// lines.
+  auto harmonic_factors(const angle::Astronomic& angles) const
+      -> Eigen::Vector2d;
+
+  /// @brief Computes the latitude dependent part of the long-period
+  /// equilibrium ocean tides.
+  ///
+  /// @param[in] lat Latitude in degrees (positive north) for the position at
+  /// which tide is computed.
+  /// @return The factors applied to the tidal potentials V20 and V30,
+  /// including the elastic response and the conversion in centimeters.
+  static auto latitude_factors(double lat) -> Eigen::Vector2d;
+
  private:
   Eigen::Matrix<double, 106, 6> order2_;  // NOLINT (magic number, physics)
   Eigen::Matrix<double, 17, 6> order3_;   // NOLINT (magic number, physics)
@@ -0,0 +1,264 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+/// @file include/fes/wave/soa_table.hpp
+/// @brief Structure-of-arrays view on the active waves of a table.
+#pragma once
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "fes/angle/astronomic.hpp"
+#include "fes/detail/math.hpp"
+#include "fes/wave.hpp"
+#include "fes/wave/table.hpp"
+
+namespace fes {
+namespace wave {
+
+/// @brief Structure-of-arrays view on the active waves of a table.
+///
+/// The wave table stores one heap-allocated object per constituent, so the
+/// prediction hot path chases a pointer per constituent per epoch to read the
+/// nodal corrections and the interpolated values. This class snapshots the
+/// active waves (computed by admittance or dynamically) once and mirrors the
+/// time and position dependent quantities into contiguous arrays: the
+/// summation kernels then only touch a few cache lines per evaluation.
+///
+/// The wave objects remain the authoritative store for the configuration
+/// (selection, interpolated values written by the models, admittance): the
+/// tide arrays are refreshed from them with update_tide(). The nodal
+/// corrections, on the other hand, are fully described by per-wave constant
+/// data (the harmonic argument multipliers, the node factor formula and an
+/// optional phase correction), so they are captured as descriptor arrays at
+/// construction and update_nodal_corrections() evaluates them data-driven,
+/// without the per-wave virtual dispatch of Wave::nodal_g(); the wave
+/// objects are not updated.
+///
+/// The arrays hold the short period constituents first, so the two sums of
+/// the harmonic summation are evaluated on contiguous segments.
+///
+/// The arrays read by the summation kernels (f, vu, real and imaginary
+/// parts) are stored with the scalar type @p U: instantiating the view with
+/// float halves the memory traffic of the summation and doubles the number
+/// of SIMD lanes per instruction. The nodal corrections are still evaluated
+/// in double from the descriptor arrays and rounded once when written, so
+/// the single precision error stays on the order of the float epsilon of
+/// the reduced phase.
+///
+/// @tparam U The scalar type of the arrays read by the summation kernels.
+template <typename U>
+class BasicSoaTable {
+ public:
+  /// The type of the arrays read by the summation kernels.
+  using Array = Eigen::Array<U, Eigen::Dynamic, 1>;
+
+  /// Build a view from the wave table used for the tidal prediction.
+  ///
+  /// The set of active waves is fixed when the table is built, so the
+  /// partition is captured once. The table must outlive the view.
+  ///
+  /// @param[in] table The list of tidal constituents used for the tidal
+  /// prediction.
+  explicit BasicSoaTable(Table& table) {
+    for (const auto& wave : table) {
+      if ((wave->admittance() || wave->dynamic()) &&
+          wave->type() == Wave::kShortPeriod) {
+        waves_.push_back(wave.get());
+      }
+    }
+    n_short_ = static_cast<Eigen::Index>(waves_.size());
+    for (const auto& wave : table) {
+      if ((wave->admittance() || wave->dynamic()) &&
+          wave->type() == Wave::kLongPeriod) {
+        waves_.push_back(wave.get());
+      }
+    }
+    const auto size = static_cast<Eigen::Index>(waves_.size());
+    freq_.resize(size);
+    f_.resize(size);
+    vu_.resize(size);
+    real_.resize(size);
+    imag_.resize(size);
+    v_.resize(size);
+    u_.resize(size);
+    for (auto& coefficient : coefficients_) {
+      coefficient.resize(size);
+    }
+    for (Eigen::Index ix = 0; ix < size; ++ix) {
+      const auto* wave = waves_[static_cast<size_t>(ix)];
+      freq_(ix) = wave->freq();
+      // Group the waves sharing a node factor formula, so each distinct
+      // formula is evaluated once per epoch instead of once per wave.
+      auto group = std::find_if(
+          node_factors_.begin(), node_factors_.end(),
+          [&wave](const typename decltype(node_factors_)::value_type& item) {
+            return item.first == wave->node_factor();
+          });
+      if (group == node_factors_.end()) {
+        node_factors_.emplace_back(wave->node_factor(),
+                                   std::vector<Eigen::Index>());
+        group = std::prev(node_factors_.end());
+      }
+      group->second.push_back(ix);
+      const auto& arguments = wave->arguments();
+      // The fifth argument (the longitude of the moon's ascending node) only
+      // contributes to the frequency, not to the greenwich argument.
+      coefficients_[0](ix) = arguments[0];
+      coefficients_[1](ix) = arguments[1];
+      coefficients_[2](ix) = arguments[2];
+      coefficients_[3](ix) = arguments[3];
+      coefficients_[4](ix) = arguments[5];
+      coefficients_[5](ix) = arguments[6];
+      coefficients_[6](ix) = arguments[7];
+      coefficients_[7](ix) = arguments[8];
+      coefficients_[8](ix) = arguments[9];
+      coefficients_[9](ix) = arguments[10];
+      // The two constituents whose nodal_g override adds a term that is not
+      // a linear combination of the astronomic angles.
+      if (wave->ident() == kM13) {
+        corrections_.emplace_back(ix, PhaseCorrection::kM13);
+      } else if (wave->ident() == kL2) {
+        corrections_.emplace_back(ix, PhaseCorrection::kL2);
+      }
+    }
+  }
+
+  /// Adjust the nodal corrections to the given date.
+  ///
+  /// The corrections are evaluated from the descriptor arrays for the active
+  /// waves only and written into the f and vu arrays; the wave objects are
+  /// not updated.
+  ///
+  /// @param[in] angles Astronomic angle, indicating the date on which the
+  /// tide is to be calculated.
+  auto update_nodal_corrections(const angle::Astronomic& angles) -> void {
+    // The additions follow the order of Wave::nodal_g, so the data-driven
+    // evaluation is bit-for-bit identical to the virtual one.
+    v_ = coefficients_[0] * angles.t() + coefficients_[1] * angles.s() +
+         coefficients_[2] * angles.h() + coefficients_[3] * angles.p() +
+         coefficients_[4] * angles.p1() +
+         coefficients_[5] * detail::math::pi_2<double>();
+    u_ = coefficients_[6] * angles.xi() + coefficients_[7] * angles.nu() +
+         coefficients_[8] * angles.nuprim() +
+         coefficients_[9] * angles.nusec();
+    for (const auto& correction : corrections_) {
+      switch (correction.second) {
+        case PhaseCorrection::kM13:
+          u_(correction.first) -= detail::math::radians(
+              1.0 /
+              std::sqrt(2.310 + 1.435 * std::cos(2 * (angles.p() -
+                                                      angles.xi()))));
+          break;
+        case PhaseCorrection::kL2:
+          u_(correction.first) -= angles.r();
+          break;
+      }
+    }
+    for (const auto& group : node_factors_) {
+      const auto value = (angles.*group.first)();
+      for (const auto ix : group.second) {
+        f_(ix) = static_cast<U>(value);
+      }
+    }
+    vu_ = (v_ + u_)
+              .unaryExpr([](const double x) {
+                return std::fmod(x, detail::math::two_pi<double>());
+              })
+              .template cast<U>();
+  }
+
+  /// Mirror the tide values of the active waves into the real and imaginary
+  /// arrays.
+  ///
+  /// The wave table must have been interpolated at the requested position
+  /// and the missing waves inferred by admittance before calling this
+  /// method.
+  auto update_tide() -> void {
+    const auto size = static_cast<Eigen::Index>(waves_.size());
+    for (Eigen::Index ix = 0; ix < size; ++ix) {
+      const auto& tide = waves_[static_cast<size_t>(ix)]->tide();
+      real_(ix) = static_cast<U>(tide.real());
+      imag_(ix) = static_cast<U>(tide.imag());
+    }
+  }
+
+  /// Returns the number of active waves.
+  inline auto size() const noexcept -> Eigen::Index {
+    return static_cast<Eigen::Index>(waves_.size());
+  }
+
+  /// Returns the number of short period constituents.
+  constexpr auto n_short() const noexcept -> Eigen::Index { return n_short_; }
+
+  /// Returns the active waves, short period constituents first.
+  constexpr auto waves() const noexcept -> const std::vector<Wave*>& {
+    return waves_;
+  }
+
+  /// Returns the frequency of each active wave, in radians per hour.
+  constexpr auto freq() const noexcept -> const Eigen::ArrayXd& {
+    return freq_;
+  }
+
+  /// Returns the nodal correction for amplitude of each active wave.
+  constexpr auto f() const noexcept -> const Array& { return f_; }
+
+  /// Returns v (greenwich argument) + u (nodal correction for phase) of each
+  /// active wave.
+  constexpr auto vu() const noexcept -> const Array& { return vu_; }
+
+  /// Returns the real part of the interpolated constituents.
+  constexpr auto real() const noexcept -> const Array& { return real_; }
+
+  /// Returns the imaginary part of the interpolated constituents.
+  constexpr auto imag() const noexcept -> const Array& { return imag_; }
+
+ private:
+  /// Phase corrections that are not a linear combination of the astronomic
+  /// angles, applied by the nodal_g override of the matching wave class.
+  enum class PhaseCorrection : uint8_t {
+    kM13,  //!< \f$M_{13}\f$
+    kL2    //!< \f$L_{2}\f$
+  };
+
+  /// Active waves, short period constituents first.
+  std::vector<Wave*> waves_{};
+  /// Number of short period constituents.
+  Eigen::Index n_short_{0};
+  /// Frequency of each active wave, in radians per hour.
+  Eigen::ArrayXd freq_{};
+  /// Nodal correction for amplitude.
+  Array f_{};
+  /// v (greenwich argument) + u (nodal correction for phase).
+  Array vu_{};
+  /// Real part of the interpolated constituents.
+  Array real_{};
+  /// Imaginary part of the interpolated constituents.
+  Array imag_{};
+  /// Scratch array holding the greenwich argument.
+  Eigen::ArrayXd v_{};
+  /// Scratch array holding the nodal correction for phase.
+  Eigen::ArrayXd u_{};
+  /// Harmonic argument multipliers of each active wave:
+  /// \f$(T, s, h, p, p_1, shift, \xi, \nu, \nu', \nu'')\f$.
+  std::array<Eigen::ArrayXd, 10> coefficients_{};
+  /// Active waves grouped by node factor formula.
+  std::vector<std::pair<Wave::nodal_factor_t, std::vector<Eigen::Index>>>
+      node_factors_{};
+  /// Waves requiring a phase correction that is not a linear combination of
+  /// the astronomic angles.
+  std::vector<std::pair<Eigen::Index, PhaseCorrection>> corrections_{};
+};
+
+/// Structure-of-arrays view evaluated in double precision.
+using SoaTable = BasicSoaTable<double>;
+
+}  // namespace wave
+}  // namespace fes
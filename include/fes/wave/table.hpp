@@ -125,6 +125,16 @@ class Table {
   /// @return Wave properties
   static auto wave_factory(const Constituent ident) -> std::shared_ptr<Wave>;
 
+  /// Create a deep copy of the table.
+  ///
+  /// The wave objects of the copy are placed in one contiguous block
+  /// allocated in a single call, so cloning a prepared table for a worker
+  /// thread does not perform one allocation per constituent as rebuilding it
+  /// would.
+  ///
+  /// @return A table holding copies of the waves of this instance.
+  auto clone() const -> Table;
+
   /// Compute nodal corrections.
   ///
   /// @param[in] angles Astronomic angle, indicating the date on which the tide
@@ -267,6 +277,31 @@ class Table {
                                 const DynamicRef<const Eigen::MatrixXd>& vu)
       -> Eigen::VectorXcd;
 
+  /// Harmonic analysis of a block of sea level time series sampled on the
+  /// same dates.
+  ///
+  /// The nodal corrections do not depend on the position, so the design
+  /// matrix and its factorization are built once and shared by all the
+  /// points: every block of right hand sides is then solved with matrix
+  /// products. A point holding undefined values only poisons its own
+  /// column of the result.
+  ///
+  /// @param[in] h Sea level, one row per point (n_points x n_times).
+  /// @param[in] f Nodal correction coefficient applied to the
+  /// amplitude of the constituents analyzed.
+  /// @param[in] vu Astronomical argument at time \f$(t\f$) + the
+  /// nodal correction coefficient applied to the phase of the
+  /// constituents analyzed.
+  /// @param[in] num_threads Number of threads to use for the computation. If
+  /// set to 0, the number of threads is automatically determined.
+  /// @return The tidal constants, one column per point
+  /// (n_constituents x n_points).
+  static auto batched_harmonic_analysis(
+      const DynamicRef<const Eigen::MatrixXd>& h,
+      const DynamicRef<const Eigen::MatrixXd>& f,
+      const DynamicRef<const Eigen::MatrixXd>& vu, size_t num_threads = 0)
+      -> Eigen::MatrixXcd;
+
   /// Calculate the tide of a given time series.
   ///
   /// @param[in] epoch Desired UTC time expressed in number of seconds elapsed
@@ -274,14 +309,19 @@ class Table {
   /// @param[in] leap_seconds The number of leap seconds since
   /// 1970-01-01T00:00:00Z.
   /// @param[in] wave Tidal wave properties computed by an harmonic analysis.
-  /// @return the tide at the given time.
   /// @param[in] formulae The formulae used to compute the astronomical angles.
+  /// @param[in] time_tolerance The time in seconds during which astronomical
+  /// angles are considered constant. The default value is 0 seconds,
+  /// indicating that astronomical angles do not remain constant with time.
+  /// @param[in] num_threads Number of threads to use for the computation. If
+  /// set to 0, the number of threads is automatically determined.
   /// @return the tide at the given time.
   auto tide_from_tide_series(
       const Eigen::Ref<const Eigen::VectorXd>& epoch,
       const Eigen::Ref<const Vector<uint16_t>>& leap_seconds,
       const Eigen::Ref<const Eigen::VectorXcd>& wave,
-      const angle::Formulae& formulae = angle::Formulae::kSchuremanOrder3) const
+      const angle::Formulae& formulae = angle::Formulae::kSchuremanOrder3,
+      double time_tolerance = 0.0, size_t num_threads = 0) const
       -> Eigen::VectorXd;
 
   /// Calculate the tide for a given date from a grid describing the properties
@@ -295,11 +335,17 @@ class Table {
   /// @param[in] formulae The formulae used to compute the astronomical angles.
   /// @param[in] num_threads Number of threads to use for the computation. If
   /// set to 0, the number of threads is automatically determined.
+  /// @param[in] tile_size Number of positions and constituents evaluated per
+  /// cache tile. The mapping is swept tile by tile so each tile is loaded
+  /// into the cache once and fully consumed; the default fits the tiles in
+  /// a typical L2 cache. Exposed for benchmarking.
+  /// @throw std::invalid_argument if tile_size is not strictly positive.
   auto tide_from_mapping(
       double epoch, uint16_t leap_seconds,
       const DynamicRef<const Eigen::MatrixXcd>& wave,
       const angle::Formulae& formulae = angle::Formulae::kSchuremanOrder3,
-      size_t num_threads = 0) const -> Eigen::MatrixXd;
+      size_t num_threads = 0, Eigen::Index tile_size = 64) const
+      -> Eigen::MatrixXd;
 
   /// Compute nodal modulations for amplitude and phase.
   ///
@@ -318,6 +364,19 @@ class Table {
       const angle::Formulae& formulae) const
       -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>;
 
+  /// Compute nodal modulations for amplitude and phase, resolving the leap
+  /// seconds from the IERS table embedded in the library.
+  ///
+  /// @param[in] epoch Desired UTC times expressed in number of seconds
+  /// elapsed since 1970-01-01T00:00:00Z.
+  /// @param[in] formulae The formulae used to compute the astronomical angles.
+  /// @return The nodal correction for amplitude, v (greenwich argument) + u
+  /// (nodal correction for phase).
+  auto compute_nodal_modulations(
+      const Eigen::Ref<const Eigen::VectorXd>& epoch,
+      const angle::Formulae& formulae) const
+      -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>;
+
  private:
   /// Typename to a function pointer to get a wave from the table
   using Getter =
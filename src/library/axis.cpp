@@ -137,20 +137,23 @@ auto Axis::find_indices(double coordinate) const
   return boost::optional<std::tuple<int64_t, int64_t>>{};
 }
 
-auto Axis::getstate() const -> std::string {
-  auto ss = std::stringstream();
-  ss.exceptions(std::stringstream::failbit);
+auto Axis::getstate(std::ostream& ss) const -> void {
   detail::serialize::write_data(ss, is_circular_);
   detail::serialize::write_data(ss, is_ascending_);
   detail::serialize::write_data(ss, start_);
   detail::serialize::write_data(ss, size_);
   detail::serialize::write_data(ss, step_);
-  return ss.str();
 }
 
-auto Axis::setstate(const string_view& data) -> Axis {
-  detail::isviewstream ss(data);
+auto Axis::getstate() const -> std::string {
+  auto ss = std::stringstream();
   ss.exceptions(std::stringstream::failbit);
+  getstate(ss);
+  return ss.str();
+}
+
+auto Axis::setstate(std::istream& ss) -> Axis {
+  ss.exceptions(std::istream::failbit);
   try {
     auto is_circular = detail::serialize::read_data<bool>(ss);
     auto is_ascending = detail::serialize::read_data<bool>(ss);
@@ -163,4 +166,9 @@ auto Axis::setstate(const string_view& data) -> Axis {
   }
 }
 
+auto Axis::setstate(const string_view& data) -> Axis {
+  detail::isviewstream ss(data);
+  return setstate(ss);
+}
+
 }  // namespace fes
@@ -0,0 +1,192 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes.h"
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fes/constituent.hpp"
+#include "fes/leap_seconds.hpp"
+#include "fes/predictor.hpp"
+#include "fes/tidal_model/netcdf.hpp"
+
+namespace {
+
+/// Message of the last error raised in the calling thread.
+thread_local std::string last_error;  // NOLINT(cert-err58-cpp)
+
+/// Stores the message of the exception being handled and returns the given
+/// result.
+template <typename T>
+auto fail(T result) -> T {
+  try {
+    throw;
+  } catch (const std::exception& error) {
+    last_error = error.what();
+  } catch (...) {
+    last_error = "unknown error";
+  }
+  return result;
+}
+
+}  // namespace
+
+/// Opaque model handle: erases the sample type of the loaded model.
+struct fes_model {
+  virtual ~fes_model() = default;
+
+  /// Builds a prediction session on the model.
+  virtual auto make_predictor(const fes::Settings& settings,
+                              size_t num_threads) const -> fes_predictor* = 0;
+};
+
+/// Opaque session handle: erases the sample type of the predictor.
+struct fes_predictor {
+  virtual ~fes_predictor() = default;
+
+  /// Evaluates the tide for a batch of points.
+  virtual auto evaluate(size_t n, const double* epoch, const double* longitude,
+                        const double* latitude, double* tide,
+                        double* long_period, uint8_t* quality) -> void = 0;
+};
+
+namespace {
+
+template <typename T>
+struct PredictorHandle final : fes_predictor {
+  explicit PredictorHandle(fes::Predictor<T> predictor)
+      : predictor(std::move(predictor)) {}
+
+  auto evaluate(const size_t n, const double* epoch, const double* longitude,
+                const double* latitude, double* tide, double* long_period,
+                uint8_t* quality) -> void override {
+    const auto size = static_cast<Eigen::Index>(n);
+    auto epoch_view = Eigen::Map<const Eigen::VectorXd>(epoch, size);
+    auto longitude_view = Eigen::Map<const Eigen::VectorXd>(longitude, size);
+    auto latitude_view = Eigen::Map<const Eigen::VectorXd>(latitude, size);
+    auto tide_view = Eigen::Map<Eigen::VectorXd>(tide, size);
+    auto long_period_view = Eigen::Map<Eigen::VectorXd>(long_period, size);
+    // Quality is a uint8_t enumeration: the caller array is written in
+    // place.
+    auto quality_view = Eigen::Map<fes::Vector<fes::Quality>>(
+        reinterpret_cast<fes::Quality*>(quality), size);
+    const auto resolved = fes::leap_seconds(epoch_view);
+    predictor.predict(epoch_view, resolved, longitude_view, latitude_view,
+                      tide_view, long_period_view, quality_view);
+  }
+
+  fes::Predictor<T> predictor;
+};
+
+template <typename T>
+struct ModelHandle final : fes_model {
+  explicit ModelHandle(fes::tidal_model::Cartesian<T> cartesian)
+      : model(std::make_shared<fes::tidal_model::Cartesian<T>>(
+            std::move(cartesian))) {}
+
+  auto make_predictor(const fes::Settings& settings,
+                      const size_t num_threads) const -> fes_predictor* final {
+    return new PredictorHandle<T>(
+        fes::Predictor<T>(model, settings, num_threads));
+  }
+
+  std::shared_ptr<const fes::AbstractTidalModel<T>> model;
+};
+
+}  // namespace
+
+extern "C" {
+
+auto fes_last_error() -> const char* {
+  return last_error.empty() ? nullptr : last_error.c_str();
+}
+
+auto fes_load_cartesian(const size_t n_constituents,
+                        const char* const* constituents,
+                        const char* const* paths, const char* const longitude,
+                        const char* const latitude,
+                        const char* const amplitude, const char* const phase,
+                        const fes_tide_type_t tide_type,
+                        const size_t num_threads) -> fes_model_t* {
+  try {
+    auto items = std::vector<std::pair<fes::Constituent, std::string>>();
+    items.reserve(n_constituents);
+    for (size_t ix = 0; ix < n_constituents; ++ix) {
+      items.emplace_back(fes::constituents::parse(constituents[ix]),
+                         paths[ix]);
+    }
+    if (items.empty()) {
+      throw std::invalid_argument("no constituent file to load");
+    }
+    const auto type = static_cast<fes::TideType>(tide_type);
+    // The sample type is chosen from the stored amplitudes: grids packed as
+    // 16-bit integers or 32-bit floating-point values do not carry more than
+    // single precision.
+    auto first = fes::detail::netcdf::File(items.front().second);
+    const auto storage = first.variable(amplitude).type;
+    if (storage == fes::detail::netcdf::kShort ||
+        storage == fes::detail::netcdf::kFloat) {
+      return new ModelHandle<float>(fes::tidal_model::load_cartesian<float>(
+          items, longitude, latitude, amplitude, phase, type, 1e-6,
+          num_threads));
+    }
+    return new ModelHandle<double>(fes::tidal_model::load_cartesian<double>(
+        items, longitude, latitude, amplitude, phase, type, 1e-6,
+        num_threads));
+  } catch (...) {
+    return fail<fes_model_t*>(nullptr);
+  }
+}
+
+auto fes_model_free(fes_model_t* const model) -> void { delete model; }
+
+auto fes_predictor_new(const fes_model_t* const model,
+                       const double time_tolerance, const size_t num_threads)
+    -> fes_predictor_t* {
+  try {
+    if (model == nullptr) {
+      throw std::invalid_argument("model is null");
+    }
+    auto settings = fes::Settings(fes::angle::Formulae::kSchuremanOrder1,
+                                  time_tolerance);
+    return model->make_predictor(settings, num_threads);
+  } catch (...) {
+    return fail<fes_predictor_t*>(nullptr);
+  }
+}
+
+auto fes_predictor_free(fes_predictor_t* const predictor) -> void {
+  delete predictor;
+}
+
+auto fes_evaluate(fes_predictor_t* const predictor, const size_t n,
+                  const double* const epoch, const double* const longitude,
+                  const double* const latitude, double* const tide,
+                  double* const long_period, uint8_t* const quality)
+    -> fes_status_t {
+  try {
+    if (predictor == nullptr || epoch == nullptr || longitude == nullptr ||
+        latitude == nullptr || tide == nullptr || long_period == nullptr ||
+        quality == nullptr) {
+      last_error = "null pointer argument";
+      return FES_INVALID_ARGUMENT;
+    }
+    if (n == 0) {
+      return FES_SUCCESS;
+    }
+    predictor->evaluate(n, epoch, longitude, latitude, tide, long_period,
+                        quality);
+    return FES_SUCCESS;
+  } catch (const std::invalid_argument&) {
+    return fail(FES_INVALID_ARGUMENT);
+  } catch (...) {
+    return fail(FES_RUNTIME_ERROR);
+  }
+}
+
+}  // extern "C"
@@ -4,6 +4,10 @@
 // BSD-style license that can be found in the LICENSE file.
 #include "fes/constituent.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 
@@ -42,11 +46,6 @@ auto known() -> std::vector<std::string> {
           wave::name::kMf1,  wave::name::kMf2,  wave::name::kM0};
 }
 
-inline auto iequals(const std::string& a, const std::string& b) -> bool {
-  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
-                    [](char a, char b) { return tolower(a) == tolower(b); });
-}
-
 auto name(Constituent constituent) -> const char* {
   switch (constituent) {
     case kO1:
@@ -205,231 +204,123 @@ auto name(Constituent constituent) -> const char* {
   }
 }
 
+namespace {
+
+/// One entry of the name lookup table.
+struct Entry {
+  /// Name of the constituent, lowercased.
+  const char* name;
+  /// Identifier of the constituent.
+  Constituent ident;
+};
+
+/// The known names, lowercased and sorted so that parse resolves a
+/// candidate with a binary search instead of a case-insensitive scan over
+/// all of them. The unit tests check the table against known().
+constexpr Entry kEntries[] = {
+    {"2mk3", k2MK3},
+    {"2mk6", k2MK6},
+    {"2mn2", k2MN2},
+    {"2mn6", k2MN6},
+    {"2ms2", k2MS2},
+    {"2ms6", k2MS6},
+    {"2n2", k2N2},
+    {"2q1", k2Q1},
+    {"2sm2", k2SM2},
+    {"2sm6", k2SM6},
+    {"a5", kA5},
+    {"chi1", kChi1},
+    {"eps2", kEps2},
+    {"eta2", kEta2},
+    {"j1", kJ1},
+    {"k1", kK1},
+    {"k2", kK2},
+    {"l2", kL2},
+    {"lambda2", kLambda2},
+    {"m0", kM0},
+    {"m11", kM11},
+    {"m12", kM12},
+    {"m13", kM13},
+    {"m2", kM2},
+    {"m3", kM3},
+    {"m4", kM4},
+    {"m6", kM6},
+    {"m8", kM8},
+    {"mf", kMf},
+    {"mf1", kMf1},
+    {"mf2", kMf2},
+    {"mk3", kMK3},
+    {"mk4", kMK4},
+    {"mks2", kMKS2},
+    {"mm", kMm},
+    {"mm1", kMm1},
+    {"mm2", kMm2},
+    {"mn4", kMN4},
+    {"mns2", kMNS2},
+    {"mo3", kMO3},
+    {"mp1", kMP1},
+    {"ms4", kMS4},
+    {"msf", kMSf},
+    {"msk6", kMSK6},
+    {"msn2", kMSN2},
+    {"msn6", kMSN6},
+    {"msqm", kMsqm},
+    {"mtm", kMtm},
+    {"mu2", kMu2},
+    {"n2", kN2},
+    {"n4", kN4},
+    {"nu2", kNu2},
+    {"o1", kO1},
+    {"oo1", kOO1},
+    {"p1", kP1},
+    {"phi1", kPhi1},
+    {"pi1", kPi1},
+    {"psi1", kPsi1},
+    {"q1", kQ1},
+    {"r2", kR2},
+    {"r4", kR4},
+    {"rho1", kRho1},
+    {"s1", kS1},
+    {"s2", kS2},
+    {"s4", kS4},
+    {"s6", kS6},
+    {"sa", kSa},
+    {"sa1", kSa1},
+    {"sigma1", kSigma1},
+    {"sk4", kSK4},
+    {"sn4", kSN4},
+    {"ssa", kSsa},
+    {"sta", kSta},
+    {"t2", kT2},
+    {"theta1", kTheta1},
+};
+
+/// Length of the longest known name ("lambda2"): bounds the normalization
+/// buffer of parse.
+constexpr auto kMaxNameSize = std::size_t(7);
+
+}  // namespace
+
 auto parse(const std::string& name) -> Constituent {
-  if (iequals(name, wave::name::kO1)) {
-    return kO1;
-  }
-  if (iequals(name, wave::name::kP1)) {
-    return kP1;
-  }
-  if (iequals(name, wave::name::kK1)) {
-    return kK1;
-  }
-  if (iequals(name, wave::name::k2N2)) {
-    return k2N2;
-  }
-  if (iequals(name, wave::name::kMu2)) {
-    return kMu2;
-  }
-  if (iequals(name, wave::name::kN2)) {
-    return kN2;
-  }
-  if (iequals(name, wave::name::kNu2)) {
-    return kNu2;
-  }
-  if (iequals(name, wave::name::kM2)) {
-    return kM2;
-  }
-  if (iequals(name, wave::name::kL2)) {
-    return kL2;
-  }
-  if (iequals(name, wave::name::kT2)) {
-    return kT2;
-  }
-  if (iequals(name, wave::name::kS2)) {
-    return kS2;
-  }
-  if (iequals(name, wave::name::kK2)) {
-    return kK2;
-  }
-  if (iequals(name, wave::name::kM4)) {
-    return kM4;
-  }
-  if (iequals(name, wave::name::kS1)) {
-    return kS1;
-  }
-  if (iequals(name, wave::name::kQ1)) {
-    return kQ1;
-  }
-  if (iequals(name, wave::name::kMm)) {
-    return kMm;
-  }
-  if (iequals(name, wave::name::kMf)) {
-    return kMf;
-  }
-  if (iequals(name, wave::name::kMtm)) {
-    return kMtm;
-  }
-  if (iequals(name, wave::name::kMsqm)) {
-    return kMsqm;
-  }
-  if (iequals(name, wave::name::kEps2)) {
-    return kEps2;
-  }
-  if (iequals(name, wave::name::kLambda2)) {
-    return kLambda2;
-  }
-  if (iequals(name, wave::name::kEta2)) {
-    return kEta2;
-  }
-  if (iequals(name, wave::name::k2Q1)) {
-    return k2Q1;
-  }
-  if (iequals(name, wave::name::kSigma1)) {
-    return kSigma1;
-  }
-  if (iequals(name, wave::name::kRho1)) {
-    return kRho1;
-  }
-  if (iequals(name, wave::name::kM11)) {
-    return kM11;
-  }
-  if (iequals(name, wave::name::kM12)) {
-    return kM12;
-  }
-  if (iequals(name, wave::name::kChi1)) {
-    return kChi1;
-  }
-  if (iequals(name, wave::name::kPi1)) {
-    return kPi1;
-  }
-  if (iequals(name, wave::name::kPhi1)) {
-    return kPhi1;
-  }
-  if (iequals(name, wave::name::kTheta1)) {
-    return kTheta1;
-  }
-  if (iequals(name, wave::name::kJ1)) {
-    return kJ1;
-  }
-  if (iequals(name, wave::name::kOO1)) {
-    return kOO1;
-  }
-  if (iequals(name, wave::name::kM3)) {
-    return kM3;
-  }
-  if (iequals(name, wave::name::kM6)) {
-    return kM6;
-  }
-  if (iequals(name, wave::name::kMN4)) {
-    return kMN4;
-  }
-  if (iequals(name, wave::name::kMS4)) {
-    return kMS4;
-  }
-  if (iequals(name, wave::name::kN4)) {
-    return kN4;
-  }
-  if (iequals(name, wave::name::kR2)) {
-    return kR2;
-  }
-  if (iequals(name, wave::name::kR4)) {
-    return kR4;
-  }
-  if (iequals(name, wave::name::kS4)) {
-    return kS4;
-  }
-  if (iequals(name, wave::name::kMNS2)) {
-    return kMNS2;
-  }
-  if (iequals(name, wave::name::kM13)) {
-    return kM13;
-  }
-  if (iequals(name, wave::name::kMK4)) {
-    return kMK4;
-  }
-  if (iequals(name, wave::name::kSN4)) {
-    return kSN4;
-  }
-  if (iequals(name, wave::name::kSK4)) {
-    return kSK4;
-  }
-  if (iequals(name, wave::name::k2MN6)) {
-    return k2MN6;
-  }
-  if (iequals(name, wave::name::k2MS6)) {
-    return k2MS6;
-  }
-  if (iequals(name, wave::name::k2MK6)) {
-    return k2MK6;
-  }
-  if (iequals(name, wave::name::kMSN6)) {
-    return kMSN6;
-  }
-  if (iequals(name, wave::name::k2SM6)) {
-    return k2SM6;
-  }
-  if (iequals(name, wave::name::kMSK6)) {
-    return kMSK6;
-  }
-  if (iequals(name, wave::name::kMP1)) {
-    return kMP1;
-  }
-  if (iequals(name, wave::name::k2SM2)) {
-    return k2SM2;
-  }
-  if (iequals(name, wave::name::kPsi1)) {
-    return kPsi1;
-  }
-  if (iequals(name, wave::name::k2MS2)) {
-    return k2MS2;
-  }
-  if (iequals(name, wave::name::kMKS2)) {
-    return kMKS2;
-  }
-  if (iequals(name, wave::name::k2MN2)) {
-    return k2MN2;
-  }
-  if (iequals(name, wave::name::kMSN2)) {
-    return kMSN2;
-  }
-  if (iequals(name, wave::name::kMO3)) {
-    return kMO3;
-  }
-  if (iequals(name, wave::name::k2MK3)) {
-    return k2MK3;
-  }
-  if (iequals(name, wave::name::kMK3)) {
-    return kMK3;
-  }
-  if (iequals(name, wave::name::kS6)) {
-    return kS6;
-  }
-  if (iequals(name, wave::name::kM8)) {
-    return kM8;
-  }
-  if (iequals(name, wave::name::kMSf)) {
-    return kMSf;
-  }
-  if (iequals(name, wave::name::kSsa)) {
-    return kSsa;
-  }
-  if (iequals(name, wave::name::kSa)) {
-    return kSa;
-  }
-  if (iequals(name, wave::name::kA5)) {
-    return kA5;
-  }
-  if (iequals(name, wave::name::kSa1)) {
-    return kSa1;
-  }
-  if (iequals(name, wave::name::kSta)) {
-    return kSta;
-  }
-  if (iequals(name, wave::name::kMm1)) {
-    return kMm1;
-  }
-  if (iequals(name, wave::name::kMm2)) {
-    return kMm2;
-  }
-  if (iequals(name, wave::name::kMf1)) {
-    return kMf1;
-  }
-  if (iequals(name, wave::name::kMf2)) {
-    return kMf2;
-  }
-  if (iequals(name, wave::name::kM0)) {
-    return kM0;
+  // The candidate is lowercased into a fixed buffer: resolving a name does
+  // not allocate.
+  char buffer[kMaxNameSize + 1];
+  const auto size = name.size();
+  if (size == 0 || size > kMaxNameSize) {
+    throw std::invalid_argument("invalid tidal constituent: " + name);
+  }
+  for (std::size_t ix = 0; ix < size; ++ix) {
+    buffer[ix] =
+        static_cast<char>(std::tolower(static_cast<unsigned char>(name[ix])));
+  }
+  buffer[size] = '\0';
+  const auto* it = std::lower_bound(
+      std::begin(kEntries), std::end(kEntries), buffer,
+      [](const Entry& entry, const char* const key) {
+        return std::strcmp(entry.name, key) < 0;
+      });
+  if (it != std::end(kEntries) && std::strcmp(it->name, buffer) == 0) {
+    return it->ident;
   }
   throw std::invalid_argument("invalid tidal constituent: " + name);
 }
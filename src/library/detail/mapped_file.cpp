@@ -0,0 +1,88 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/detail/mapped_file.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FES_HAVE_MMAP
+#endif
+
+namespace fes {
+namespace detail {
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef FES_HAVE_MMAP
+  auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    throw std::invalid_argument("unable to open file: " + path);
+  }
+  struct stat properties {};
+  if (::fstat(fd, &properties) == -1) {
+    ::close(fd);
+    throw std::invalid_argument("unable to stat file: " + path);
+  }
+  size_ = static_cast<std::size_t>(properties.st_size);
+  if (size_ != 0) {
+    auto* address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::invalid_argument("unable to map file: " + path);
+    }
+    // The serialized state is parsed front to back.
+    ::madvise(address, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(address);
+    mapped_ = true;
+  }
+  ::close(fd);
+#else
+  auto stream = std::ifstream(path, std::ios::binary | std::ios::ate);
+  if (!stream) {
+    throw std::invalid_argument("unable to open file: " + path);
+  }
+  size_ = static_cast<std::size_t>(stream.tellg());
+  auto* buffer = new char[size_];
+  stream.seekg(0);
+  stream.read(buffer, static_cast<std::streamsize>(size_));
+  data_ = buffer;
+#endif
+}
+
+MappedFile::~MappedFile() { release(); }
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+  if (this != &other) {
+    release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mapped_ = std::exchange(other.mapped_, false);
+  }
+  return *this;
+}
+
+auto MappedFile::release() noexcept -> void {
+  if (data_ == nullptr) {
+    return;
+  }
+#ifdef FES_HAVE_MMAP
+  if (mapped_) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+#else
+  delete[] data_;
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+}
+
+}  // namespace detail
+}  // namespace fes
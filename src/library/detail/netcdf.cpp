@@ -0,0 +1,352 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/detail/netcdf.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace fes {
+namespace detail {
+namespace netcdf {
+
+namespace {
+
+/// Tag of the dimension list in the header.
+constexpr int32_t kDimensionTag = 0x0A;
+/// Tag of a variable list in the header.
+constexpr int32_t kVariableTag = 0x0B;
+/// Tag of an attribute list in the header.
+constexpr int32_t kAttributeTag = 0x0C;
+
+/// Size, in bytes, of a stored value of the given type.
+auto item_size(const Type type) -> std::size_t {
+  switch (type) {
+    case kByte:
+    case kChar:
+      return 1;
+    case kShort:
+      return 2;
+    case kInt:
+    case kFloat:
+      return 4;
+    case kDouble:
+      return 8;
+    default:
+      throw std::invalid_argument("unknown netCDF type: " +
+                                  std::to_string(type));
+  }
+}
+
+/// Bounds-checked cursor over the mapped header, decoding the big-endian
+/// encoding of the classic format.
+class Cursor {
+ public:
+  explicit Cursor(const string_view& view)
+      : data_(reinterpret_cast<const unsigned char*>(view.data())),
+        size_(view.size()) {}
+
+  auto read_uint32() -> uint32_t {
+    ensure(4);
+    auto result = (static_cast<uint32_t>(data_[pos_]) << 24U) |
+                  (static_cast<uint32_t>(data_[pos_ + 1]) << 16U) |
+                  (static_cast<uint32_t>(data_[pos_ + 2]) << 8U) |
+                  static_cast<uint32_t>(data_[pos_ + 3]);
+    pos_ += 4;
+    return result;
+  }
+
+  auto read_int32() -> int32_t { return static_cast<int32_t>(read_uint32()); }
+
+  auto read_int64() -> int64_t {
+    auto high = static_cast<uint64_t>(read_uint32());
+    auto low = static_cast<uint64_t>(read_uint32());
+    return static_cast<int64_t>((high << 32U) | low);
+  }
+
+  /// Read a name: its length followed by its characters, padded to a
+  /// four-byte boundary.
+  auto read_name() -> std::string {
+    auto size = read_int32();
+    if (size < 0) {
+      fail();
+    }
+    ensure(static_cast<std::size_t>(size));
+    auto result = std::string(
+        reinterpret_cast<const char*>(data_ + pos_),
+        static_cast<std::size_t>(size));
+    pos_ += static_cast<std::size_t>(size);
+    skip_padding();
+    return result;
+  }
+
+  /// Read the values of an attribute, padded to a four-byte boundary.
+  auto read_attribute(Attribute& attribute) -> void {
+    auto size = read_int32();
+    if (size < 0) {
+      fail();
+    }
+    auto count = static_cast<std::size_t>(size);
+    if (attribute.type == kChar) {
+      ensure(count);
+      attribute.text = std::string(
+          reinterpret_cast<const char*>(data_ + pos_), count);
+      pos_ += count;
+    } else {
+      attribute.values.reserve(count);
+      for (std::size_t ix = 0; ix < count; ++ix) {
+        attribute.values.push_back(read_value(attribute.type));
+      }
+    }
+    skip_padding();
+  }
+
+  /// Read one stored value of the given type, widened to double.
+  auto read_value(const Type type) -> double {
+    switch (type) {
+      case kByte: {
+        ensure(1);
+        auto result = static_cast<int8_t>(data_[pos_]);
+        ++pos_;
+        return static_cast<double>(result);
+      }
+      case kShort: {
+        ensure(2);
+        auto result = static_cast<int16_t>(
+            (static_cast<uint16_t>(data_[pos_]) << 8U) |
+            static_cast<uint16_t>(data_[pos_ + 1]));
+        pos_ += 2;
+        return static_cast<double>(result);
+      }
+      case kInt:
+        return static_cast<double>(read_int32());
+      case kFloat: {
+        auto bits = read_uint32();
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return static_cast<double>(result);
+      }
+      case kDouble: {
+        auto bits = static_cast<uint64_t>(read_int64());
+        double result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+      }
+      default:
+        fail();
+    }
+  }
+
+  auto position() const noexcept -> std::size_t { return pos_; }
+
+  /// Fail the parsing: the header does not follow the classic format.
+  [[noreturn]] static auto fail() -> void {
+    throw std::invalid_argument("corrupted netCDF classic file");
+  }
+
+ private:
+  const unsigned char* data_;
+  std::size_t size_;
+  std::size_t pos_{0};
+
+  auto ensure(const std::size_t size) const -> void {
+    if (size > size_ - pos_ || pos_ > size_) {
+      fail();
+    }
+  }
+
+  auto skip_padding() -> void {
+    auto padding = (4 - (pos_ & 3U)) & 3U;
+    ensure(padding);
+    pos_ += padding;
+  }
+};
+
+/// True if a view and a name hold the same characters.
+auto equals(const string_view& view, const std::string& name) -> bool {
+  return view.size() == name.size() &&
+         std::memcmp(view.data(), name.data(), name.size()) == 0;
+}
+
+/// Read an attribute list: its tag and the attributes it holds.
+auto read_attributes(Cursor& cursor) -> std::vector<Attribute> {
+  auto tag = cursor.read_int32();
+  auto count = cursor.read_int32();
+  if ((tag != kAttributeTag && tag != 0) || (tag == 0 && count != 0) ||
+      count < 0) {
+    Cursor::fail();
+  }
+  auto result = std::vector<Attribute>();
+  result.reserve(static_cast<std::size_t>(count));
+  for (auto ix = 0; ix < count; ++ix) {
+    auto attribute = Attribute();
+    attribute.name = cursor.read_name();
+    attribute.type = static_cast<Type>(cursor.read_int32());
+    item_size(attribute.type);
+    cursor.read_attribute(attribute);
+    result.emplace_back(std::move(attribute));
+  }
+  return result;
+}
+
+}  // namespace
+
+auto Variable::attribute(const string_view& name) const -> const Attribute* {
+  for (const auto& item : attributes) {
+    if (equals(name, item.name)) {
+      return &item;
+    }
+  }
+  return nullptr;
+}
+
+File::File(const std::string& path) : file_(path) {
+  auto view = file_.view();
+  if (view.size() < 4 || view[0] != 'C' || view[1] != 'D' || view[2] != 'F') {
+    throw std::invalid_argument("not a netCDF classic file: " + path);
+  }
+  auto version = view[3];
+  if (version != 1 && version != 2) {
+    throw std::invalid_argument(
+        "unhandled netCDF format version (only the classic CDF-1 and CDF-2 "
+        "formats are handled): " +
+        path);
+  }
+  auto cursor = Cursor(string_view(view.data() + 4, view.size() - 4));
+  auto numrecs = cursor.read_int32();
+
+  // Dimension list.
+  auto tag = cursor.read_int32();
+  auto count = cursor.read_int32();
+  if ((tag != kDimensionTag && tag != 0) || (tag == 0 && count != 0) ||
+      count < 0) {
+    Cursor::fail();
+  }
+  dimensions_.reserve(static_cast<std::size_t>(count));
+  for (auto ix = 0; ix < count; ++ix) {
+    auto dimension = Dimension();
+    dimension.name = cursor.read_name();
+    dimension.size = cursor.read_int32();
+    if (dimension.size == 0) {
+      // The record dimension: its actual size is the number of records.
+      record_dimension_ = ix;
+      dimension.size = numrecs;
+    }
+    dimensions_.emplace_back(std::move(dimension));
+  }
+
+  // Global attributes.
+  attributes_ = read_attributes(cursor);
+
+  // Variable list.
+  tag = cursor.read_int32();
+  count = cursor.read_int32();
+  if ((tag != kVariableTag && tag != 0) || (tag == 0 && count != 0) ||
+      count < 0) {
+    Cursor::fail();
+  }
+  variables_.reserve(static_cast<std::size_t>(count));
+  for (auto ix = 0; ix < count; ++ix) {
+    auto variable = Variable();
+    variable.name = cursor.read_name();
+    auto rank = cursor.read_int32();
+    if (rank < 0) {
+      Cursor::fail();
+    }
+    variable.dimensions.reserve(static_cast<std::size_t>(rank));
+    variable.size = 1;
+    for (auto jx = 0; jx < rank; ++jx) {
+      auto id = cursor.read_int32();
+      if (id < 0 || static_cast<std::size_t>(id) >= dimensions_.size()) {
+        Cursor::fail();
+      }
+      variable.dimensions.push_back(id);
+      variable.size *= dimensions_[static_cast<std::size_t>(id)].size;
+    }
+    variable.attributes = read_attributes(cursor);
+    variable.type = static_cast<Type>(cursor.read_int32());
+    item_size(variable.type);
+    cursor.read_int32();  // vsize, redundant with the dimensions.
+    variable.begin =
+        version == 1 ? cursor.read_int32() : cursor.read_int64();
+    variables_.emplace_back(std::move(variable));
+  }
+}
+
+auto File::has_variable(const std::string& name) const -> bool {
+  for (const auto& item : variables_) {
+    if (item.name == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto File::variable(const std::string& name) const -> const Variable& {
+  for (const auto& item : variables_) {
+    if (item.name == name) {
+      return item;
+    }
+  }
+  throw std::invalid_argument("no such netCDF variable: " + name);
+}
+
+auto File::values(const Variable& variable) const -> Vector<double> {
+  if (variable.type == kChar) {
+    throw std::invalid_argument("netCDF variable holds text, not values: " +
+                                variable.name);
+  }
+  if (record_dimension_ >= 0 && !variable.dimensions.empty() &&
+      variable.dimensions.front() == record_dimension_) {
+    // The records of such a variable are interleaved with those of the
+    // other record variables; the tidal atlases do not use them.
+    throw std::invalid_argument("netCDF record variables are not handled: " +
+                                variable.name);
+  }
+  auto view = file_.view();
+  auto bytes = static_cast<std::size_t>(variable.size) *
+               item_size(variable.type);
+  if (variable.begin < 0 ||
+      static_cast<std::size_t>(variable.begin) > view.size() ||
+      bytes > view.size() - static_cast<std::size_t>(variable.begin)) {
+    Cursor::fail();
+  }
+  auto cursor = Cursor(string_view(
+      view.data() + static_cast<std::size_t>(variable.begin), bytes));
+
+  auto scale = 1.0;
+  auto offset = 0.0;
+  const auto* attribute = variable.attribute("scale_factor");
+  if (attribute != nullptr && !attribute->values.empty()) {
+    scale = attribute->values.front();
+  }
+  attribute = variable.attribute("add_offset");
+  if (attribute != nullptr && !attribute->values.empty()) {
+    offset = attribute->values.front();
+  }
+  // The fill value is compared to the stored samples, before the scale and
+  // offset are applied.
+  auto fill = std::numeric_limits<double>::quiet_NaN();
+  attribute = variable.attribute("_FillValue");
+  if (attribute == nullptr) {
+    attribute = variable.attribute("missing_value");
+  }
+  if (attribute != nullptr && !attribute->values.empty()) {
+    fill = attribute->values.front();
+  }
+
+  auto result = Vector<double>(variable.size);
+  for (Eigen::Index ix = 0; ix < variable.size; ++ix) {
+    auto value = cursor.read_value(variable.type);
+    result(ix) = value == fill
+                     ? std::numeric_limits<double>::quiet_NaN()
+                     : value * scale + offset;
+  }
+  return result;
+}
+
+}  // namespace netcdf
+}  // namespace detail
+}  // namespace fes
@@ -0,0 +1,114 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/detail/shared_memory.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FES_HAVE_SHM
+#endif
+
+namespace fes {
+namespace detail {
+
+SharedMemory::SharedMemory(const std::string& name, const std::size_t size) {
+#ifdef FES_HAVE_SHM
+  auto fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+  if (fd == -1) {
+    throw std::invalid_argument("unable to create shared memory segment: " +
+                                name);
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+    ::close(fd);
+    throw std::invalid_argument("unable to size shared memory segment: " +
+                                name);
+  }
+  size_ = size;
+  if (size_ != 0) {
+    auto* address =
+        ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::invalid_argument("unable to map shared memory segment: " +
+                                  name);
+    }
+    data_ = static_cast<char*>(address);
+  }
+  ::close(fd);
+#else
+  static_cast<void>(size);
+  throw std::invalid_argument(
+      "shared memory segments are not supported on this platform");
+#endif
+}
+
+SharedMemory::SharedMemory(const std::string& name) {
+#ifdef FES_HAVE_SHM
+  auto fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd == -1) {
+    throw std::invalid_argument("unable to open shared memory segment: " +
+                                name);
+  }
+  struct stat properties {};
+  if (::fstat(fd, &properties) == -1) {
+    ::close(fd);
+    throw std::invalid_argument("unable to stat shared memory segment: " +
+                                name);
+  }
+  size_ = static_cast<std::size_t>(properties.st_size);
+  if (size_ != 0) {
+    auto* address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::invalid_argument("unable to map shared memory segment: " +
+                                  name);
+    }
+    // The pages are mapped read-only: writing through data() would fault.
+    data_ = static_cast<char*>(address);
+  }
+  ::close(fd);
+#else
+  throw std::invalid_argument(
+      "shared memory segments are not supported on this platform");
+#endif
+}
+
+SharedMemory::~SharedMemory() { release(); }
+
+auto SharedMemory::operator=(SharedMemory&& other) noexcept -> SharedMemory& {
+  if (this != &other) {
+    release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+auto SharedMemory::unlink(const std::string& name) -> void {
+#ifdef FES_HAVE_SHM
+  ::shm_unlink(name.c_str());
+#else
+  static_cast<void>(name);
+#endif
+}
+
+auto SharedMemory::release() noexcept -> void {
+  if (data_ == nullptr) {
+    return;
+  }
+#ifdef FES_HAVE_SHM
+  ::munmap(data_, size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace detail
+}  // namespace fes
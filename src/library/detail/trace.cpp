@@ -0,0 +1,66 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/detail/trace.hpp"
+
+#include <cstdlib>
+#include <fstream>
+
+namespace fes {
+namespace detail {
+namespace trace {
+
+auto Recorder::instance() -> Recorder& {
+  static Recorder recorder;
+  return recorder;
+}
+
+Recorder::Recorder() {
+  const auto* path = std::getenv("FES_TRACE");
+  if (path == nullptr || *path == '\0') {
+    return;
+  }
+  enabled_ = true;
+  path_ = path;
+  origin_ = std::chrono::steady_clock::now();
+}
+
+auto Recorder::record(const char* const name, const double start) -> void {
+  // The buffer of the calling thread, registered with the recorder on the
+  // first span so the destructor can collect it.
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.emplace_back(new ThreadBuffer{buffers_.size(), {}});
+    buffer = buffers_.back().get();
+  }
+  buffer->events.push_back({name, start, now() - start, buffer->tid});
+}
+
+Recorder::~Recorder() {
+  if (!enabled_) {
+    return;
+  }
+  auto stream = std::ofstream(path_);
+  if (!stream) {
+    return;
+  }
+  stream << "{\"traceEvents\":[";
+  auto first = true;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& buffer : buffers_) {
+    for (const auto& event : buffer->events) {
+      stream << (first ? "\n" : ",\n")
+             << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":0,"
+             << "\"tid\":" << event.tid << ",\"ts\":" << event.ts
+             << ",\"dur\":" << event.dur << "}";
+      first = false;
+    }
+  }
+  stream << "\n]}\n";
+}
+
+}  // namespace trace
+}  // namespace detail
+}  // namespace fes
@@ -5,9 +5,10 @@
 #include "fes/mesh/index.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <exception>
 #include <limits>
-#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -50,10 +51,12 @@ static auto sanity_check(
 }
 
 Index::Index(Eigen::VectorXd lon, Eigen::VectorXd lat,
-             Eigen::Matrix<int32_t, Eigen::Dynamic, 3> triangles)
+             Eigen::Matrix<int32_t, Eigen::Dynamic, 3> triangles,
+             const Backend backend)
     : lon_(std::move(lon)),
       lat_(std::move(lat)),
-      triangles_(std::move(triangles)) {
+      triangles_(std::move(triangles)),
+      backend_(backend) {
   // Sanity checks on the input data
   sanity_check(lon_, lat_, triangles_);
 
@@ -61,6 +64,134 @@ Index::Index(Eigen::VectorXd lon, Eigen::VectorXd lat,
   std::for_each(lon_.data(), lon_.data() + lon_.size(),
                 [](double& lon) { lon = detail::math::normalize_angle(lon); });
 
+  // The ECEF coordinates are computed once per vertex, not once per
+  // triangle corner.
+  ecef_ = Eigen::Matrix<double, Eigen::Dynamic, 3>(lon_.size(), 3);
+  for (Eigen::Index ix = 0; ix < lon_.size(); ++ix) {
+    const auto point = static_cast<geometry::EarthCenteredEarthFixed>(
+        geometry::Point(lon_(ix), lat_(ix)));
+    ecef_(ix, 0) = point.x();
+    ecef_(ix, 1) = point.y();
+    ecef_(ix, 2) = point.z();
+  }
+  build_backend();
+}
+
+Index::Index(Eigen::VectorXd lon, Eigen::VectorXd lat,
+             Eigen::Matrix<int32_t, Eigen::Dynamic, 3> triangles,
+             Eigen::Matrix<double, Eigen::Dynamic, 3> ecef,
+             const Backend backend)
+    : lon_(std::move(lon)),
+      lat_(std::move(lat)),
+      triangles_(std::move(triangles)),
+      backend_(backend),
+      ecef_(std::move(ecef)) {
+  build_backend();
+}
+
+auto Index::build_backend() -> void {
+  build_adjacency();
+  build_barycentric();
+  // The cell grid is built for both backends: the R*Tree uses it as a
+  // coarse occupancy bitmap to reject out-of-domain queries without a
+  // spatial search.
+  build_grid();
+  if (backend_ == kRTree) {
+    build_rtree();
+  }
+}
+
+auto Index::build_barycentric() -> void {
+  barycentric_.resize(triangles_.rows(), 6);
+  for (auto ix = int32_t(0); ix < triangles_.rows(); ++ix) {
+    const auto i0 = triangles_(ix, 0);
+    const auto i1 = triangles_(ix, 1);
+    const auto i2 = triangles_(ix, 2);
+    // Offsets of the second and third vertices, in a local frame centered on
+    // the first vertex so that the longitudes do not wrap.
+    const auto ctx = detail::math::normalize_angle(lon_(i1) - lon_(i0));
+    const auto cty = detail::math::normalize_angle(lon_(i2) - lon_(i0));
+    const auto cpx = lat_(i1) - lat_(i0);
+    const auto cpy = lat_(i2) - lat_(i0);
+
+    const auto jacobien = ctx * cpy - cty * cpx;
+    auto inverse = std::numeric_limits<double>::quiet_NaN();
+    if (!detail::math::is_almost_zero(jacobien)) {
+      inverse = 1.0 / jacobien;
+    }
+    barycentric_(ix, 0) = lon_(i0);
+    barycentric_(ix, 1) = lat_(i0);
+    barycentric_(ix, 2) = cpy * inverse;
+    barycentric_(ix, 3) = -cty * inverse;
+    barycentric_(ix, 4) = -cpx * inverse;
+    barycentric_(ix, 5) = ctx * inverse;
+  }
+}
+
+auto Index::contains(const int32_t triangle_index,
+                     const geometry::Point& point) const -> bool {
+  // The tolerance absorbs the rounding of the transform for points lying on
+  // the border of the triangle. A NaN transform (degenerate triangle) fails
+  // every comparison.
+  constexpr auto kEpsilon = 1e-12;
+  const auto row = barycentric_.row(triangle_index);
+  const auto dx = detail::math::normalize_angle(point.lon() - row(0));
+  const auto dy = point.lat() - row(1);
+  const auto x = row(2) * dx + row(3) * dy;
+  const auto y = row(4) * dx + row(5) * dy;
+  return x >= -kEpsilon && y >= -kEpsilon && x + y <= 1 + kEpsilon;
+}
+
+auto Index::reference_right_angled(const int32_t triangle_index,
+                                   const geometry::Point& point) const
+    -> std::tuple<double, double> {
+  const auto row = barycentric_.row(triangle_index);
+  if (std::isnan(row(2))) {
+    // Degenerate triangle: same result as the uncached computation.
+    return {0.0, 0.0};
+  }
+  const auto dx = detail::math::normalize_angle(point.lon() - row(0));
+  const auto dy = point.lat() - row(1);
+  return {row(2) * dx + row(3) * dy, row(4) * dx + row(5) * dy};
+}
+
+auto Index::build_adjacency() -> void {
+  // One record per directed edge: the undirected edge as a sortable key, the
+  // triangle and the edge slot it was seen from.
+  struct Edge {
+    uint64_t key;
+    int32_t triangle;
+    int8_t slot;
+  };
+  auto edges = std::vector<Edge>();
+  edges.reserve(triangles_.rows() * 3);
+  for (auto ix = int32_t(0); ix < triangles_.rows(); ++ix) {
+    for (int8_t jx = 0; jx < 3; ++jx) {
+      const auto a = triangles_(ix, jx);
+      const auto b = triangles_(ix, (jx + 1) % 3);
+      const auto key = (static_cast<uint64_t>(std::min(a, b)) << 32U) |
+                       static_cast<uint64_t>(std::max(a, b));
+      edges.push_back({key, ix, jx});
+    }
+  }
+  std::sort(edges.begin(), edges.end(),
+            [](const Edge& lhs, const Edge& rhs) { return lhs.key < rhs.key; });
+
+  // Triangles sharing an edge end up adjacent in the sorted records.
+  adjacency_ = Eigen::Matrix<int32_t, Eigen::Dynamic, 3>::Constant(
+      triangles_.rows(), 3, -1);
+  for (size_t ix = 1; ix < edges.size(); ++ix) {
+    const auto& lhs = edges[ix - 1];
+    const auto& rhs = edges[ix];
+    if (lhs.key == rhs.key) {
+      adjacency_(lhs.triangle, lhs.slot) = rhs.triangle;
+      adjacency_(rhs.triangle, rhs.slot) = lhs.triangle;
+      ++ix;
+    }
+  }
+}
+
+auto Index::build_rtree() -> void {
   // Allocate the values used to build the index.
   auto values = std::vector<value_t>{};
   values.reserve(triangles_.rows() * 3);
@@ -73,19 +204,324 @@ Index::Index(Eigen::VectorXd lon, Eigen::VectorXd lat,
     // index to the values vector.
     for (uint8_t jx = 0; jx < 3; ++jx) {
       auto kx = index(jx);
-      values.emplace_back(static_cast<geometry::EarthCenteredEarthFixed>(
-                              geometry::Point(lon_(kx), lat_(kx))),
+      values.emplace_back(geometry::EarthCenteredEarthFixed(
+                              ecef_(kx, 0), ecef_(kx, 1), ecef_(kx, 2)),
                           std::make_pair(jx, ix));
     }
   }
   rtree_ = rtree_t{values.begin(), values.end()};
 }
 
+template <typename Callable>
+auto Index::for_each_cell(const int32_t triangle_index,
+                          const Callable& callable) const -> void {
+  const Eigen::Vector3i& index = triangles_.row(triangle_index);
+  auto min_lon = std::numeric_limits<double>::max();
+  auto max_lon = std::numeric_limits<double>::lowest();
+  auto min_lat = std::numeric_limits<double>::max();
+  auto max_lat = std::numeric_limits<double>::lowest();
+  for (uint8_t jx = 0; jx < 3; ++jx) {
+    min_lon = std::min(min_lon, lon_(index(jx)));
+    max_lon = std::max(max_lon, lon_(index(jx)));
+    min_lat = std::min(min_lat, lat_(index(jx)));
+    max_lat = std::max(max_lat, lat_(index(jx)));
+  }
+  const auto clamp = [](const int32_t value, const int32_t upper) -> int32_t {
+    return std::max(int32_t(0), std::min(value, upper - 1));
+  };
+  const auto x_cell = [&](const double lon) -> int32_t {
+    return clamp(
+        static_cast<int32_t>((lon - grid_.lon_min) / grid_.cell_width),
+        grid_.nx);
+  };
+  const auto y0 = clamp(
+      static_cast<int32_t>((min_lat - grid_.lat_min) / grid_.cell_height),
+      grid_.ny);
+  const auto y1 = clamp(
+      static_cast<int32_t>((max_lat - grid_.lat_min) / grid_.cell_height),
+      grid_.ny);
+  // A triangle whose longitudes span more than half the circle crosses the
+  // seam: its cells run from the easternmost vertex to the end of the row
+  // and from the start of the row to the westernmost vertex.
+  const auto crosses_seam = max_lon - min_lon > 180.0;
+  for (auto y = y0; y <= y1; ++y) {
+    if (crosses_seam) {
+      for (auto x = x_cell(max_lon); x < grid_.nx; ++x) {
+        callable(y * grid_.nx + x);
+      }
+      for (auto x = int32_t(0); x <= x_cell(min_lon); ++x) {
+        callable(y * grid_.nx + x);
+      }
+    } else {
+      for (auto x = x_cell(min_lon); x <= x_cell(max_lon); ++x) {
+        callable(y * grid_.nx + x);
+      }
+    }
+  }
+}
+
+auto Index::build_grid() -> void {
+  const auto n = static_cast<int32_t>(triangles_.rows());
+  grid_.lon_min = lon_.minCoeff();
+  grid_.lat_min = lat_.minCoeff();
+  const auto width = std::max(lon_.maxCoeff() - grid_.lon_min,
+                              std::numeric_limits<double>::epsilon());
+  const auto height = std::max(lat_.maxCoeff() - grid_.lat_min,
+                               std::numeric_limits<double>::epsilon());
+
+  // Aim at one cell per triangle, so that a cell of a quasi-uniform mesh
+  // holds a handful of candidates.
+  const auto clamp_axis = [](const double value) -> int32_t {
+    return static_cast<int32_t>(
+        std::max(1.0, std::min(value, double(std::numeric_limits<int16_t>::max()))));
+  };
+  grid_.ny = clamp_axis(std::round(std::sqrt(n * height / width)));
+  grid_.nx = clamp_axis(std::round(double(n) / grid_.ny));
+  grid_.cell_width = width / grid_.nx;
+  grid_.cell_height = height / grid_.ny;
+  grid_.circular = width >= 360.0 - grid_.cell_width;
+
+  // First pass: count the candidates of each cell.
+  grid_.offsets.assign(static_cast<size_t>(grid_.nx) * grid_.ny + 1, 0);
+  for (auto ix = int32_t(0); ix < n; ++ix) {
+    for_each_cell(ix, [this](const int32_t cell) { ++grid_.offsets[cell + 1]; });
+  }
+  for (size_t cell = 1; cell < grid_.offsets.size(); ++cell) {
+    grid_.offsets[cell] += grid_.offsets[cell - 1];
+  }
+
+  // Second pass: fill the candidates of each cell. The cursors start at the
+  // cell offsets and advance as the candidates are written.
+  grid_.candidates.resize(grid_.offsets.back());
+  auto cursors = std::vector<int32_t>(grid_.offsets.begin(),
+                                      grid_.offsets.end() - 1);
+  for (auto ix = int32_t(0); ix < n; ++ix) {
+    for_each_cell(ix, [this, ix, &cursors](const int32_t cell) {
+      grid_.candidates[cursors[cell]++] = ix;
+    });
+  }
+
+  // Distance transform of the occupancy: a multi-source ring expansion from
+  // the non-empty cells, one ring of the 8-neighborhood per pass, yields the
+  // Chebyshev distance of every cell to the mesh. maybe_inside() classifies
+  // a query with one lookup in this field instead of scanning a
+  // neighborhood of cells.
+  const auto n_cells = static_cast<size_t>(grid_.nx) * grid_.ny;
+  grid_.distance.assign(n_cells, std::numeric_limits<uint8_t>::max());
+  auto current = std::vector<int32_t>();
+  for (size_t cell = 0; cell < n_cells; ++cell) {
+    if (grid_.offsets[cell] != grid_.offsets[cell + 1]) {
+      grid_.distance[cell] = 0;
+      current.push_back(static_cast<int32_t>(cell));
+    }
+  }
+  auto next = std::vector<int32_t>();
+  for (auto d = uint32_t(1);
+       d < std::numeric_limits<uint8_t>::max() && !current.empty(); ++d) {
+    next.clear();
+    for (const auto cell : current) {
+      const auto cx = cell % grid_.nx;
+      const auto cy = cell / grid_.nx;
+      for (auto dy = int32_t(-1); dy <= 1; ++dy) {
+        const auto y = cy + dy;
+        if (y < 0 || y >= grid_.ny) {
+          continue;
+        }
+        for (auto dx = int32_t(-1); dx <= 1; ++dx) {
+          auto x = cx + dx;
+          if (grid_.circular) {
+            x = (x + grid_.nx) % grid_.nx;
+          } else if (x < 0 || x >= grid_.nx) {
+            continue;
+          }
+          const auto neighbor = y * grid_.nx + x;
+          if (grid_.distance[neighbor] > d) {
+            grid_.distance[neighbor] = static_cast<uint8_t>(d);
+            next.push_back(neighbor);
+          }
+        }
+      }
+    }
+    std::swap(current, next);
+  }
+}
+
+/// Spread the 16 low bits of a value over 32 bits, leaving one zero bit
+/// between two consecutive bits.
+static constexpr auto spread_bits(uint32_t value) -> uint32_t {
+  value &= 0x0000ffffU;
+  value = (value | (value << 8)) & 0x00ff00ffU;
+  value = (value | (value << 4)) & 0x0f0f0f0fU;
+  value = (value | (value << 2)) & 0x33333333U;
+  value = (value | (value << 1)) & 0x55555555U;
+  return value;
+}
+
+/// Morton code of a point: its longitude and latitude are quantized to 16
+/// bits each and their bits interleaved. Points close on the sphere get
+/// close codes.
+static auto morton_code(const geometry::Point& point) -> uint32_t {
+  const auto x = static_cast<uint32_t>(
+      (detail::math::normalize_angle(point.lon()) + 180.0) * (65535.0 / 360.0));
+  const auto y =
+      static_cast<uint32_t>((point.lat() + 90.0) * (65535.0 / 180.0));
+  return spread_bits(x) | (spread_bits(y) << 1);
+}
+
+auto Index::maybe_inside(const geometry::Point& point,
+                         const double max_distance) const -> bool {
+  // Locate the cell of the query. A query outside the raster is clamped to
+  // its nearest edge cell and the clamping offset, in cells, is folded back
+  // into the distance below.
+  const auto lon = detail::math::normalize_angle(point.lon());
+  auto x = static_cast<int64_t>(
+      std::floor((lon - grid_.lon_min) / grid_.cell_width));
+  auto y = static_cast<int64_t>(
+      std::floor((point.lat() - grid_.lat_min) / grid_.cell_height));
+  auto overshoot = int64_t(0);
+  if (grid_.circular) {
+    x = (x % grid_.nx + grid_.nx) % grid_.nx;
+  } else if (x < 0) {
+    overshoot = -x;
+    x = 0;
+  } else if (x >= grid_.nx) {
+    overshoot = x - grid_.nx + 1;
+    x = grid_.nx - 1;
+  }
+  if (y < 0) {
+    overshoot = std::max(overshoot, -y);
+    y = 0;
+  } else if (y >= grid_.ny) {
+    overshoot = std::max(overshoot, y - grid_.ny + 1);
+    y = grid_.ny - 1;
+  }
+
+  // Chebyshev distance, in cells, from the query to the nearest non-empty
+  // cell: the precomputed field at the clamped cell, corrected by the
+  // clamping offset through the reverse triangle inequality.
+  const auto field = static_cast<int64_t>(grid_.distance[y * grid_.nx + x]);
+  const auto cells = std::max(field - overshoot, overshoot);
+  if (cells < 2) {
+    // The query sits in or next to a non-empty cell: only the spatial
+    // search can decide.
+    return true;
+  }
+
+  // A Chebyshev distance of d cells guarantees d - 1 empty cells along one
+  // axis; which axis is unknown, so the shorter conversion of the two
+  // bounds the distance on the sphere from below. One degree is counted as
+  // 110 km along a meridian and shrunk, along a parallel, by the cosine of
+  // the highest latitude the separation can reach.
+  constexpr auto kMetersPerDegree = 110e3;
+  const auto lat_extent = std::max(
+      std::abs(point.lat()),
+      std::max(std::abs(grid_.lat_min),
+               std::abs(grid_.lat_min + grid_.ny * grid_.cell_height)));
+  const auto degrees = static_cast<double>(cells - 1);
+  const auto meters =
+      kMetersPerDegree *
+      std::min(degrees * grid_.cell_height,
+               degrees * grid_.cell_width *
+                   std::max(std::cos(detail::math::radians(lat_extent)), 0.0));
+  return meters <= max_distance;
+}
+
 auto Index::search(const geometry::Point& point,
                    const double max_distance) const -> SelectedTriangle {
+  // Reject a query outside the model domain before any spatial search: a
+  // global grid pays nothing for the points over land.
+  if (!maybe_inside(point, max_distance)) {
+    return {};
+  }
+  return backend_ == kUniformGrid ? search_grid(point, max_distance)
+                                  : search_rtree(point, max_distance);
+}
+
+auto Index::search_from(const geometry::Point& point, const int32_t hint,
+                        const double max_distance) const -> SelectedTriangle {
+  // A query staying close to the hint is found in two or three steps; a
+  // larger budget only delays the fall back to the full search.
+  constexpr auto kMaxSteps = int32_t(16);
+
+  if (hint < 0 || hint >= triangles_.rows()) {
+    return search(point, max_distance);
+  }
+
+  // 2D orientation of a vertex or of the query with respect to the directed
+  // edge (a, b), in a local frame centered on a so that the longitudes do
+  // not wrap.
+  const auto orient = [this](const int32_t a, const int32_t b,
+                             const double lon, const double lat) {
+    const auto bx = detail::math::normalize_angle(lon_(b) - lon_(a));
+    const auto by = lat_(b) - lat_(a);
+    const auto px = detail::math::normalize_angle(lon - lon_(a));
+    const auto py = lat - lat_(a);
+    return bx * py - by * px;
+  };
+
+  auto current = hint;
+  for (auto step = int32_t(0); step < kMaxSteps; ++step) {
+    if (contains(current, point)) {
+      return {true, current, point, build_triangle(current)};
+    }
+    // Cross the first edge putting the query and the opposite vertex on
+    // opposite sides. An exit edge on the mesh boundary, or no exit edge at
+    // all, ends the walk.
+    auto next = int32_t(-1);
+    for (int8_t jx = 0; jx < 3; ++jx) {
+      const auto a = triangles_(current, jx);
+      const auto b = triangles_(current, (jx + 1) % 3);
+      const auto c = triangles_(current, (jx + 2) % 3);
+      const auto side = orient(a, b, point.lon(), point.lat());
+      const auto reference = orient(a, b, lon_(c), lat_(c));
+      if (side * reference < 0 && adjacency_(current, jx) != -1) {
+        next = adjacency_(current, jx);
+        break;
+      }
+    }
+    if (next == -1) {
+      break;
+    }
+    current = next;
+  }
+  return search(point, max_distance);
+}
+
+auto Index::search_many(const std::vector<geometry::Point>& points,
+                        const double max_distance) const
+    -> std::vector<SelectedTriangle> {
+  // Schedule the queries along the space-filling curve, so that consecutive
+  // searches hit the same part of the spatial structure.
+  auto order = std::vector<size_t>(points.size());
+  auto codes = std::vector<uint32_t>(points.size());
+  for (size_t ix = 0; ix < points.size(); ++ix) {
+    order[ix] = ix;
+    codes[ix] = morton_code(points[ix]);
+  }
+  std::sort(order.begin(), order.end(),
+            [&codes](const size_t lhs, const size_t rhs) -> bool {
+              return codes[lhs] < codes[rhs];
+            });
+
+  auto results = std::vector<SelectedTriangle>(points.size());
+  auto previous = int32_t(-1);
+  for (const auto ix : order) {
+    // Neighboring queries usually fall in the same triangle or next to it:
+    // walk from the triangle selected by the previous query.
+    results[ix] = search_from(points[ix], previous, max_distance);
+    previous = results[ix].inside ? results[ix].index : int32_t(-1);
+  }
+  return results;
+}
+
+auto Index::search_rtree(const geometry::Point& point,
+                         const double max_distance) const -> SelectedTriangle {
   constexpr size_t kMaxNeighbors = 11;
   auto min_distance = std::numeric_limits<double>::max();
-  auto triangle_indices = std::set<int>();
+  // At most one triangle id per neighbor: a stack buffer deduplicated with a
+  // linear scan replaces the heap-allocated set.
+  std::array<int32_t, kMaxNeighbors> candidates;
+  auto count = int32_t(0);
 
   // Query position in ECEF coordinates
   auto cartesian_point = static_cast<geometry::EarthCenteredEarthFixed>(point);
@@ -93,24 +529,145 @@ auto Index::search(const geometry::Point& point,
   std::for_each(rtree_.qbegin(boost::geometry::index::nearest(cartesian_point,
                                                               kMaxNeighbors)),
                 rtree_.qend(),
-                [&cartesian_point, &min_distance,
-                 &triangle_indices](const auto& item) -> void {
-                  triangle_indices.emplace(item.second.second);
+                [&cartesian_point, &min_distance, &candidates,
+                 &count](const auto& item) -> void {
+                  const auto ix = item.second.second;
+                  if (std::find(candidates.begin(), candidates.begin() + count,
+                                ix) == candidates.begin() + count) {
+                    candidates[count++] = ix;
+                  }
                   min_distance = std::min(
                       min_distance,
                       boost::geometry::distance(cartesian_point, item.first));
                 });
 
+  return resolve(point, candidates.data(), count, min_distance, max_distance);
+}
+
+auto Index::search_grid(const geometry::Point& point,
+                        const double max_distance) const -> SelectedTriangle {
+  // The candidates of a quasi-uniform mesh fit in this stack buffer; an
+  // overflowing candidate is folded into the running extrapolation result
+  // instead of being stored.
+  constexpr auto kMaxCandidates = int32_t(64);
+  std::array<int32_t, kMaxCandidates> candidates;
+  auto count = int32_t(0);
+  auto found = int32_t(-1);
+  auto min_distance = std::numeric_limits<double>::max();
+  auto overflow_distance = std::numeric_limits<double>::max();
+  auto overflow_index = int32_t(-1);
+
+  // Query position in ECEF coordinates
+  auto cartesian_point = static_cast<geometry::EarthCenteredEarthFixed>(point);
+
+  const auto clamp = [](const int32_t value, const int32_t upper) -> int32_t {
+    return std::max(int32_t(0), std::min(value, upper - 1));
+  };
+  const auto lon = detail::math::normalize_angle(point.lon());
+  const auto x0 = clamp(
+      static_cast<int32_t>((lon - grid_.lon_min) / grid_.cell_width), grid_.nx);
+  const auto y0 = clamp(
+      static_cast<int32_t>((point.lat() - grid_.lat_min) / grid_.cell_height),
+      grid_.ny);
+
+  // Visit the candidates of the cell holding the query, then of the
+  // surrounding rings of cells. One extra ring is visited once a candidate
+  // has been found, so that a triangle slightly off-cell is not missed.
+  const auto visit = [this, &point, &cartesian_point, &min_distance,
+                      &candidates, &count, &found, &overflow_distance,
+                      &overflow_index](const int32_t x,
+                                       const int32_t y) -> void {
+    if (y < 0 || y >= grid_.ny) {
+      return;
+    }
+    auto wrapped = x;
+    if (grid_.circular) {
+      wrapped = (x % grid_.nx + grid_.nx) % grid_.nx;
+    } else if (x < 0 || x >= grid_.nx) {
+      return;
+    }
+    const auto cell = y * grid_.nx + wrapped;
+    for (auto jx = grid_.offsets[cell]; jx < grid_.offsets[cell + 1]; ++jx) {
+      const auto ix = grid_.candidates[jx];
+      if (std::find(candidates.begin(), candidates.begin() + count, ix) !=
+          candidates.begin() + count) {
+        continue;
+      }
+      if (found == -1 && contains(ix, point)) {
+        found = ix;
+        return;
+      }
+      const Eigen::Vector3i& index = triangles_.row(ix);
+      for (uint8_t kx = 0; kx < 3; ++kx) {
+        const auto vx = index(kx);
+        min_distance =
+            std::min(min_distance,
+                     boost::geometry::distance(
+                         cartesian_point,
+                         geometry::EarthCenteredEarthFixed(
+                             ecef_(vx, 0), ecef_(vx, 1), ecef_(vx, 2))));
+      }
+      if (count < kMaxCandidates) {
+        candidates[count++] = ix;
+      } else {
+        const auto distance = build_triangle(ix).distance(point);
+        if (distance < overflow_distance) {
+          overflow_distance = distance;
+          overflow_index = ix;
+        }
+      }
+    }
+  };
+
+  const auto max_ring = std::max(grid_.nx, grid_.ny);
+  auto last_ring = max_ring;
+  for (auto ring = int32_t(0); ring <= last_ring && found == -1; ++ring) {
+    if (ring == 0) {
+      visit(x0, y0);
+    } else {
+      for (auto x = x0 - ring; x <= x0 + ring && found == -1; ++x) {
+        visit(x, y0 - ring);
+        visit(x, y0 + ring);
+      }
+      for (auto y = y0 - ring + 1; y <= y0 + ring - 1 && found == -1; ++y) {
+        visit(x0 - ring, y);
+        visit(x0 + ring, y);
+      }
+    }
+    if ((count != 0 || found != -1) && last_ring == max_ring) {
+      last_ring = std::min(max_ring, ring + 1);
+    }
+  }
+
+  if (found != -1) {
+    return {true, found, point, build_triangle(found)};
+  }
+  auto result =
+      resolve(point, candidates.data(), count, min_distance, max_distance);
+  if (!result.inside && result.index != -1 && overflow_index != -1 &&
+      overflow_distance < result.triangle.distance(point)) {
+    // A candidate folded on overflow is closer than the resolved one.
+    result.index = overflow_index;
+    result.triangle = build_triangle(overflow_index);
+    result.point = result.triangle.project(point);
+  }
+  return result;
+}
+
+auto Index::resolve(const geometry::Point& point, const int32_t* candidates,
+                    const int32_t count, double min_distance,
+                    const double max_distance) const -> SelectedTriangle {
   // We consider the distance accurate to 1 cm
   if (min_distance < 1e-2) {
     min_distance = 0;
   }
 
-  // Check for each selected triangle if the point is inside.
-  for (auto& ix : triangle_indices) {
-    auto triangle = build_triangle(ix);
-    if (triangle.covered_by(point)) {
-      return {true, ix, point, std::move(triangle)};
+  // Check for each selected triangle if the point is inside: the cached
+  // barycentric transform answers without rebuilding the geometry.
+  for (auto jx = int32_t(0); jx < count; ++jx) {
+    const auto ix = candidates[jx];
+    if (contains(ix, point)) {
+      return {true, ix, point, build_triangle(ix)};
     }
   }
 
@@ -121,13 +678,13 @@ auto Index::search(const geometry::Point& point,
   if (min_distance < max_distance) {
     min_distance = std::numeric_limits<double>::max();
 
-    for (auto& ix : triangle_indices) {
-      auto triangle = build_triangle(ix);
+    for (auto jx = int32_t(0); jx < count; ++jx) {
+      auto triangle = build_triangle(candidates[jx]);
       auto distance = triangle.distance(point);
 
       if (distance < min_distance) {
         min_distance = distance;
-        result.index = ix;
+        result.index = candidates[jx];
         result.triangle = std::move(triangle);
       }
     }
@@ -136,28 +693,61 @@ auto Index::search(const geometry::Point& point,
   return result;
 }
 
-auto Index::getstate() const -> std::string {
-  auto ss = std::stringstream();
-  ss.exceptions(std::stringstream::failbit);
+auto Index::getstate(std::ostream& ss) const -> void {
   detail::serialize::write_matrix(ss, lon_);
   detail::serialize::write_matrix(ss, lat_);
   detail::serialize::write_matrix(ss, triangles_);
-  return ss.str();
+  // The ECEF coordinates of the vertices are carried in the state:
+  // setstate() rebuilds the selected backend from this flat buffer without
+  // converting the geometry again.
+  detail::serialize::write_matrix(ss, ecef_);
+  detail::serialize::write_data(ss, static_cast<std::uint8_t>(backend_));
 }
 
-auto Index::setstate(const string_view& data) -> Index {
-  detail::isviewstream ss(data);
+auto Index::getstate() const -> std::string {
+  auto ss = std::stringstream();
   ss.exceptions(std::stringstream::failbit);
+  getstate(ss);
+  return ss.str();
+}
+
+auto Index::state_size() const noexcept -> std::size_t {
+  // Each matrix is written as its dimensions followed by its items, then the
+  // backend as one byte.
+  return 4 * 2 * sizeof(Eigen::Index) +
+         static_cast<std::size_t>(lon_.size()) * sizeof(double) +
+         static_cast<std::size_t>(lat_.size()) * sizeof(double) +
+         static_cast<std::size_t>(triangles_.size()) * sizeof(int32_t) +
+         static_cast<std::size_t>(lon_.size()) * 3 * sizeof(double) +
+         sizeof(std::uint8_t);
+}
+
+auto Index::setstate(std::istream& ss) -> Index {
+  ss.exceptions(std::istream::failbit);
   try {
     auto lon = detail::serialize::read_matrix<double, Eigen::Dynamic, 1>(ss);
     auto lat = detail::serialize::read_matrix<double, Eigen::Dynamic, 1>(ss);
     auto triangles =
         detail::serialize::read_matrix<int32_t, Eigen::Dynamic, 3>(ss);
-    return Index(std::move(lon), std::move(lat), std::move(triangles));
+    auto ecef = detail::serialize::read_matrix<double, Eigen::Dynamic, 3>(ss);
+    auto backend = detail::serialize::read_data<std::uint8_t>(ss);
+    if (ecef.rows() != lon.size() || backend > kUniformGrid) {
+      throw std::invalid_argument("invalid index state");
+    }
+    // The geometry was validated and normalized when the state was written:
+    // the backend is rebuilt from the stored vertex coordinates without
+    // recomputing anything.
+    return Index(std::move(lon), std::move(lat), std::move(triangles),
+                 std::move(ecef), static_cast<Backend>(backend));
   } catch (const std::exception&) {
     throw std::invalid_argument("invalid index state");
   }
 }
 
+auto Index::setstate(const string_view& data) -> Index {
+  detail::isviewstream ss(data);
+  return setstate(ss);
+}
+
 }  // namespace mesh
 }  // namespace fes
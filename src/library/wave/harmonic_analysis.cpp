@@ -0,0 +1,89 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/wave/harmonic_analysis.hpp"
+
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "fes/detail/broadcast.hpp"
+#include "fes/detail/thread.hpp"
+
+namespace fes {
+namespace wave {
+
+HarmonicAnalysis::HarmonicAnalysis(const DynamicRef<const Eigen::MatrixXd>& f,
+                                   const DynamicRef<const Eigen::MatrixXd>& vu)
+    : w_size_(f.rows()), design_(f.rows() << 1, f.cols()) {
+  detail::check_eigen_shape("f", f, "vu", vu);
+  design_.topRows(w_size_) = f.array() * vu.array().cos();
+  design_.bottomRows(w_size_) = f.array() * vu.array().sin();
+  ldlt_.compute(design_ * design_.transpose());
+}
+
+auto HarmonicAnalysis::solve(const Eigen::Ref<const Eigen::VectorXd>& h) const
+    -> Eigen::VectorXcd {
+  if (h.rows() != design_.cols()) {
+    throw std::invalid_argument(
+        "h could not be broadcast with the time base of the analysis with "
+        "shape " +
+        detail::eigen_shape(h) + ", (" + std::to_string(design_.cols()) + ")");
+  }
+  auto result = Eigen::VectorXcd(w_size_);
+
+  if (h.hasNaN()) {
+    result.fill(std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
+                                     std::numeric_limits<double>::quiet_NaN()));
+    return result;
+  }
+
+  Eigen::VectorXd solution = ldlt_.solve(design_ * h);
+  result.real() = solution.topRows(w_size_);
+  result.imag() = solution.bottomRows(w_size_);
+
+  return result;
+}
+
+auto HarmonicAnalysis::batched_solve(const DynamicRef<const Eigen::MatrixXd>& h,
+                                     const size_t num_threads) const
+    -> Eigen::MatrixXcd {
+  if (h.cols() != design_.cols()) {
+    throw std::invalid_argument(
+        "h could not be broadcast with the time base of the analysis with "
+        "shape " +
+        detail::eigen_shape(h) + ", (" + std::to_string(design_.cols()) + ")");
+  }
+  const auto n_points = h.rows();
+  auto result = Eigen::MatrixXcd(w_size_, n_points);
+
+  // Worker responsible for the analysis of a block of points. The right
+  // hand sides of the block are built and solved with matrix products
+  // against the shared factorization.
+  auto worker = [&](const size_t start, const size_t end) {
+    const auto block = static_cast<Eigen::Index>(end - start);
+    const auto rows = h.middleRows(static_cast<Eigen::Index>(start), block);
+    const auto solution =
+        Eigen::MatrixXd(ldlt_.solve(design_ * rows.transpose()));
+    for (Eigen::Index px = 0; px < block; ++px) {
+      auto column = result.col(static_cast<Eigen::Index>(start) + px);
+      if (rows.row(px).hasNaN()) {
+        // An undefined series only poisons its own column of the block:
+        // the corresponding constants are explicitly set to nan.
+        column.fill(
+            std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
+                                 std::numeric_limits<double>::quiet_NaN()));
+        continue;
+      }
+      column.real() = solution.col(px).topRows(w_size_);
+      column.imag() = solution.col(px).bottomRows(w_size_);
+    }
+  };
+  detail::parallel_for(worker, static_cast<size_t>(n_points), num_threads);
+  return result;
+}
+
+}  // namespace wave
+}  // namespace fes
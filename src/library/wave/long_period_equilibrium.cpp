@@ -4,6 +4,8 @@
 // BSD-style license that can be found in the LICENSE file.
 #include "fes/wave/long_period_equilibrium.hpp"
 
+#include "fes/detail/broadcast.hpp"
+
 namespace fes {
 namespace wave {
 
@@ -206,26 +208,27 @@ auto LongPeriodEquilibrium::disable_dynamic_wave(const Table& table) -> void {
   }
 }
 
-auto LongPeriodEquilibrium::lpe_minus_n_waves(const angle::Astronomic& angles,
-                                              const double lat) -> double {
+auto LongPeriodEquilibrium::harmonic_factors(const angle::Astronomic& angles)
+    const -> Eigen::Vector2d {
   // Vector containing the required nodal corrections.
   Eigen::Matrix<double, 5, 1> shpn =
       (Eigen::Matrix<double, 5, 1>() << angles.s(), angles.h(), angles.p(),
        detail::math::two_pi<double>() - angles.n(), angles.p1())
           .finished();
 
-  // Tidal potential V20
-  auto h20 = 0.0;
-  for (auto ix = 0L; ix < order2_.rows(); ++ix) {
-    h20 += std::cos(order2_.row(ix).head(5).dot(shpn)) * order2_(ix, 5);
-  }
+  // Tidal potentials V20 and V30. The astronomical arguments of all the
+  // spectral lines are produced by one matrix product, so the summation is
+  // laid out for vectorization instead of scanning the table row by row.
+  const auto h20 =
+      (order2_.leftCols<5>() * shpn).array().cos().matrix().dot(order2_.col(5));
+  const auto h30 =
+      (order3_.leftCols<5>() * shpn).array().sin().matrix().dot(order3_.col(5));
 
-  // Tidal potential V30
-  auto h30 = 0.0;
-  for (auto ix = 0L; ix < order3_.rows(); ++ix) {
-    h30 += std::sin(order3_.row(ix).head(5).dot(shpn)) * order3_(ix, 5);
-  }
+  return {h20, h30};
+}
 
+auto LongPeriodEquilibrium::latitude_factors(const double lat)
+    -> Eigen::Vector2d {
   // FES14C: mass conservation for long period equilibrium
   // Subtraction of the mean of c20 and c30 on ocean, for mass conservation
   // mean_c20 = -0.014432247
@@ -240,9 +243,49 @@ auto LongPeriodEquilibrium::lpe_minus_n_waves(const angle::Astronomic& angles,
              0.012469818;
 
   // m -> cm
-  return ((1.0 - 0.609 /* H2 */ + 0.302 /* K2 */) * c20 * h20 +
-          (1.0 - 0.291 /* H3 */ + 0.093 /* K3 */) * c30 * h30) *
-         100;
+  return {(1.0 - 0.609 /* H2 */ + 0.302 /* K2 */) * c20 * 100,
+          (1.0 - 0.291 /* H3 */ + 0.093 /* K3 */) * c30 * 100};
+}
+
+auto LongPeriodEquilibrium::lpe_minus_n_waves(const angle::Astronomic& angles,
+                                              const double lat) -> double {
+  return harmonic_factors(angles).dot(latitude_factors(lat));
+}
+
+auto LongPeriodEquilibrium::lpe_minus_n_waves(
+    const Eigen::Ref<const Eigen::VectorXd>& epoch,
+    const Eigen::Ref<const Vector<uint16_t>>& leap_seconds,
+    const Eigen::Ref<const Eigen::VectorXd>& lat,
+    const angle::Formulae& formulae) const -> Eigen::VectorXd {
+  const auto size = detail::broadcast_eigen_shape(
+      "epoch", epoch, "leap_seconds", leap_seconds, "lat", lat);
+
+  // Size-1 vectors are broadcast against the others.
+  auto epoch_view =
+      detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(epoch);
+  auto leap_seconds_view =
+      detail::BroadcastView<Eigen::Ref<const Vector<uint16_t>>>(leap_seconds);
+  auto lat_view = detail::BroadcastView<Eigen::Ref<const Eigen::VectorXd>>(lat);
+
+  auto result = Eigen::VectorXd(size);
+  if (size == 0) {
+    return result;
+  }
+
+  // The spectral summation only depends on the date: it is evaluated once
+  // per distinct epoch, so all the points sharing an epoch reuse the scan.
+  auto angles = angle::Astronomic(formulae, epoch_view(0), leap_seconds_view(0));
+  auto factors = harmonic_factors(angles);
+  auto last_epoch = epoch_view(0);
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    if (epoch_view(ix) != last_epoch) {
+      last_epoch = epoch_view(ix);
+      angles.update(last_epoch, leap_seconds_view(ix));
+      factors = harmonic_factors(angles);
+    }
+    result(ix) = factors.dot(latitude_factors(lat_view(ix)));
+  }
+  return result;
 }
 
 }  // namespace wave
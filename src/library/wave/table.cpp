@@ -6,176 +6,266 @@
 
 #include <Eigen/Dense>
 #include <array>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "fes/angle/batched_astronomic.hpp"
 #include "fes/detail/broadcast.hpp"
 #include "fes/detail/thread.hpp"
 #include "fes/detail/wave/name.hpp"
+#include "fes/leap_seconds.hpp"
+#include "fes/wave/harmonic_analysis.hpp"
 
 namespace fes {
 namespace wave {
 
-auto Table::wave_factory(const Constituent ident) -> std::shared_ptr<Wave> {
+namespace {
+
+/// Calls the provided maker with a prototype of the concrete wave class
+/// matching the given identifier. Factoring the dispatch here keeps the
+/// heap-allocating factory and the placement construction used by the arena
+/// of Table::clone on a single list of constituents.
+template <typename Maker>
+auto wave_dispatch(const Constituent ident, const Maker& maker)
+    -> decltype(maker(wave::O1())) {
   switch (ident) {
     case kO1:
-      return std::shared_ptr<Wave>(new wave::O1());
+      return maker(wave::O1());
     case kP1:
-      return std::shared_ptr<Wave>(new wave::P1());
+      return maker(wave::P1());
     case kK1:
-      return std::shared_ptr<Wave>(new wave::K1());
+      return maker(wave::K1());
     case k2N2:
-      return std::shared_ptr<Wave>(new wave::_2N2());
+      return maker(wave::_2N2());
     case kMu2:
-      return std::shared_ptr<Wave>(new wave::Mu2());
+      return maker(wave::Mu2());
     case kN2:
-      return std::shared_ptr<Wave>(new wave::N2());
+      return maker(wave::N2());
     case kNu2:
-      return std::shared_ptr<Wave>(new wave::Nu2());
+      return maker(wave::Nu2());
     case kM2:
-      return std::shared_ptr<Wave>(new wave::M2());
+      return maker(wave::M2());
     case kL2:
-      return std::shared_ptr<Wave>(new wave::L2());
+      return maker(wave::L2());
     case kT2:
-      return std::shared_ptr<Wave>(new wave::T2());
+      return maker(wave::T2());
     case kS2:
-      return std::shared_ptr<Wave>(new wave::S2());
+      return maker(wave::S2());
     case kK2:
-      return std::shared_ptr<Wave>(new wave::K2());
+      return maker(wave::K2());
     case kM4:
-      return std::shared_ptr<Wave>(new wave::M4());
+      return maker(wave::M4());
     case kS1:
-      return std::shared_ptr<Wave>(new wave::S1());
+      return maker(wave::S1());
     case kQ1:
-      return std::shared_ptr<Wave>(new wave::Q1());
+      return maker(wave::Q1());
     case kMm:
-      return std::shared_ptr<Wave>(new wave::Mm());
+      return maker(wave::Mm());
     case kMf:
-      return std::shared_ptr<Wave>(new wave::Mf());
+      return maker(wave::Mf());
     case kMtm:
-      return std::shared_ptr<Wave>(new wave::Mtm());
+      return maker(wave::Mtm());
     case kMsqm:
-      return std::shared_ptr<Wave>(new wave::Msqm());
+      return maker(wave::Msqm());
     case kEps2:
-      return std::shared_ptr<Wave>(new wave::Eps2());
+      return maker(wave::Eps2());
     case kLambda2:
-      return std::shared_ptr<Wave>(new wave::Lambda2());
+      return maker(wave::Lambda2());
     case kEta2:
-      return std::shared_ptr<Wave>(new wave::Eta2());
+      return maker(wave::Eta2());
     case k2Q1:
-      return std::shared_ptr<Wave>(new wave::_2Q1());
+      return maker(wave::_2Q1());
     case kSigma1:
-      return std::shared_ptr<Wave>(new wave::Sigma1());
+      return maker(wave::Sigma1());
     case kRho1:
-      return std::shared_ptr<Wave>(new wave::Rho1());
+      return maker(wave::Rho1());
     case kM11:
-      return std::shared_ptr<Wave>(new wave::M11());
+      return maker(wave::M11());
     case kM12:
-      return std::shared_ptr<Wave>(new wave::M12());
+      return maker(wave::M12());
     case kChi1:
-      return std::shared_ptr<Wave>(new wave::Chi1());
+      return maker(wave::Chi1());
     case kPi1:
-      return std::shared_ptr<Wave>(new wave::Pi1());
+      return maker(wave::Pi1());
     case kPhi1:
-      return std::shared_ptr<Wave>(new wave::Phi1());
+      return maker(wave::Phi1());
     case kTheta1:
-      return std::shared_ptr<Wave>(new wave::Theta1());
+      return maker(wave::Theta1());
     case kJ1:
-      return std::shared_ptr<Wave>(new wave::J1());
+      return maker(wave::J1());
     case kOO1:
-      return std::shared_ptr<Wave>(new wave::OO1());
+      return maker(wave::OO1());
     case kM3:
-      return std::shared_ptr<Wave>(new wave::M3());
+      return maker(wave::M3());
     case kM6:
-      return std::shared_ptr<Wave>(new wave::M6());
+      return maker(wave::M6());
     case kMN4:
-      return std::shared_ptr<Wave>(new wave::MN4());
+      return maker(wave::MN4());
     case kMS4:
-      return std::shared_ptr<Wave>(new wave::MS4());
+      return maker(wave::MS4());
     case kN4:
-      return std::shared_ptr<Wave>(new wave::N4());
+      return maker(wave::N4());
     case kR2:
-      return std::shared_ptr<Wave>(new wave::R2());
+      return maker(wave::R2());
     case kR4:
-      return std::shared_ptr<Wave>(new wave::R4());
+      return maker(wave::R4());
     case kS4:
-      return std::shared_ptr<Wave>(new wave::S4());
+      return maker(wave::S4());
     case kMNS2:
-      return std::shared_ptr<Wave>(new wave::MNS2());
+      return maker(wave::MNS2());
     case kM13:
-      return std::shared_ptr<Wave>(new wave::M13());
+      return maker(wave::M13());
     case kMK4:
-      return std::shared_ptr<Wave>(new wave::MK4());
+      return maker(wave::MK4());
     case kSN4:
-      return std::shared_ptr<Wave>(new wave::SN4());
+      return maker(wave::SN4());
     case kSK4:
-      return std::shared_ptr<Wave>(new wave::SK4());
+      return maker(wave::SK4());
     case k2MN6:
-      return std::shared_ptr<Wave>(new wave::_2MN6());
+      return maker(wave::_2MN6());
     case k2MS6:
-      return std::shared_ptr<Wave>(new wave::_2MS6());
+      return maker(wave::_2MS6());
     case k2MK6:
-      return std::shared_ptr<Wave>(new wave::_2MK6());
+      return maker(wave::_2MK6());
     case kMSN6:
-      return std::shared_ptr<Wave>(new wave::MSN6());
+      return maker(wave::MSN6());
     case k2SM6:
-      return std::shared_ptr<Wave>(new wave::_2SM6());
+      return maker(wave::_2SM6());
     case kMSK6:
-      return std::shared_ptr<Wave>(new wave::MSK6());
+      return maker(wave::MSK6());
     case kMP1:
-      return std::shared_ptr<Wave>(new wave::MP1());
+      return maker(wave::MP1());
     case k2SM2:
-      return std::shared_ptr<Wave>(new wave::_2SM2());
+      return maker(wave::_2SM2());
     case kPsi1:
-      return std::shared_ptr<Wave>(new wave::Psi1());
+      return maker(wave::Psi1());
     case k2MS2:
-      return std::shared_ptr<Wave>(new wave::_2MS2());
+      return maker(wave::_2MS2());
     case kMKS2:
-      return std::shared_ptr<Wave>(new wave::MKS2());
+      return maker(wave::MKS2());
     case k2MN2:
-      return std::shared_ptr<Wave>(new wave::_2MN2());
+      return maker(wave::_2MN2());
     case kMSN2:
-      return std::shared_ptr<Wave>(new wave::MSN2());
+      return maker(wave::MSN2());
     case kMO3:
-      return std::shared_ptr<Wave>(new wave::MO3());
+      return maker(wave::MO3());
     case k2MK3:
-      return std::shared_ptr<Wave>(new wave::_2MK3());
+      return maker(wave::_2MK3());
     case kMK3:
-      return std::shared_ptr<Wave>(new wave::MK3());
+      return maker(wave::MK3());
     case kS6:
-      return std::shared_ptr<Wave>(new wave::S6());
+      return maker(wave::S6());
     case kM8:
-      return std::shared_ptr<Wave>(new wave::M8());
+      return maker(wave::M8());
     case kMSf:
-      return std::shared_ptr<Wave>(new wave::MSf());
+      return maker(wave::MSf());
     case kSsa:
-      return std::shared_ptr<Wave>(new wave::Ssa());
+      return maker(wave::Ssa());
     case kSa:
-      return std::shared_ptr<Wave>(new wave::Sa());
+      return maker(wave::Sa());
     case kA5:
-      return std::shared_ptr<Wave>(new wave::A5());
+      return maker(wave::A5());
     case kSa1:
-      return std::shared_ptr<Wave>(new wave::Sa1());
+      return maker(wave::Sa1());
     case kSta:
-      return std::shared_ptr<Wave>(new wave::Sta());
+      return maker(wave::Sta());
     case kMm2:
-      return std::shared_ptr<Wave>(new wave::Mm2());
+      return maker(wave::Mm2());
     case kMm1:
-      return std::shared_ptr<Wave>(new wave::Mm1());
+      return maker(wave::Mm1());
     case kMf1:
-      return std::shared_ptr<Wave>(new wave::Mf1());
+      return maker(wave::Mf1());
     case kMf2:
-      return std::shared_ptr<Wave>(new wave::Mf2());
+      return maker(wave::Mf2());
     case kM0:
-      return std::shared_ptr<Wave>(new wave::M0());
+      return maker(wave::M0());
     default:
       throw std::invalid_argument("wave identifier not recognized: " +
                                   std::to_string(ident));
   }
 }
 
+/// Contiguous storage for the wave objects of a cloned table.
+///
+/// The block is allocated once for all the waves of the table and kept alive
+/// by the aliasing shared pointers handed out by Table::clone; the last one
+/// dropped destroys the constructed waves with the block.
+class WaveArena {
+ public:
+  /// Allocates a block able to hold the given number of waves.
+  explicit WaveArena(const size_t count) : block_(new slot_t[count]) {
+    constructed_.reserve(count);
+  }
+
+  /// Destroys the constructed waves.
+  ~WaveArena() {
+    for (auto* item : constructed_) {
+      item->~Wave();
+    }
+  }
+
+  WaveArena(const WaveArena&) = delete;
+  auto operator=(const WaveArena&) -> WaveArena& = delete;
+
+  /// Copies the given wave into the next slot of the block, preserving its
+  /// concrete class.
+  auto emplace(const Wave& wave) -> Wave* {
+    auto* slot = &block_[constructed_.size()];
+    auto* item = wave_dispatch(
+        wave.ident(), [slot](const auto& prototype) -> Wave* {
+          using wave_t = typename std::decay<decltype(prototype)>::type;
+          static_assert(sizeof(wave_t) <= sizeof(slot_t) &&
+                            alignof(wave_t) <= alignof(slot_t),
+                        "wave does not fit in an arena slot");
+          return new (slot) wave_t(prototype);
+        });
+    // The concrete classes carry no state of their own: assigning the base
+    // subobject copies the whole state of the source wave.
+    *item = wave;
+    constructed_.push_back(item);
+    return item;
+  }
+
+ private:
+  /// Storage for one wave object.
+  using slot_t =
+      typename std::aligned_storage<sizeof(Wave), alignof(Wave)>::type;
+
+  /// The block holding the wave objects.
+  std::unique_ptr<slot_t[]> block_;
+
+  /// The waves constructed in the block, in construction order.
+  std::vector<Wave*> constructed_;
+};
+
+}  // namespace
+
+auto Table::clone() const -> Table {
+  auto result = Table(*this);
+  auto arena = std::make_shared<WaveArena>(size());
+  for (auto& item : result.waves_) {
+    if (item) {
+      item = std::shared_ptr<Wave>(arena, arena->emplace(*item));
+    }
+  }
+  return result;
+}
+
+auto Table::wave_factory(const Constituent ident) -> std::shared_ptr<Wave> {
+  return wave_dispatch(ident,
+                       [](const auto& prototype) -> std::shared_ptr<Wave> {
+                         using wave_t =
+                             typename std::decay<decltype(prototype)>::type;
+                         return std::shared_ptr<Wave>(new wave_t(prototype));
+                       });
+}
+
 /// Create a table with all known constituents.
 inline auto create_table(const std::vector<std::string>& known_constituents,
                          std::vector<std::shared_ptr<Wave>>& table) -> void {
@@ -348,33 +438,29 @@ auto Table::harmonic_analysis(const Eigen::Ref<const Eigen::VectorXd>& h,
         "f, vu could not be broadcast with h with shape " +
         detail::eigen_shape(f) + ", " + detail::eigen_shape(h));
   }
-  auto w_size = f.rows();
-  auto result = Eigen::VectorXcd(w_size);
+  return HarmonicAnalysis(f, vu).solve(h);
+}
 
-  if (h.hasNaN()) {
-    result.fill(std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
-                                     std::numeric_limits<double>::quiet_NaN()));
-    return result;
+auto Table::batched_harmonic_analysis(const DynamicRef<const Eigen::MatrixXd>& h,
+                                      const DynamicRef<const Eigen::MatrixXd>& f,
+                                      const DynamicRef<const Eigen::MatrixXd>& vu,
+                                      const size_t num_threads)
+    -> Eigen::MatrixXcd {
+  detail::check_eigen_shape("f", f, "vu", vu);
+  if (h.cols() != f.cols() || h.cols() != vu.cols()) {
+    throw std::invalid_argument(
+        "f, vu could not be broadcast with h with shape " +
+        detail::eigen_shape(f) + ", " + detail::eigen_shape(h));
   }
-
-  auto H = Eigen::MatrixXd(w_size << 1, h.rows());
-
-  H.topRows(w_size) = f.array() * vu.array().cos();
-  H.bottomRows(w_size) = f.array() * vu.array().sin();
-
-  Eigen::LDLT<Eigen::MatrixXd> ldlt(H * H.transpose());
-  Eigen::VectorXd solution = ldlt.solve(H * h);
-  result.real() = solution.topRows(w_size);
-  result.imag() = solution.bottomRows(w_size);
-
-  return result;
+  return HarmonicAnalysis(f, vu).batched_solve(h, num_threads);
 }
 
 auto Table::tide_from_tide_series(
     const Eigen::Ref<const Eigen::VectorXd>& epoch,
     const Eigen::Ref<const Vector<uint16_t>>& leap_seconds,
     const Eigen::Ref<const Eigen::VectorXcd>& wave,
-    const angle::Formulae& formulae) const -> Eigen::VectorXd {
+    const angle::Formulae& formulae, const double time_tolerance,
+    const size_t num_threads) const -> Eigen::VectorXd {
   detail::check_eigen_shape("epoch", epoch, "leap_seconds", leap_seconds);
   if (static_cast<size_t>(wave.rows()) != size()) {
     throw std::invalid_argument(
@@ -383,55 +469,105 @@ auto Table::tide_from_tide_series(
   }
   auto result = Eigen::VectorXd(epoch.rows());
 
-  /// The object responsible for the calculation of astronomical angles.
-  auto angles = angle::Astronomic(formulae);
-
-  // The wave properties of the object must be immutable for the provided
-  // instance.
-  auto wt = Table(*this);
-
-  for (auto ix = 0; ix < epoch.rows(); ++ix) {
-    double tide = 0;
-    angles.update(epoch(ix), leap_seconds(ix));
-    wt.compute_nodal_corrections(angles);
+  // Worker responsible for the reconstruction of a chunk of the series.
+  auto worker = [&](const size_t start, const size_t end) {
+    /// The object responsible for the calculation of astronomical angles.
+    auto angles = angle::Astronomic(formulae);
 
-    for (size_t jx = 0; jx < wt.size(); ++jx) {
-      const auto& item = wt[jx];
-      double phi = item->vu();
-
-      tide += item->f() * (wave(jx).real() * std::cos(phi) +
-                           wave(jx).imag() * std::sin(phi));
+    // The wave properties of the object must be immutable for the provided
+    // instance and the workers must not share the wave objects, so each one
+    // operates on a deep copy.
+    auto wt = clone();
+    const auto n = static_cast<Eigen::Index>(wt.size());
+
+    // The analysed constants and the per-epoch quantities are gathered into
+    // contiguous arrays so the summation is evaluated with vectorized array
+    // expressions instead of one pointer chase per constituent.
+    auto real = Eigen::ArrayXd(n);
+    auto imag = Eigen::ArrayXd(n);
+    for (Eigen::Index jx = 0; jx < n; ++jx) {
+      real(jx) = wave(jx).real();
+      imag(jx) = wave(jx).imag();
     }
-    result(ix) = tide;
-  }
+    auto f = Eigen::ArrayXd(n);
+    auto vu = Eigen::ArrayXd(n);
+    auto cos_vu = Eigen::ArrayXd(n);
+    auto sin_vu = Eigen::ArrayXd(n);
+
+    // The astronomic angles are considered constant within time_tolerance,
+    // like Accelerator::calculate_angle does for the tidal models.
+    auto last_epoch = std::numeric_limits<double>::max();
+    for (auto ix = start; ix < end; ++ix) {
+      if (std::abs(epoch(ix) - last_epoch) > time_tolerance) {
+        last_epoch = epoch(ix);
+        angles.update(epoch(ix), leap_seconds(ix));
+        wt.compute_nodal_corrections(angles);
+        for (Eigen::Index jx = 0; jx < n; ++jx) {
+          const auto& item = wt[static_cast<size_t>(jx)];
+          f(jx) = item->f();
+          vu(jx) = item->vu();
+        }
+        cos_vu = vu.cos();
+        sin_vu = vu.sin();
+      }
+      result(ix) = (f * (real * cos_vu + imag * sin_vu)).sum();
+    }
+  };
+  detail::parallel_for(worker, static_cast<size_t>(epoch.rows()), num_threads);
   return result;
 }
 
 auto Table::tide_from_mapping(const double epoch, const uint16_t leap_seconds,
                               const DynamicRef<const Eigen::MatrixXcd>& wave,
                               const angle::Formulae& formulae,
-                              const size_t num_threads) const
+                              const size_t num_threads,
+                              const Eigen::Index tile_size) const
     -> Eigen::MatrixXd {
   if (static_cast<size_t>(wave.rows()) != size()) {
     throw std::invalid_argument(
         "wave must contain as many elements as the number of waves in the "
         "table");
   }
+  if (tile_size <= 0) {
+    throw std::invalid_argument("tile_size must be strictly positive");
+  }
+  const auto n = static_cast<Eigen::Index>(size());
   auto result = Eigen::MatrixXd(wave.cols(), wave.rows());
   auto worker = [&](const int64_t start, const int64_t end) {
     // The wave properties of the object must be immutable for the provided
-    // instance.
-    auto wt = Table(*this);
+    // instance and the workers must not share the wave objects, so each one
+    // operates on a deep copy.
+    auto wt = clone();
     wt.compute_nodal_corrections(
         angle::Astronomic(formulae, epoch, leap_seconds));
 
-    for (auto ix = start; ix < end; ++ix) {
-      for (size_t jx = 0; jx < wt.size(); ++jx) {
-        const auto& item = wt[jx];
-        double phi = item->vu();
+    // The nodal corrections do not depend on the position, so the two
+    // factors of the summation are evaluated once per wave.
+    auto a = Eigen::ArrayXd(n);
+    auto b = Eigen::ArrayXd(n);
+    for (Eigen::Index jx = 0; jx < n; ++jx) {
+      const auto& item = wt[static_cast<size_t>(jx)];
+      const auto phi = item->vu();
+      a(jx) = item->f() * std::cos(phi);
+      b(jx) = item->f() * std::sin(phi);
+    }
 
-        result(ix, jx) += item->f() * (wave(jx, ix).real() * std::cos(phi) +
-                                       wave(jx, ix).imag() * std::sin(phi));
+    // The input stores the constituents of one position contiguously while
+    // the output stores the positions of one constituent contiguously, so
+    // the sweep is a transposition: it is evaluated tile by tile so each
+    // tile of the mapping is loaded into the cache once and fully consumed.
+    for (auto bx = start; bx < end;
+         bx += static_cast<int64_t>(tile_size)) {
+      const auto columns =
+          std::min<int64_t>(static_cast<int64_t>(tile_size), end - bx);
+      for (Eigen::Index bj = 0; bj < n; bj += tile_size) {
+        const auto rows = std::min<Eigen::Index>(tile_size, n - bj);
+        for (Eigen::Index jx = bj; jx < bj + rows; ++jx) {
+          for (auto ix = bx; ix < bx + columns; ++ix) {
+            result(ix, jx) = a(jx) * wave(jx, ix).real() +
+                             b(jx) * wave(jx, ix).imag();
+          }
+        }
       }
     }
   };
@@ -449,15 +585,19 @@ auto Table::compute_nodal_modulations(
   auto f = Eigen::MatrixXd(size(), epoch.size());
   auto vu = Eigen::MatrixXd(size(), epoch.size());
 
-  /// The object responsible for the calculation of astronomical angles.
+  // The angle series are evaluated in one vectorized pass over the whole
+  // epoch vector; the batch is then scattered one epoch at a time into the
+  // scalar instance consumed by the nodal corrections.
+  auto batch = angle::BatchedAstronomic(formulae);
+  batch.update(epoch, leap_seconds);
   auto angles = angle::Astronomic(formulae);
 
   // The wave properties of the object must be immutable for the provided
-  // instance.
-  auto wt = Table(*this);
+  // instance, so the nodal corrections are applied to a deep copy.
+  auto wt = clone();
 
   for (auto ix = 0; ix < epoch.size(); ++ix) {
-    angles.update(epoch(ix), leap_seconds(ix));
+    batch.fill(ix, angles);
     wt.compute_nodal_corrections(angles);
 
     for (size_t jx = 0; jx < wt.size(); ++jx) {
@@ -469,6 +609,14 @@ auto Table::compute_nodal_modulations(
   return std::make_tuple(f, vu);
 }
 
+auto Table::compute_nodal_modulations(
+    const Eigen::Ref<const Eigen::VectorXd>& epoch,
+    const angle::Formulae& formulae) const
+    -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> {
+  const auto resolved = fes::leap_seconds(epoch);
+  return compute_nodal_modulations(epoch, resolved, formulae);
+}
+
 auto Table::select_waves_for_analysis(const double duration, const double f)
     -> std::vector<std::string> {
   auto result = std::vector<std::string>();
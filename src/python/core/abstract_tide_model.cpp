@@ -3,6 +3,7 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -35,8 +36,11 @@ class PyAbstractTidalModel : public fes::AbstractTidalModel<T> {
   }
 
   void add_constituent(const fes::Constituent ident,
-                       fes::Vector<std::complex<T>> wave) override {
-    PYBIND11_OVERLOAD_PURE(void, cname, add_constituent, ident, wave);
+                       fes::DataVector<std::complex<T>> wave) override {
+    // A Python override receives its own copy of the samples: the view
+    // cannot outlive the buffer it was built over.
+    auto samples = fes::Vector<std::complex<T>>(wave.map());
+    PYBIND11_OVERLOAD_PURE(void, cname, add_constituent, ident, samples);
   }
 };
 
@@ -98,13 +102,34 @@ void init_abstract_tide_model(py::module& m, const std::string& postfix) {
       .def(
           "add_constituent",
           [](fes::AbstractTidalModel<T>& self, const std::string& name,
-             fes::Vector<std::complex<T>> wave) -> void {
-            self.add_constituent(name, std::move(wave));
+             py::array_t<std::complex<T>,
+                         py::array::c_style | py::array::forcecast>
+                 wave) -> void {
+            if (wave.ndim() != 1) {
+              throw std::invalid_argument(
+                  "wave must be a one-dimensional array");
+            }
+            // The model views the numpy buffer in place instead of copying
+            // it. The keep-alive handle releases the reference with the GIL
+            // held: the view may be dropped while the GIL is released, for
+            // example by crop().
+            auto keep_alive = std::shared_ptr<const void>(
+                wave.data(), [wave](const void* /*unused*/) mutable -> void {
+                  py::gil_scoped_acquire acquire;
+                  wave = py::array_t<std::complex<T>>();
+                });
+            self.add_constituent(
+                name, fes::DataVector<std::complex<T>>(
+                          wave.data(), static_cast<Eigen::Index>(wave.size()),
+                          std::move(keep_alive)));
           },
           py::arg("name"), py::arg("wave"),
           R"__doc__(
 Add a tidal constituent to the model.
 
+The model wraps the given array without copying it and keeps a reference on
+it as long as the constituent is held.
+
 Args:
   name: The name of tidal constituent to add. Search is not case sensitive. So
     ``Msqm``, ``MSQM`` and ``msqm`` are equivalent.
@@ -176,6 +201,70 @@ equilibrium wave calculation routine (`lpe_minus_n_waves`).
 )__doc__")
       .def("clear", &fes::AbstractTidalModel<T>::clear,
            "Clear the loaded wave models from memory.")
+      .def("quantize", &fes::AbstractTidalModel<T>::quantize,
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Quantize the loaded wave models to 16-bit integers.
+
+The floating-point storage is released and replaced by int16 samples scaled
+by a per-constituent factor, halving or quartering the model footprint. The
+quantization is lossy: the error per component is bounded by half the scale
+factor. Adding a constituent restores the floating-point storage.
+)__doc__")
+      .def("dequantize", &fes::AbstractTidalModel<T>::dequantize,
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Restore the floating-point storage of a quantized model.
+
+The restored values carry the quantization error; the original samples are
+not recoverable.
+)__doc__")
+      .def("quantized", &fes::AbstractTidalModel<T>::quantized,
+           "Return true if the model stores its wave models quantized.")
+      .def("lazy", &fes::AbstractTidalModel<T>::lazy,
+           "Return true if some wave models are read on demand from a mapped "
+           "file.")
+      .def(
+          "fault_in",
+          [](const fes::AbstractTidalModel<T>& self) -> void {
+            self.fault_in();
+          },
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Load the wave models of a lazily loaded model that are not resident.
+
+The first interpolation does this implicitly; calling it up front moves the
+loading cost out of the prediction.
+)__doc__")
+      .def(
+          "fault_in",
+          [](const fes::AbstractTidalModel<T>& self,
+             const std::vector<fes::Constituent>& idents) -> void {
+            self.fault_in(idents);
+          },
+          py::arg("idents"), py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Load the given wave models of a lazily loaded model.
+
+If a residency budget was given when the model was loaded, the least recently
+used wave models beyond the budget are evicted, sparing the ones just
+requested.
+
+Args:
+  idents: The tidal constituents to load. The ones that are not read on
+    demand are ignored.
+)__doc__")
+      .def("unload", &fes::AbstractTidalModel<T>::unload,
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Release the wave models of a lazily loaded model.
+
+The memory is handed back and the next interpolation faults the wave models
+in again.
+)__doc__")
+      .def("resident", &fes::AbstractTidalModel<T>::resident,
+           "Return the wave models read on demand that are currently "
+           "resident in memory.")
       .def_property_readonly("tide_type",
                              &fes::AbstractTidalModel<T>::tide_type,
                              "Return the type of tide.")
@@ -11,10 +11,15 @@ extern void init_angle(py::module& m);
 extern void init_settings(py::module& m);
 extern void init_axis(py::module& m);
 extern void init_cartesian_model(py::module& m);
+extern void init_composite_model(py::module& m);
 extern void init_constituent(py::module& m);
 extern void init_datemanip(py::module& m);
+extern void init_harmonic_analysis(py::module& m);
 extern void init_lgp_model(py::module& m);
 extern void init_mesh_index(py::module& m);
+extern void init_netcdf_loader(py::module& m);
+extern void init_perf_counters(py::module& m);
+extern void init_predictor(py::module& m);
 extern void init_tide(py::module& m);
 extern void init_wave_order2(py::module& m);
 extern void init_wave_table(py::module& m);
@@ -42,6 +47,7 @@ PYBIND11_MODULE(core, m) {
   // Define wave handling objects
   init_wave_table(m);
   init_wave_order2(m);
+  init_harmonic_analysis(m);
 
   // Define the mesh indexer.
   init_mesh_index(mesh);
@@ -52,8 +58,16 @@ PYBIND11_MODULE(core, m) {
   // Define the tidal models.
   init_abstract_tide_model(m);
   init_cartesian_model(tidal_model);
+  init_composite_model(tidal_model);
   init_lgp_model(tidal_model);
+  init_netcdf_loader(tidal_model);
 
   // Define the tide estimator.
   init_tide(m);
+
+  // Define the performance counters of the prediction hot paths.
+  init_perf_counters(m);
+
+  // Define the tide prediction session.
+  init_predictor(m);
 }
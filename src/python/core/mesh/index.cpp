@@ -11,11 +11,22 @@
 namespace py = pybind11;
 
 void init_mesh_index(py::module& m) {
-  py::class_<fes::mesh::Index, std::shared_ptr<fes::mesh::Index>>(
-      m, "Index", "Index the triangles of a mesh.")
+  auto index = py::class_<fes::mesh::Index, std::shared_ptr<fes::mesh::Index>>(
+      m, "Index", "Index the triangles of a mesh.");
+
+  py::enum_<fes::mesh::Index::Backend>(
+      index, "Backend", "Spatial structure answering the queries.")
+      .value("RTREE", fes::mesh::Index::kRTree,
+             "R*Tree over the triangle vertices. Handles any mesh.")
+      .value("UNIFORM_GRID", fes::mesh::Index::kUniformGrid,
+             "Uniform longitude/latitude cell grid over the triangles. "
+             "Suited to quasi-uniform meshes.");
+
+  index
       .def(py::init<Eigen::VectorXd, Eigen::VectorXd,
-                    Eigen::Matrix<int32_t, -1, 3>>(),
+                    Eigen::Matrix<int32_t, -1, 3>, fes::mesh::Index::Backend>(),
            py::arg("lon"), py::arg("lat"), py::arg("triangles"),
+           py::arg("backend") = fes::mesh::Index::kRTree,
            R"__doc__(
 Construct an index of a mesh.
 
@@ -23,8 +34,15 @@ Args:
     lon: The longitude of the vertices.
     lat: The latitude of the vertices.
     triangles: The triangles of the mesh.
+    backend: The spatial structure answering the queries.
 )__doc__",
            py::call_guard<py::gil_scoped_release>())
+      .def("backend", &fes::mesh::Index::backend, R"__doc__(
+Get the spatial structure answering the queries.
+
+Returns:
+    The backend of the index.
+)__doc__")
       .def("lon", &fes::mesh::Index::lon, R"__doc__(
 Get the longitude of the vertices.
 
@@ -0,0 +1,71 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/perf_counters.hpp"
+
+#include <pybind11/pybind11.h>
+
+#include <sstream>
+
+namespace py = pybind11;
+
+void init_perf_counters(py::module& m) {
+  py::class_<fes::PerfCounters>(
+      m, "PerfCounters",
+      "Counters describing how the prediction hot paths behaved.")
+      .def_readonly("angle_recomputes", &fes::PerfCounters::angle_recomputes,
+                    "Number of times the astronomic angles were recomputed.")
+      .def_readonly("angle_cache_hits", &fes::PerfCounters::angle_cache_hits,
+                    "Number of times the astronomic angles were served by the "
+                    "cache governed by the time tolerance.")
+      .def_readonly(
+          "interpolation_cache_hits",
+          &fes::PerfCounters::interpolation_cache_hits,
+          "Number of queries served by the cell or triangle cached by the "
+          "last interpolation.")
+      .def_readonly("interpolation_cache_misses",
+                    &fes::PerfCounters::interpolation_cache_misses,
+                    "Number of queries that could not reuse the cached cell "
+                    "or triangle.")
+      .def_readonly("searches", &fes::PerfCounters::searches,
+                    "Number of spatial searches (axis lookups or mesh point "
+                    "locations).")
+      .def_readonly("extrapolations", &fes::PerfCounters::extrapolations,
+                    "Number of queries answered by extrapolation.")
+      .def_readonly("undefined", &fes::PerfCounters::undefined,
+                    "Number of queries outside the domain of the model.")
+      .def_readonly("adaptive_chunks", &fes::PerfCounters::adaptive_chunks,
+                    "Number of chunks claimed by the adaptive scheduler.")
+      .def_readonly("adaptive_chunk_size",
+                    &fes::PerfCounters::adaptive_chunk_size,
+                    "Chunk size the adaptive scheduler converged to during "
+                    "the most recent adaptive run; zero when no adaptive run "
+                    "has completed.")
+      .def("__repr__", [](const fes::PerfCounters& self) -> std::string {
+        auto ss = std::stringstream();
+        ss << "PerfCounters(angle_recomputes=" << self.angle_recomputes
+           << ", angle_cache_hits=" << self.angle_cache_hits
+           << ", interpolation_cache_hits=" << self.interpolation_cache_hits
+           << ", interpolation_cache_misses="
+           << self.interpolation_cache_misses << ", searches=" << self.searches
+           << ", extrapolations=" << self.extrapolations
+           << ", undefined=" << self.undefined
+           << ", adaptive_chunks=" << self.adaptive_chunks
+           << ", adaptive_chunk_size=" << self.adaptive_chunk_size << ")";
+        return ss.str();
+      });
+
+  m.def("perf_counters", &fes::perf_counters,
+        R"__doc__(
+Returns a snapshot of the process-wide performance counters.
+
+The counters cover the calculations whose accelerators have been destroyed; a
+calculation still in progress is not visible yet.
+
+Returns:
+    The accumulated performance counters.
+)__doc__");
+  m.def("reset_perf_counters", &fes::reset_perf_counters,
+        "Clears the process-wide performance counters.");
+}
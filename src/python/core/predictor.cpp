@@ -0,0 +1,89 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/predictor.hpp"
+
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <boost/optional.hpp>
+
+#include "fes/python/datetime64.hpp"
+#include "fes/python/optional.hpp"
+
+namespace py = pybind11;
+
+template <typename T>
+void init_predictor(py::module& m, const std::string& postfix) {
+  py::class_<fes::Predictor<T>>(
+      m, ("Predictor" + postfix).c_str(),
+      "Reusable tide prediction session keeping the wave table, the "
+      "accelerators and the other prediction state warm across calls.")
+      .def(py::init([](std::shared_ptr<fes::AbstractTidalModel<T>> tidal_model,
+                       const boost::optional<fes::Settings>& settings,
+                       const size_t num_threads) {
+             return fes::Predictor<T>(std::move(tidal_model),
+                                      settings.value_or(fes::Settings()),
+                                      num_threads);
+           }),
+           py::arg("tidal_model"), py::arg("settings") = boost::none,
+           py::arg("num_threads") = 0,
+           R"__doc(
+Construct a tide prediction session.
+
+Args:
+  tidal_model: Tidal model used to interpolate the modelized waves. The
+    session keeps a reference on the model for its whole lifetime.
+  settings: Settings for the tide computation.
+  num_threads: Number of threads used by :py:meth:`predict`. If 0, the
+    number of threads is automatically determined.
+)__doc")
+      .def(
+          "predict",
+          [](fes::Predictor<T>& self, py::array& dates,
+             const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+             const Eigen::Ref<const Eigen::VectorXd>& longitudes,
+             const Eigen::Ref<const Eigen::VectorXd>& latitudes)
+              -> std::tuple<Eigen::VectorXd, Eigen::VectorXd,
+                            fes::Vector<fes::Quality>> {
+            auto epoch = fes::python::npdatetime64_to_epoch(dates);
+            {
+              py::gil_scoped_release gil;
+              return self.predict(epoch, leap_seconds, longitudes, latitudes);
+            }
+          },
+          py::arg("date"), py::arg("leap_seconds"), py::arg("longitude"),
+          py::arg("latitude"),
+          R"__doc(
+Ocean tide calculation reusing the state cached by the session.
+
+Args:
+  date: Date of the tide calculation
+  leap_seconds: Leap seconds at the date of the tide calculation
+  longitude: Longitude in degrees for the position at which the tide is
+    calculated
+  latitude: Latitude in degrees for the position at which the tide is
+    calculated
+
+Returns:
+  A tuple that contains:
+    - The height of the the diurnal and semi-diurnal constituents of the
+      tidal spectrum (cm)
+    - The height of the long period wave constituents of the tidal
+      spectrum (cm)
+    - The quality of the tide calculation.
+
+.. note::
+
+  The input vectors could not have the same size: a size-1 vector is
+  broadcast against the others without materializing the repeated values.
+)__doc");
+}
+
+void init_predictor(py::module& m) {
+  init_predictor<double>(m, "Complex128");
+  init_predictor<float>(m, "Complex64");
+}
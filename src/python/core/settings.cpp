@@ -11,23 +11,33 @@
 
 #include "fes/angle/astronomic.hpp"
 #include "fes/constituent.hpp"
+#include "fes/detail/thread.hpp"
 #include "fes/python/optional.hpp"
 
 namespace py = pybind11;
 
 void init_settings(py::module& m) {
+  m.attr("ADAPTIVE_CHUNK_SIZE") = fes::kAdaptiveChunkSize;
   py::class_<fes::Settings>(m, "Settings", "Settings for the FES computation.")
       .def(py::init([](const fes::angle::Formulae astronomic_formulae,
                        const double time_tolerance,
                        const boost::optional<std::vector<fes::Constituent>>&
-                           excluded) {
+                           excluded,
+                       const size_t chunk_size, const bool pin_threads,
+                       const bool fast_sincos, const bool single_precision,
+                       const bool group_by_epoch) {
              return fes::Settings(
                  astronomic_formulae, time_tolerance,
-                 excluded.value_or(std::vector<fes::Constituent>()));
+                 excluded.value_or(std::vector<fes::Constituent>()),
+                 chunk_size, pin_threads, fast_sincos, single_precision,
+                 group_by_epoch);
            }),
            py::arg("astronomic_formulae") =
                fes::angle::Formulae::kSchuremanOrder1,
            py::arg("time_tolerance") = 0.0, py::arg("excluded") = boost::none,
+           py::arg("chunk_size") = 0, py::arg("pin_threads") = false,
+           py::arg("fast_sincos") = false, py::arg("single_precision") = false,
+           py::arg("group_by_epoch") = false,
            R"__doc__(
 Constructor.
 
@@ -41,6 +51,34 @@ Args:
         Constituents included in this list will be processed through admittance
         calculations and in the long-period equilibrium wave calculation
         routine (`lpe_minus_n_waves`). The default value is an empty list.
+    chunk_size: The number of indexes claimed at once by a worker thread. The
+        default value 0 splits the work into one static chunk per thread. A
+        non-zero value enables dynamic scheduling, where the workers claim
+        fixed-size chunks until the work is exhausted, redistributing
+        straggler chunks over the remaining threads. The special value
+        ``ADAPTIVE_CHUNK_SIZE`` lets the workers time each chunk and steer
+        the granularity toward a fixed time quantum; the granularity the run
+        converged to is reported by :py:func:`perf_counters`.
+    pin_threads: If true, the workers of the process-wide thread pool are
+        pinned to one CPU each before the computation starts, preventing the
+        scheduler from migrating them across cores or NUMA nodes. Pinning is a
+        process-wide decision: once a computation has requested it, it stays
+        in effect for the lifetime of the process.
+    fast_sincos: If true, the sine and cosine terms of the harmonic summation
+        are evaluated with a polynomial approximation instead of the C
+        library. The approximation is accurate to a few ulps of the reduced
+        argument, far below the accuracy of the tidal models.
+    single_precision: If true, the harmonic summation is evaluated in single
+        precision, halving its memory traffic and doubling the number of
+        constituents processed per SIMD instruction. The error stays on the
+        order of the float epsilon of the tide, ample for quick-look products
+        with centimetric accuracy requirements.
+    group_by_epoch: If true, the tide evaluation groups the input indices by
+        epoch before partitioning them across threads, so the astronomic
+        angles and the nodal corrections are evaluated once per distinct
+        epoch per worker even when the inputs are sorted by position, as in
+        crossover datasets. The results keep the input order; only the
+        evaluation order changes.
 )__doc__")
       .def_property_readonly("astronomic_formulae",
                              &fes::Settings::astronomic_formulae,
@@ -52,5 +90,25 @@ Args:
           "considered constant.")
       .def_property_readonly("excluded", &fes::Settings::excluded,
                              "Return the list of tidal constituents to be "
-                             "excluded from the model.");
+                             "excluded from the model.")
+      .def_property_readonly("chunk_size", &fes::Settings::chunk_size,
+                             "Return the number of indexes claimed at once by "
+                             "a worker thread (0 for one static chunk per "
+                             "thread).")
+      .def_property_readonly("fast_sincos", &fes::Settings::fast_sincos,
+                             "Return whether the sine and cosine terms of the "
+                             "harmonic summation are evaluated with a "
+                             "polynomial approximation.")
+      .def_property_readonly("single_precision",
+                             &fes::Settings::single_precision,
+                             "Return whether the harmonic summation is "
+                             "evaluated in single precision.")
+      .def_property_readonly("pin_threads", &fes::Settings::pin_threads,
+                             "Return whether the workers of the thread pool "
+                             "are pinned to one CPU each before the "
+                             "computation starts.")
+      .def_property_readonly("group_by_epoch", &fes::Settings::group_by_epoch,
+                             "Return whether the input indices are grouped "
+                             "by epoch before being partitioned across "
+                             "threads.");
 }
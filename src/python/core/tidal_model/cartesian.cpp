@@ -9,6 +9,8 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "fes/tidal_model/file.hpp"
+
 namespace py = pybind11;
 
 template <typename T>
@@ -41,6 +43,149 @@ Get the latitude axis.
 
 Returns:
      The latitude axis.
+)__doc__")
+      .def("crop", &fes::tidal_model::Cartesian<T>::crop, py::arg("min_lon"),
+           py::arg("max_lon"), py::arg("min_lat"), py::arg("max_lat"),
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Shrink the model to a geographical bounding box.
+
+Only the axis points covering the box are kept, padded with one point on
+each side so the box boundary remains interpolable, and the constituent
+grids are sliced accordingly.
+
+Args:
+    min_lon: The minimum longitude, in degrees, of the box.
+    max_lon: The maximum longitude, in degrees, of the box.
+    min_lat: The minimum latitude, in degrees, of the box.
+    max_lat: The maximum latitude, in degrees, of the box.
+)__doc__")
+      .def("interleave", &fes::tidal_model::Cartesian<T>::interleave,
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Pack the constituent values in an interleaved buffer.
+
+All the constituent values of one grid node are stored contiguously
+(node-major, constituent-minor), so one interpolation reads four contiguous
+runs of memory instead of four cells per constituent grid. Adding a
+constituent invalidates the packed buffer.
+)__doc__")
+      .def("interleaved", &fes::tidal_model::Cartesian<T>::interleaved,
+           R"__doc__(
+True if the interpolation reads the interleaved layout.
+)__doc__")
+      .def(
+          "save",
+          [](const fes::tidal_model::Cartesian<T>& self,
+             const std::string& path) -> void {
+            fes::tidal_model::save(self, path);
+          },
+          py::arg("path"), py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Write the serialized state of the model to a file.
+
+Args:
+    path: The path of the file written.
+)__doc__")
+      .def_static(
+          "load",
+          [](const std::string& path,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::Cartesian<T> {
+            return fes::tidal_model::load<fes::tidal_model::Cartesian<T>>(
+                path, wanted);
+          },
+          py::arg("path"),
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Load a model saved with save().
+
+The file is mapped in memory and parsed directly from the mapped pages.
+
+Args:
+    path: The path of the file to load.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent. The other constituents are skipped in the file,
+        cutting the load time and the memory footprint: they are inferred by
+        admittance during the prediction.
+
+Returns:
+    The tidal model.
+)__doc__")
+      .def_static(
+          "lazy_load",
+          [](const std::string& path, const size_t max_resident,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::Cartesian<T> {
+            return fes::tidal_model::lazy_load<
+                fes::tidal_model::Cartesian<T>>(path, max_resident, wanted);
+          },
+          py::arg("path"), py::arg("max_resident") = 0,
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Load a model saved with save(), reading its constituents on demand.
+
+Only the geometry of the model is read eagerly; the constituent grids stay in
+the mapped file and are faulted in by the first interpolation that needs
+them.
+
+Args:
+    path: The path of the file to load. The model keeps the file mapped for
+        its whole lifetime.
+    max_resident: The maximum number of constituent grids kept resident: the
+        least recently used grids beyond this budget are evicted and faulted
+        in again on their next use. 0 keeps every loaded grid resident.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent.
+
+Returns:
+    The tidal model.
+)__doc__")
+      .def(
+          "publish",
+          [](const fes::tidal_model::Cartesian<T>& self,
+             const std::string& name) -> void {
+            fes::tidal_model::publish(self, name);
+          },
+          py::arg("name"), py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Place the serialized state of the model in a named shared-memory segment.
+
+The segment persists after the process exits, until unpublish() removes it:
+one worker process publishes the model and the others attach it without
+loading or copying anything.
+
+Args:
+    name: The name of the segment; must start with a slash.
+)__doc__")
+      .def_static(
+          "attach",
+          [](const std::string& name,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::Cartesian<T> {
+            return fes::tidal_model::attach<fes::tidal_model::Cartesian<T>>(
+                name, wanted);
+          },
+          py::arg("name"),
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Attach a model published with publish().
+
+Only the geometry of the model is read; the constituent values are viewed in
+place in the segment, whose pages are shared between all the processes
+attached to it.
+
+Args:
+    name: The name of the segment; must start with a slash. The model keeps
+        the segment mapped for its whole lifetime.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent.
+
+Returns:
+    The tidal model.
 )__doc__")
       .def(py::pickle(
           [](const fes::tidal_model::Cartesian<T>& self) {
@@ -58,6 +203,16 @@ Returns:
 }
 
 void init_cartesian_model(py::module& m) {
+  m.def("unpublish", &fes::tidal_model::unpublish, py::arg("name"),
+        R"__doc__(
+Remove a shared-memory segment created by publish().
+
+The models attached to the segment remain valid; the name becomes available
+again. Removing a segment that does not exist is a no-op.
+
+Args:
+    name: The name of the segment; must start with a slash.
+)__doc__");
   init_cartesian_model<double>(m, "Complex128");
   init_cartesian_model<float>(m, "Complex64");
 }
@@ -0,0 +1,43 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/tidal_model/composite.hpp"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+template <typename T>
+void init_composite_model(py::module& m, const std::string& suffix) {
+  py::class_<fes::tidal_model::Composite<T>, fes::AbstractTidalModel<T>,
+             std::shared_ptr<fes::tidal_model::Composite<T>>>(
+      m, ("Composite" + suffix).c_str(),
+      R"__doc__(
+Cascade of tidal models evaluated in priority order: each point is
+answered by the first member model defining it.
+)__doc__")
+      .def(py::init<std::vector<
+               std::shared_ptr<const fes::AbstractTidalModel<T>>>>(),
+           py::arg("models"),
+           R"__doc__(
+Construct a composite tidal model.
+
+Args:
+    models: The member models, ordered from the highest to the lowest
+        priority. They must handle the same tide type and the same
+        constituent set.
+)__doc__")
+      .def("models", &fes::tidal_model::Composite<T>::models, R"__doc__(
+Get the member models, ordered from the highest to the lowest priority.
+
+Returns:
+    The member models.
+)__doc__");
+}
+
+void init_composite_model(py::module& m) {
+  init_composite_model<double>(m, "Complex128");
+  init_composite_model<float>(m, "Complex64");
+}
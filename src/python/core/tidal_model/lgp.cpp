@@ -8,6 +8,8 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "fes/tidal_model/file.hpp"
+
 namespace py = pybind11;
 
 template <typename T>
@@ -41,6 +43,149 @@ Get the index of the finite elements.
 
 Returns:
     The index of the finite elements.
+)__doc__")
+      .def("crop", &fes::tidal_model::LGP1<T>::crop, py::arg("min_lon"),
+           py::arg("max_lon"), py::arg("min_lat"), py::arg("max_lat"),
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Shrink the model to a geographical bounding box.
+
+Only the triangles with at least one vertex inside the box are kept: the
+mesh index is rebuilt from the remaining vertices and the wave models are
+subset to the LGP codes still referenced.
+
+Args:
+    min_lon: The minimum longitude, in degrees, of the box.
+    max_lon: The maximum longitude, in degrees, of the box.
+    min_lat: The minimum latitude, in degrees, of the box.
+    max_lat: The maximum latitude, in degrees, of the box.
+)__doc__")
+      .def("interleave", &fes::tidal_model::LGP1<T>::interleave,
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Pack the wave models in an interleaved matrix.
+
+All the constituent values of one LGP code are stored contiguously
+(code-major, constituent-minor), so one interpolation streams the rows of
+the selected triangle instead of gathering the codes from one vector per
+constituent. Adding a constituent invalidates the packed matrix.
+)__doc__")
+      .def("interleaved", &fes::tidal_model::LGP1<T>::interleaved,
+           R"__doc__(
+True if the interpolation reads the interleaved layout.
+)__doc__")
+      .def(
+          "save",
+          [](const fes::tidal_model::LGP1<T>& self,
+             const std::string& path) -> void {
+            fes::tidal_model::save(self, path);
+          },
+          py::arg("path"), py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Write the serialized state of the model to a file.
+
+Args:
+    path: The path of the file written.
+)__doc__")
+      .def_static(
+          "load",
+          [](const std::string& path,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::LGP1<T> {
+            return fes::tidal_model::load<fes::tidal_model::LGP1<T>>(path,
+                                                                     wanted);
+          },
+          py::arg("path"),
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Load a model saved with save().
+
+The file is mapped in memory and parsed directly from the mapped pages.
+
+Args:
+    path: The path of the file to load.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent. The other constituents are skipped in the file,
+        cutting the load time and the memory footprint: they are inferred by
+        admittance during the prediction.
+
+Returns:
+    The tidal model.
+)__doc__")
+      .def_static(
+          "lazy_load",
+          [](const std::string& path, const size_t max_resident,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::LGP1<T> {
+            return fes::tidal_model::lazy_load<fes::tidal_model::LGP1<T>>(
+                path, max_resident, wanted);
+          },
+          py::arg("path"), py::arg("max_resident") = 0,
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Load a model saved with save(), reading its wave models on demand.
+
+Only the mesh index and the LGP codes are read eagerly; the wave models stay
+in the mapped file and are faulted in by the first interpolation that needs
+them.
+
+Args:
+    path: The path of the file to load. The model keeps the file mapped for
+        its whole lifetime.
+    max_resident: The maximum number of wave models kept resident: the least
+        recently used ones beyond this budget are evicted and faulted in
+        again on their next use. 0 keeps every loaded wave model resident.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent.
+
+Returns:
+    The tidal model.
+)__doc__")
+      .def(
+          "publish",
+          [](const fes::tidal_model::LGP1<T>& self,
+             const std::string& name) -> void {
+            fes::tidal_model::publish(self, name);
+          },
+          py::arg("name"), py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Place the serialized state of the model in a named shared-memory segment.
+
+The segment persists after the process exits, until unpublish() removes it:
+one worker process publishes the model and the others attach it without
+loading or copying anything.
+
+Args:
+    name: The name of the segment; must start with a slash.
+)__doc__")
+      .def_static(
+          "attach",
+          [](const std::string& name,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::LGP1<T> {
+            return fes::tidal_model::attach<fes::tidal_model::LGP1<T>>(
+                name, wanted);
+          },
+          py::arg("name"),
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Attach a model published with publish().
+
+Only the mesh index and the LGP codes are read; the wave models are viewed
+in place in the segment, whose pages are shared between all the processes
+attached to it.
+
+Args:
+    name: The name of the segment; must start with a slash. The model keeps
+        the segment mapped for its whole lifetime.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent.
+
+Returns:
+    The tidal model.
 )__doc__")
       .def(py::pickle(
           [](const fes::tidal_model::LGP1<T>& self) {
@@ -88,6 +233,149 @@ Get the index of the finite elements.
 
 Returns:
     The index of the finite elements.
+)__doc__")
+      .def("crop", &fes::tidal_model::LGP2<T>::crop, py::arg("min_lon"),
+           py::arg("max_lon"), py::arg("min_lat"), py::arg("max_lat"),
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Shrink the model to a geographical bounding box.
+
+Only the triangles with at least one vertex inside the box are kept: the
+mesh index is rebuilt from the remaining vertices and the wave models are
+subset to the LGP codes still referenced.
+
+Args:
+    min_lon: The minimum longitude, in degrees, of the box.
+    max_lon: The maximum longitude, in degrees, of the box.
+    min_lat: The minimum latitude, in degrees, of the box.
+    max_lat: The maximum latitude, in degrees, of the box.
+)__doc__")
+      .def("interleave", &fes::tidal_model::LGP2<T>::interleave,
+           py::call_guard<py::gil_scoped_release>(),
+           R"__doc__(
+Pack the wave models in an interleaved matrix.
+
+All the constituent values of one LGP code are stored contiguously
+(code-major, constituent-minor), so one interpolation streams the rows of
+the selected triangle instead of gathering the codes from one vector per
+constituent. Adding a constituent invalidates the packed matrix.
+)__doc__")
+      .def("interleaved", &fes::tidal_model::LGP2<T>::interleaved,
+           R"__doc__(
+True if the interpolation reads the interleaved layout.
+)__doc__")
+      .def(
+          "save",
+          [](const fes::tidal_model::LGP2<T>& self,
+             const std::string& path) -> void {
+            fes::tidal_model::save(self, path);
+          },
+          py::arg("path"), py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Write the serialized state of the model to a file.
+
+Args:
+    path: The path of the file written.
+)__doc__")
+      .def_static(
+          "load",
+          [](const std::string& path,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::LGP2<T> {
+            return fes::tidal_model::load<fes::tidal_model::LGP2<T>>(path,
+                                                                     wanted);
+          },
+          py::arg("path"),
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Load a model saved with save().
+
+The file is mapped in memory and parsed directly from the mapped pages.
+
+Args:
+    path: The path of the file to load.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent. The other constituents are skipped in the file,
+        cutting the load time and the memory footprint: they are inferred by
+        admittance during the prediction.
+
+Returns:
+    The tidal model.
+)__doc__")
+      .def_static(
+          "lazy_load",
+          [](const std::string& path, const size_t max_resident,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::LGP2<T> {
+            return fes::tidal_model::lazy_load<fes::tidal_model::LGP2<T>>(
+                path, max_resident, wanted);
+          },
+          py::arg("path"), py::arg("max_resident") = 0,
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Load a model saved with save(), reading its wave models on demand.
+
+Only the mesh index and the LGP codes are read eagerly; the wave models stay
+in the mapped file and are faulted in by the first interpolation that needs
+them.
+
+Args:
+    path: The path of the file to load. The model keeps the file mapped for
+        its whole lifetime.
+    max_resident: The maximum number of wave models kept resident: the least
+        recently used ones beyond this budget are evicted and faulted in
+        again on their next use. 0 keeps every loaded wave model resident.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent.
+
+Returns:
+    The tidal model.
+)__doc__")
+      .def(
+          "publish",
+          [](const fes::tidal_model::LGP2<T>& self,
+             const std::string& name) -> void {
+            fes::tidal_model::publish(self, name);
+          },
+          py::arg("name"), py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Place the serialized state of the model in a named shared-memory segment.
+
+The segment persists after the process exits, until unpublish() removes it:
+one worker process publishes the model and the others attach it without
+loading or copying anything.
+
+Args:
+    name: The name of the segment; must start with a slash.
+)__doc__")
+      .def_static(
+          "attach",
+          [](const std::string& name,
+             const std::vector<fes::Constituent>& wanted)
+              -> fes::tidal_model::LGP2<T> {
+            return fes::tidal_model::attach<fes::tidal_model::LGP2<T>>(
+                name, wanted);
+          },
+          py::arg("name"),
+          py::arg("wanted") = std::vector<fes::Constituent>{},
+          py::call_guard<py::gil_scoped_release>(),
+          R"__doc__(
+Attach a model published with publish().
+
+Only the mesh index and the LGP codes are read; the wave models are viewed
+in place in the segment, whose pages are shared between all the processes
+attached to it.
+
+Args:
+    name: The name of the segment; must start with a slash. The model keeps
+        the segment mapped for its whole lifetime.
+    wanted: The identifiers of the constituents to load; an empty list loads
+        every constituent.
+
+Returns:
+    The tidal model.
 )__doc__")
       .def(py::pickle(
           [](const fes::tidal_model::LGP2<T>& self) {
@@ -0,0 +1,81 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/tidal_model/netcdf.hpp"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+void init_netcdf_loader(py::module& m) {
+  m.def(
+      "load_cartesian",
+      [](const std::vector<std::pair<fes::Constituent, std::string>>& paths,
+         const std::string& longitude, const std::string& latitude,
+         const std::string& amplitude, const std::string& phase,
+         const fes::TideType tide_type, const double epsilon,
+         const size_t num_threads) -> py::object {
+        // The sample type is chosen from the stored amplitudes: grids packed
+        // as 16-bit integers or 32-bit floating-point values do not carry
+        // more than single precision.
+        auto single = false;
+        {
+          auto gil = py::gil_scoped_release();
+          if (paths.empty()) {
+            throw std::invalid_argument("no constituent file to load");
+          }
+          auto first = fes::detail::netcdf::File(paths.front().second);
+          auto type = first.variable(amplitude).type;
+          single = type == fes::detail::netcdf::kShort ||
+                   type == fes::detail::netcdf::kFloat;
+        }
+        if (single) {
+          auto model = [&]() {
+            auto gil = py::gil_scoped_release();
+            return fes::tidal_model::load_cartesian<float>(
+                paths, longitude, latitude, amplitude, phase, tide_type,
+                epsilon, num_threads);
+          }();
+          return py::cast(std::move(model));
+        }
+        auto model = [&]() {
+          auto gil = py::gil_scoped_release();
+          return fes::tidal_model::load_cartesian<double>(
+              paths, longitude, latitude, amplitude, phase, tide_type,
+              epsilon, num_threads);
+        }();
+        return py::cast(std::move(model));
+      },
+      py::arg("paths"), py::arg("longitude"), py::arg("latitude"),
+      py::arg("amplitude"), py::arg("phase"),
+      py::arg("tide_type") = fes::TideType::kTide, py::arg("epsilon") = 1e-6,
+      py::arg("num_threads") = 0,
+      R"__doc__(
+Build a Cartesian tidal model from a set of netCDF constituent files,
+reading them concurrently.
+
+The files must be in the netCDF classic format (CDF-1 or CDF-2); netCDF-4
+files are rejected with an error. The model holds single-precision samples
+when the amplitudes are stored as 16-bit integers or 32-bit floating-point
+values, double-precision samples otherwise.
+
+Args:
+    paths: The constituents loaded and the paths of their files, as a list
+        of (constituent, path) pairs.
+    longitude: The name of the longitude variable.
+    latitude: The name of the latitude variable.
+    amplitude: The name of the amplitude variable.
+    phase: The name of the phase variable, in degrees or radians according
+        to its units attribute.
+    tide_type: The type of tide handled by the model.
+    epsilon: The tolerance used to determine if the longitude axis is
+        circular.
+    num_threads: The number of threads reading the files. 0 uses all the
+        available cores.
+
+Returns:
+    The tidal model.
+)__doc__");
+}
@@ -16,35 +16,184 @@
 
 namespace py = pybind11;
 
+namespace {
+
+/// Preallocated result arrays provided through the out= keyword: the tide,
+/// the long period tide and the quality flags.
+using OutputArrays = std::tuple<py::array, py::array, py::array>;
+
+/// Maps a preallocated numpy array onto a writable Eigen vector without
+/// copying it. The array must be one-dimensional, contiguous, writable and
+/// of the dtype produced by the allocating overload.
+template <typename T>
+auto map_output_array(const py::array& array, const char* const name)
+    -> Eigen::Map<fes::Vector<T>> {
+  const auto type_num =
+      py::detail::array_descriptor_proxy(array.dtype().ptr())->type_num;
+  const auto expected =
+      py::detail::array_descriptor_proxy(py::dtype::of<T>().ptr())->type_num;
+  if (type_num != expected || array.ndim() != 1 || !array.writeable() ||
+      (array.shape(0) != 0 &&
+       array.strides(0) != static_cast<py::ssize_t>(sizeof(T)))) {
+    throw std::invalid_argument(
+        std::string(name) +
+        " must be a writable contiguous one-dimensional array of the dtype "
+        "returned when out is not provided");
+  }
+  return {static_cast<T*>(const_cast<void*>(array.data())), array.shape(0)};
+}
+
+}  // namespace
+
 template <typename T>
 auto evaluate_tide(const fes::AbstractTidalModel<T>* const tidal_model,
                    py::array& dates,
-                   const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+                   const boost::optional<fes::Vector<uint16_t>>& leap_seconds,
                    const Eigen::Ref<const Eigen::VectorXd>& longitudes,
                    const Eigen::Ref<const Eigen::VectorXd>& latitudes,
                    const boost::optional<fes::Settings>& settings,
-                   const size_t num_threads = 0)
+                   const boost::optional<OutputArrays>& out,
+                   const size_t num_threads = 0) -> py::tuple {
+  // The library broadcasts size-1 vectors against the others and throws if
+  // the sizes are incompatible.
+  auto epoch = fes::python::npdatetime64_to_epoch(dates, num_threads);
+  if (!out) {
+    std::tuple<Eigen::VectorXd, Eigen::VectorXd, fes::Vector<fes::Quality>>
+        result;
+    {
+      py::gil_scoped_release gil;
+      const auto resolved =
+          leap_seconds ? *leap_seconds : fes::leap_seconds(epoch);
+      result = fes::evaluate_tide(tidal_model, epoch, resolved, longitudes,
+                                  latitudes, settings.value_or(fes::Settings()),
+                                  num_threads);
+    }
+    return py::make_tuple(std::get<0>(result), std::get<1>(result),
+                          std::get<2>(result));
+  }
+  // The workers write into the provided arrays directly: no result array is
+  // allocated and the GIL stays released for the whole computation, so
+  // chunked pipelines overlap with the interpreter.
+  auto tide = map_output_array<double>(std::get<0>(*out), "out[0]");
+  auto long_period = map_output_array<double>(std::get<1>(*out), "out[1]");
+  auto quality = map_output_array<fes::Quality>(std::get<2>(*out), "out[2]");
+  {
+    py::gil_scoped_release gil;
+    const auto resolved =
+        leap_seconds ? *leap_seconds : fes::leap_seconds(epoch);
+    fes::evaluate_tide(tidal_model, epoch, resolved, longitudes, latitudes,
+                       tide, long_period, quality,
+                       settings.value_or(fes::Settings()), num_threads);
+  }
+  return py::make_tuple(std::get<0>(*out), std::get<1>(*out),
+                        std::get<2>(*out));
+}
+
+template <typename T>
+auto evaluate_tide_at_point(
+    const fes::AbstractTidalModel<T>* const tidal_model, py::array& dates,
+    const boost::optional<fes::Vector<uint16_t>>& leap_seconds,
+    const double longitude, const double latitude,
+    const boost::optional<fes::Settings>& settings,
+    const size_t num_threads = 0)
     -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, fes::Vector<fes::Quality>> {
-  if (dates.size() != leap_seconds.size() ||
-      dates.size() != longitudes.size() || dates.size() != latitudes.size()) {
+  if (leap_seconds && dates.size() != leap_seconds->size()) {
     throw std::invalid_argument(
-        "epoch, leap_seconds, longitudes and latitudes must have the same "
-        "size");
+        "epoch and leap_seconds must have the same size");
   }
-  auto epoch = fes::python::npdatetime64_to_epoch(dates);
+  auto epoch = fes::python::npdatetime64_to_epoch(dates, num_threads);
   {
     py::gil_scoped_release gil;
-    return fes::evaluate_tide(tidal_model, epoch, leap_seconds, longitudes,
-                              latitudes, settings.value_or(fes::Settings()),
+    const auto resolved =
+        leap_seconds ? *leap_seconds : fes::leap_seconds(epoch);
+    return fes::evaluate_tide(tidal_model, epoch, resolved, longitude,
+                              latitude, settings.value_or(fes::Settings()),
                               num_threads);
   }
 }
 
+template <typename T>
+auto evaluate_tide_grid(
+    const fes::AbstractTidalModel<T>* const tidal_model, const py::object& date,
+    const boost::optional<uint16_t>& leap_seconds,
+    const Eigen::Ref<const Eigen::VectorXd>& longitudes,
+    const Eigen::Ref<const Eigen::VectorXd>& latitudes,
+    const boost::optional<fes::Settings>& settings,
+    const size_t num_threads = 0)
+    -> std::tuple<Eigen::VectorXd, Eigen::VectorXd, fes::Vector<fes::Quality>> {
+  if (longitudes.size() != latitudes.size()) {
+    throw std::invalid_argument(
+        "longitudes and latitudes must have the same size");
+  }
+  auto epoch = fes::python::npdatetime64_scalar_to_epoch(date);
+  {
+    py::gil_scoped_release gil;
+    const auto resolved =
+        leap_seconds ? *leap_seconds : fes::leap_seconds(epoch);
+    return fes::evaluate_tide_grid(tidal_model, epoch, resolved, longitudes,
+                                   latitudes,
+                                   settings.value_or(fes::Settings()),
+                                   num_threads);
+  }
+}
+
+template <typename T>
+auto evaluate_tide_outer(
+    const fes::AbstractTidalModel<T>* const tidal_model, py::array& dates,
+    const boost::optional<fes::Vector<uint16_t>>& leap_seconds,
+    const Eigen::Ref<const Eigen::VectorXd>& longitudes,
+    const Eigen::Ref<const Eigen::VectorXd>& latitudes,
+    const boost::optional<fes::Settings>& settings,
+    const size_t num_threads = 0)
+    -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, fes::Vector<fes::Quality>> {
+  auto epoch = fes::python::npdatetime64_to_epoch(dates, num_threads);
+  {
+    py::gil_scoped_release gil;
+    const auto resolved =
+        leap_seconds ? *leap_seconds : fes::leap_seconds(epoch);
+    return fes::evaluate_tide_outer(tidal_model, epoch, resolved, longitudes,
+                                    latitudes,
+                                    settings.value_or(fes::Settings()),
+                                    num_threads);
+  }
+}
+
+template <typename T>
+auto evaluate_extrema(const fes::AbstractTidalModel<T>* const tidal_model,
+                      const py::object& start, const py::object& end,
+                      const double longitude, const double latitude,
+                      const double step, const double resynchronization,
+                      const boost::optional<fes::Settings>& settings)
+    -> py::tuple {
+  auto start_epoch = fes::python::npdatetime64_scalar_to_epoch(start);
+  auto end_epoch = fes::python::npdatetime64_scalar_to_epoch(end);
+  std::tuple<Eigen::VectorXd, Eigen::VectorXd, fes::Vector<fes::ExtremumType>,
+             fes::Quality>
+      result;
+  {
+    py::gil_scoped_release gil;
+    result = fes::evaluate_extrema(tidal_model, start_epoch, end_epoch,
+                                   longitude, latitude, step, resynchronization,
+                                   settings.value_or(fes::Settings()));
+  }
+  // The extrema times are handed back as a datetime64 array, like the dates
+  // accepted by the evaluation functions.
+  const auto& times = std::get<0>(result);
+  auto dates = py::array(py::dtype("datetime64[us]"), times.size());
+  auto* ticks = static_cast<int64_t*>(dates.mutable_data());
+  for (Eigen::Index ix = 0; ix < times.size(); ++ix) {
+    ticks[ix] = static_cast<int64_t>(std::llround(times(ix) * 1e6));
+  }
+  return py::make_tuple(dates, std::get<1>(result), std::get<2>(result),
+                        std::get<3>(result));
+}
+
 template <typename T>
 void init_tide(py::module& m) {
   m.def("evaluate_tide", &evaluate_tide<T>, py::arg("tidal_model"),
-        py::arg("date"), py::arg("leap_seconds"), py::arg("longitude"),
-        py::arg("latitude"), py::arg("settings") = boost::none,
+        py::arg("date"), py::arg("leap_seconds") = boost::none,
+        py::arg("longitude"), py::arg("latitude"),
+        py::arg("settings") = boost::none, py::arg("out") = boost::none,
         py::arg("num_threads") = 0,
         R"__doc(
 Ocean tide calculation
@@ -52,12 +201,19 @@ Ocean tide calculation
 Args:
   tidal_model: Tidal model used to interpolate the modelized waves
   date: Date of the tide calculation
-  leap_seconds: Leap seconds at the date of the tide calculation
+  leap_seconds: Leap seconds at the date of the tide calculation. If
+    None, the leap seconds are resolved from the IERS table embedded in
+    the library.
   longitude: Longitude in degrees for the position at which the tide is
     calculated
   latitude: Latitude in degrees for the position at which the tide is
     calculated
   settings: Settings for the tide computation.
+  out: A tuple of three preallocated one-dimensional contiguous arrays
+    (two of dtype float64 and one of dtype uint8, sized to the broadcast
+    shape of the inputs) receiving the heights of the short and long
+    period constituents and the quality flags. If None, the result
+    arrays are allocated by the call.
   num_threads: Number of threads to use for the computation. If 0, the
     number of threads is automatically determined.
 
@@ -77,10 +233,168 @@ Returns:
   to nan if no data is available at the given position. the long period wave
   constituents is always computed because this value does not depend on
   input grids.
+
+.. note::
+
+  The input vectors could not have the same size: a size-1 vector is
+  broadcast against the others without materializing the repeated values.
+
+.. note::
+
+  When ``out`` is provided, the computation writes into the given arrays
+  with the GIL released for its entire duration and the same arrays are
+  returned, so chunked pipelines run allocation-free and overlap with the
+  interpreter.
+)__doc");
+  m.def("evaluate_tide", &evaluate_tide_at_point<T>, py::arg("tidal_model"),
+        py::arg("date"), py::arg("leap_seconds") = boost::none,
+        py::arg("longitude"), py::arg("latitude"),
+        py::arg("settings") = boost::none,
+        py::arg("num_threads") = 0,
+        R"__doc(
+Ocean tide calculation for a time series observed at a fixed position.
+
+The tidal constituents are interpolated once at the requested position,
+then only the time dependent part of the calculation is evaluated for
+each date provided.
+
+Args:
+  tidal_model: Tidal model used to interpolate the modelized waves
+  date: Dates of the tide calculation
+  leap_seconds: Leap seconds at the dates of the tide calculation. If
+    None, the leap seconds are resolved from the IERS table embedded in
+    the library.
+  longitude: Longitude in degrees for the position at which the tide is
+    calculated
+  latitude: Latitude in degrees for the position at which the tide is
+    calculated
+  settings: Settings for the tide computation.
+  num_threads: Number of threads to use for the computation. If 0, the
+    number of threads is automatically determined.
+
+Returns:
+  A tuple that contains:
+    - The height of the the diurnal and semi-diurnal constituents of the
+      tidal spectrum (cm)
+    - The height of the long period wave constituents of the tidal
+      spectrum (cm)
+    - The quality of the tide calculation.
+)__doc");
+  m.def("evaluate_tide_grid", &evaluate_tide_grid<T>, py::arg("tidal_model"),
+        py::arg("date"), py::arg("leap_seconds") = boost::none,
+        py::arg("longitude"), py::arg("latitude"),
+        py::arg("settings") = boost::none,
+        py::arg("num_threads") = 0,
+        R"__doc(
+Ocean tide calculation for a set of positions at a single date.
+
+The astronomic angles and the nodal corrections are computed once, then
+only the position dependent part of the calculation is evaluated for
+each point provided.
+
+Args:
+  tidal_model: Tidal model used to interpolate the modelized waves
+  date: Date of the tide calculation
+  leap_seconds: Leap seconds at the date of the tide calculation. If
+    None, the leap seconds are resolved from the IERS table embedded in
+    the library.
+  longitude: Longitudes in degrees for the positions at which the tide is
+    calculated
+  latitude: Latitudes in degrees for the positions at which the tide is
+    calculated
+  settings: Settings for the tide computation.
+  num_threads: Number of threads to use for the computation. If 0, the
+    number of threads is automatically determined.
+
+Returns:
+  A tuple that contains:
+    - The height of the the diurnal and semi-diurnal constituents of the
+      tidal spectrum (cm)
+    - The height of the long period wave constituents of the tidal
+      spectrum (cm)
+    - The quality of the tide calculation.
+)__doc");
+  m.def("evaluate_tide_outer", &evaluate_tide_outer<T>, py::arg("tidal_model"),
+        py::arg("date"), py::arg("leap_seconds") = boost::none,
+        py::arg("longitude"), py::arg("latitude"),
+        py::arg("settings") = boost::none,
+        py::arg("num_threads") = 0,
+        R"__doc(
+Ocean tide calculation for the product of a set of dates by a set of
+positions.
+
+The constituents are interpolated once per position and the astronomic
+angles are computed once per date, then the two factors are combined
+with blocked matrix products.
+
+Args:
+  tidal_model: Tidal model used to interpolate the modelized waves
+  date: Dates of the tide calculation
+  leap_seconds: Leap seconds at the dates of the tide calculation. If
+    None, the leap seconds are resolved from the IERS table embedded in
+    the library.
+  longitude: Longitudes in degrees for the positions at which the tide is
+    calculated
+  latitude: Latitudes in degrees for the positions at which the tide is
+    calculated
+  settings: Settings for the tide computation.
+  num_threads: Number of threads to use for the computation. If 0, the
+    number of threads is automatically determined.
+
+Returns:
+  A tuple that contains:
+    - The height of the the diurnal and semi-diurnal constituents of the
+      tidal spectrum (cm), as a date × position matrix
+    - The height of the long period wave constituents of the tidal
+      spectrum (cm), as a date × position matrix
+    - The quality of the tide calculation for each position.
+)__doc");
+  m.def("evaluate_extrema", &evaluate_extrema<T>, py::arg("tidal_model"),
+        py::arg("start"), py::arg("end"), py::arg("longitude"),
+        py::arg("latitude"), py::arg("step") = 1800.0,
+        py::arg("resynchronization") = 3600.0,
+        py::arg("settings") = boost::none,
+        R"__doc(
+Search of the high and low waters over a time window at a fixed position.
+
+The phase of each constituent is linear in time while the nodal
+corrections are held constant, so the time derivative of the harmonic
+summation is available analytically: its sign changes are bracketed with
+a coarse step, then refined with Newton iterations, yielding the extrema
+directly instead of scanning a densely sampled series.
+
+Args:
+  tidal_model: Tidal model used to interpolate the modelized waves
+  start: Beginning of the search window.
+  end: End of the search window.
+  longitude: Longitude in degrees for the position at which the extrema
+    are searched
+  latitude: Latitude in degrees for the position at which the extrema are
+    searched
+  step: Bracketing step, in seconds. Two extrema closer than the step may
+    be merged.
+  resynchronization: Time during which the nodal corrections are held
+    constant, in seconds.
+  settings: Settings for the tide computation.
+
+Returns:
+  A tuple that contains:
+    - The dates of the extrema.
+    - The heights of the extrema: the sum of the short and long period
+      constituents of the tidal spectrum (cm).
+    - The classification of each extremum: kHighWater or kLowWater.
+    - The quality of the interpolation at the requested position. If the
+      point is not defined by the model the quality is kUndefined and the
+      other elements are empty.
 )__doc");
 }
 
 void init_tide(py::module& m) {
+  py::enum_<fes::ExtremumType>(m, "ExtremumType")
+      .value("kLowWater", fes::ExtremumType::kLowWater)
+      .value("kHighWater", fes::ExtremumType::kHighWater)
+      .export_values();
+
   init_tide<double>(m);
   init_tide<float>(m);
 }
@@ -0,0 +1,74 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/wave/harmonic_analysis.hpp"
+
+#include <pybind11/eigen.h>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void init_harmonic_analysis(py::module& m) {
+  py::class_<fes::wave::HarmonicAnalysis>(m, "HarmonicAnalysis",
+                                          R"__doc__(
+Reusable harmonic analysis context.
+
+The design matrix of an harmonic analysis only depends on the nodal
+modulations of the time base, not on the sea level analyzed. This context
+precomputes the matrix and the factorization of its normal equations once, so
+that every gauge sharing the time base only pays for a cheap solve.
+)__doc__")
+      .def(py::init<const fes::DynamicRef<const Eigen::MatrixXd>&,
+                    const fes::DynamicRef<const Eigen::MatrixXd>&>(),
+           py::arg("f"), py::arg("vu"),
+           R"__doc__(
+Build an analysis context from the nodal modulations of a time base.
+
+Args:
+  f: Nodal correction coefficient applied to the amplitude of the
+    constituents analyzed.
+  vu: Astronomical argument at time :math:`t` + the nodal correction
+    coefficient applied to the phase of the constituents analyzed.
+)__doc__")
+      .def(
+          "solve",
+          [](const fes::wave::HarmonicAnalysis& self,
+             const Eigen::Ref<const Eigen::VectorXd>& h) -> Eigen::VectorXcd {
+            py::gil_scoped_release release;
+            return self.solve(h);
+          },
+          py::arg("h"),
+          R"__doc__(
+Harmonic analysis of one sea level time series.
+
+Args:
+  h: Sea level sampled on the time base of this context.
+
+Returns:
+    The tidal constants of the analyzed constituents.
+)__doc__")
+      .def(
+          "batched_solve",
+          [](const fes::wave::HarmonicAnalysis& self,
+             const fes::DynamicRef<const Eigen::MatrixXd>& h,
+             const size_t num_threads) -> Eigen::MatrixXcd {
+            py::gil_scoped_release release;
+            return self.batched_solve(h, num_threads);
+          },
+          py::arg("h"), py::arg("num_threads") = 0,
+          R"__doc__(
+Harmonic analysis of a block of sea level time series.
+
+Args:
+  h: Sea level, one row per point (n_points x n_times).
+  num_threads: Number of threads to use for the computation. If set to 0,
+    the number of threads is automatically determined.
+
+Returns:
+    The tidal constants, one column per point (n_constituents x n_points).
+)__doc__")
+      .def("__len__", [](const fes::wave::HarmonicAnalysis& self) {
+        return static_cast<size_t>(self.size());
+      });
+}
@@ -4,8 +4,11 @@
 // BSD-style license that can be found in the LICENSE file.
 #include "fes/wave/long_period_equilibrium.hpp"
 
+#include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
 
+#include "fes/python/datetime64.hpp"
+
 namespace py = pybind11;
 
 void init_wave_order2(py::module& m) {
@@ -24,7 +27,8 @@ Args:
   Waves to disable
 )__doc__")
       .def("lpe_minus_n_waves",
-           &fes::wave::LongPeriodEquilibrium::lpe_minus_n_waves,
+           py::overload_cast<const fes::angle::Astronomic&, double>(
+               &fes::wave::LongPeriodEquilibrium::lpe_minus_n_waves),
            py::arg("angles"), py::arg("lat"),
            R"__doc__(
 Computes the long-period equilibrium ocean tides.
@@ -46,5 +50,39 @@ Args:
     tide is computed.
 Returns:
   Computed long-period tide, in centimeters.
+)__doc__")
+      .def(
+          "lpe_minus_n_waves",
+          [](const fes::wave::LongPeriodEquilibrium& self, py::array& dates,
+             const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+             const Eigen::Ref<const Eigen::VectorXd>& lat,
+             const fes::angle::Formulae& formulae) -> Eigen::VectorXd {
+            auto epoch = fes::python::npdatetime64_to_epoch(dates);
+            {
+              py::gil_scoped_release gil;
+              return self.lpe_minus_n_waves(epoch, leap_seconds, lat, formulae);
+            }
+          },
+          py::arg("dates"), py::arg("leap_seconds"), py::arg("lat"),
+          py::arg("formulae") = fes::angle::Formulae::kSchuremanOrder3,
+          R"__doc__(
+Computes the long-period equilibrium ocean tides over a vector of dates.
+
+The spectral summation only depends on the date: it is evaluated once per
+distinct date, so consecutive points sharing a date reuse the scan of the
+Cartwright-Tayler-Edden tables. Size-1 vectors are broadcast against the
+others.
+
+Args:
+  dates: UTC dates. The array must be one-dimensional and of type
+    :py:class:`numpy.datetime64`.
+  leap_seconds: Leap seconds at the dates of the tide calculation.
+  lat: Latitude in degrees (positive north) for the positions at which the
+    tide is computed.
+  formulae: Astronomic formulae used to calculate the astronomic angles.
+    Defaults to :py:attr:`pyfes.Formulae.kSchuremanOrder3
+    <pyfes.core.Formulae.kSchuremanOrder3>`.
+Returns:
+  Computed long-period tides, in centimeters.
 )__doc__");
 }
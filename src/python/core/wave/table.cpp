@@ -8,8 +8,12 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <boost/optional.hpp>
+
+#include "fes/leap_seconds.hpp"
 #include "fes/python/datemanip.hpp"
 #include "fes/python/datetime64.hpp"
+#include "fes/python/optional.hpp"
 
 namespace py = pybind11;
 
@@ -63,21 +67,58 @@ Args:
 
 Returns:
     The complex number representing the different reconstructed waves.
+)__doc__")
+      .def_static(
+          "harmonic_analysis",
+          [](const fes::DynamicRef<const Eigen::MatrixXd>& h,
+             const fes::DynamicRef<const Eigen::MatrixXd>& f,
+             const fes::DynamicRef<const Eigen::MatrixXd>& vu,
+             const size_t num_threads) -> Eigen::MatrixXcd {
+            py::gil_scoped_release release;
+            return fes::wave::Table::batched_harmonic_analysis(h, f, vu,
+                                                               num_threads);
+          },
+          py::arg("h"), py::arg("f"), py::arg("vu"),
+          py::arg("num_threads") = 0,
+          R"__doc__(
+Harmonic analysis of a block of sea level time series sampled on the same
+dates.
+
+The design matrix and its factorization are built once and shared by all the
+points. A point holding undefined values only poisons its own column of the
+result.
+
+Args:
+  h: Sea level, one row per point (n_points x n_times).
+  f: Nodal correction coefficient applied to the amplitude of the
+    constituents analyzed.
+  vu: Astronomical argument at time :math:`t` + the nodal correction
+    coefficient applied to the phase of the constituents analyzed.
+  num_threads: Number of threads to use for the computation. If set to 0,
+    the number of threads is automatically determined.
+
+Returns:
+    The tidal constants, one column per point (n_constituents x n_points).
 )__doc__")
       .def(
           "tide_from_tide_series",
           [](const fes::wave::Table& self, py::array& dates,
              const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
              const Eigen::Ref<const Eigen::VectorXcd>& wave,
-             const fes::angle::Formulae& formulae) -> Eigen::VectorXd {
+             const fes::angle::Formulae& formulae,
+             const double time_tolerance,
+             const size_t num_threads) -> Eigen::VectorXd {
             auto epoch = fes::python::npdatetime64_to_epoch(dates);
             {
               py::gil_scoped_release gil;
-              return self.tide_from_tide_series(epoch, leap_seconds, wave);
+              return self.tide_from_tide_series(epoch, leap_seconds, wave,
+                                                formulae, time_tolerance,
+                                                num_threads);
             }
           },
           py::arg("dates"), py::arg("leap_seconds"), py::arg("wave"),
           py::arg("formulae") = fes::angle::Formulae::kSchuremanOrder3,
+          py::arg("time_tolerance") = 0.0, py::arg("num_threads") = 0,
           R"__doc__(
 Calculates the tide of a given time series.
 
@@ -91,6 +132,11 @@ Args:
   formulae: Astronomic formulae used to calculate the astronomic angles.
     Defaults to :py:attr:`pyfes.Formulae.kSchuremanOrder3
     <pyfes.core.Formulae.kSchuremanOrder3>`.
+  time_tolerance: The time in seconds during which astronomical angles are
+    considered constant. The default value is 0 seconds, indicating that
+    astronomical angles do not remain constant with time.
+  num_threads: Number of threads to use for the computation. If set to 0,
+    the number of threads is automatically determined.
 
 Return:
   The tide calculated for the time series provided.
@@ -100,18 +146,18 @@ Return:
           [](const fes::wave::Table& self, const py::handle& date,
              const uint16_t leap_seconds,
              const fes::DynamicRef<const Eigen::MatrixXcd>& wave,
-             const fes::angle::Formulae& formulae,
-             const size_t num_threads) -> Eigen::MatrixXd {
+             const fes::angle::Formulae& formulae, const size_t num_threads,
+             const Eigen::Index tile_size) -> Eigen::MatrixXd {
             auto epoch = fes::python::datemanip::as_float64(date);
             {
               py::gil_scoped_release gil;
               return self.tide_from_mapping(epoch, leap_seconds, wave, formulae,
-                                            num_threads);
+                                            num_threads, tile_size);
             }
           },
           py::arg("date"), py::arg("leap_seconds"), py::arg("mapping"),
           py::arg("formulae") = fes::angle::Formulae::kSchuremanOrder3,
-          py::arg("num_threads") = 0,
+          py::arg("num_threads") = 0, py::arg("tile_size") = 64,
           R"__doc__(
 Calculates the tide for a given date from a grid describing the wave properties
 over an area of interest.
@@ -125,23 +171,27 @@ Args:
     <pyfes.core.Formulae.kSchuremanOrder3>`.
   num_threads: Number of threads to use. If 0, the number of threads is
     automatically determined.
+  tile_size: Number of positions and constituents evaluated per cache tile.
+    The default fits the tiles in a typical L2 cache. Exposed for
+    benchmarking.
 Returns:
   The tide calculated for the mapping provided at the given date.
 )__doc__")
       .def(
           "compute_nodal_modulations",
           [](const fes::wave::Table& self, py::array& dates,
-             const Eigen::Ref<const fes::Vector<uint16_t>>& leap_seconds,
+             const boost::optional<fes::Vector<uint16_t>>& leap_seconds,
              const fes::angle::Formulae& formulae)
               -> std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> {
             auto epoch = fes::python::npdatetime64_to_epoch(dates);
             {
               py::gil_scoped_release gil;
-              return self.compute_nodal_modulations(epoch, leap_seconds,
-                                                    formulae);
+              const auto resolved =
+                  leap_seconds ? *leap_seconds : fes::leap_seconds(epoch);
+              return self.compute_nodal_modulations(epoch, resolved, formulae);
             }
           },
-          py::arg("dates"), py::arg("leap_seconds"),
+          py::arg("dates"), py::arg("leap_seconds") = boost::none,
           py::arg("formulae") = fes::angle::Formulae::kSchuremanOrder3,
           R"__doc__(
 Compute nodal modulations for amplitude and phase.
@@ -149,7 +199,9 @@ Compute nodal modulations for amplitude and phase.
 Args:
     dates: Desired UTC time. The array must be one-dimensional
         and of type :py:class:`numpy.datetime64`.
-    leap_seconds: Leap seconds at the date of the tide calculation.
+    leap_seconds: Leap seconds at the date of the tide calculation. If
+        None, the leap seconds are resolved from the IERS table embedded
+        in the library.
     formulae: Astronomic formulae used to calculate the astronomic angles.
         Defaults to :py:attr:`pyfes.Formulae.kSchuremanOrder3
         <pyfes.core.Formulae.kSchuremanOrder3>`.
@@ -5,23 +5,46 @@
 """Tidal model prediction library."""
 from __future__ import annotations
 
+import numpy
+
 from . import core
 from .astronomic_angle import AstronomicAngle
 from .config import load as load_config
-from .core import Constituent, Formulae, Quality, constituents
+from .core import (
+    ADAPTIVE_CHUNK_SIZE,
+    Constituent,
+    ExtremumType,
+    Formulae,
+    PerfCounters,
+    Quality,
+    constituents,
+    perf_counters,
+    reset_perf_counters,
+)
 from .leap_seconds import get_leap_seconds
-from .typing import VectorDateTime64, VectorFloat64, VectorInt8
+from .typing import (
+    VectorDateTime64,
+    VectorFloat64,
+    VectorInt8,
+    VectorUInt8,
+)
 from .version import __version__
 from .wave_table import WaveDict, WaveTable
 
 __all__ = [
     '__version__',
     'constituents',
+    'ADAPTIVE_CHUNK_SIZE',
     'AstronomicAngle',
     'Constituent',
+    'ExtremumType',
     'Formulae',
+    'PerfCounters',
+    'Predictor',
     'Quality',
     'load_config',
+    'perf_counters',
+    'reset_perf_counters',
     'WaveDict',
     'WaveTable',
 ]
@@ -43,6 +66,29 @@ class Settings(core.Settings):
             Constituents included in this list will be processed through
             admittance calculations and in the long-period equilibrium wave
             calculation routine (``lpe_minus_n_waves``).
+        chunk_size: The number of indexes claimed at once by a worker thread.
+            The default value 0 splits the work into one static chunk per
+            thread. A non-zero value enables dynamic scheduling, where the
+            workers claim fixed-size chunks until the work is exhausted,
+            redistributing straggler chunks over the remaining threads. The
+            special value :py:data:`ADAPTIVE_CHUNK_SIZE` lets the workers
+            time each chunk and steer the granularity toward a fixed time
+            quantum; the granularity the run converged to is reported by
+            :py:func:`perf_counters`.
+        pin_threads: If true, the workers of the process-wide thread pool are
+            pinned to one CPU each before the computation starts, preventing
+            the scheduler from migrating them across cores or NUMA nodes.
+            Pinning is a process-wide decision: once a computation has
+            requested it, it stays in effect for the lifetime of the process.
+        fast_sincos: If true, the sine and cosine terms of the harmonic
+            summation are evaluated with a polynomial approximation instead
+            of the C library. The approximation is accurate to a few ulps of
+            the reduced argument, far below the accuracy of the tidal models.
+        single_precision: If true, the harmonic summation is evaluated in
+            single precision, halving its memory traffic and doubling the
+            number of constituents processed per SIMD instruction. The error
+            stays on the order of the float epsilon of the tide, ample for
+            quick-look products with centimetric accuracy requirements.
 
     .. note::
 
@@ -64,15 +110,80 @@ class Settings(core.Settings):
                  *,
                  astronomic_formulae: Formulae = Formulae.kSchuremanOrder1,
                  time_tolerance: float = 0.0,
-                 excluded: list[str] | None = None) -> None:
+                 excluded: list[str] | None = None,
+                 chunk_size: int = 0,
+                 pin_threads: bool = False,
+                 fast_sincos: bool = False,
+                 single_precision: bool = False) -> None:
         excluded = excluded or []
         super().__init__(
             astronomic_formulae,
             time_tolerance,
             [core.constituents.parse(constituent) for constituent in excluded],
+            chunk_size,
+            pin_threads,
+            fast_sincos,
+            single_precision,
         )
 
 
+class Predictor:
+    """Reusable tide prediction session.
+
+    :py:func:`evaluate_tide` rebuilds its internal state (wave table,
+    accelerators, ...) at every call, which dominates the runtime when the
+    prediction is invoked many times on small batches. A session is
+    constructed once from a model and settings and keeps this state warm
+    across calls to :py:meth:`predict`.
+
+    Args:
+        tidal_model: Tidal model used to interpolate the modeled waves. The
+            session keeps a reference on the model for its whole lifetime.
+        settings: Settings used for the tide calculation. See
+            :py:class:`Settings` for more details.
+        num_threads: Number of threads used by :py:meth:`predict`. If 0, all
+            available threads are used.
+
+    .. warning::
+
+        A session must not be used from several threads at the same time.
+    """
+
+    def __init__(self,
+                 tidal_model: core.AbstractTidalModelComplex128
+                 | core.AbstractTidalModelComplex64,
+                 *,
+                 settings: Settings | None = None,
+                 num_threads: int = 0) -> None:
+        if isinstance(tidal_model, core.AbstractTidalModelComplex128):
+            self._session = core.PredictorComplex128(tidal_model, settings,
+                                                     num_threads)
+        else:
+            self._session = core.PredictorComplex64(tidal_model, settings,
+                                                    num_threads)
+
+    def predict(
+        self,
+        date: VectorDateTime64,
+        longitude: VectorFloat64,
+        latitude: VectorFloat64,
+    ) -> tuple[VectorFloat64, VectorFloat64, VectorInt8]:
+        """Compute the tide at the given location and time.
+
+        Args:
+            date: Date of the tide calculation.
+            longitude: Longitude in degrees for the position at which the tide
+                is calculated.
+            latitude: Latitude in degrees for the position at which the tide
+                is calculated.
+
+        Returns:
+            The same tuple as :py:func:`evaluate_tide`.
+        """
+        return self._session.predict(date, get_leap_seconds(date), longitude,
+                                     latitude)
+
+
 def evaluate_tide(
     tidal_model: core.AbstractTidalModelComplex128
     | core.AbstractTidalModelComplex64,
@@ -81,6 +192,7 @@ def evaluate_tide(
     latitude: VectorFloat64,
     *,
     settings: Settings | None = None,
+    out: tuple[VectorFloat64, VectorFloat64, VectorUInt8] | None = None,
     num_threads: int = 0,
 ) -> tuple[VectorFloat64, VectorFloat64, VectorInt8]:
     """Compute the tide at the given location and time.
@@ -94,6 +206,11 @@ def evaluate_tide(
             calculated.
         settings: Settings used for the tide calculation. See
             :py:class:`Settings` for more details.
+        out: A tuple of three preallocated one-dimensional contiguous arrays
+            (two of dtype ``float64`` and one of dtype ``uint8``, sized to
+            the broadcast shape of the inputs) receiving the results. If
+            None, the result arrays are allocated by the call. Providing
+            ``out`` lets chunked pipelines run allocation-free.
         num_threads: Number of threads to use for the calculation. If 0, all
             available threads are used.
 
@@ -136,13 +253,173 @@ def evaluate_tide(
 
             The flag value ``2`` or ``3`` are only possible if the
             tidal model used is a Cartesian grid.
+
+        .. note::
+
+            ``date``, ``longitude`` and ``latitude`` do not have to share the
+            same size: a size-1 array is broadcast against the other arguments
+            without materializing the repeated values.
     """
     return core.evaluate_tide(
         tidal_model,  # type: ignore
         date,
-        get_leap_seconds(date),
+        None,
+        longitude,
+        latitude,
+        settings,
+        out,
+        num_threads,
+    )
+
+
+def evaluate_tide_grid(
+    tidal_model: core.AbstractTidalModelComplex128
+    | core.AbstractTidalModelComplex64,
+    date: numpy.datetime64,
+    longitude: VectorFloat64,
+    latitude: VectorFloat64,
+    *,
+    settings: Settings | None = None,
+    num_threads: int = 0,
+) -> tuple[VectorFloat64, VectorFloat64, VectorInt8]:
+    """Compute the tide at the given locations for a single date.
+
+    The astronomic angles and the nodal corrections are computed once,
+    then only the position dependent part of the calculation is evaluated
+    for each point provided. This is the preferred entry point to generate
+    tide maps, as it avoids replicating the date into a vector the size of
+    the grid.
+
+    Args:
+        tidal_model: Tidal models used to interpolate the modeled waves.
+        date: Date of the tide calculation.
+        longitude: Longitudes in degrees for the positions at which the tide
+            is calculated.
+        latitude: Latitudes in degrees for the positions at which the tide is
+            calculated.
+        settings: Settings used for the tide calculation. See
+            :py:class:`Settings` for more details.
+        num_threads: Number of threads to use for the calculation. If 0, all
+            available threads are used.
+
+    Returns:
+        The same tuple as :py:func:`evaluate_tide`.
+    """
+    return core.evaluate_tide_grid(
+        tidal_model,  # type: ignore
+        date,
+        None,
         longitude,
         latitude,
         settings,
         num_threads,
     )
+
+
+def evaluate_tide_outer(
+    tidal_model: core.AbstractTidalModelComplex128
+    | core.AbstractTidalModelComplex64,
+    date: VectorDateTime64,
+    longitude: VectorFloat64,
+    latitude: VectorFloat64,
+    *,
+    settings: Settings | None = None,
+    num_threads: int = 0,
+) -> tuple[numpy.ndarray, numpy.ndarray, VectorInt8]:
+    """Compute the tide for the product of the given dates by the given
+    locations.
+
+    The tidal constituents are interpolated once per position and the
+    astronomic angles are computed once per date, instead of repeating both
+    for every (date, position) pair. This is the preferred entry point for
+    crossover analysis, where the tide is needed at every position for every
+    date.
+
+    Args:
+        tidal_model: Tidal models used to interpolate the modeled waves.
+        date: Dates of the tide calculation.
+        longitude: Longitudes in degrees for the positions at which the tide
+            is calculated.
+        latitude: Latitudes in degrees for the positions at which the tide is
+            calculated.
+        settings: Settings used for the tide calculation. See
+            :py:class:`Settings` for more details.
+        num_threads: Number of threads to use for the calculation. If 0, all
+            available threads are used.
+
+    Returns:
+        * The height of the diurnal and semi-diurnal constituents of the
+          tidal spectrum (cm), as a date × position matrix
+        * The height of the long period wave constituents of the tidal
+          spectrum (cm), as a date × position matrix
+        * A flag indicating if the tide is correctly estimated or not for
+          each position. See :py:func:`evaluate_tide` for the possible
+          values.
+    """
+    return core.evaluate_tide_outer(
+        tidal_model,  # type: ignore
+        date,
+        None,
+        longitude,
+        latitude,
+        settings,
+        num_threads,
+    )
+
+
+def evaluate_extrema(
+    tidal_model: core.AbstractTidalModelComplex128
+    | core.AbstractTidalModelComplex64,
+    start: numpy.datetime64,
+    end: numpy.datetime64,
+    longitude: float,
+    latitude: float,
+    *,
+    step: float = 1800.0,
+    resynchronization: float = 3600.0,
+    settings: Settings | None = None,
+) -> tuple[VectorDateTime64, VectorFloat64, VectorUInt8, Quality]:
+    """Search the high and low waters over a time window at a fixed position.
+
+    The time derivative of the harmonic summation is available analytically,
+    so the extrema are located by bracketing its sign changes and refining
+    each bracket with Newton iterations, instead of scanning a densely
+    sampled prediction. This is the preferred entry point to generate tide
+    tables.
+
+    Args:
+        tidal_model: Tidal models used to interpolate the modeled waves.
+        start: Beginning of the search window.
+        end: End of the search window.
+        longitude: Longitude in degrees for the position at which the extrema
+            are searched.
+        latitude: Latitude in degrees for the position at which the extrema
+            are searched.
+        step: Bracketing step, in seconds. Two extrema closer than the step
+            may be merged.
+        resynchronization: Time during which the nodal corrections are held
+            constant, in seconds.
+        settings: Settings used for the tide calculation. See
+            :py:class:`Settings` for more details.
+
+    Returns:
+        * The dates of the extrema.
+        * The heights of the extrema: the sum of the short and long period
+          constituents of the tidal spectrum (cm).
+        * The classification of each extremum. See
+          :py:class:`pyfes.core.ExtremumType`.
+        * The quality of the interpolation at the requested position. If the
+          point is not defined by the model the quality is
+          :py:attr:`pyfes.Quality.kUndefined <pyfes.core.Quality.kUndefined>`
+          and the other elements are empty.
+    """
+    return core.evaluate_extrema(
+        tidal_model,  # type: ignore
+        start,
+        end,
+        longitude,
+        latitude,
+        step,
+        resynchronization,
+        settings,
+    )
@@ -238,9 +238,40 @@ class Cartesian(Common):
         if not self.phase:
             raise ValueError('phase cannot be empty.')
 
+    def _native_load(self) -> TidalModel | None:
+        """Load the tidal model with the native loader, which reads the
+        constituent files concurrently. Returns None when a file is not in
+        the netCDF classic format handled by the native reader."""
+        paths: list[tuple[Constituent, str]] = []
+        for constituent, path in self.paths.items():
+            if not os.path.exists(path):
+                raise FileNotFoundError(f'File not found: {path!r}.')
+            with open(path, 'rb') as stream:
+                magic = stream.read(4)
+            if magic[:3] != b'CDF' or magic[3:] not in (b'\x01', b'\x02'):
+                return None
+            paths.append((core.constituents.parse(constituent), path))
+        instance: TidalModel = core.tidal_model.load_cartesian(
+            paths,
+            self.longitude,
+            self.latitude,
+            self.amplitude,
+            self.phase,
+            tide_type=TideType[self.tidal_type.upper()].value,
+            epsilon=self.epsilon,
+        )
+        instance.dynamic = self.dynamic_constituents
+        return instance
+
     def load(self) -> TidalModel:
         """Load the tidal model defined by the configuration."""
 
+        # The native loader decodes the constituent files concurrently;
+        # netCDF-4 files fall back to the netCDF4 module below.
+        native = self._native_load()
+        if native is not None:
+            return native
+
         # Define a named tuple to hold the properties of the cartesian grid.
         class GridProperties(NamedTuple):
             """Properties of the cartesian grid."""
@@ -1,6 +1,8 @@
 from typing import ClassVar, Dict, Iterator, List, Optional, Tuple, overload
 import datetime
 
+import numpy
+
 from . import constituents, datemanip, mesh, tidal_model
 
 __all__ = [
@@ -10,14 +12,21 @@ __all__ = [
     "AstronomicAngle",
     "Axis",
     "Constituent",
+    "ExtremumType",
     "Formulae",
+    "HarmonicAnalysis",
     "LongPeriodEquilibrium",
+    "PredictorComplex128",
+    "PredictorComplex64",
     "Quality",
     "Settings",
     "TideType",
     "Wave",
     "WaveTable",
+    "evaluate_extrema",
     "evaluate_tide",
+    "evaluate_tide_grid",
+    "evaluate_tide_outer",
     "constituents",
     "datemanip",
     "mesh",
@@ -53,12 +62,14 @@ kEta2: Constituent
 kExtrapolated1: Quality
 kExtrapolated2: Quality
 kExtrapolated3: Quality
+kHighWater: ExtremumType
 kInterpolated: Quality
 kJ1: Constituent
 kK1: Constituent
 kK2: Constituent
 kL2: Constituent
 kLambda2: Constituent
+kLowWater: ExtremumType
 kM0: Constituent
 kM11: Constituent
 kM12: Constituent
@@ -139,6 +150,17 @@ class AbstractTidalModelComplex128:
     def clear(self) -> None:
         ...
 
+    def dequantize(self) -> None:
+        ...
+
+    @overload
+    def fault_in(self) -> None:
+        ...
+
+    @overload
+    def fault_in(self, idents: List[Constituent]) -> None:
+        ...
+
     def identifiers(self) -> List[Constituent]:
         ...
 
@@ -156,6 +178,21 @@ class AbstractTidalModelComplex128:
                     wave_table: WaveTable) -> Quality:
         ...
 
+    def lazy(self) -> bool:
+        ...
+
+    def quantize(self) -> None:
+        ...
+
+    def quantized(self) -> bool:
+        ...
+
+    def resident(self) -> List[Constituent]:
+        ...
+
+    def unload(self) -> None:
+        ...
+
     def __bool__(self) -> bool:
         ...
 
@@ -191,6 +228,17 @@ class AbstractTidalModelComplex64:
     def clear(self) -> None:
         ...
 
+    def dequantize(self) -> None:
+        ...
+
+    @overload
+    def fault_in(self) -> None:
+        ...
+
+    @overload
+    def fault_in(self, idents: List[Constituent]) -> None:
+        ...
+
     def identifiers(self) -> List[Constituent]:
         ...
 
@@ -208,6 +256,21 @@ class AbstractTidalModelComplex64:
                     wave_table: WaveTable) -> Quality:
         ...
 
+    def lazy(self) -> bool:
+        ...
+
+    def quantize(self) -> None:
+        ...
+
+    def quantized(self) -> bool:
+        ...
+
+    def resident(self) -> List[Constituent]:
+        ...
+
+    def unload(self) -> None:
+        ...
+
     def __bool__(self) -> bool:
         ...
 
@@ -456,6 +519,45 @@ class Constituent:
         ...
 
 
+class ExtremumType:
+    __members__: ClassVar[dict] = ...  # read-only
+    __entries: ClassVar[dict] = ...
+    kHighWater: ClassVar[ExtremumType] = ...
+    kLowWater: ClassVar[ExtremumType] = ...
+
+    def __init__(self, value: int) -> None:
+        ...
+
+    def __eq__(self, other: object) -> bool:
+        ...
+
+    def __getstate__(self) -> int:
+        ...
+
+    def __hash__(self) -> int:
+        ...
+
+    def __index__(self) -> int:
+        ...
+
+    def __int__(self) -> int:
+        ...
+
+    def __ne__(self, other: object) -> bool:
+        ...
+
+    def __setstate__(self, state: int) -> None:
+        ...
+
+    @property
+    def name(self) -> str:
+        ...
+
+    @property
+    def value(self) -> int:
+        ...
+
+
 class Formulae:
     __members__: ClassVar[dict] = ...  # read-only
     __entries: ClassVar[dict] = ...
@@ -496,6 +598,23 @@ class Formulae:
         ...
 
 
+class HarmonicAnalysis:
+
+    def __init__(self, f: MatrixFloat64, vu: MatrixFloat64) -> None:
+        ...
+
+    def solve(self, h: VectorFloat64) -> VectorComplex128:
+        ...
+
+    def batched_solve(self,
+                      h: MatrixFloat64,
+                      num_threads: int = ...) -> MatrixComplex128:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+
 class LongPeriodEquilibrium:
 
     def __init__(self) -> None:
@@ -504,9 +623,54 @@ class LongPeriodEquilibrium:
     def disable_dynamic_wave(self, wave_table: WaveTable) -> None:
         ...
 
+    @overload
     def lpe_minus_n_waves(self, angles: AstronomicAngle, lat: float) -> float:
         ...
 
+    @overload
+    def lpe_minus_n_waves(self,
+                          dates: VectorDateTime64,
+                          leap_seconds: VectorUInt16,
+                          lat: VectorFloat64,
+                          formulae: Formulae = ...) -> VectorFloat64:
+        ...
+
+
+class PredictorComplex128:
+
+    def __init__(self,
+                 tidal_model: AbstractTidalModelComplex128,
+                 settings: Optional[Settings] = ...,
+                 num_threads: int = ...) -> None:
+        ...
+
+    def predict(
+        self,
+        date: VectorDateTime64,
+        leap_seconds: VectorUInt16,
+        longitude: VectorFloat64,
+        latitude: VectorFloat64,
+    ) -> Tuple[VectorFloat64, VectorFloat64, VectorInt8]:
+        ...
+
+
+class PredictorComplex64:
+
+    def __init__(self,
+                 tidal_model: AbstractTidalModelComplex64,
+                 settings: Optional[Settings] = ...,
+                 num_threads: int = ...) -> None:
+        ...
+
+    def predict(
+        self,
+        date: VectorDateTime64,
+        leap_seconds: VectorUInt16,
+        longitude: VectorFloat64,
+        latitude: VectorFloat64,
+    ) -> Tuple[VectorFloat64, VectorFloat64, VectorInt8]:
+        ...
+
 
 class Quality:
     __members__: ClassVar[dict] = ...  # read-only
@@ -555,17 +719,37 @@ class Settings:
     def __init__(self,
                  astronomic_formulae: Formulae = ...,
                  time_tolerance: float = ...,
-                 excluded: Optional[List[Constituent]] = ...) -> None:
+                 excluded: Optional[List[Constituent]] = ...,
+                 chunk_size: int = ...,
+                 pin_threads: bool = ...,
+                 fast_sincos: bool = ...,
+                 single_precision: bool = ...) -> None:
         ...
 
     @property
     def astronomic_formulae(self) -> Formulae:
         ...
 
+    @property
+    def chunk_size(self) -> int:
+        ...
+
     @property
     def excluded(self) -> List[Constituent]:
         ...
 
+    @property
+    def fast_sincos(self) -> bool:
+        ...
+
+    @property
+    def pin_threads(self) -> bool:
+        ...
+
+    @property
+    def single_precision(self) -> bool:
+        ...
+
     @property
     def time_tolerance(self) -> float:
         ...
@@ -720,11 +904,20 @@ class WaveTable:
     def find(self, ident: str) -> Wave:
         ...
 
+    @overload
     @staticmethod
     def harmonic_analysis(h: VectorFloat64, f: MatrixFloat64,
                           vu: MatrixFloat64) -> VectorComplex128:
         ...
 
+    @overload
+    @staticmethod
+    def harmonic_analysis(h: MatrixFloat64,
+                          f: MatrixFloat64,
+                          vu: MatrixFloat64,
+                          num_threads: int = ...) -> MatrixComplex128:
+        ...
+
     def keys(self) -> List[str]:
         ...
 
@@ -738,14 +931,17 @@ class WaveTable:
                           leap_seconds: int,
                           mapping: MatrixComplex128,
                           formulae: Formulae = ...,
-                          num_threads: int = ...) -> MatrixFloat64:
+                          num_threads: int = ...,
+                          tile_size: int = ...) -> MatrixFloat64:
         ...
 
     def tide_from_tide_series(self,
                               dates: VectorDateTime64,
                               leap_seconds: VectorUInt16,
                               wave: VectorComplex128,
-                              formulae: Formulae = ...) -> VectorFloat64:
+                              formulae: Formulae = ...,
+                              time_tolerance: float = ...,
+                              num_threads: int = ...) -> VectorFloat64:
         ...
 
     def values(self) -> List[Wave]:
@@ -761,6 +957,34 @@ class WaveTable:
         ...
 
 
+@overload
+def evaluate_extrema(
+    tidal_model: AbstractTidalModelComplex128,
+    start: numpy.datetime64,
+    end: numpy.datetime64,
+    longitude: float,
+    latitude: float,
+    step: float = ...,
+    resynchronization: float = ...,
+    settings: Optional[Settings] = ...
+) -> Tuple[VectorDateTime64, VectorFloat64, VectorUInt8, Quality]:
+    ...
+
+
+@overload
+def evaluate_extrema(
+    tidal_model: AbstractTidalModelComplex64,
+    start: numpy.datetime64,
+    end: numpy.datetime64,
+    longitude: float,
+    latitude: float,
+    step: float = ...,
+    resynchronization: float = ...,
+    settings: Optional[Settings] = ...
+) -> Tuple[VectorDateTime64, VectorFloat64, VectorUInt8, Quality]:
+    ...
+
+
 @overload
 def evaluate_tide(
     tidal_model: AbstractTidalModelComplex128,
@@ -785,3 +1009,81 @@ def evaluate_tide(
     num_threads: int = ...
 ) -> Tuple[VectorFloat64, VectorFloat64, VectorUInt8]:
     ...
+
+
+@overload
+def evaluate_tide(
+    tidal_model: AbstractTidalModelComplex128,
+    date: VectorDateTime64,
+    leap_seconds: VectorUInt16,
+    longitude: float,
+    latitude: float,
+    settings: Optional[Settings] = ...,
+    num_threads: int = ...
+) -> Tuple[VectorFloat64, VectorFloat64, VectorUInt8]:
+    ...
+
+
+@overload
+def evaluate_tide(
+    tidal_model: AbstractTidalModelComplex64,
+    date: VectorDateTime64,
+    leap_seconds: VectorUInt16,
+    longitude: float,
+    latitude: float,
+    settings: Optional[Settings] = ...,
+    num_threads: int = ...
+) -> Tuple[VectorFloat64, VectorFloat64, VectorUInt8]:
+    ...
+
+
+@overload
+def evaluate_tide_grid(
+    tidal_model: AbstractTidalModelComplex128,
+    date: numpy.datetime64,
+    leap_seconds: int,
+    longitude: VectorFloat64,
+    latitude: VectorFloat64,
+    settings: Optional[Settings] = ...,
+    num_threads: int = ...
+) -> Tuple[VectorFloat64, VectorFloat64, VectorUInt8]:
+    ...
+
+
+@overload
+def evaluate_tide_grid(
+    tidal_model: AbstractTidalModelComplex64,
+    date: numpy.datetime64,
+    leap_seconds: int,
+    longitude: VectorFloat64,
+    latitude: VectorFloat64,
+    settings: Optional[Settings] = ...,
+    num_threads: int = ...
+) -> Tuple[VectorFloat64, VectorFloat64, VectorUInt8]:
+    ...
+
+
+@overload
+def evaluate_tide_outer(
+    tidal_model: AbstractTidalModelComplex128,
+    date: VectorDateTime64,
+    leap_seconds: VectorUInt16,
+    longitude: VectorFloat64,
+    latitude: VectorFloat64,
+    settings: Optional[Settings] = ...,
+    num_threads: int = ...
+) -> Tuple[MatrixFloat64, MatrixFloat64, VectorUInt8]:
+    ...
+
+
+@overload
+def evaluate_tide_outer(
+    tidal_model: AbstractTidalModelComplex64,
+    date: VectorDateTime64,
+    leap_seconds: VectorUInt16,
+    longitude: VectorFloat64,
+    latitude: VectorFloat64,
+    settings: Optional[Settings] = ...,
+    num_threads: int = ...
+) -> Tuple[MatrixFloat64, MatrixFloat64, VectorUInt8]:
+    ...
@@ -2,8 +2,18 @@ from ..typing import MatrixInt32, VectorFloat64
 
 class Index:
 
-    def __init__(self, lon: VectorFloat64, lat: VectorFloat64,
-                 triangles: MatrixInt32) -> None:
+    class Backend:
+        RTREE: 'Index.Backend'
+        UNIFORM_GRID: 'Index.Backend'
+
+    def __init__(self,
+                 lon: VectorFloat64,
+                 lat: VectorFloat64,
+                 triangles: MatrixInt32,
+                 backend: 'Index.Backend' = ...) -> None:
+        ...
+
+    def backend(self) -> 'Index.Backend':
         ...
 
     def lat(self) -> VectorFloat64:
@@ -2,6 +2,7 @@ from . import (
     AbstractTidalModelComplex64,
     AbstractTidalModelComplex128,
     Axis,
+    Constituent,
     TideType,
     mesh,
 )
@@ -22,12 +23,44 @@ class CartesianComplex128(AbstractTidalModelComplex128):
     def __setstate__(self, state: bytes) -> None:
         ...
 
+    @staticmethod
+    def attach(name: str) -> 'CartesianComplex128':
+        ...
+
+    def crop(self,
+             min_lon: float,
+             max_lon: float,
+             min_lat: float,
+             max_lat: float) -> None:
+        ...
+
+    def interleave(self) -> None:
+        ...
+
+    def interleaved(self) -> bool:
+        ...
+
     def lat(self) -> Axis:
         ...
 
+    @staticmethod
+    def lazy_load(path: str,
+                  max_resident: int = ...) -> 'CartesianComplex128':
+        ...
+
+    @staticmethod
+    def load(path: str) -> 'CartesianComplex128':
+        ...
+
     def lon(self) -> Axis:
         ...
 
+    def publish(self, name: str) -> None:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
 
 class CartesianComplex64(AbstractTidalModelComplex64):
 
@@ -44,12 +77,65 @@ class CartesianComplex64(AbstractTidalModelComplex64):
     def __setstate__(self, state: bytes) -> None:
         ...
 
+    @staticmethod
+    def attach(name: str) -> 'CartesianComplex64':
+        ...
+
+    def crop(self,
+             min_lon: float,
+             max_lon: float,
+             min_lat: float,
+             max_lat: float) -> None:
+        ...
+
+    def interleave(self) -> None:
+        ...
+
+    def interleaved(self) -> bool:
+        ...
+
     def lat(self) -> Axis:
         ...
 
+    @staticmethod
+    def lazy_load(path: str, max_resident: int = ...) -> 'CartesianComplex64':
+        ...
+
+    @staticmethod
+    def load(path: str) -> 'CartesianComplex64':
+        ...
+
     def lon(self) -> Axis:
         ...
 
+    def publish(self, name: str) -> None:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
+
+class CompositeComplex128(AbstractTidalModelComplex128):
+
+    def __init__(
+            self,
+            models: list[AbstractTidalModelComplex128]) -> None:
+        ...
+
+    def models(self) -> list[AbstractTidalModelComplex128]:
+        ...
+
+
+class CompositeComplex64(AbstractTidalModelComplex64):
+
+    def __init__(
+            self,
+            models: list[AbstractTidalModelComplex64]) -> None:
+        ...
+
+    def models(self) -> list[AbstractTidalModelComplex64]:
+        ...
+
 
 class LGP1Complex128(AbstractTidalModelComplex128):
 
@@ -66,9 +152,40 @@ class LGP1Complex128(AbstractTidalModelComplex128):
     def __setstate__(self, state: bytes) -> None:
         ...
 
+    @staticmethod
+    def attach(name: str) -> 'LGP1Complex128':
+        ...
+
+    def crop(self,
+             min_lon: float,
+             max_lon: float,
+             min_lat: float,
+             max_lat: float) -> None:
+        ...
+
     def index(self) -> mesh.Index:
         ...
 
+    def interleave(self) -> None:
+        ...
+
+    def interleaved(self) -> bool:
+        ...
+
+    @staticmethod
+    def lazy_load(path: str, max_resident: int = ...) -> 'LGP1Complex128':
+        ...
+
+    @staticmethod
+    def load(path: str) -> 'LGP1Complex128':
+        ...
+
+    def publish(self, name: str) -> None:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
 
 class LGP1Complex64(AbstractTidalModelComplex64):
 
@@ -85,9 +202,40 @@ class LGP1Complex64(AbstractTidalModelComplex64):
     def __setstate__(self, state: bytes) -> None:
         ...
 
+    @staticmethod
+    def attach(name: str) -> 'LGP1Complex64':
+        ...
+
+    def crop(self,
+             min_lon: float,
+             max_lon: float,
+             min_lat: float,
+             max_lat: float) -> None:
+        ...
+
     def index(self) -> mesh.Index:
         ...
 
+    def interleave(self) -> None:
+        ...
+
+    def interleaved(self) -> bool:
+        ...
+
+    @staticmethod
+    def lazy_load(path: str, max_resident: int = ...) -> 'LGP1Complex64':
+        ...
+
+    @staticmethod
+    def load(path: str) -> 'LGP1Complex64':
+        ...
+
+    def publish(self, name: str) -> None:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
 
 class LGP2Complex128(AbstractTidalModelComplex128):
 
@@ -104,9 +252,40 @@ class LGP2Complex128(AbstractTidalModelComplex128):
     def __setstate__(self, state: bytes) -> None:
         ...
 
+    @staticmethod
+    def attach(name: str) -> 'LGP2Complex128':
+        ...
+
+    def crop(self,
+             min_lon: float,
+             max_lon: float,
+             min_lat: float,
+             max_lat: float) -> None:
+        ...
+
     def index(self) -> mesh.Index:
         ...
 
+    def interleave(self) -> None:
+        ...
+
+    def interleaved(self) -> bool:
+        ...
+
+    @staticmethod
+    def lazy_load(path: str, max_resident: int = ...) -> 'LGP2Complex128':
+        ...
+
+    @staticmethod
+    def load(path: str) -> 'LGP2Complex128':
+        ...
+
+    def publish(self, name: str) -> None:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
 
 class LGP2Complex64(AbstractTidalModelComplex64):
 
@@ -123,5 +302,53 @@ class LGP2Complex64(AbstractTidalModelComplex64):
     def __setstate__(self, state: bytes) -> None:
         ...
 
+    @staticmethod
+    def attach(name: str) -> 'LGP2Complex64':
+        ...
+
+    def crop(self,
+             min_lon: float,
+             max_lon: float,
+             min_lat: float,
+             max_lat: float) -> None:
+        ...
+
     def index(self) -> mesh.Index:
         ...
+
+    def interleave(self) -> None:
+        ...
+
+    def interleaved(self) -> bool:
+        ...
+
+    @staticmethod
+    def lazy_load(path: str, max_resident: int = ...) -> 'LGP2Complex64':
+        ...
+
+    @staticmethod
+    def load(path: str) -> 'LGP2Complex64':
+        ...
+
+    def publish(self, name: str) -> None:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
+
+def load_cartesian(
+    paths: list[tuple[Constituent, str]],
+    longitude: str,
+    latitude: str,
+    amplitude: str,
+    phase: str,
+    tide_type: TideType = ...,
+    epsilon: float = ...,
+    num_threads: int = ...
+) -> CartesianComplex64 | CartesianComplex128:
+    ...
+
+
+def unpublish(name: str) -> None:
+    ...
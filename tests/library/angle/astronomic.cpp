@@ -82,3 +82,50 @@ TEST(Angle, SchuremanOrder3) {
   EXPECT_NEAR(a.s(), 4.8350091919708946, 1e-6);
   EXPECT_NEAR(a.t(), 3.141592653589793, 1e-6);
 }
+
+namespace {
+
+// Checks that the compile time specialization reproduces the runtime
+// dispatched evaluation bit for bit.
+template <fes::angle::Formulae F>
+void check_typed_astronomic() {
+  // 946684800 is 2000-01-01T00:00:00Z
+  auto reference = fes::angle::Astronomic(F, 946684800.0, 32);
+  auto typed = fes::angle::TypedAstronomic<F>(946684800.0, 32);
+  EXPECT_DOUBLE_EQ(typed.t(), reference.t());
+  EXPECT_DOUBLE_EQ(typed.n(), reference.n());
+  EXPECT_DOUBLE_EQ(typed.h(), reference.h());
+  EXPECT_DOUBLE_EQ(typed.s(), reference.s());
+  EXPECT_DOUBLE_EQ(typed.p(), reference.p());
+  EXPECT_DOUBLE_EQ(typed.p1(), reference.p1());
+  EXPECT_DOUBLE_EQ(typed.i(), reference.i());
+  EXPECT_DOUBLE_EQ(typed.xi(), reference.xi());
+  EXPECT_DOUBLE_EQ(typed.nu(), reference.nu());
+  EXPECT_DOUBLE_EQ(typed.x1ra(), reference.x1ra());
+  EXPECT_DOUBLE_EQ(typed.r(), reference.r());
+  EXPECT_DOUBLE_EQ(typed.nuprim(), reference.nuprim());
+  EXPECT_DOUBLE_EQ(typed.nusec(), reference.nusec());
+
+  // The statically bound update() must also shadow the runtime dispatch
+  // when the angles are refreshed in place.
+  // -2208988800 is 1900-01-01T00:00:00Z
+  reference.update(-2208988800.0, 0);
+  typed.update(-2208988800.0, 0);
+  EXPECT_DOUBLE_EQ(typed.n(), reference.n());
+  EXPECT_DOUBLE_EQ(typed.s(), reference.s());
+  EXPECT_DOUBLE_EQ(typed.xi(), reference.xi());
+}
+
+}  // namespace
+
+TEST(Angle, TypedSchuremanOrder1) {
+  check_typed_astronomic<fes::angle::Formulae::kSchuremanOrder1>();
+}
+
+TEST(Angle, TypedSchuremanOrder3) {
+  check_typed_astronomic<fes::angle::Formulae::kSchuremanOrder3>();
+}
+
+TEST(Angle, TypedMeeus) {
+  check_typed_astronomic<fes::angle::Formulae::kMeeus>();
+}
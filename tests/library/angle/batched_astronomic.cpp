@@ -0,0 +1,75 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/angle/batched_astronomic.hpp"
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Core>
+
+namespace {
+
+// Checks that the batched evaluation reproduces the scalar evaluation for
+// every epoch of the batch.
+void check_against_scalar(const fes::angle::Formulae formulae) {
+  auto epoch = Eigen::VectorXd(5);
+  // From 1900-01-01T00:00:00Z to 2000-01-01T00:00:00Z
+  epoch << -2208988800.0, -631152000.0, 0.0, 646786800.0, 946684800.0;
+  auto leap_seconds = fes::Vector<uint16_t>(5);
+  leap_seconds << 0, 0, 10, 25, 32;
+
+  auto batch = fes::angle::BatchedAstronomic(formulae);
+  batch.update(epoch, leap_seconds);
+  ASSERT_EQ(batch.size(), epoch.size());
+
+  auto scattered = fes::angle::Astronomic(formulae);
+  for (Eigen::Index ix = 0; ix < epoch.size(); ++ix) {
+    auto reference =
+        fes::angle::Astronomic(formulae, epoch(ix), leap_seconds(ix));
+    EXPECT_NEAR(batch.t()(ix), reference.t(), 1e-12);
+    EXPECT_NEAR(batch.n()(ix), reference.n(), 1e-9);
+    EXPECT_NEAR(batch.h()(ix), reference.h(), 1e-9);
+    EXPECT_NEAR(batch.s()(ix), reference.s(), 1e-9);
+    EXPECT_NEAR(batch.p1()(ix), reference.p1(), 1e-9);
+    EXPECT_NEAR(batch.p()(ix), reference.p(), 1e-9);
+    EXPECT_NEAR(batch.i()(ix), reference.i(), 1e-9);
+    EXPECT_NEAR(batch.xi()(ix), reference.xi(), 1e-9);
+    EXPECT_NEAR(batch.nu()(ix), reference.nu(), 1e-9);
+    EXPECT_NEAR(batch.x1ra()(ix), reference.x1ra(), 1e-9);
+    EXPECT_NEAR(batch.r()(ix), reference.r(), 1e-9);
+    EXPECT_NEAR(batch.nuprim()(ix), reference.nuprim(), 1e-9);
+    EXPECT_NEAR(batch.nusec()(ix), reference.nusec(), 1e-9);
+
+    // The scattered scalar instance must expose the same node factors as
+    // the reference.
+    batch.fill(ix, scattered);
+    EXPECT_NEAR(scattered.f_m2(), reference.f_m2(), 1e-9);
+    EXPECT_NEAR(scattered.f_k1(), reference.f_k1(), 1e-9);
+    EXPECT_NEAR(scattered.f_l2(), reference.f_l2(), 1e-9);
+  }
+}
+
+}  // namespace
+
+TEST(BatchedAngle, SchuremanOrder1) {
+  check_against_scalar(fes::angle::Formulae::kSchuremanOrder1);
+}
+
+TEST(BatchedAngle, SchuremanOrder3) {
+  check_against_scalar(fes::angle::Formulae::kSchuremanOrder3);
+}
+
+TEST(BatchedAngle, Meeus) {
+  check_against_scalar(fes::angle::Formulae::kMeeus);
+}
+
+TEST(BatchedAngle, ShapeMismatch) {
+  auto epoch = Eigen::VectorXd(2);
+  epoch << 0.0, 3600.0;
+  auto leap_seconds = fes::Vector<uint16_t>(1);
+  leap_seconds << 10;
+
+  auto batch = fes::angle::BatchedAstronomic();
+  EXPECT_THROW(batch.update(epoch, leap_seconds), std::invalid_argument);
+}
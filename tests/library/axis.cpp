@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 TEST(Axis, Constructor) {
   auto points =
       static_cast<Eigen::VectorXd>(Eigen::VectorXd::LinSpaced(360, 0.0, 359.0));
@@ -195,6 +197,12 @@ TEST(Axis, Serialization) {
       fes::Axis::setstate(fes::string_view(state.data(), state.size()));
   EXPECT_EQ(axis, other);
 
+  // The stream variants produce and parse the same bytes.
+  auto ss = std::stringstream();
+  axis.getstate(ss);
+  EXPECT_EQ(ss.str(), state);
+  EXPECT_EQ(axis, fes::Axis::setstate(ss));
+
   EXPECT_THROW(
       { fes::Axis::setstate(fes::string_view("invalid state")); },
       std::invalid_argument);
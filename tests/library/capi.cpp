@@ -0,0 +1,219 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "fes/detail/netcdf.hpp"
+#include "fes/leap_seconds.hpp"
+#include "fes/tide.hpp"
+#include "fes/tidal_model/netcdf.hpp"
+
+namespace {
+
+// Helpers writing the big-endian encoding of the classic format.
+
+auto put_uint32(std::string& buffer, const uint32_t value) -> void {
+  buffer.push_back(static_cast<char>(value >> 24U));
+  buffer.push_back(static_cast<char>(value >> 16U));
+  buffer.push_back(static_cast<char>(value >> 8U));
+  buffer.push_back(static_cast<char>(value));
+}
+
+auto put_int32(std::string& buffer, const int32_t value) -> void {
+  put_uint32(buffer, static_cast<uint32_t>(value));
+}
+
+auto put_float(std::string& buffer, const float value) -> void {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  put_uint32(buffer, bits);
+}
+
+auto put_double(std::string& buffer, const double value) -> void {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  put_uint32(buffer, static_cast<uint32_t>(bits >> 32U));
+  put_uint32(buffer, static_cast<uint32_t>(bits));
+}
+
+auto put_name(std::string& buffer, const std::string& name) -> void {
+  put_int32(buffer, static_cast<int32_t>(name.size()));
+  buffer.append(name);
+  while ((buffer.size() & 3U) != 0) {
+    buffer.push_back('\0');
+  }
+}
+
+/// Build the header of the test file: a 2 x 3 (lat x lon) grid with the
+/// amplitudes and the phases, in radians, stored as plain floats.
+auto build_header(const std::array<int32_t, 4>& begins) -> std::string {
+  auto buffer = std::string("CDF\x01", 4);
+  put_int32(buffer, 0);  // numrecs
+  // Dimensions: lat(2), lon(3).
+  put_int32(buffer, 0x0A);
+  put_int32(buffer, 2);
+  put_name(buffer, "lat");
+  put_int32(buffer, 2);
+  put_name(buffer, "lon");
+  put_int32(buffer, 3);
+  // No global attribute.
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  // Variables: lon(lon), lat(lat), amplitude(lat, lon), phase(lat, lon),
+  // none carrying attributes.
+  put_int32(buffer, 0x0B);
+  put_int32(buffer, 4);
+  put_name(buffer, "lon");
+  put_int32(buffer, 1);
+  put_int32(buffer, 1);
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  put_int32(buffer, fes::detail::netcdf::kDouble);
+  put_int32(buffer, 24);
+  put_int32(buffer, begins[0]);
+  put_name(buffer, "lat");
+  put_int32(buffer, 1);
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  put_int32(buffer, fes::detail::netcdf::kDouble);
+  put_int32(buffer, 16);
+  put_int32(buffer, begins[1]);
+  put_name(buffer, "amplitude");
+  put_int32(buffer, 2);
+  put_int32(buffer, 0);
+  put_int32(buffer, 1);
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  put_int32(buffer, fes::detail::netcdf::kFloat);
+  put_int32(buffer, 24);
+  put_int32(buffer, begins[2]);
+  put_name(buffer, "phase");
+  put_int32(buffer, 2);
+  put_int32(buffer, 0);
+  put_int32(buffer, 1);
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  put_int32(buffer, fes::detail::netcdf::kFloat);
+  put_int32(buffer, 24);
+  put_int32(buffer, begins[3]);
+  return buffer;
+}
+
+/// Write a constituent file holding the given amplitudes and phases.
+auto write_constituent_file(const std::string& path, const float amplitude,
+                            const float phase) -> void {
+  // The variable offsets depend on the header size, which does not depend
+  // on them: measure with placeholders, then rebuild.
+  auto header = static_cast<int32_t>(build_header({0, 0, 0, 0}).size());
+  auto buffer =
+      build_header({header, header + 24, header + 40, header + 64});
+  for (auto value : {0.0, 1.0, 2.0}) {
+    put_double(buffer, value);
+  }
+  for (auto value : {0.0, 10.0}) {
+    put_double(buffer, value);
+  }
+  for (auto ix = 0; ix < 6; ++ix) {
+    put_float(buffer, amplitude);
+  }
+  for (auto ix = 0; ix < 6; ++ix) {
+    put_float(buffer, phase);
+  }
+  auto stream = std::ofstream(path, std::ios::binary);
+  stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+}  // namespace
+
+TEST(CAPI, Evaluate) {
+  const auto m2 = testing::TempDir() + "capi_m2.nc";
+  const auto k1 = testing::TempDir() + "capi_k1.nc";
+  write_constituent_file(m2, 10.F, 0.5F);
+  write_constituent_file(k1, 4.F, 1.5F);
+
+  const char* constituents[] = {"M2", "K1"};
+  const char* paths[] = {m2.c_str(), k1.c_str()};
+  auto* model = fes_load_cartesian(2, constituents, paths, "lon", "lat",
+                                   "amplitude", "phase", FES_TIDE, 1);
+  ASSERT_NE(model, nullptr) << fes_last_error();
+  auto* predictor = fes_predictor_new(model, 0.0, 1);
+  ASSERT_NE(predictor, nullptr) << fes_last_error();
+
+  constexpr auto n = size_t(24);
+  std::array<double, n> epoch;
+  for (size_t ix = 0; ix < n; ++ix) {
+    epoch[ix] = 1577836800.0 + static_cast<double>(ix) * 3600.0;
+  }
+  auto lon = std::array<double, n>();
+  auto lat = std::array<double, n>();
+  lon.fill(1.0);
+  lat.fill(5.0);
+  std::array<double, n> tide;
+  std::array<double, n> long_period;
+  std::array<uint8_t, n> quality;
+
+  ASSERT_EQ(fes_evaluate(predictor, n, epoch.data(), lon.data(), lat.data(),
+                         tide.data(), long_period.data(), quality.data()),
+            FES_SUCCESS)
+      << fes_last_error();
+
+  // The C interface matches the C++ prediction on the same model.
+  auto reference = fes::tidal_model::load_cartesian<float>(
+      {{fes::kM2, m2}, {fes::kK1, k1}}, "lon", "lat", "amplitude", "phase");
+  auto epoch_ref = Eigen::Map<const Eigen::VectorXd>(
+      epoch.data(), static_cast<Eigen::Index>(n));
+  Eigen::VectorXd expected_tide;
+  Eigen::VectorXd expected_long_period;
+  fes::Vector<fes::Quality> expected_quality;
+  std::tie(expected_tide, expected_long_period, expected_quality) =
+      fes::evaluate_tide(&reference, epoch_ref,
+                         fes::leap_seconds(epoch_ref), 1.0, 5.0,
+                         fes::Settings(), 1);
+  for (size_t ix = 0; ix < n; ++ix) {
+    const auto jx = static_cast<Eigen::Index>(ix);
+    EXPECT_EQ(quality[ix], FES_INTERPOLATED);
+    EXPECT_NEAR(tide[ix], expected_tide(jx), 1e-12);
+    EXPECT_NEAR(long_period[ix], expected_long_period(jx), 1e-12);
+  }
+
+  // Out-of-domain points are flagged, not rejected.
+  auto far_lon = 30.0;
+  auto far_lat = 5.0;
+  double far_tide;
+  double far_long_period;
+  uint8_t far_quality;
+  ASSERT_EQ(fes_evaluate(predictor, 1, epoch.data(), &far_lon, &far_lat,
+                         &far_tide, &far_long_period, &far_quality),
+            FES_SUCCESS);
+  EXPECT_EQ(far_quality, FES_UNDEFINED);
+  EXPECT_TRUE(std::isnan(far_tide));
+
+  fes_predictor_free(predictor);
+  fes_model_free(model);
+}
+
+TEST(CAPI, Errors) {
+  const char* constituents[] = {"M2"};
+  const char* paths[] = {"/nonexistent/m2.nc"};
+  EXPECT_EQ(fes_load_cartesian(1, constituents, paths, "lon", "lat",
+                               "amplitude", "phase", FES_TIDE, 1),
+            nullptr);
+  EXPECT_NE(fes_last_error(), nullptr);
+
+  EXPECT_EQ(fes_predictor_new(nullptr, 0.0, 1), nullptr);
+  EXPECT_NE(fes_last_error(), nullptr);
+
+  EXPECT_EQ(fes_evaluate(nullptr, 0, nullptr, nullptr, nullptr, nullptr,
+                         nullptr, nullptr),
+            FES_INVALID_ARGUMENT);
+}
@@ -17,7 +17,11 @@ inline auto check_parse(const fes::wave::Table& table) -> void {
 TEST(Constituents, Parse) {
   check_parse(fes::wave::Table());
   EXPECT_THROW(fes::constituents::parse("__x__"), std::invalid_argument);
+  EXPECT_THROW(fes::constituents::parse(""), std::invalid_argument);
+  // Candidates longer than any known name are rejected before the search.
+  EXPECT_THROW(fes::constituents::parse("lambda2x"), std::invalid_argument);
   EXPECT_EQ(fes::constituents::parse("msqm"), fes::kMsqm);
+  EXPECT_EQ(fes::constituents::parse("LAMBDA2"), fes::kLambda2);
 }
 
 TEST(Constituents, ListParseAndGetName) {
@@ -0,0 +1,42 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/constituent_map.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(ConstituentMap, Interface) {
+  auto map = fes::ConstituentMap<int>();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_FALSE(map.contains(fes::kM2));
+  EXPECT_THROW(map.at(fes::kM2), std::out_of_range);
+
+  // Insertion order does not matter: the entries are kept sorted by
+  // identifier, like the std::map this container replaces.
+  map.emplace(fes::kK1, 2);
+  map.emplace(fes::kM2, 3);
+  map.emplace(fes::kMm, 1);
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_TRUE(map.contains(fes::kM2));
+  EXPECT_EQ(map.at(fes::kMm), 1);
+  EXPECT_EQ(map.at(fes::kK1), 2);
+  EXPECT_EQ(map.at(fes::kM2), 3);
+
+  auto idents = std::vector<fes::Constituent>();
+  for (const auto& item : map) {
+    idents.push_back(item.first);
+  }
+  EXPECT_EQ(idents, (std::vector<fes::Constituent>{fes::kMm, fes::kK1,
+                                                   fes::kM2}));
+
+  // Like std::map::emplace, an existing entry is not overwritten.
+  map.emplace(fes::kM2, 4);
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.at(fes::kM2), 3);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(fes::kM2));
+}
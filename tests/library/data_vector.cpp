@@ -0,0 +1,61 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/data_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+TEST(DataVector, Owned) {
+  auto samples = fes::Vector<std::complex<double>>(3);
+  samples << std::complex<double>(1, -1), std::complex<double>(2, -2),
+      std::complex<double>(3, -3);
+  auto data = fes::DataVector<std::complex<double>>(samples);
+  EXPECT_TRUE(data.owns());
+  EXPECT_EQ(data.size(), 3);
+  EXPECT_EQ(data(1), std::complex<double>(2, -2));
+
+  // Copies of an owning vector own their own samples.
+  auto copy = data;
+  EXPECT_TRUE(copy.owns());
+  EXPECT_NE(copy.data(), data.data());
+  EXPECT_EQ(copy(2), data(2));
+
+  // A moved-from vector is left empty.
+  auto moved = std::move(copy);
+  EXPECT_EQ(moved(0), std::complex<double>(1, -1));
+  EXPECT_EQ(copy.size(), 0);  // NOLINT(bugprone-use-after-move)
+  EXPECT_TRUE(copy.owns());
+
+  auto empty = fes::DataVector<std::complex<double>>();
+  EXPECT_TRUE(empty.owns());
+  EXPECT_EQ(empty.size(), 0);
+}
+
+TEST(DataVector, View) {
+  auto buffer = std::make_shared<std::vector<std::complex<double>>>(
+      std::vector<std::complex<double>>{{1, -1}, {2, -2}, {3, -3}});
+  auto data = fes::DataVector<std::complex<double>>(
+      buffer->data(), static_cast<Eigen::Index>(buffer->size()), buffer);
+  EXPECT_FALSE(data.owns());
+  EXPECT_EQ(data.size(), 3);
+  EXPECT_EQ(data.data(), buffer->data());
+  EXPECT_EQ(data(1), std::complex<double>(2, -2));
+  EXPECT_EQ(data.map().sum(), std::complex<double>(6, -6));
+
+  // Copies of a view share the viewed buffer and keep it alive.
+  auto copy = data;
+  EXPECT_FALSE(copy.owns());
+  EXPECT_EQ(copy.data(), data.data());
+  buffer.reset();
+  EXPECT_EQ(copy(2), std::complex<double>(3, -3));
+
+  // Writing always goes through the assignment of a freshly owned vector.
+  copy = fes::Vector<std::complex<double>>();
+  EXPECT_TRUE(copy.owns());
+  EXPECT_EQ(copy.size(), 0);
+}
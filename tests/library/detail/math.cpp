@@ -162,3 +162,26 @@ TEST(Math, DegreesMinutesSecondesToDecialDegrees) {
   // 3600
   EXPECT_DOUBLE_EQ(math::dms_to_degrees<double>(1, 2, 3), 1.0341666666666667);
 }
+
+TEST(Math, FastSincos) {
+  // The polynomial approximation must stay within the 1e-9 relative error
+  // tolerated by the tide products over the range of the summation
+  // arguments.
+  for (auto ix = -1000; ix <= 1000; ++ix) {
+    const auto x = static_cast<double>(ix) * (math::two_pi<double>() / 1000.0);
+    double sin_x;
+    double cos_x;
+    std::tie(sin_x, cos_x) = math::fast_sincos(x);
+    EXPECT_NEAR(sin_x, std::sin(x), 1e-12);
+    EXPECT_NEAR(cos_x, std::cos(x), 1e-12);
+  }
+  // Quadrant boundaries.
+  for (auto ix = -8; ix <= 8; ++ix) {
+    const auto x = static_cast<double>(ix) * math::pi_2<double>();
+    double sin_x;
+    double cos_x;
+    std::tie(sin_x, cos_x) = math::fast_sincos(x);
+    EXPECT_NEAR(sin_x, std::sin(x), 1e-12);
+    EXPECT_NEAR(cos_x, std::cos(x), 1e-12);
+  }
+}
@@ -0,0 +1,240 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/detail/netcdf.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "fes/tidal_model/netcdf.hpp"
+
+namespace {
+
+// Helpers writing the big-endian encoding of the classic format.
+
+auto put_uint32(std::string& buffer, const uint32_t value) -> void {
+  buffer.push_back(static_cast<char>(value >> 24U));
+  buffer.push_back(static_cast<char>(value >> 16U));
+  buffer.push_back(static_cast<char>(value >> 8U));
+  buffer.push_back(static_cast<char>(value));
+}
+
+auto put_int32(std::string& buffer, const int32_t value) -> void {
+  put_uint32(buffer, static_cast<uint32_t>(value));
+}
+
+auto put_short(std::string& buffer, const int16_t value) -> void {
+  buffer.push_back(static_cast<char>(static_cast<uint16_t>(value) >> 8U));
+  buffer.push_back(static_cast<char>(value));
+}
+
+auto put_float(std::string& buffer, const float value) -> void {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  put_uint32(buffer, bits);
+}
+
+auto put_double(std::string& buffer, const double value) -> void {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  put_uint32(buffer, static_cast<uint32_t>(bits >> 32U));
+  put_uint32(buffer, static_cast<uint32_t>(bits));
+}
+
+auto pad4(std::string& buffer) -> void {
+  while ((buffer.size() & 3U) != 0) {
+    buffer.push_back('\0');
+  }
+}
+
+auto put_name(std::string& buffer, const std::string& name) -> void {
+  put_int32(buffer, static_cast<int32_t>(name.size()));
+  buffer.append(name);
+  pad4(buffer);
+}
+
+/// Build the header of the test file: a 2 x 3 (lat x lon) grid with the
+/// amplitudes packed as scaled shorts and the phases stored as floats in
+/// degrees.
+auto build_header(const std::array<int32_t, 4>& begins) -> std::string {
+  auto buffer = std::string("CDF\x01", 4);
+  put_int32(buffer, 0);  // numrecs
+  // Dimensions: lat(2), lon(3).
+  put_int32(buffer, 0x0A);
+  put_int32(buffer, 2);
+  put_name(buffer, "lat");
+  put_int32(buffer, 2);
+  put_name(buffer, "lon");
+  put_int32(buffer, 3);
+  // No global attribute.
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  // Variables.
+  put_int32(buffer, 0x0B);
+  put_int32(buffer, 4);
+  // lon(lon): double.
+  put_name(buffer, "lon");
+  put_int32(buffer, 1);
+  put_int32(buffer, 1);
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  put_int32(buffer, fes::detail::netcdf::kDouble);
+  put_int32(buffer, 24);
+  put_int32(buffer, begins[0]);
+  // lat(lat): double.
+  put_name(buffer, "lat");
+  put_int32(buffer, 1);
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  put_int32(buffer, 0);
+  put_int32(buffer, fes::detail::netcdf::kDouble);
+  put_int32(buffer, 16);
+  put_int32(buffer, begins[1]);
+  // amplitude(lat, lon): short, scaled by 0.1 and filled with 32767.
+  put_name(buffer, "amplitude");
+  put_int32(buffer, 2);
+  put_int32(buffer, 0);
+  put_int32(buffer, 1);
+  put_int32(buffer, 0x0C);
+  put_int32(buffer, 2);
+  put_name(buffer, "scale_factor");
+  put_int32(buffer, fes::detail::netcdf::kDouble);
+  put_int32(buffer, 1);
+  put_double(buffer, 0.1);
+  put_name(buffer, "_FillValue");
+  put_int32(buffer, fes::detail::netcdf::kShort);
+  put_int32(buffer, 1);
+  put_short(buffer, 32767);
+  pad4(buffer);
+  put_int32(buffer, fes::detail::netcdf::kShort);
+  put_int32(buffer, 12);
+  put_int32(buffer, begins[2]);
+  // phase(lat, lon): float, in degrees.
+  put_name(buffer, "phase");
+  put_int32(buffer, 2);
+  put_int32(buffer, 0);
+  put_int32(buffer, 1);
+  put_int32(buffer, 0x0C);
+  put_int32(buffer, 1);
+  put_name(buffer, "units");
+  put_int32(buffer, fes::detail::netcdf::kChar);
+  put_int32(buffer, 7);
+  buffer.append("degrees");
+  pad4(buffer);
+  put_int32(buffer, fes::detail::netcdf::kFloat);
+  put_int32(buffer, 24);
+  put_int32(buffer, begins[3]);
+  return buffer;
+}
+
+/// Write a constituent file holding the given packed amplitudes and phases.
+auto write_constituent_file(const std::string& path,
+                            const std::array<int16_t, 6>& amplitudes,
+                            const std::array<float, 6>& phases) -> void {
+  // The variable offsets depend on the header size, which does not depend
+  // on them: measure with placeholders, then rebuild.
+  auto header = static_cast<int32_t>(build_header({0, 0, 0, 0}).size());
+  auto buffer = build_header(
+      {header, header + 24, header + 40, header + 52});
+  for (auto value : {0.0, 1.0, 2.0}) {
+    put_double(buffer, value);
+  }
+  for (auto value : {0.0, 10.0}) {
+    put_double(buffer, value);
+  }
+  for (auto value : amplitudes) {
+    put_short(buffer, value);
+  }
+  for (auto value : phases) {
+    put_float(buffer, value);
+  }
+  auto stream = std::ofstream(path, std::ios::binary);
+  stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+}  // namespace
+
+TEST(NetCDF, Reader) {
+  const auto path = testing::TempDir() + "constituent.nc";
+  write_constituent_file(path, {10, 20, 32767, 30, 40, 50},
+                         {0.F, 30.F, 60.F, 90.F, 120.F, 150.F});
+
+  auto file = fes::detail::netcdf::File(path);
+  ASSERT_EQ(file.dimensions().size(), 2);
+  EXPECT_EQ(file.dimensions()[0].name, "lat");
+  EXPECT_EQ(file.dimensions()[0].size, 2);
+  EXPECT_EQ(file.dimensions()[1].name, "lon");
+  EXPECT_EQ(file.dimensions()[1].size, 3);
+  ASSERT_EQ(file.variables().size(), 4);
+  EXPECT_TRUE(file.has_variable("amplitude"));
+  EXPECT_FALSE(file.has_variable("missing"));
+  EXPECT_THROW(file.variable("missing"), std::invalid_argument);
+
+  auto lon = file.values(file.variable("lon"));
+  ASSERT_EQ(lon.size(), 3);
+  EXPECT_EQ(lon(2), 2.0);
+
+  // The scale factor is applied and the fill value becomes NaN.
+  const auto& amplitude = file.variable("amplitude");
+  EXPECT_EQ(amplitude.type, fes::detail::netcdf::kShort);
+  ASSERT_NE(amplitude.attribute("scale_factor"), nullptr);
+  EXPECT_EQ(amplitude.attribute("scale_factor")->values.front(), 0.1);
+  EXPECT_EQ(amplitude.attribute("unknown"), nullptr);
+  auto values = file.values(amplitude);
+  ASSERT_EQ(values.size(), 6);
+  EXPECT_NEAR(values(1), 2.0, 1e-12);
+  EXPECT_TRUE(std::isnan(values(2)));
+  EXPECT_NEAR(values(5), 5.0, 1e-12);
+
+  // The phases are stored as is: the loader handles the unit conversion.
+  const auto& phase = file.variable("phase");
+  ASSERT_NE(phase.attribute("units"), nullptr);
+  EXPECT_EQ(phase.attribute("units")->text, "degrees");
+  EXPECT_EQ(file.values(phase)(3), 90.0);
+
+  // Files not in the classic format are rejected.
+  const auto garbage = testing::TempDir() + "garbage.nc";
+  auto stream = std::ofstream(garbage, std::ios::binary);
+  stream << "\x89HDF not a classic file";
+  stream.close();
+  EXPECT_THROW(auto rejected = fes::detail::netcdf::File(garbage),
+               std::invalid_argument);
+}
+
+TEST(NetCDF, LoadCartesian) {
+  const auto m2 = testing::TempDir() + "m2.nc";
+  const auto k2 = testing::TempDir() + "k2.nc";
+  write_constituent_file(m2, {10, 20, 32767, 30, 40, 50},
+                         {0.F, 30.F, 60.F, 90.F, 120.F, 150.F});
+  write_constituent_file(k2, {60, 50, 40, 30, 20, 10},
+                         {180.F, 150.F, 120.F, 90.F, 60.F, 30.F});
+
+  auto model = fes::tidal_model::load_cartesian<double>(
+      {{fes::kM2, m2}, {fes::kK2, k2}}, "lon", "lat", "amplitude", "phase");
+  EXPECT_EQ(model.lon().size(), 3);
+  EXPECT_EQ(model.lat().size(), 2);
+  ASSERT_EQ(model.size(), 2);
+
+  // The phases, in degrees, are combined with the amplitudes into complex
+  // samples.
+  const auto& wave = model.data().at(fes::kM2);
+  ASSERT_EQ(wave.size(), 6);
+  EXPECT_NEAR(wave(0).real(), 1.0, 1e-6);
+  EXPECT_NEAR(wave(0).imag(), 0.0, 1e-6);
+  EXPECT_NEAR(wave(1).real(), 2.0 * std::cos(M_PI / 6.0), 1e-6);
+  EXPECT_NEAR(wave(1).imag(), 2.0 * std::sin(M_PI / 6.0), 1e-6);
+  // The fill value propagates as NaN.
+  EXPECT_TRUE(std::isnan(wave(2).real()));
+  EXPECT_NEAR(model.data().at(fes::kK2)(0).real(), -6.0, 1e-6);
+
+  EXPECT_THROW(fes::tidal_model::load_cartesian<double>(
+                   {}, "lon", "lat", "amplitude", "phase"),
+               std::invalid_argument);
+}
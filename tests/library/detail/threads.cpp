@@ -4,7 +4,12 @@
 // BSD-style license that can be found in the LICENSE file.
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "fes/detail/thread.hpp"
+#include "fes/detail/thread_pool.hpp"
 
 TEST(Thread, ParallelFor) {
   auto data = std::vector<size_t>(100);
@@ -19,6 +24,111 @@ TEST(Thread, ParallelFor) {
   }
 }
 
+TEST(Thread, ParallelForDynamic) {
+  auto data = std::vector<size_t>(100);
+  auto callable = [&data](const size_t start, const size_t end) {
+    for (auto i = start; i < end; ++i) {
+      data[i] = i;
+    }
+  };
+  // Workers claim chunks of 7 indexes from a shared counter: every index
+  // must still be visited exactly once.
+  fes::detail::parallel_for(callable, 100, 15, 7);
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(data[i], i);
+  }
+}
+
+TEST(Thread, ParallelForNested) {
+  std::atomic<size_t> sum(0);
+  auto callable = [&sum](const size_t start, const size_t end) {
+    // A parallel section reached from a pool worker submits its own chunks
+    // to the shared pool and helps executing queued tasks while it waits,
+    // instead of deadlocking on the pool.
+    auto inner = [&sum](const size_t inner_start, const size_t inner_end) {
+      sum += inner_end - inner_start;
+    };
+    fes::detail::parallel_for(inner, end - start, 4);
+  };
+  fes::detail::parallel_for(callable, 100, 15);
+  EXPECT_EQ(sum, 100);
+}
+
+TEST(Thread, ParallelForConcurrentCalls) {
+  // Several top-level calls running concurrently (one per caller thread)
+  // share the pool instead of oversubscribing the machine.
+  std::atomic<size_t> sum(0);
+  auto callable = [&sum](const size_t start, const size_t end) {
+    sum += end - start;
+  };
+  auto caller = [&callable]() {
+    for (auto run = 0; run < 5; ++run) {
+      fes::detail::parallel_for(callable, 100, 8);
+    }
+  };
+  auto threads = std::vector<std::thread>();
+  for (auto ix = 0; ix < 4; ++ix) {
+    threads.emplace_back(caller);
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(sum, 4 * 5 * 100);
+}
+
+TEST(Thread, ThreadPoolReuse) {
+  // The same process-wide pool serves consecutive calls.
+  auto& pool = fes::detail::ThreadPool::instance();
+  EXPECT_EQ(&pool, &fes::detail::ThreadPool::instance());
+  EXPECT_GE(pool.size(), 1);
+  std::atomic<size_t> sum(0);
+  auto callable = [&sum](const size_t start, const size_t end) {
+    sum += end - start;
+  };
+  for (auto run = 0; run < 10; ++run) {
+    fes::detail::parallel_for(callable, 100, 8);
+  }
+  EXPECT_EQ(sum, 1000);
+}
+
+TEST(Thread, ParallelForPinned) {
+  // Pinning only constrains where the workers run, not the result. The call
+  // is idempotent, so requesting it twice is harmless.
+  auto data = std::vector<size_t>(100);
+  auto callable = [&data](const size_t start, const size_t end) {
+    for (auto i = start; i < end; ++i) {
+      data[i] = i;
+    }
+  };
+  fes::detail::parallel_for(callable, 100, 15, 0, true);
+  fes::detail::parallel_for(callable, 100, 15, 7, true);
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(data[i], i);
+  }
+}
+
+TEST(Thread, ParallelForAdaptive) {
+  auto data = std::vector<size_t>(100000);
+  auto callable = [&data](const size_t start, const size_t end) {
+    for (auto i = start; i < end; ++i) {
+      data[i] = i;
+    }
+  };
+  // Adaptive scheduling only changes the chunk granularity over time: every
+  // index must still be visited exactly once.
+  fes::reset_perf_counters();
+  fes::detail::parallel_for(callable, data.size(), 8,
+                            fes::kAdaptiveChunkSize);
+  for (size_t i = 0; i < data.size(); ++i) {
+    EXPECT_EQ(data[i], i);
+  }
+  // The parameters the scheduler settled on are published, so they can be
+  // pinned as a regular chunk size.
+  const auto counters = fes::perf_counters();
+  EXPECT_GE(counters.adaptive_chunks, 1);
+  EXPECT_GE(counters.adaptive_chunk_size, fes::detail::kAdaptiveMinChunkSize);
+}
+
 TEST(Thread, ParallelForCatchException) {
   auto data = std::vector<size_t>(100);
   auto callable = [&data](const size_t start, const size_t end) {
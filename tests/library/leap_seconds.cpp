@@ -0,0 +1,35 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/leap_seconds.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(LeapSeconds, Scalar) {
+  // Before 1972-01-01 the table clamps to its first entry.
+  EXPECT_EQ(fes::leap_seconds(0.0), 10);
+  // 1972-01-01T00:00:00Z, first entry of the table.
+  EXPECT_EQ(fes::leap_seconds(63072000.0), 10);
+  // One second before the 1972-07-01 step.
+  EXPECT_EQ(fes::leap_seconds(78796799.0), 10);
+  // 1972-07-01T00:00:00Z.
+  EXPECT_EQ(fes::leap_seconds(78796800.0), 11);
+  // 2000-01-01T00:00:00Z.
+  EXPECT_EQ(fes::leap_seconds(946684800.0), 32);
+  // 2017-01-01T00:00:00Z, last entry of the table.
+  EXPECT_EQ(fes::leap_seconds(1483228800.0), 37);
+  // No leap second has been announced since.
+  EXPECT_EQ(fes::leap_seconds(1893456000.0), 37);
+}
+
+TEST(LeapSeconds, Vector) {
+  auto epoch = Eigen::VectorXd(4);
+  epoch << 0.0, 78796800.0, 946684800.0, 1893456000.0;
+  auto result = fes::leap_seconds(epoch);
+  ASSERT_EQ(result.size(), 4);
+  EXPECT_EQ(result(0), 10);
+  EXPECT_EQ(result(1), 11);
+  EXPECT_EQ(result(2), 32);
+  EXPECT_EQ(result(3), 37);
+}
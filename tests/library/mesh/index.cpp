@@ -6,6 +6,9 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+#include <vector>
+
 namespace mesh = fes::mesh;
 
 static auto make_data()
@@ -96,6 +99,14 @@ TEST(Index, Serialize) {
   auto other =
       mesh::Index::setstate(fes::string_view(state.data(), state.size()));
 
+  // The stream variants produce and parse the same bytes.
+  auto ss = std::stringstream();
+  index.getstate(ss);
+  EXPECT_EQ(ss.str(), state);
+  EXPECT_EQ(state.size(), index.state_size());
+  auto from_stream = mesh::Index::setstate(ss);
+  EXPECT_EQ(from_stream.getstate(), state);
+
   EXPECT_THROW(mesh::Index::setstate("invalid"), std::invalid_argument);
 
   auto query =
@@ -106,4 +117,186 @@ TEST(Index, Serialize) {
   query = index.search({-0.4057, 0.0717}, 50'000);
   EXPECT_TRUE(query.inside);
   EXPECT_EQ(query.index, 10);
+
+  // The tree bulk-loaded from the stored leaf coordinates answers queries
+  // like the original one.
+  query = other.search({-0.16067459068705148, 0.09857747238454806}, 50'000);
+  EXPECT_TRUE(query.inside);
+  EXPECT_EQ(query.index, 5);
+}
+
+TEST(Index, OutsideDomain) {
+  auto lon = Eigen::VectorXd();
+  auto lat = Eigen::VectorXd();
+  auto triangles = Eigen::Matrix<int, -1, 3>();
+  std::tie(lon, lat, triangles) = make_data();
+
+  for (auto backend : {mesh::Index::kRTree, mesh::Index::kUniformGrid}) {
+    auto index = mesh::Index(lon, lat, triangles, backend);
+
+    // Queries far from the mesh are rejected by the distance-to-mesh field,
+    // whatever the extrapolation distance.
+    for (auto point : {fes::geometry::Point{1, 1},
+                       fes::geometry::Point{90, 45},
+                       fes::geometry::Point{-120, -60}}) {
+      auto query = index.search(point, 0);
+      EXPECT_FALSE(query.inside);
+      EXPECT_EQ(query.index, -1);
+      query = index.search(point, 50'000);
+      EXPECT_FALSE(query.inside);
+      EXPECT_EQ(query.index, -1);
+    }
+
+    // A point far outside the raster is classified from its clamped edge
+    // cell: still hopeless, even with a generous extrapolation distance.
+    auto far_query = index.search({120, 0}, 500'000);
+    EXPECT_FALSE(far_query.inside);
+    EXPECT_EQ(far_query.index, -1);
+
+    // Queries inside the mesh or close to it are unaffected.
+    auto query =
+        index.search({-0.16067459068705148, 0.09857747238454806}, 0);
+    EXPECT_TRUE(query.inside);
+    EXPECT_EQ(query.index, 5);
+    query = index.search({0.5741, -0.1029}, 50'000);
+    EXPECT_FALSE(query.inside);
+    EXPECT_EQ(query.index, 19);
+  }
+}
+
+TEST(Index, BarycentricCache) {
+  auto lon = Eigen::VectorXd();
+  auto lat = Eigen::VectorXd();
+  auto triangles = Eigen::Matrix<int, -1, 3>();
+  std::tie(lon, lat, triangles) = make_data();
+
+  auto index = mesh::Index(lon, lat, triangles);
+
+  auto points = std::vector<fes::geometry::Point>{
+      {-0.16067459068705148, 0.09857747238454806},
+      {-0.4057, 0.0717},
+      {0.2562, 0.0101},
+      {0.5741, -0.1029},
+      {1, 1},
+  };
+  for (int32_t ix = 0; ix < triangles.rows(); ++ix) {
+    const Eigen::Vector3i& vertices = triangles.row(ix);
+    auto triangle = fes::geometry::Triangle(
+        {lon(vertices(0)), lat(vertices(0))},
+        {lon(vertices(1)), lat(vertices(1))},
+        {lon(vertices(2)), lat(vertices(2))});
+    for (const auto& point : points) {
+      // The cached transform agrees with the geometric predicate.
+      EXPECT_EQ(index.contains(ix, point), triangle.covered_by(point));
+      if (index.contains(ix, point)) {
+        auto expected = triangle.reference_right_angled(point);
+        auto cached = index.reference_right_angled(ix, point);
+        EXPECT_NEAR(std::get<0>(cached), std::get<0>(expected), 1e-12);
+        EXPECT_NEAR(std::get<1>(cached), std::get<1>(expected), 1e-12);
+      }
+    }
+  }
+}
+
+TEST(Index, SearchFrom) {
+  auto lon = Eigen::VectorXd();
+  auto lat = Eigen::VectorXd();
+  auto triangles = Eigen::Matrix<int, -1, 3>();
+  std::tie(lon, lat, triangles) = make_data();
+
+  auto index = mesh::Index(lon, lat, triangles);
+
+  // The walk from the hinted triangle crosses the mesh to the containing
+  // triangle.
+  auto point = fes::geometry::Point(-0.16067459068705148, 0.09857747238454806);
+  for (auto hint : {int32_t(5), int32_t(0), int32_t(19), int32_t(-1)}) {
+    auto query = index.search_from(point, hint, 50'000);
+    EXPECT_TRUE(query.inside);
+    EXPECT_EQ(query.index, 5);
+  }
+
+  // A point outside the mesh exits the walk and falls back to the full
+  // search: extrapolation still works.
+  auto query = index.search_from({0.5741, -0.1029}, 3, 50'000);
+  EXPECT_FALSE(query.inside);
+  EXPECT_EQ(query.index, 19);
+
+  // A point too far away is not found, whatever the hint.
+  query = index.search_from({1, 1}, 3, 50'000);
+  EXPECT_FALSE(query.inside);
+  EXPECT_EQ(query.index, -1);
+}
+
+TEST(Index, SearchMany) {
+  auto lon = Eigen::VectorXd();
+  auto lat = Eigen::VectorXd();
+  auto triangles = Eigen::Matrix<int, -1, 3>();
+  std::tie(lon, lat, triangles) = make_data();
+
+  auto index = mesh::Index(lon, lat, triangles);
+
+  // Shuffled queries: inside the mesh, outside but near it, and too far.
+  auto points = std::vector<fes::geometry::Point>{
+      {0.2562, 0.0101},
+      {1, 1},
+      {-0.16067459068705148, 0.09857747238454806},
+      {0.5741, -0.1029},
+      {-0.4057, 0.0717},
+      {-0.1606, 0.0985},
+  };
+  auto results = index.search_many(points, 50'000);
+  ASSERT_EQ(results.size(), points.size());
+
+  // The batch answers, scheduled along the space-filling curve, match the
+  // one-by-one answers in the original order.
+  for (size_t ix = 0; ix < points.size(); ++ix) {
+    auto expected = index.search(points[ix], 50'000);
+    EXPECT_EQ(results[ix].inside, expected.inside);
+    EXPECT_EQ(results[ix].index, expected.index);
+  }
+  EXPECT_EQ(results[2].index, 5);
+  EXPECT_EQ(results[1].index, -1);
+}
+
+TEST(Index, UniformGrid) {
+  auto lon = Eigen::VectorXd();
+  auto lat = Eigen::VectorXd();
+  auto triangles = Eigen::Matrix<int, -1, 3>();
+  std::tie(lon, lat, triangles) = make_data();
+
+  auto index =
+      mesh::Index(lon, lat, triangles, mesh::Index::kUniformGrid);
+  EXPECT_EQ(index.backend(), mesh::Index::kUniformGrid);
+
+  // The cell grid answers the same queries as the R*Tree.
+  auto query =
+      index.search({-0.16067459068705148, 0.09857747238454806}, 50'000);
+  EXPECT_TRUE(query.inside);
+  EXPECT_EQ(query.index, 5);
+
+  query = index.search({-0.4057, 0.0717}, 50'000);
+  EXPECT_TRUE(query.inside);
+  EXPECT_EQ(query.index, 10);
+
+  // This point is outside the convex hull of the mesh, but near enough to
+  // the mesh that it should be found.
+  query = index.search({0.5741, -0.1029}, 50'000);
+  EXPECT_FALSE(query.inside);
+  EXPECT_EQ(query.index, 19);
+
+  // This point is outside the convex hull of the mesh, and too far away to
+  // be found.
+  query = index.search({1, 1}, 50'000);
+  EXPECT_FALSE(query.inside);
+  EXPECT_EQ(query.index, -1);
+
+  // The backend is preserved across serialization.
+  auto state = index.getstate();
+  EXPECT_EQ(state.size(), index.state_size());
+  auto other =
+      mesh::Index::setstate(fes::string_view(state.data(), state.size()));
+  EXPECT_EQ(other.backend(), mesh::Index::kUniformGrid);
+  query = other.search({-0.16067459068705148, 0.09857747238454806}, 50'000);
+  EXPECT_TRUE(query.inside);
+  EXPECT_EQ(query.index, 5);
 }
@@ -0,0 +1,100 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/perf_counters.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "fes/tidal_model/cartesian.hpp"
+#include "fes/tide.hpp"
+
+namespace {
+
+/// Build a small Cartesian model defined on a 5x5 grid.
+auto make_model() -> std::unique_ptr<fes::tidal_model::Cartesian<double>> {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto model = std::unique_ptr<fes::tidal_model::Cartesian<double>>(
+      new fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide));
+  model->add_constituent(
+      fes::kM2, Eigen::VectorXcd::Constant(25, std::complex<double>(10, 5)));
+  model->add_constituent(
+      fes::kK1, Eigen::VectorXcd::Constant(25, std::complex<double>(4, -2)));
+  return model;
+}
+
+}  // namespace
+
+TEST(PerfCounters, FixedPosition) {
+  auto model = make_model();
+  constexpr auto n = 24;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  fes::reset_perf_counters();
+  fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat,
+                     fes::Settings(), 1);
+  auto counters = fes::perf_counters();
+
+  // The tolerance is zero: the angle is recomputed at every epoch.
+  EXPECT_EQ(counters.angle_recomputes, n);
+  EXPECT_EQ(counters.angle_cache_hits, 0);
+  // The position repeats: only the first query searches the axes.
+  EXPECT_EQ(counters.interpolation_cache_misses, 1);
+  EXPECT_EQ(counters.searches, 1);
+  EXPECT_EQ(counters.interpolation_cache_hits, n - 1);
+  EXPECT_EQ(counters.extrapolations, 0);
+  EXPECT_EQ(counters.undefined, 0);
+}
+
+TEST(PerfCounters, TimeTolerance) {
+  auto model = make_model();
+  constexpr auto n = 24;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  fes::reset_perf_counters();
+  // The angles stay valid for the whole day: one recompute, the rest served
+  // by the cache.
+  auto settings =
+      fes::Settings(fes::angle::Formulae::kSchuremanOrder1, 86400.0);
+  fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat, settings, 1);
+  auto counters = fes::perf_counters();
+
+  EXPECT_EQ(counters.angle_recomputes, 1);
+  EXPECT_EQ(counters.angle_cache_hits, n - 1);
+}
+
+TEST(PerfCounters, Undefined) {
+  auto model = make_model();
+
+  auto epoch = Eigen::VectorXd::Constant(1, 1577836800.0);
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(1, 27);
+  // The query point lies outside the 5x5 grid.
+  auto lon = Eigen::VectorXd::Constant(1, 30.0);
+  auto lat = Eigen::VectorXd::Constant(1, 2.0);
+
+  fes::reset_perf_counters();
+  fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat,
+                     fes::Settings(), 1);
+  auto counters = fes::perf_counters();
+
+  EXPECT_EQ(counters.undefined, 1);
+  EXPECT_EQ(counters.interpolation_cache_hits, 0);
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/pipeline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "fes/tidal_model/cartesian.hpp"
+#include "fes/tide.hpp"
+
+namespace {
+
+/// Build a small Cartesian model defined on a 5x5 grid.
+auto make_model() -> std::shared_ptr<fes::tidal_model::Cartesian<double>> {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto model = std::make_shared<fes::tidal_model::Cartesian<double>>(
+      axis, axis, fes::kTide);
+  model->add_constituent(
+      fes::kM2, Eigen::VectorXcd::Constant(25, std::complex<double>(10, 5)));
+  model->add_constituent(
+      fes::kK1, Eigen::VectorXcd::Constant(25, std::complex<double>(4, -2)));
+  model->add_constituent(
+      fes::kO1, Eigen::VectorXcd::Constant(25, std::complex<double>(1, 3)));
+  return model;
+}
+
+}  // namespace
+
+TEST(TidePipeline, Run) {
+  auto model = make_model();
+  constexpr auto n = 100;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    // Hourly epochs starting on 2020-01-01T00:00:00Z.
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // Stream the same dataset through the pipeline with a chunk size that does
+  // not divide the dataset size.
+  auto pipeline = fes::TidePipeline<double>(model, fes::Settings(), 7);
+  auto read = Eigen::Index(0);
+  auto streamed_tide = Eigen::VectorXd(n);
+  auto streamed_long_period = Eigen::VectorXd(n);
+  auto streamed_quality = fes::Vector<fes::Quality>(n);
+  auto written = Eigen::Index(0);
+
+  pipeline.run(
+      [&](fes::TidePipeline<double>::Chunk& chunk) -> Eigen::Index {
+        auto count = std::min(chunk.capacity(), n - read);
+        chunk.epoch.head(count) = epoch.segment(read, count);
+        chunk.leap_seconds.head(count) = leap_seconds.segment(read, count);
+        chunk.longitude.head(count) = lon.segment(read, count);
+        chunk.latitude.head(count) = lat.segment(read, count);
+        read += count;
+        return count;
+      },
+      [&](const fes::TidePipeline<double>::Chunk& chunk) {
+        streamed_tide.segment(written, chunk.size) =
+            chunk.tide.head(chunk.size);
+        streamed_long_period.segment(written, chunk.size) =
+            chunk.long_period.head(chunk.size);
+        streamed_quality.segment(written, chunk.size) =
+            chunk.quality.head(chunk.size);
+        written += chunk.size;
+      });
+
+  ASSERT_EQ(read, n);
+  ASSERT_EQ(written, n);
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), streamed_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), streamed_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), streamed_quality(ix));
+  }
+}
+
+TEST(TidePipeline, EmptyStream) {
+  auto model = make_model();
+  auto pipeline = fes::TidePipeline<double>(model);
+  auto consumed = false;
+
+  pipeline.run(
+      [](fes::TidePipeline<double>::Chunk& /*chunk*/) -> Eigen::Index {
+        return 0;
+      },
+      [&](const fes::TidePipeline<double>::Chunk& /*chunk*/) {
+        consumed = true;
+      });
+  EXPECT_FALSE(consumed);
+}
+
+TEST(TidePipeline, InvalidArguments) {
+  auto model = make_model();
+  EXPECT_THROW(fes::TidePipeline<double>(model, fes::Settings(), 0),
+               std::invalid_argument);
+
+  auto pipeline = fes::TidePipeline<double>(model);
+  EXPECT_THROW(
+      pipeline.run(
+          [](fes::TidePipeline<double>::Chunk& chunk) -> Eigen::Index {
+            return chunk.capacity() + 1;
+          },
+          [](const fes::TidePipeline<double>::Chunk& /*chunk*/) {}),
+      std::invalid_argument);
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/predictor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "fes/tidal_model/cartesian.hpp"
+
+namespace {
+
+/// Build a small Cartesian model defined on a 5x5 grid.
+auto make_model() -> std::shared_ptr<fes::tidal_model::Cartesian<double>> {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto model = std::make_shared<fes::tidal_model::Cartesian<double>>(
+      axis, axis, fes::kTide);
+  model->add_constituent(
+      fes::kM2, Eigen::VectorXcd::Constant(25, std::complex<double>(10, 5)));
+  model->add_constituent(
+      fes::kK1, Eigen::VectorXcd::Constant(25, std::complex<double>(4, -2)));
+  model->add_constituent(
+      fes::kO1, Eigen::VectorXcd::Constant(25, std::complex<double>(1, 3)));
+  return model;
+}
+
+}  // namespace
+
+TEST(Predictor, Predict) {
+  auto model = make_model();
+  auto predictor = fes::Predictor<double>(model);
+  constexpr auto n = 24;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    // Hourly epochs starting on 2020-01-01T00:00:00Z.
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // The warm caches must not change the results, even across repeated calls
+  // of the same session.
+  for (auto call = 0; call < 3; ++call) {
+    Eigen::VectorXd session_tide;
+    Eigen::VectorXd session_long_period;
+    fes::Vector<fes::Quality> session_quality;
+    std::tie(session_tide, session_long_period, session_quality) =
+        predictor.predict(epoch, leap_seconds, lon, lat);
+
+    for (auto ix = 0; ix < n; ++ix) {
+      EXPECT_NEAR(tide(ix), session_tide(ix), 1e-12);
+      EXPECT_NEAR(long_period(ix), session_long_period(ix), 1e-12);
+      EXPECT_EQ(quality(ix), session_quality(ix));
+    }
+  }
+}
+
+TEST(Predictor, Broadcast) {
+  auto model = make_model();
+  auto predictor = fes::Predictor<double>(model);
+  constexpr auto n = 8;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) = predictor.predict(
+      epoch, fes::Vector<uint16_t>::Constant(1, 27),
+      Eigen::VectorXd::Constant(1, 2.0), Eigen::VectorXd::Constant(1, 2.0));
+  ASSERT_EQ(tide.size(), n);
+
+  // In-place variant reusing preallocated buffers.
+  auto buffer_tide = Eigen::VectorXd(n);
+  auto buffer_long_period = Eigen::VectorXd(n);
+  auto buffer_quality = fes::Vector<fes::Quality>(n);
+  predictor.predict(epoch, fes::Vector<uint16_t>::Constant(1, 27),
+                    Eigen::VectorXd::Constant(1, 2.0),
+                    Eigen::VectorXd::Constant(1, 2.0), buffer_tide,
+                    buffer_long_period, buffer_quality);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), buffer_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), buffer_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), buffer_quality(ix));
+  }
+}
+
+TEST(Predictor, NullModel) {
+  EXPECT_THROW(fes::Predictor<double>(nullptr), std::invalid_argument);
+}
+
+TEST(Predictor, DynamicScheduling) {
+  auto model = make_model();
+  // Many more chunks than cached slots: every invocation of the worker must
+  // borrow a slot instead of indexing them by invocation.
+  constexpr auto n = 4096;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  auto reference = fes::Predictor<double>(model);
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      reference.predict(epoch, leap_seconds, lon, lat);
+
+  // Dynamic scheduling only changes how indexes are distributed over the
+  // workers, not the result.
+  auto chunked = fes::Predictor<double>(
+      model, fes::Settings(fes::angle::Formulae::kSchuremanOrder1, 0.0, {},
+                           16));
+  auto adaptive = fes::Predictor<double>(
+      model, fes::Settings(fes::angle::Formulae::kSchuremanOrder1, 0.0, {},
+                           fes::kAdaptiveChunkSize));
+  for (auto* predictor : {&chunked, &adaptive}) {
+    Eigen::VectorXd session_tide;
+    Eigen::VectorXd session_long_period;
+    fes::Vector<fes::Quality> session_quality;
+    std::tie(session_tide, session_long_period, session_quality) =
+        predictor->predict(epoch, leap_seconds, lon, lat);
+
+    for (auto ix = 0; ix < n; ++ix) {
+      EXPECT_NEAR(tide(ix), session_tide(ix), 1e-12);
+      EXPECT_NEAR(long_period(ix), session_long_period(ix), 1e-12);
+      EXPECT_EQ(quality(ix), session_quality(ix));
+    }
+  }
+}
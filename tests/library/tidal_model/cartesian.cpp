@@ -6,6 +6,10 @@
 
 #include <gtest/gtest.h>
 
+#include <complex>
+#include <memory>
+#include <vector>
+
 TEST(TidalModelCartesian, Constructor) {
   auto points = Eigen::VectorXd(5);
   points << 0, 1, 2, 3, 4;
@@ -59,3 +63,370 @@ TEST(TidalModelCartesian, GetSetState) {
   EXPECT_EQ(model_data.at(fes::kM2)(4), other_data.at(fes::kM2)(4));
   EXPECT_EQ(model_data.at(fes::kK2)(4), other_data.at(fes::kK2)(4));
 }
+
+TEST(TidalModelCartesian, Interleave) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto m2 = Eigen::VectorXcd(25);
+  auto k2 = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    m2(ix) = std::complex<double>(ix, -ix);
+    k2(ix) = std::complex<double>(2.0 * ix, 0.5 * ix);
+  }
+  // An undefined cell exercises the extrapolation counting.
+  m2(12) = std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::quiet_NaN());
+
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, m2);
+  model.add_constituent(fes::kK2, k2);
+  EXPECT_FALSE(model.interleaved());
+
+  const auto queries = std::vector<fes::geometry::Point>{
+      {0.5, 0.5}, {1.9, 2.1}, {3.5, 3.5}, {10.0, 10.0}};
+
+  // The interleaved layout only changes where the corner cells are read,
+  // not the interpolation itself.
+  for (const auto& point : queries) {
+    auto scattered_quality = fes::Quality();
+    auto interleaved_quality = fes::Quality();
+    auto scattered_acc = std::unique_ptr<fes::Accelerator>(
+        model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+    auto scattered =
+        model.interpolate(point, scattered_quality, scattered_acc.get());
+
+    model.interleave();
+    EXPECT_TRUE(model.interleaved());
+    auto interleaved_acc = std::unique_ptr<fes::Accelerator>(
+        model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+    auto interleaved =
+        model.interpolate(point, interleaved_quality, interleaved_acc.get());
+
+    EXPECT_EQ(scattered_quality, interleaved_quality);
+    ASSERT_EQ(scattered.size(), interleaved.size());
+    for (size_t ix = 0; ix < scattered.size(); ++ix) {
+      EXPECT_EQ(scattered[ix].first, interleaved[ix].first);
+      if (std::isnan(scattered[ix].second.real())) {
+        EXPECT_TRUE(std::isnan(interleaved[ix].second.real()));
+        continue;
+      }
+      EXPECT_EQ(scattered[ix].second, interleaved[ix].second);
+    }
+
+    // Adding a constituent invalidates the packed buffer.
+    model.add_constituent(fes::kO1, k2);
+    EXPECT_FALSE(model.interleaved());
+    auto restored = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+    restored.add_constituent(fes::kM2, m2);
+    restored.add_constituent(fes::kK2, k2);
+    model = std::move(restored);
+  }
+}
+
+TEST(TidalModelCartesian, Quantize) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto m2 = Eigen::VectorXcd(25);
+  auto k2 = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    m2(ix) = std::complex<double>(ix, -ix);
+    k2(ix) = std::complex<double>(2.0 * ix, 0.5 * ix);
+  }
+  m2(12) = std::complex<double>(std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::quiet_NaN());
+
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, m2);
+  model.add_constituent(fes::kK2, k2);
+  EXPECT_FALSE(model.quantized());
+
+  auto reference = model;
+  model.quantize();
+  EXPECT_TRUE(model.quantized());
+  // The floating-point storage is released; the constituent set is kept.
+  EXPECT_EQ(model.data().at(fes::kM2).size(), 0);
+  EXPECT_EQ(model.size(), 2);
+
+  // The quantization error per component is bounded by half the scale
+  // factor, i.e. the largest magnitude of the constituent over 65534.
+  const auto tolerance = 1e-2;
+  auto quality = fes::Quality();
+  auto expected_quality = fes::Quality();
+  for (const auto& point : std::vector<fes::geometry::Point>{
+           {0.5, 0.5}, {1.9, 2.1}, {3.5, 3.5}, {10.0, 10.0}}) {
+    auto acc = std::unique_ptr<fes::Accelerator>(
+        model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+    auto reference_acc = std::unique_ptr<fes::Accelerator>(
+        reference.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+    auto expected = reference.interpolate(point, expected_quality,
+                                          reference_acc.get());
+    auto actual = model.interpolate(point, quality, acc.get());
+    EXPECT_EQ(quality, expected_quality);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t ix = 0; ix < expected.size(); ++ix) {
+      EXPECT_EQ(expected[ix].first, actual[ix].first);
+      if (std::isnan(expected[ix].second.real())) {
+        EXPECT_TRUE(std::isnan(actual[ix].second.real()));
+        continue;
+      }
+      EXPECT_NEAR(expected[ix].second.real(), actual[ix].second.real(),
+                  tolerance);
+      EXPECT_NEAR(expected[ix].second.imag(), actual[ix].second.imag(),
+                  tolerance);
+    }
+  }
+
+  // The interleaved layout duplicates the released storage.
+  EXPECT_THROW(model.interleave(), std::invalid_argument);
+
+  // A quantized model serializes with the same layout as an unquantized one.
+  auto state = model.getstate();
+  auto other = fes::tidal_model::Cartesian<double>::setstate(
+      fes::string_view(state.data(), state.size()));
+  EXPECT_FALSE(other.quantized());
+  EXPECT_NEAR(other.data().at(fes::kK2)(3).real(), k2(3).real(), tolerance);
+
+  // Restoring the floating-point storage carries the quantization error.
+  model.dequantize();
+  EXPECT_FALSE(model.quantized());
+  EXPECT_NEAR(model.data().at(fes::kM2)(7).real(), m2(7).real(), tolerance);
+  EXPECT_TRUE(std::isnan(model.data().at(fes::kM2)(12).real()));
+
+  // Adding a constituent restores the floating-point storage.
+  model.quantize();
+  model.add_constituent(fes::kO1, k2);
+  EXPECT_FALSE(model.quantized());
+  EXPECT_EQ(model.data().at(fes::kK2).size(), 25);
+}
+
+TEST(TidalModelCartesian, Crop) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto m2 = Eigen::VectorXcd(25);
+  auto k2 = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    m2(ix) = std::complex<double>(ix, -ix);
+    k2(ix) = std::complex<double>(2.0 * ix, 0.5 * ix);
+  }
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, m2);
+  model.add_constituent(fes::kK2, k2);
+
+  auto cropped = model;
+  cropped.crop(1.2, 2.8, 1.2, 2.8);
+  // The box [1.2, 2.8] selects the points {2}, padded with one point on each
+  // side.
+  EXPECT_EQ(cropped.lon().size(), 3);
+  EXPECT_EQ(cropped.lat().size(), 3);
+  EXPECT_EQ(cropped.lon().min_value(), 1.0);
+  EXPECT_EQ(cropped.lon().max_value(), 3.0);
+
+  // Inside the box, the cropped model interpolates exactly like the full one.
+  auto quality = fes::Quality();
+  auto cropped_quality = fes::Quality();
+  for (const auto& point : std::vector<fes::geometry::Point>{
+           {1.5, 1.5}, {2.0, 2.0}, {2.7, 1.3}}) {
+    auto acc = std::unique_ptr<fes::Accelerator>(
+        model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+    auto cropped_acc = std::unique_ptr<fes::Accelerator>(
+        cropped.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+    auto expected = model.interpolate(point, quality, acc.get());
+    auto actual = cropped.interpolate(point, cropped_quality, cropped_acc.get());
+    EXPECT_EQ(quality, cropped_quality);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t ix = 0; ix < expected.size(); ++ix) {
+      EXPECT_EQ(expected[ix].first, actual[ix].first);
+      EXPECT_EQ(expected[ix].second, actual[ix].second);
+    }
+  }
+
+  // Outside the box, the cropped model is undefined.
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      cropped.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  cropped.interpolate({0.1, 0.1}, quality, acc.get());
+  EXPECT_EQ(quality, fes::kUndefined);
+
+  // A box covering the whole grid leaves the model unchanged.
+  auto whole = model;
+  whole.crop(-1.0, 5.0, -1.0, 5.0);
+  EXPECT_EQ(whole.lon().size(), 5);
+  EXPECT_EQ(whole.lat().size(), 5);
+
+  // An empty box or a box outside the grid is rejected.
+  EXPECT_THROW(model.crop(2.0, 1.0, 0.0, 4.0), std::invalid_argument);
+  EXPECT_THROW(model.crop(10.0, 20.0, 0.0, 4.0), std::invalid_argument);
+}
+
+TEST(TidalModelCartesian, AcceleratorCellCache) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto m2 = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    m2(ix) = std::complex<double>(ix, -ix);
+  }
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, m2);
+
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto* cartesian_acc =
+      acc->cast<fes::tidal_model::CartesianAccelerator>();
+  ASSERT_NE(cartesian_acc, nullptr);
+  EXPECT_FALSE(cartesian_acc->in_cache({0.5, 0.5}));
+
+  auto quality = fes::Quality();
+  auto first = model.interpolate({0.5, 0.5}, quality, acc.get());
+  EXPECT_EQ(quality, fes::kInterpolated);
+  EXPECT_TRUE(cartesian_acc->in_cache({0.5, 0.5}));
+  // A point of the same cell is served from the cached corners.
+  EXPECT_TRUE(cartesian_acc->in_cache({0.9, 0.1}));
+  // A point of another cell invalidates nothing but misses the cache.
+  EXPECT_FALSE(cartesian_acc->in_cache({2.5, 0.5}));
+
+  // The cached cell must give the same result as a fresh search.
+  const auto cached = model.interpolate({0.9, 0.1}, quality, acc.get());
+  const auto expected_quality = quality;
+  auto fresh_acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  const auto fresh = model.interpolate({0.9, 0.1}, quality, fresh_acc.get());
+  EXPECT_EQ(quality, expected_quality);
+  ASSERT_EQ(cached.size(), fresh.size());
+  EXPECT_EQ(cached[0].first, fresh[0].first);
+  EXPECT_EQ(cached[0].second, fresh[0].second);
+
+  // Leaving the grid still reports an undefined quality.
+  model.interpolate({10.0, 10.0}, quality, acc.get());
+  EXPECT_EQ(quality, fes::kUndefined);
+
+  // Moving to another cell refreshes the cache.
+  model.interpolate({2.5, 2.5}, quality, acc.get());
+  EXPECT_EQ(quality, fes::kInterpolated);
+  EXPECT_TRUE(cartesian_acc->in_cache({2.5, 2.5}));
+  EXPECT_FALSE(cartesian_acc->in_cache({0.5, 0.5}));
+}
+
+TEST(TidalModelCartesian, ViewedConstituent) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto buffer = std::make_shared<std::vector<std::complex<double>>>(25);
+  for (size_t ix = 0; ix < buffer->size(); ++ix) {
+    (*buffer)[ix] = std::complex<double>(static_cast<double>(ix),
+                                         -static_cast<double>(ix));
+  }
+
+  // The model wraps the caller-owned buffer without copying it.
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(
+      fes::kM2,
+      fes::DataVector<std::complex<double>>(buffer->data(), 25, buffer));
+  EXPECT_FALSE(model.data().at(fes::kM2).owns());
+  EXPECT_EQ(model.data().at(fes::kM2).data(), buffer->data());
+
+  // The serialized state matches the one of a model owning its samples.
+  auto owned = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  owned.add_constituent(
+      fes::kM2,
+      Eigen::Map<const Eigen::VectorXcd>(buffer->data(), 25));
+  EXPECT_TRUE(owned.data().at(fes::kM2).owns());
+  EXPECT_EQ(model.getstate(), owned.getstate());
+
+  // A view of the wrong size is rejected like any other wave.
+  EXPECT_THROW(
+      model.add_constituent(
+          fes::kK2,
+          fes::DataVector<std::complex<double>>(buffer->data(), 5, buffer)),
+      std::invalid_argument);
+}
+
+TEST(TidalModelCartesian, InterpolateMany) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto m2 = Eigen::VectorXcd(25);
+  auto k1 = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    m2(ix) = std::complex<double>(ix, -ix);
+    k1(ix) = std::complex<double>(-2 * ix, ix);
+  }
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, m2);
+  model.add_constituent(fes::kK1, k1);
+
+  // Clustered points sharing cells, a cell switch and a point off the grid.
+  const auto queries = std::vector<fes::geometry::Point>{
+      {0.5, 0.5}, {0.9, 0.1}, {0.5, 0.5}, {2.5, 2.5}, {10.0, 10.0}};
+
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto values = fes::Matrix<std::complex<double>>();
+  auto quality = fes::Vector<fes::Quality>();
+  model.interpolate_many(queries, values, quality, acc.get());
+
+  ASSERT_EQ(values.rows(), 2);
+  ASSERT_EQ(values.cols(), 5);
+  ASSERT_EQ(quality.size(), 5);
+
+  // The batched run matches the per-point interpolation, column by column,
+  // with the rows following the constituent order of the model.
+  const auto idents = model.identifiers();
+  auto scalar_acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  for (size_t ix = 0; ix < queries.size(); ++ix) {
+    auto expected_quality = fes::Quality();
+    const auto& expected =
+        model.interpolate(queries[ix], expected_quality, scalar_acc.get());
+    EXPECT_EQ(quality(ix), expected_quality);
+    if (expected_quality == fes::kUndefined) {
+      continue;
+    }
+    for (size_t jx = 0; jx < idents.size(); ++jx) {
+      EXPECT_EQ(expected[jx].first, idents[jx]);
+      EXPECT_EQ(values(jx, ix), expected[jx].second);
+    }
+  }
+
+  // A bound accelerator gathers into the wave table, not into a matrix.
+  auto wave_table = fes::wave::Table(std::vector<fes::Constituent>{
+      fes::kM2, fes::kK1});
+  acc->bind(wave_table);
+  EXPECT_THROW(model.interpolate_many(queries, values, quality, acc.get()),
+               std::invalid_argument);
+}
+
+TEST(TidalModelCartesian, SetStateSubset) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto wave = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    wave(ix) = std::complex<double>(ix, -ix);
+  }
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, wave);
+  model.add_constituent(fes::kK1, 2.0 * wave);
+  model.add_constituent(fes::kO1, 3.0 * wave);
+
+  auto state = model.getstate();
+  auto subset = fes::tidal_model::Cartesian<double>::setstate(
+      fes::string_view(state.data(), state.size()), {fes::kM2, fes::kO1});
+
+  // The grids of the other constituents are skipped in the stream: the
+  // model only holds the wanted subset.
+  EXPECT_EQ(subset.data().size(), 2);
+  EXPECT_EQ(subset.identifiers(),
+            (std::vector<fes::Constituent>{fes::kO1, fes::kM2}));
+  for (auto ix = 0; ix < 25; ++ix) {
+    EXPECT_EQ(subset.data().at(fes::kM2)(ix), wave(ix));
+    EXPECT_EQ(subset.data().at(fes::kO1)(ix), 3.0 * wave(ix));
+  }
+
+  // An empty list keeps the current behavior: every constituent is loaded.
+  auto full = fes::tidal_model::Cartesian<double>::setstate(
+      fes::string_view(state.data(), state.size()), {});
+  EXPECT_EQ(full.data().size(), 3);
+}
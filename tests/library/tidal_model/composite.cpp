@@ -0,0 +1,110 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/tidal_model/composite.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include "fes/tidal_model/cartesian.hpp"
+
+static auto make_cartesian(const double start, const double step,
+                           const double scale)
+    -> std::shared_ptr<fes::tidal_model::Cartesian<double>> {
+  auto points = Eigen::VectorXd(5);
+  for (auto ix = 0; ix < 5; ++ix) {
+    points(ix) = start + ix * step;
+  }
+  auto m2 = Eigen::VectorXcd(25);
+  auto k2 = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    m2(ix) = std::complex<double>(scale * ix, -scale * ix);
+    k2(ix) = std::complex<double>(2.0 * scale * ix, 0.5 * scale * ix);
+  }
+  auto axis = fes::Axis(points);
+  auto model = std::make_shared<fes::tidal_model::Cartesian<double>>(
+      axis, axis, fes::kTide);
+  model->add_constituent(fes::kM2, m2);
+  model->add_constituent(fes::kK2, k2);
+  return model;
+}
+
+TEST(TidalModelComposite, Cascade) {
+  // The regional model covers [2, 3] with a finer step; the global one
+  // covers [0, 4].
+  auto regional = make_cartesian(2.0, 0.25, 100.0);
+  auto global = make_cartesian(0.0, 1.0, 1.0);
+
+  auto composite = fes::tidal_model::Composite<double>(
+      {regional, global});
+  EXPECT_EQ(composite.tide_type(), fes::kTide);
+  EXPECT_EQ(composite.size(), 2);
+
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      composite.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  fes::Quality quality;
+
+  // Inside the regional domain, the regional model answers.
+  auto expected_acc = std::unique_ptr<fes::Accelerator>(
+      regional->accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  fes::Quality expected_quality;
+  auto expected =
+      regional->interpolate({2.5, 2.5}, expected_quality, expected_acc.get());
+  auto actual = composite.interpolate({2.5, 2.5}, quality, acc.get());
+  EXPECT_EQ(quality, expected_quality);
+  EXPECT_EQ(expected, actual);
+
+  // Outside the regional domain, the query falls through to the global
+  // model.
+  expected_acc = std::unique_ptr<fes::Accelerator>(
+      global->accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  expected =
+      global->interpolate({0.5, 0.5}, expected_quality, expected_acc.get());
+  actual = composite.interpolate({0.5, 0.5}, quality, acc.get());
+  EXPECT_EQ(quality, expected_quality);
+  EXPECT_EQ(expected, actual);
+
+  // Outside every member, the composite is undefined.
+  actual = composite.interpolate({30.0, 30.0}, quality, acc.get());
+  EXPECT_EQ(quality, fes::kUndefined);
+  ASSERT_EQ(actual.size(), 2);
+  EXPECT_TRUE(std::isnan(actual[0].second.real()));
+}
+
+TEST(TidalModelComposite, Validation) {
+  auto global = make_cartesian(0.0, 1.0, 1.0);
+
+  // At least one member is required.
+  auto no_members =
+      std::vector<std::shared_ptr<const fes::AbstractTidalModel<double>>>();
+  EXPECT_THROW((fes::tidal_model::Composite<double>(no_members)),
+               std::invalid_argument);
+
+  // Members must share the constituent set.
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto partial = std::make_shared<fes::tidal_model::Cartesian<double>>(
+      axis, axis, fes::kTide);
+  partial->add_constituent(fes::kM2, Eigen::VectorXcd::Zero(25));
+  EXPECT_THROW(fes::tidal_model::Composite<double>({partial, global}),
+               std::invalid_argument);
+
+  // Members must share the tide type.
+  auto radial = std::make_shared<fes::tidal_model::Cartesian<double>>(
+      axis, axis, fes::kRadial);
+  radial->add_constituent(fes::kM2, Eigen::VectorXcd::Zero(25));
+  radial->add_constituent(fes::kK2, Eigen::VectorXcd::Zero(25));
+  EXPECT_THROW(fes::tidal_model::Composite<double>({radial, global}),
+               std::invalid_argument);
+
+  // The composite does not store samples itself.
+  auto composite = fes::tidal_model::Composite<double>({global});
+  EXPECT_THROW(composite.add_constituent(fes::kM2, Eigen::VectorXcd::Zero(25)),
+               std::invalid_argument);
+}
@@ -0,0 +1,234 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/tidal_model/file.hpp"
+
+#include <gtest/gtest.h>
+
+#include "fes/tidal_model/cartesian.hpp"
+#include "fes/tidal_model/lgp.hpp"
+
+TEST(TidalModelFile, Cartesian) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto wave = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    wave(ix) = std::complex<double>(ix, -ix);
+  }
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, wave);
+  model.add_constituent(fes::kK2, wave);
+
+  // The stream variants produce and parse the same bytes as the string ones.
+  auto ss = std::stringstream();
+  model.getstate(ss);
+  EXPECT_EQ(ss.str(), model.getstate());
+  auto from_stream = fes::tidal_model::Cartesian<double>::setstate(ss);
+  EXPECT_EQ(from_stream.getstate(), model.getstate());
+
+  const auto path = testing::TempDir() + "cartesian_model.bin";
+  fes::tidal_model::save(model, path);
+  auto loaded = fes::tidal_model::load<fes::tidal_model::Cartesian<double>>(
+      path);
+  EXPECT_EQ(model.getstate(), loaded.getstate());
+
+  EXPECT_THROW(fes::tidal_model::load<fes::tidal_model::Cartesian<double>>(
+                   testing::TempDir() + "missing_model.bin"),
+               std::invalid_argument);
+}
+
+TEST(TidalModelFile, LazyLoad) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto wave = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    wave(ix) = std::complex<double>(ix, -ix);
+  }
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, wave);
+  model.add_constituent(fes::kK2, wave);
+
+  const auto path = testing::TempDir() + "lazy_model.bin";
+  fes::tidal_model::save(model, path);
+
+  auto lazy =
+      fes::tidal_model::lazy_load<fes::tidal_model::Cartesian<double>>(path);
+  EXPECT_TRUE(lazy.lazy());
+  EXPECT_FALSE(model.lazy());
+  // The geometry is read eagerly, the grids are not.
+  EXPECT_EQ(lazy.size(), 2);
+  EXPECT_EQ(lazy.identifiers(), model.identifiers());
+  EXPECT_TRUE(lazy.resident().empty());
+
+  // The first interpolation faults the grids in.
+  auto quality = fes::Quality();
+  auto lazy_quality = fes::Quality();
+  const auto point = fes::geometry::Point(1.5, 2.5);
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto lazy_acc = std::unique_ptr<fes::Accelerator>(
+      lazy.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto expected = model.interpolate(point, quality, acc.get());
+  auto actual = lazy.interpolate(point, lazy_quality, lazy_acc.get());
+  EXPECT_EQ(quality, lazy_quality);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t ix = 0; ix < expected.size(); ++ix) {
+    EXPECT_EQ(expected[ix].first, actual[ix].first);
+    EXPECT_EQ(expected[ix].second, actual[ix].second);
+  }
+  EXPECT_EQ(lazy.resident().size(), 2);
+
+  // Released grids are faulted in again on the next use.
+  lazy.unload();
+  EXPECT_TRUE(lazy.resident().empty());
+  lazy_acc.reset(
+      lazy.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  actual = lazy.interpolate(point, lazy_quality, lazy_acc.get());
+  EXPECT_EQ(actual[0].second, expected[0].second);
+
+  // The serialized state is complete even when the grids are not resident.
+  lazy.unload();
+  EXPECT_EQ(lazy.getstate(), model.getstate());
+
+  // With a residency budget, the least recently used grid is evicted.
+  auto budgeted =
+      fes::tidal_model::lazy_load<fes::tidal_model::Cartesian<double>>(path,
+                                                                       1);
+  budgeted.fault_in({fes::kM2});
+  EXPECT_EQ(budgeted.resident(), std::vector<fes::Constituent>{fes::kM2});
+  budgeted.fault_in({fes::kK2});
+  EXPECT_EQ(budgeted.resident(), std::vector<fes::Constituent>{fes::kK2});
+}
+
+TEST(TidalModelFile, SharedMemory) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto wave = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    wave(ix) = std::complex<double>(ix, -ix);
+  }
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, wave);
+  model.add_constituent(fes::kK2, wave);
+
+  const auto name = std::string("/fes-test-model");
+  try {
+    fes::tidal_model::publish(model, name);
+  } catch (const std::invalid_argument&) {
+    GTEST_SKIP() << "shared memory is not available in this environment";
+  }
+  auto attached =
+      fes::tidal_model::attach<fes::tidal_model::Cartesian<double>>(name);
+  // The segment can be removed right away: the mapping held by the attached
+  // model remains valid.
+  fes::tidal_model::unpublish(name);
+
+  // The grids are viewed in place in the segment, not copied.
+  EXPECT_FALSE(attached.data().at(fes::kM2).owns());
+  EXPECT_TRUE(model.data().at(fes::kM2).owns());
+  EXPECT_EQ(attached.getstate(), model.getstate());
+
+  auto quality = fes::Quality();
+  auto attached_quality = fes::Quality();
+  const auto point = fes::geometry::Point(1.5, 2.5);
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto attached_acc = std::unique_ptr<fes::Accelerator>(
+      attached.accelerator(fes::angle::Formulae::kSchuremanOrder3, 0.0));
+  auto expected = model.interpolate(point, quality, acc.get());
+  auto actual = attached.interpolate(point, attached_quality,
+                                     attached_acc.get());
+  EXPECT_EQ(quality, attached_quality);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t ix = 0; ix < expected.size(); ++ix) {
+    EXPECT_EQ(expected[ix].first, actual[ix].first);
+    EXPECT_EQ(expected[ix].second, actual[ix].second);
+  }
+
+  // A mutator slices the grids into freshly owned storage.
+  attached.crop(0.0, 2.0, 0.0, 2.0);
+  EXPECT_TRUE(attached.data().at(fes::kM2).owns());
+
+  EXPECT_THROW(
+      fes::tidal_model::attach<fes::tidal_model::Cartesian<double>>(name),
+      std::invalid_argument);
+}
+
+TEST(TidalModelFile, LGP1) {
+  auto lon = Eigen::VectorXd(4);
+  auto lat = Eigen::VectorXd(4);
+  auto triangles = Eigen::Matrix<int, -1, 3>(2, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(2, 3);
+  auto values = Eigen::VectorXcd(6);
+
+  lon << 0, 1, 1, 0;
+  lat << 0, 0, 1, 1;
+  triangles << 0, 1, 2,  // 0
+      0, 2, 3;           // 1
+  codes << 0, 1, 2,  // 0
+      3, 4, 5;       // 1
+  for (auto ix = 0; ix < values.size(); ++ix) {
+    values(ix) = std::complex<double>(ix, -ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  auto model =
+      fes::tidal_model::LGP1<double>(std::move(index), codes, fes::kTide);
+  model.add_constituent(fes::kM2, values);
+
+  const auto path = testing::TempDir() + "lgp1_model.bin";
+  fes::tidal_model::save(model, path);
+  auto loaded = fes::tidal_model::load<fes::tidal_model::LGP1<double>>(path);
+  EXPECT_EQ(model.getstate(), loaded.getstate());
+
+  // Lazily loaded models serialize the same state, faulting the wave models
+  // in on demand.
+  auto lazy =
+      fes::tidal_model::lazy_load<fes::tidal_model::LGP1<double>>(path);
+  EXPECT_TRUE(lazy.lazy());
+  EXPECT_TRUE(lazy.resident().empty());
+  EXPECT_EQ(model.getstate(), lazy.getstate());
+}
+
+TEST(TidalModelFile, LoadSubset) {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto wave = Eigen::VectorXcd(25);
+  for (auto ix = 0; ix < 25; ++ix) {
+    wave(ix) = std::complex<double>(ix, -ix);
+  }
+  auto model = fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide);
+  model.add_constituent(fes::kM2, wave);
+  model.add_constituent(fes::kK2, 2.0 * wave);
+  model.add_constituent(fes::kO1, 3.0 * wave);
+
+  const auto path = testing::TempDir() + "subset_model.bin";
+  fes::tidal_model::save(model, path);
+
+  // An eager load of a subset skips the other grids in the file.
+  auto loaded = fes::tidal_model::load<fes::tidal_model::Cartesian<double>>(
+      path, {fes::kM2, fes::kO1});
+  EXPECT_EQ(loaded.identifiers(),
+            (std::vector<fes::Constituent>{fes::kO1, fes::kM2}));
+  for (auto ix = 0; ix < 25; ++ix) {
+    EXPECT_EQ(loaded.data().at(fes::kM2)(ix), wave(ix));
+    EXPECT_EQ(loaded.data().at(fes::kO1)(ix), 3.0 * wave(ix));
+  }
+
+  // A lazy load of a subset only scans the offsets of the wanted grids: the
+  // other ones are never faulted in.
+  auto lazy = fes::tidal_model::lazy_load<fes::tidal_model::Cartesian<double>>(
+      path, 0, {fes::kM2});
+  EXPECT_TRUE(lazy.lazy());
+  EXPECT_EQ(lazy.identifiers(), std::vector<fes::Constituent>{fes::kM2});
+  lazy.fault_in({fes::kM2});
+  EXPECT_EQ(lazy.resident(), std::vector<fes::Constituent>{fes::kM2});
+  for (auto ix = 0; ix < 25; ++ix) {
+    EXPECT_EQ(lazy.data().at(fes::kM2)(ix), wave(ix));
+  }
+}
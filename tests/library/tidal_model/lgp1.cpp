@@ -87,3 +87,526 @@ TEST(InterpolatorLGP1, Constructor) {
   auto y = other.interpolate({0.0, 0.0}, quality, acc.get());
   EXPECT_EQ(x, y);
 }
+
+TEST(InterpolatorLGP1, Crop) {
+  auto lon = Eigen::VectorXd(19);
+  auto lat = Eigen::VectorXd(19);
+  auto triangles = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto values = Eigen::VectorXcd(24 * 3);
+
+  lon << 0.004, -0.175, -0.273, -0.11, 0.183, 0.256, 0.183, -0.428, -0.501,
+      -0.371, 0.46, 0.622, 0.451, 0.313, -0.021, -0.289, -0.175, 0.077, 0.321;
+
+  lat << 0.004, 0.264, 0.004, -0.192, -0.232, 0.012, 0.264, 0.256, -0.013,
+      -0.24, -0.281, -0.004, 0.289, 0.459, 0.443, 0.435, -0.354, -0.363, -0.428;
+
+  triangles << 0, 2, 3,  // 0
+      0, 3, 4,           // 1
+      0, 4, 5,           // 2
+      0, 5, 6,           // 3
+      0, 6, 1,           // 4
+      0, 1, 2,           // 5
+      1, 6, 14,          // 6
+      1, 14, 15,         // 7
+      1, 15, 7,          // 8
+      1, 7, 2,           // 9
+      2, 7, 8,           // 10
+      2, 8, 9,           // 11
+      2, 9, 3,           // 12
+      3, 9, 16,          // 13
+      3, 16, 17,         // 14
+      3, 17, 4,          // 15
+      4, 17, 18,         // 16
+      4, 18, 10,         // 17
+      4, 10, 5,          // 18
+      5, 10, 11,         // 19
+      5, 11, 12,         // 20
+      5, 12, 6,          // 21
+      6, 12, 13,         // 22
+      6, 13, 14;         // 23
+
+  for (auto ix = 0; ix < 24; ++ix) {
+    codes.row(ix) << ix * 3, ix * 3 + 1, ix * 3 + 2;
+  }
+  for (auto ix = 0; ix < values.size(); ++ix) {
+    values(ix) = std::complex<double>(ix, -ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> lgp1(std::move(index), codes, fes::kTide);
+  lgp1.add_constituent(fes::kS2, values);
+
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  fes::Quality quality;
+  const auto expected = lgp1.interpolate({0.0, 0.0}, quality, acc.get());
+  const auto expected_quality = quality;
+
+  // Only the vertex 0 falls in the box: the six triangles of its fan are
+  // kept and the wave model shrinks to the codes they reference.
+  lgp1.crop(-0.15, 0.15, -0.15, 0.15);
+  EXPECT_EQ(lgp1.index()->n_triangles(), 6);
+  EXPECT_EQ(lgp1.index()->n_positions(), 7);
+  EXPECT_EQ(lgp1.data().at(fes::kS2).size(), 18);
+
+  auto cropped_acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  const auto actual = lgp1.interpolate({0.0, 0.0}, quality, cropped_acc.get());
+  EXPECT_EQ(quality, expected_quality);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t ix = 0; ix < expected.size(); ++ix) {
+    EXPECT_EQ(expected[ix].first, actual[ix].first);
+    EXPECT_EQ(expected[ix].second, actual[ix].second);
+  }
+
+  // Outside the cropped mesh, the model is undefined.
+  lgp1.interpolate({0.5, -0.3}, quality, cropped_acc.get());
+  EXPECT_EQ(quality, fes::kUndefined);
+
+  // An empty box or a box outside the mesh is rejected.
+  EXPECT_THROW(lgp1.crop(0.15, -0.15, -0.15, 0.15), std::invalid_argument);
+  EXPECT_THROW(lgp1.crop(10.0, 20.0, 10.0, 20.0), std::invalid_argument);
+
+  // A quantized model is cropped like an unquantized one and stays
+  // quantized. Only the vertex 4 of the fan falls in the box: the two
+  // triangles sharing it are kept.
+  lgp1.quantize();
+  lgp1.crop(0.15, 0.2, -0.25, -0.2);
+  EXPECT_TRUE(lgp1.quantized());
+  EXPECT_EQ(lgp1.index()->n_triangles(), 2);
+
+  // The quantized storage interpolates within the quantization error.
+  const auto tolerance = 1e-2;
+  auto plain = lgp1;
+  plain.dequantize();
+  const auto centroid = fes::geometry::Point(0.0257, -0.14);
+  auto quantized_acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  auto plain_acc = std::unique_ptr<fes::Accelerator>(
+      plain.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  auto plain_quality = fes::Quality();
+  const auto quantized =
+      lgp1.interpolate(centroid, quality, quantized_acc.get());
+  const auto dequantized =
+      plain.interpolate(centroid, plain_quality, plain_acc.get());
+  EXPECT_EQ(quality, plain_quality);
+  ASSERT_EQ(quantized.size(), dequantized.size());
+  for (size_t ix = 0; ix < quantized.size(); ++ix) {
+    EXPECT_EQ(quantized[ix].first, dequantized[ix].first);
+    EXPECT_NEAR(quantized[ix].second.real(), dequantized[ix].second.real(),
+                tolerance);
+    EXPECT_NEAR(quantized[ix].second.imag(), dequantized[ix].second.imag(),
+                tolerance);
+  }
+}
+
+TEST(InterpolatorLGP1, Interleave) {
+  auto lon = Eigen::VectorXd(19);
+  auto lat = Eigen::VectorXd(19);
+  auto triangles = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto s2 = Eigen::VectorXcd(24 * 3);
+  auto m2 = Eigen::VectorXcd(24 * 3);
+
+  lon << 0.004, -0.175, -0.273, -0.11, 0.183, 0.256, 0.183, -0.428, -0.501,
+      -0.371, 0.46, 0.622, 0.451, 0.313, -0.021, -0.289, -0.175, 0.077, 0.321;
+
+  lat << 0.004, 0.264, 0.004, -0.192, -0.232, 0.012, 0.264, 0.256, -0.013,
+      -0.24, -0.281, -0.004, 0.289, 0.459, 0.443, 0.435, -0.354, -0.363, -0.428;
+
+  triangles << 0, 2, 3,  // 0
+      0, 3, 4,           // 1
+      0, 4, 5,           // 2
+      0, 5, 6,           // 3
+      0, 6, 1,           // 4
+      0, 1, 2,           // 5
+      1, 6, 14,          // 6
+      1, 14, 15,         // 7
+      1, 15, 7,          // 8
+      1, 7, 2,           // 9
+      2, 7, 8,           // 10
+      2, 8, 9,           // 11
+      2, 9, 3,           // 12
+      3, 9, 16,          // 13
+      3, 16, 17,         // 14
+      3, 17, 4,          // 15
+      4, 17, 18,         // 16
+      4, 18, 10,         // 17
+      4, 10, 5,          // 18
+      5, 10, 11,         // 19
+      5, 11, 12,         // 20
+      5, 12, 6,          // 21
+      6, 12, 13,         // 22
+      6, 13, 14;         // 23
+
+  for (auto ix = 0; ix < 24; ++ix) {
+    codes.row(ix) << ix * 3, ix * 3 + 1, ix * 3 + 2;
+  }
+  for (auto ix = 0; ix < s2.size(); ++ix) {
+    s2(ix) = std::complex<double>(ix, -ix);
+    m2(ix) = std::complex<double>(-ix, 2 * ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> lgp1(std::move(index), codes, fes::kTide);
+  lgp1.add_constituent(fes::kM2, m2);
+  lgp1.add_constituent(fes::kS2, s2);
+
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  fes::Quality quality;
+  const auto expected = lgp1.interpolate({0.0, 0.0}, quality, acc.get());
+  const auto expected_quality = quality;
+  const auto first = expected;
+
+  // The packed matrix must give the same results as the canonical storage.
+  EXPECT_FALSE(lgp1.interleaved());
+  lgp1.interleave();
+  EXPECT_TRUE(lgp1.interleaved());
+  auto packed_acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  const auto actual = lgp1.interpolate({0.0, 0.0}, quality, packed_acc.get());
+  EXPECT_EQ(quality, expected_quality);
+  ASSERT_EQ(first.size(), actual.size());
+  for (size_t ix = 0; ix < first.size(); ++ix) {
+    EXPECT_EQ(first[ix].first, actual[ix].first);
+    EXPECT_NEAR(first[ix].second.real(), actual[ix].second.real(), 1e-12);
+    EXPECT_NEAR(first[ix].second.imag(), actual[ix].second.imag(), 1e-12);
+  }
+
+  // Outside the mesh, the packed layout reports an undefined quality too.
+  lgp1.interpolate({5.0, 5.0}, quality, packed_acc.get());
+  EXPECT_EQ(quality, fes::kUndefined);
+
+  // Adding a constituent invalidates the packed matrix.
+  lgp1.add_constituent(fes::kK2, s2);
+  EXPECT_FALSE(lgp1.interleaved());
+
+  // The interleaved layout is not available for a quantized model.
+  lgp1.quantize();
+  EXPECT_THROW(lgp1.interleave(), std::invalid_argument);
+}
+
+TEST(InterpolatorLGP1, RepeatedPosition) {
+  auto lon = Eigen::VectorXd(19);
+  auto lat = Eigen::VectorXd(19);
+  auto triangles = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto values = Eigen::VectorXcd(24 * 3);
+
+  lon << 0.004, -0.175, -0.273, -0.11, 0.183, 0.256, 0.183, -0.428, -0.501,
+      -0.371, 0.46, 0.622, 0.451, 0.313, -0.021, -0.289, -0.175, 0.077, 0.321;
+
+  lat << 0.004, 0.264, 0.004, -0.192, -0.232, 0.012, 0.264, 0.256, -0.013,
+      -0.24, -0.281, -0.004, 0.289, 0.459, 0.443, 0.435, -0.354, -0.363, -0.428;
+
+  triangles << 0, 2, 3,  // 0
+      0, 3, 4,           // 1
+      0, 4, 5,           // 2
+      0, 5, 6,           // 3
+      0, 6, 1,           // 4
+      0, 1, 2,           // 5
+      1, 6, 14,          // 6
+      1, 14, 15,         // 7
+      1, 15, 7,          // 8
+      1, 7, 2,           // 9
+      2, 7, 8,           // 10
+      2, 8, 9,           // 11
+      2, 9, 3,           // 12
+      3, 9, 16,          // 13
+      3, 16, 17,         // 14
+      3, 17, 4,          // 15
+      4, 17, 18,         // 16
+      4, 18, 10,         // 17
+      4, 10, 5,          // 18
+      5, 10, 11,         // 19
+      5, 11, 12,         // 20
+      5, 12, 6,          // 21
+      6, 12, 13,         // 22
+      6, 13, 14;         // 23
+
+  for (auto ix = 0; ix < 24; ++ix) {
+    codes.row(ix) << ix * 3, ix * 3 + 1, ix * 3 + 2;
+  }
+  for (auto ix = 0; ix < values.size(); ++ix) {
+    values(ix) = std::complex<double>(ix, -ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> lgp1(std::move(index), codes, fes::kTide);
+  lgp1.add_constituent(fes::kS2, values);
+
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  fes::Quality quality;
+
+  // The second query at a bit-identical position reuses the cached beta
+  // coefficients and yields the same result.
+  const auto first = lgp1.interpolate({0.0, 0.0}, quality, acc.get());
+  const auto first_quality = quality;
+  const auto repeated = lgp1.interpolate({0.0, 0.0}, quality, acc.get());
+  EXPECT_EQ(quality, first_quality);
+  EXPECT_EQ(first, repeated);
+
+  // A different position invalidates the cache; its result matches a fresh
+  // accelerator.
+  const auto moved = lgp1.interpolate({0.2, 0.1}, quality, acc.get());
+  auto fresh_acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  const auto expected = lgp1.interpolate({0.2, 0.1}, quality, fresh_acc.get());
+  EXPECT_EQ(moved, expected);
+
+  // Returning to the first position gives the original result again.
+  const auto back = lgp1.interpolate({0.0, 0.0}, quality, acc.get());
+  EXPECT_EQ(first, back);
+}
+
+TEST(InterpolatorLGP1, SharedSpatialCache) {
+  auto lon = Eigen::VectorXd(19);
+  auto lat = Eigen::VectorXd(19);
+  auto triangles = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto values = Eigen::VectorXcd(24 * 3);
+
+  lon << 0.004, -0.175, -0.273, -0.11, 0.183, 0.256, 0.183, -0.428, -0.501,
+      -0.371, 0.46, 0.622, 0.451, 0.313, -0.021, -0.289, -0.175, 0.077, 0.321;
+
+  lat << 0.004, 0.264, 0.004, -0.192, -0.232, 0.012, 0.264, 0.256, -0.013,
+      -0.24, -0.281, -0.004, 0.289, 0.459, 0.443, 0.435, -0.354, -0.363, -0.428;
+
+  triangles << 0, 2, 3,  // 0
+      0, 3, 4,           // 1
+      0, 4, 5,           // 2
+      0, 5, 6,           // 3
+      0, 6, 1,           // 4
+      0, 1, 2,           // 5
+      1, 6, 14,          // 6
+      1, 14, 15,         // 7
+      1, 15, 7,          // 8
+      1, 7, 2,           // 9
+      2, 7, 8,           // 10
+      2, 8, 9,           // 11
+      2, 9, 3,           // 12
+      3, 9, 16,          // 13
+      3, 16, 17,         // 14
+      3, 17, 4,          // 15
+      4, 17, 18,         // 16
+      4, 18, 10,         // 17
+      4, 10, 5,          // 18
+      5, 10, 11,         // 19
+      5, 11, 12,         // 20
+      5, 12, 6,          // 21
+      6, 12, 13,         // 22
+      6, 13, 14;         // 23
+
+  for (auto ix = 0; ix < 24; ++ix) {
+    codes.row(ix) << ix * 3, ix * 3 + 1, ix * 3 + 2;
+  }
+  for (auto ix = 0; ix < values.size(); ++ix) {
+    values(ix) = std::complex<double>(ix, -ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> first(index, codes, fes::kTide);
+  first.add_constituent(fes::kS2, values);
+  fes::tidal_model::LGP1<double> second(index, codes, fes::kRadial);
+  second.add_constituent(fes::kS2, Eigen::VectorXcd(2 * values));
+
+  // Models built on the same mesh index agree to share their searches; a
+  // model built on its own copy of the mesh declines.
+  EXPECT_TRUE(second.shares_spatial_cache(first));
+  auto other_index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> foreign(std::move(other_index), codes,
+                                         fes::kTide);
+  EXPECT_FALSE(foreign.shares_spatial_cache(first));
+
+  auto first_acc = std::unique_ptr<fes::Accelerator>(
+      first.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  auto second_acc = std::unique_ptr<fes::Accelerator>(
+      second.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  fes::Quality quality;
+
+  // The first model pays the triangle search; the seeded accelerator of the
+  // second model reuses it.
+  first.interpolate({0.2, 0.1}, quality, first_acc.get());
+  second.seed_spatial_cache({0.2, 0.1}, *first_acc, second_acc.get());
+  const auto seeded = second.interpolate({0.2, 0.1}, quality, second_acc.get());
+  EXPECT_EQ(second_acc->counters().searches, 0);
+
+  // The seeded interpolation matches a fresh one.
+  auto fresh_acc = std::unique_ptr<fes::Accelerator>(
+      second.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  const auto expected =
+      second.interpolate({0.2, 0.1}, quality, fresh_acc.get());
+  EXPECT_EQ(seeded, expected);
+  EXPECT_EQ(fresh_acc->counters().searches, 1);
+}
+
+TEST(InterpolatorLGP1, InterpolateMany) {
+  auto lon = Eigen::VectorXd(19);
+  auto lat = Eigen::VectorXd(19);
+  auto triangles = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto s2 = Eigen::VectorXcd(24 * 3);
+  auto m2 = Eigen::VectorXcd(24 * 3);
+
+  lon << 0.004, -0.175, -0.273, -0.11, 0.183, 0.256, 0.183, -0.428, -0.501,
+      -0.371, 0.46, 0.622, 0.451, 0.313, -0.021, -0.289, -0.175, 0.077, 0.321;
+
+  lat << 0.004, 0.264, 0.004, -0.192, -0.232, 0.012, 0.264, 0.256, -0.013,
+      -0.24, -0.281, -0.004, 0.289, 0.459, 0.443, 0.435, -0.354, -0.363, -0.428;
+
+  triangles << 0, 2, 3,  // 0
+      0, 3, 4,           // 1
+      0, 4, 5,           // 2
+      0, 5, 6,           // 3
+      0, 6, 1,           // 4
+      0, 1, 2,           // 5
+      1, 6, 14,          // 6
+      1, 14, 15,         // 7
+      1, 15, 7,          // 8
+      1, 7, 2,           // 9
+      2, 7, 8,           // 10
+      2, 8, 9,           // 11
+      2, 9, 3,           // 12
+      3, 9, 16,          // 13
+      3, 16, 17,         // 14
+      3, 17, 4,          // 15
+      4, 17, 18,         // 16
+      4, 18, 10,         // 17
+      4, 10, 5,          // 18
+      5, 10, 11,         // 19
+      5, 11, 12,         // 20
+      5, 12, 6,          // 21
+      6, 12, 13,         // 22
+      6, 13, 14;         // 23
+
+  for (auto ix = 0; ix < 24; ++ix) {
+    codes.row(ix) << ix * 3, ix * 3 + 1, ix * 3 + 2;
+  }
+  for (auto ix = 0; ix < s2.size(); ++ix) {
+    s2(ix) = std::complex<double>(ix, -ix);
+    m2(ix) = std::complex<double>(-ix, 2 * ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> lgp1(std::move(index), codes, fes::kTide);
+  lgp1.add_constituent(fes::kM2, m2);
+  lgp1.add_constituent(fes::kS2, s2);
+
+  // Scattered interior points, a repeated position and a point outside the
+  // mesh. Points on an element boundary are avoided: the fixture assigns
+  // distinct codes to a vertex in each adjacent triangle, so the value there
+  // depends on which covering triangle the search happens to select.
+  const auto queries = std::vector<fes::geometry::Point>{
+      {-0.3, -0.2}, {0.4, 0.3},   {0.0, 0.0},  {0.4, -0.3},
+      {-0.3, 0.3},  {-0.3, -0.2}, {0.1, 0.05}, {5.0, 5.0}};
+
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  auto values = fes::Matrix<std::complex<double>>();
+  auto quality = fes::Vector<fes::Quality>();
+  lgp1.interpolate_many(queries, values, quality, acc.get());
+
+  ASSERT_EQ(values.rows(), 2);
+  ASSERT_EQ(values.cols(), static_cast<Eigen::Index>(queries.size()));
+
+  // The batched run locates the triangles with one warm-started search and
+  // matches the per-point interpolation everywhere.
+  const auto idents = lgp1.identifiers();
+  auto scalar_acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  for (size_t ix = 0; ix < queries.size(); ++ix) {
+    auto expected_quality = fes::Quality();
+    const auto& expected =
+        lgp1.interpolate(queries[ix], expected_quality, scalar_acc.get());
+    EXPECT_EQ(quality(ix), expected_quality);
+    if (expected_quality == fes::kUndefined) {
+      // Both paths return NaN values outside the mesh.
+      continue;
+    }
+    for (size_t jx = 0; jx < idents.size(); ++jx) {
+      EXPECT_EQ(expected[jx].first, idents[jx]);
+      EXPECT_EQ(values(jx, ix), expected[jx].second);
+    }
+  }
+}
+
+TEST(InterpolatorLGP1, SetStateSubset) {
+  auto lon = Eigen::VectorXd(19);
+  auto lat = Eigen::VectorXd(19);
+  auto triangles = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto values = Eigen::VectorXcd(24 * 3);
+
+  lon << 0.004, -0.175, -0.273, -0.11, 0.183, 0.256, 0.183, -0.428, -0.501,
+      -0.371, 0.46, 0.622, 0.451, 0.313, -0.021, -0.289, -0.175, 0.077, 0.321;
+
+  lat << 0.004, 0.264, 0.004, -0.192, -0.232, 0.012, 0.264, 0.256, -0.013,
+      -0.24, -0.281, -0.004, 0.289, 0.459, 0.443, 0.435, -0.354, -0.363, -0.428;
+
+  triangles << 0, 2, 3,  // 0
+      0, 3, 4,           // 1
+      0, 4, 5,           // 2
+      0, 5, 6,           // 3
+      0, 6, 1,           // 4
+      0, 1, 2,           // 5
+      1, 6, 14,          // 6
+      1, 14, 15,         // 7
+      1, 15, 7,          // 8
+      1, 7, 2,           // 9
+      2, 7, 8,           // 10
+      2, 8, 9,           // 11
+      2, 9, 3,           // 12
+      3, 9, 16,          // 13
+      3, 16, 17,         // 14
+      3, 17, 4,          // 15
+      4, 17, 18,         // 16
+      4, 18, 10,         // 17
+      4, 10, 5,          // 18
+      5, 10, 11,         // 19
+      5, 11, 12,         // 20
+      5, 12, 6,          // 21
+      6, 12, 13,         // 22
+      6, 13, 14;         // 23
+
+  for (auto ix = 0; ix < 24; ++ix) {
+    codes.row(ix) << ix * 3, ix * 3 + 1, ix * 3 + 2;
+  }
+  for (auto ix = 0; ix < values.size(); ++ix) {
+    values(ix) = std::complex<double>(ix, -ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> lgp1(std::move(index), std::move(codes),
+                                      fes::kTide);
+  lgp1.add_constituent(fes::kM2, values);
+  lgp1.add_constituent(fes::kS2, 2.0 * values);
+
+  auto state = lgp1.getstate();
+  auto subset = fes::tidal_model::LGP1<double>::setstate(
+      fes::string_view(state.data(), state.size()), {fes::kM2});
+
+  // The wave models of the other constituents are skipped in the stream:
+  // the model only holds the wanted subset.
+  EXPECT_EQ(subset.data().size(), 1);
+  EXPECT_TRUE(subset.data().contains(fes::kM2));
+  EXPECT_FALSE(subset.data().contains(fes::kS2));
+
+  // The kept wave model interpolates like the one of a full load.
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  auto subset_acc = std::unique_ptr<fes::Accelerator>(
+      subset.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  fes::Quality quality;
+  fes::Quality subset_quality;
+  const auto point = fes::geometry::Point(0.1, 0.05);
+  auto expected = lgp1.interpolate(point, quality, acc.get());
+  auto actual = subset.interpolate(point, subset_quality, subset_acc.get());
+  EXPECT_EQ(subset_quality, quality);
+  ASSERT_EQ(actual.size(), 1);
+  EXPECT_EQ(actual[0].first, fes::kM2);
+  EXPECT_EQ(expected[0].first, fes::kM2);
+  EXPECT_EQ(actual[0].second, expected[0].second);
+}
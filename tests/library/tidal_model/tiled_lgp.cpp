@@ -0,0 +1,201 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "fes/tidal_model/tiled_lgp.hpp"
+
+TEST(TiledLGP1, RoundTrip) {
+  auto lon = Eigen::VectorXd(19);
+  auto lat = Eigen::VectorXd(19);
+  auto triangles = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto s2 = Eigen::VectorXcd(24 * 3);
+  auto m2 = Eigen::VectorXcd(24 * 3);
+
+  lon << 0.004, -0.175, -0.273, -0.11, 0.183, 0.256, 0.183, -0.428, -0.501,
+      -0.371, 0.46, 0.622, 0.451, 0.313, -0.021, -0.289, -0.175, 0.077, 0.321;
+
+  lat << 0.004, 0.264, 0.004, -0.192, -0.232, 0.012, 0.264, 0.256, -0.013,
+      -0.24, -0.281, -0.004, 0.289, 0.459, 0.443, 0.435, -0.354, -0.363, -0.428;
+
+  triangles << 0, 2, 3,  // 0
+      0, 3, 4,           // 1
+      0, 4, 5,           // 2
+      0, 5, 6,           // 3
+      0, 6, 1,           // 4
+      0, 1, 2,           // 5
+      1, 6, 14,          // 6
+      1, 14, 15,         // 7
+      1, 15, 7,          // 8
+      1, 7, 2,           // 9
+      2, 7, 8,           // 10
+      2, 8, 9,           // 11
+      2, 9, 3,           // 12
+      3, 9, 16,          // 13
+      3, 16, 17,         // 14
+      3, 17, 4,          // 15
+      4, 17, 18,         // 16
+      4, 18, 10,         // 17
+      4, 10, 5,          // 18
+      5, 10, 11,         // 19
+      5, 11, 12,         // 20
+      5, 12, 6,          // 21
+      6, 12, 13,         // 22
+      6, 13, 14;         // 23
+
+  for (auto ix = 0; ix < 24; ++ix) {
+    codes.row(ix) << ix * 3, ix * 3 + 1, ix * 3 + 2;
+  }
+  for (auto ix = 0; ix < s2.size(); ++ix) {
+    s2(ix) = std::complex<double>(ix, -ix);
+    m2(ix) = std::complex<double>(-ix, 2 * ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> lgp1(std::move(index), codes, fes::kTide);
+  lgp1.add_constituent(fes::kM2, m2);
+  lgp1.add_constituent(fes::kS2, s2);
+
+  // The tile grid must hold at least one tile and the overlap must be
+  // positive.
+  {
+    auto ss = std::stringstream();
+    EXPECT_THROW(
+        fes::tidal_model::TiledLGP1<double>::shard(lgp1, 0, 2, 0.5, ss),
+        std::invalid_argument);
+    EXPECT_THROW(
+        fes::tidal_model::TiledLGP1<double>::shard(lgp1, 2, 2, -0.5, ss),
+        std::invalid_argument);
+  }
+
+  const auto path = ::testing::TempDir() + "tiled_lgp1_round_trip.bin";
+  {
+    auto ss = std::ofstream(path, std::ios::binary);
+    fes::tidal_model::TiledLGP1<double>::shard(lgp1, 2, 2, 0.5, ss);
+  }
+  const auto tiled = fes::tidal_model::TiledLGP1<double>::setstate(
+      std::make_shared<fes::detail::MappedFile>(path), 1);
+
+  // The shard directory is read eagerly, the shards are not.
+  EXPECT_EQ(tiled.n_shards(), 4);
+  EXPECT_EQ(tiled.resident_shards(), 0);
+  EXPECT_EQ(tiled.identifiers(), lgp1.identifiers());
+
+  // A tiled model is read-only.
+  auto writable = tiled;
+  EXPECT_THROW(writable.add_constituent(fes::kK2, s2), std::invalid_argument);
+
+  // One point per tile, plus a vertex and a point outside the mesh: the
+  // tiled model matches the monolithic one everywhere, including across
+  // tile switches of the same accelerator.
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      lgp1.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  auto tiled_acc = std::unique_ptr<fes::Accelerator>(
+      tiled.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  const auto points = std::vector<fes::geometry::Point>{
+      {-0.3, -0.2}, {0.4, 0.3}, {0.4, -0.3}, {-0.3, 0.3},
+      {0.0, 0.0},   {-0.3, -0.2}, {0.004, 0.004}, {5.0, 5.0}};
+  for (const auto& point : points) {
+    auto expected_quality = fes::Quality();
+    auto quality = fes::Quality();
+    const auto expected = lgp1.interpolate(point, expected_quality, acc.get());
+    const auto actual = tiled.interpolate(point, quality, tiled_acc.get());
+    EXPECT_EQ(quality, expected_quality);
+    if (expected_quality == fes::kUndefined) {
+      // Both models return NaN values outside the mesh.
+      continue;
+    }
+    EXPECT_EQ(expected, actual);
+  }
+
+  // The residency budget holds: the queries touched every tile, only the
+  // last one used stays resident.
+  EXPECT_EQ(tiled.resident_shards(), 1);
+}
+
+TEST(TiledLGP1, DemandLoading) {
+  auto lon = Eigen::VectorXd(19);
+  auto lat = Eigen::VectorXd(19);
+  auto triangles = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto codes = Eigen::Matrix<int, -1, 3>(24, 3);
+  auto values = Eigen::VectorXcd(24 * 3);
+
+  lon << 0.004, -0.175, -0.273, -0.11, 0.183, 0.256, 0.183, -0.428, -0.501,
+      -0.371, 0.46, 0.622, 0.451, 0.313, -0.021, -0.289, -0.175, 0.077, 0.321;
+
+  lat << 0.004, 0.264, 0.004, -0.192, -0.232, 0.012, 0.264, 0.256, -0.013,
+      -0.24, -0.281, -0.004, 0.289, 0.459, 0.443, 0.435, -0.354, -0.363, -0.428;
+
+  triangles << 0, 2, 3,  // 0
+      0, 3, 4,           // 1
+      0, 4, 5,           // 2
+      0, 5, 6,           // 3
+      0, 6, 1,           // 4
+      0, 1, 2,           // 5
+      1, 6, 14,          // 6
+      1, 14, 15,         // 7
+      1, 15, 7,          // 8
+      1, 7, 2,           // 9
+      2, 7, 8,           // 10
+      2, 8, 9,           // 11
+      2, 9, 3,           // 12
+      3, 9, 16,          // 13
+      3, 16, 17,         // 14
+      3, 17, 4,          // 15
+      4, 17, 18,         // 16
+      4, 18, 10,         // 17
+      4, 10, 5,          // 18
+      5, 10, 11,         // 19
+      5, 11, 12,         // 20
+      5, 12, 6,          // 21
+      6, 12, 13,         // 22
+      6, 13, 14;         // 23
+
+  for (auto ix = 0; ix < 24; ++ix) {
+    codes.row(ix) << ix * 3, ix * 3 + 1, ix * 3 + 2;
+  }
+  for (auto ix = 0; ix < values.size(); ++ix) {
+    values(ix) = std::complex<double>(ix, -ix);
+  }
+
+  auto index = std::make_shared<fes::mesh::Index>(lon, lat, triangles);
+  fes::tidal_model::LGP1<double> lgp1(std::move(index), codes, fes::kTide);
+  lgp1.add_constituent(fes::kS2, values);
+
+  const auto path = ::testing::TempDir() + "tiled_lgp1_demand_loading.bin";
+  {
+    auto ss = std::ofstream(path, std::ios::binary);
+    fes::tidal_model::TiledLGP1<double>::shard(lgp1, 2, 2, 0.5, ss);
+  }
+  // An unbounded budget keeps every loaded shard resident: only the tiles
+  // actually queried are faulted in.
+  const auto tiled = fes::tidal_model::TiledLGP1<double>::setstate(
+      std::make_shared<fes::detail::MappedFile>(path), 0);
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      tiled.accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  auto quality = fes::Quality();
+
+  EXPECT_EQ(tiled.resident_shards(), 0);
+  tiled.interpolate({-0.3, -0.2}, quality, acc.get());
+  EXPECT_EQ(tiled.resident_shards(), 1);
+  // A repeated query does not fault anything in.
+  tiled.interpolate({-0.3, -0.2}, quality, acc.get());
+  EXPECT_EQ(tiled.resident_shards(), 1);
+  tiled.interpolate({0.4, 0.3}, quality, acc.get());
+  EXPECT_EQ(tiled.resident_shards(), 2);
+}
+
+TEST(TiledLGP1, InvalidState) {
+  const auto path = ::testing::TempDir() + "tiled_lgp1_invalid_state.bin";
+  {
+    auto ss = std::ofstream(path, std::ios::binary);
+    ss << "not a tiled model";
+  }
+  EXPECT_THROW(fes::tidal_model::TiledLGP1<double>::setstate(
+                   std::make_shared<fes::detail::MappedFile>(path), 0),
+               std::runtime_error);
+}
@@ -0,0 +1,842 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/tide.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "fes/tidal_model/cartesian.hpp"
+
+namespace {
+
+/// Build a small Cartesian model defined on a 5x5 grid.
+auto make_model() -> std::unique_ptr<fes::tidal_model::Cartesian<double>> {
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto model = std::unique_ptr<fes::tidal_model::Cartesian<double>>(
+      new fes::tidal_model::Cartesian<double>(axis, axis, fes::kTide));
+  model->add_constituent(
+      fes::kM2, Eigen::VectorXcd::Constant(25, std::complex<double>(10, 5)));
+  model->add_constituent(
+      fes::kK1, Eigen::VectorXcd::Constant(25, std::complex<double>(4, -2)));
+  model->add_constituent(
+      fes::kO1, Eigen::VectorXcd::Constant(25, std::complex<double>(1, 3)));
+  return model;
+}
+
+}  // namespace
+
+TEST(EvaluateTide, FixedPosition) {
+  auto model = make_model();
+  constexpr auto n = 24;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    // Hourly epochs starting on 2020-01-01T00:00:00Z.
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  Eigen::VectorXd fast_tide;
+  Eigen::VectorXd fast_long_period;
+  fes::Vector<fes::Quality> fast_quality;
+  std::tie(fast_tide, fast_long_period, fast_quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, 2.0, 2.0);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), fast_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), fast_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), fast_quality(ix));
+  }
+}
+
+TEST(EvaluateTide, InPlace) {
+  auto model = make_model();
+  constexpr auto n = 8;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // Preallocated buffers reused by the in-place overload.
+  auto buffer_tide = Eigen::VectorXd(n);
+  auto buffer_long_period = Eigen::VectorXd(n);
+  auto buffer_quality = fes::Vector<fes::Quality>(n);
+  fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat, buffer_tide,
+                     buffer_long_period, buffer_quality);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), buffer_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), buffer_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), buffer_quality(ix));
+  }
+
+  // The output buffers must match the size of the input vectors.
+  auto short_tide = Eigen::VectorXd(n - 1);
+  EXPECT_THROW(
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat, short_tide,
+                         buffer_long_period, buffer_quality),
+      std::invalid_argument);
+}
+
+TEST(EvaluateTide, DynamicScheduling) {
+  auto model = make_model();
+  constexpr auto n = 8;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // Dynamic scheduling only changes how indexes are distributed over the
+  // workers, not the result.
+  auto settings =
+      fes::Settings(fes::angle::Formulae::kSchuremanOrder1, 0.0, {}, 3);
+  Eigen::VectorXd chunked_tide;
+  Eigen::VectorXd chunked_long_period;
+  fes::Vector<fes::Quality> chunked_quality;
+  std::tie(chunked_tide, chunked_long_period, chunked_quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat, settings);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), chunked_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), chunked_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), chunked_quality(ix));
+  }
+}
+
+TEST(EvaluateTide, Broadcast) {
+  auto model = make_model();
+  constexpr auto n = 8;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // Size-1 vectors are broadcast against the epoch vector.
+  Eigen::VectorXd broadcast_tide;
+  Eigen::VectorXd broadcast_long_period;
+  fes::Vector<fes::Quality> broadcast_quality;
+  std::tie(broadcast_tide, broadcast_long_period, broadcast_quality) =
+      fes::evaluate_tide(model.get(), epoch,
+                         fes::Vector<uint16_t>::Constant(1, 27),
+                         Eigen::VectorXd::Constant(1, 2.0),
+                         Eigen::VectorXd::Constant(1, 2.0));
+
+  ASSERT_EQ(broadcast_tide.size(), n);
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), broadcast_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), broadcast_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), broadcast_quality(ix));
+  }
+
+  // Vectors that are neither of the common size nor of size one are
+  // rejected.
+  EXPECT_THROW(fes::evaluate_tide(model.get(), epoch, leap_seconds,
+                                  Eigen::VectorXd::Constant(n - 1, 2.0), lat),
+               std::invalid_argument);
+}
+
+TEST(EvaluateTide, Grid) {
+  auto model = make_model();
+  constexpr auto n = 16;
+
+  auto epoch = Eigen::VectorXd::Constant(n, 1577836800.0);
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd(n);
+  auto lat = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < 4; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      lon(ix * 4 + jx) = ix;
+      lat(ix * 4 + jx) = jx;
+    }
+  }
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  Eigen::VectorXd grid_tide;
+  Eigen::VectorXd grid_long_period;
+  fes::Vector<fes::Quality> grid_quality;
+  std::tie(grid_tide, grid_long_period, grid_quality) =
+      fes::evaluate_tide_grid(model.get(), 1577836800.0, 27, lon, lat);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), grid_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), grid_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), grid_quality(ix));
+  }
+}
+
+TEST(EvaluateTide, FastSincos) {
+  auto model = make_model();
+  constexpr auto n = 8;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // The polynomial approximation stays well within the accuracy of the
+  // products.
+  auto settings = fes::Settings(fes::angle::Formulae::kSchuremanOrder1, 0.0,
+                                {}, 0, false, true);
+  Eigen::VectorXd fast_tide;
+  Eigen::VectorXd fast_long_period;
+  fes::Vector<fes::Quality> fast_quality;
+  std::tie(fast_tide, fast_long_period, fast_quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat, settings);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), fast_tide(ix), 1e-9);
+    EXPECT_NEAR(long_period(ix), fast_long_period(ix), 1e-9);
+    EXPECT_EQ(quality(ix), fast_quality(ix));
+  }
+}
+
+TEST(EvaluateTide, SinglePrecision) {
+  auto model = make_model();
+  constexpr auto n = 8;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // The single precision summation stays within the float epsilon of the
+  // double one, far below the centimetric accuracy of the quick-look
+  // products it targets.
+  auto settings = fes::Settings(fes::angle::Formulae::kSchuremanOrder1, 0.0,
+                                {}, 0, false, false, true);
+  Eigen::VectorXd single_tide;
+  Eigen::VectorXd single_long_period;
+  fes::Vector<fes::Quality> single_quality;
+  std::tie(single_tide, single_long_period, single_quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat, settings);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), single_tide(ix), 1e-4);
+    EXPECT_NEAR(long_period(ix), single_long_period(ix), 1e-4);
+    EXPECT_EQ(quality(ix), single_quality(ix));
+  }
+
+  // The fixed position time series overload honours the flag as well.
+  Eigen::VectorXd series_tide;
+  Eigen::VectorXd series_long_period;
+  fes::Vector<fes::Quality> series_quality;
+  std::tie(series_tide, series_long_period, series_quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, 2.0, 2.0, settings);
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), series_tide(ix), 1e-4);
+    EXPECT_NEAR(long_period(ix), series_long_period(ix), 1e-4);
+  }
+}
+
+TEST(EvaluateTide, AngleCacheHit) {
+  auto model = make_model();
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model->accelerator(fes::angle::Formulae::kSchuremanOrder1, 30.0));
+
+  // The first call always updates the angle; within the tolerance the angle
+  // is served from the cache and the flag reports it.
+  acc->calculate_angle(1577836800.0, 27);
+  EXPECT_TRUE(acc->angle_updated());
+  acc->calculate_angle(1577836810.0, 27);
+  EXPECT_FALSE(acc->angle_updated());
+  acc->calculate_angle(1577836900.0, 27);
+  EXPECT_TRUE(acc->angle_updated());
+}
+
+TEST(EvaluateTide, HarmonicSummationKernel) {
+  auto model = make_model();
+  auto wave_table = fes::detail::build_wave_table(model.get(),
+                                                  std::vector<fes::Constituent>{});
+  auto kernel = fes::detail::HarmonicSummationKernel(wave_table);
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model->accelerator(fes::angle::Formulae::kSchuremanOrder1, 0.0));
+
+  const auto& angles = acc->calculate_angle(1577836800.0, 27);
+  // The kernel evaluates the corrections data-driven; the scalar reference
+  // reads them from the wave objects, so both are updated here.
+  kernel.update_nodal_corrections(angles);
+  wave_table.compute_nodal_corrections(angles);
+  static_cast<fes::AbstractTidalModel<double>*>(model.get())
+      ->interpolate({2.0, 2.0}, wave_table, acc.get());
+  wave_table.admittance();
+
+  // The vectorized kernel must match the scalar summation.
+  auto h = 0.0;
+  auto h_long_period = 0.0;
+  fes::detail::accumulate_tide(wave_table, h, h_long_period);
+
+  auto kernel_h = 0.0;
+  auto kernel_h_long_period = 0.0;
+  kernel.accumulate(kernel_h, kernel_h_long_period);
+
+  EXPECT_NEAR(h, kernel_h, 1e-12);
+  EXPECT_NEAR(h_long_period, kernel_h_long_period, 1e-12);
+}
+
+TEST(EvaluateTide, Outer) {
+  auto model = make_model();
+  constexpr auto n_epochs = 6;
+  constexpr auto n_positions = 5;
+
+  auto epoch = Eigen::VectorXd(n_epochs);
+  for (auto ix = 0; ix < n_epochs; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(1, 27);
+  auto lon = Eigen::VectorXd(n_positions);
+  auto lat = Eigen::VectorXd(n_positions);
+  lon << 0.5, 1.5, 2.5, 3.5, 20.0;
+  lat << 0.5, 1.5, 2.5, 3.5, 20.0;
+
+  Eigen::MatrixXd tide;
+  Eigen::MatrixXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide_outer(model.get(), epoch, leap_seconds, lon, lat);
+
+  ASSERT_EQ(tide.rows(), n_epochs);
+  ASSERT_EQ(tide.cols(), n_positions);
+
+  // The last position is outside the model domain.
+  EXPECT_EQ(quality(n_positions - 1), fes::kUndefined);
+
+  // Each column must match the flattened evaluation at the same position.
+  for (auto jx = 0; jx < n_positions; ++jx) {
+    Eigen::VectorXd ref_tide;
+    Eigen::VectorXd ref_long_period;
+    fes::Vector<fes::Quality> ref_quality;
+    std::tie(ref_tide, ref_long_period, ref_quality) = fes::evaluate_tide(
+        model.get(), epoch, fes::Vector<uint16_t>::Constant(n_epochs, 27),
+        lon(jx), lat(jx));
+
+    for (auto ix = 0; ix < n_epochs; ++ix) {
+      if (ref_quality(ix) == fes::kUndefined) {
+        EXPECT_TRUE(std::isnan(tide(ix, jx)));
+      } else {
+        EXPECT_NEAR(tide(ix, jx), ref_tide(ix), 1e-9);
+      }
+      EXPECT_NEAR(long_period(ix, jx), ref_long_period(ix), 1e-9);
+      EXPECT_EQ(quality(jx), ref_quality(ix));
+    }
+  }
+}
+
+TEST(EvaluateTide, Uniform) {
+  auto model = make_model();
+  // One day sampled every minute.
+  constexpr auto n = 1440;
+  constexpr auto start = 1577836800.0;
+  constexpr auto step = 60.0;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = start + ix * step;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(1, 27);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) = fes::evaluate_tide(
+      model.get(), epoch, fes::Vector<uint16_t>::Constant(n, 27), 2.0, 2.0);
+
+  // Resynchronizing at every step reproduces the exact evaluation.
+  Eigen::VectorXd exact_tide;
+  Eigen::VectorXd exact_long_period;
+  fes::Vector<fes::Quality> exact_quality;
+  std::tie(exact_tide, exact_long_period, exact_quality) =
+      fes::evaluate_tide_uniform(model.get(), start, step, n, leap_seconds,
+                                 2.0, 2.0, step);
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), exact_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), exact_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), exact_quality(ix));
+  }
+
+  // With the default hourly resynchronization the recurrence only
+  // approximates the slowly varying terms within the window.
+  Eigen::VectorXd fast_tide;
+  Eigen::VectorXd fast_long_period;
+  fes::Vector<fes::Quality> fast_quality;
+  std::tie(fast_tide, fast_long_period, fast_quality) =
+      fes::evaluate_tide_uniform(model.get(), start, step, n, leap_seconds,
+                                 2.0, 2.0);
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), fast_tide(ix), 1e-4);
+    EXPECT_NEAR(long_period(ix), fast_long_period(ix), 1e-4);
+    EXPECT_EQ(quality(ix), fast_quality(ix));
+  }
+
+  EXPECT_THROW(fes::evaluate_tide_uniform(model.get(), start, -step, n,
+                                          leap_seconds, 2.0, 2.0),
+               std::invalid_argument);
+}
+
+TEST(EvaluateTide, BatchedHarmonicSummationKernel) {
+  auto model = make_model();
+  auto wave_table = fes::detail::build_wave_table(
+      model.get(), std::vector<fes::Constituent>{});
+  constexpr auto n = 4;
+  auto kernel = fes::detail::BatchedHarmonicSummationKernel(wave_table, n);
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model->accelerator(fes::angle::Formulae::kSchuremanOrder1, 0.0));
+
+  static_cast<fes::AbstractTidalModel<double>*>(model.get())
+      ->interpolate({2.0, 2.0}, wave_table, acc.get());
+  wave_table.admittance();
+  kernel.load_constituents();
+
+  auto h = Eigen::VectorXd(n);
+  auto h_long_period = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    const auto& angles =
+        acc->calculate_angle(1577836800.0 + ix * 3600.0, 27);
+    kernel.gather(ix, angles);
+    wave_table.compute_nodal_corrections(angles);
+    // The scalar summation is the reference.
+    h(ix) = 0.0;
+    h_long_period(ix) = 0.0;
+    fes::detail::accumulate_tide(wave_table, h(ix), h_long_period(ix));
+  }
+
+  auto batched_h = Eigen::VectorXd::Zero(n).eval();
+  auto batched_h_long_period = Eigen::VectorXd::Zero(n).eval();
+  kernel.evaluate(n, batched_h, batched_h_long_period);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(h(ix), batched_h(ix), 1e-12);
+    EXPECT_NEAR(h_long_period(ix), batched_h_long_period(ix), 1e-12);
+  }
+}
+
+TEST(EvaluateTide, FixedPositionUndefined) {
+  auto model = make_model();
+  constexpr auto n = 4;
+
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  // The position is outside the model domain.
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, 20.0, 20.0);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_TRUE(std::isnan(tide(ix)));
+    EXPECT_FALSE(std::isnan(long_period(ix)));
+    EXPECT_EQ(quality(ix), fes::kUndefined);
+  }
+}
+
+TEST(EvaluateTide, GroupByEpoch) {
+  auto model = make_model();
+  constexpr auto n = 12;
+
+  // Position-sorted crossover-like inputs: each position is observed at a
+  // few distinct epochs, so consecutive indices jump between epochs.
+  auto epoch = Eigen::VectorXd(n);
+  auto lon = Eigen::VectorXd(n);
+  auto lat = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + (ix % 3) * 3600.0;
+    lon(ix) = 1.0 + 0.5 * (ix / 3);
+    lat(ix) = 2.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // Grouping the indices by epoch only changes the evaluation order, not
+  // the result or its ordering.
+  auto settings = fes::Settings(fes::angle::Formulae::kSchuremanOrder1, 0.0,
+                                {}, 0, false, false, false, true);
+  Eigen::VectorXd grouped_tide;
+  Eigen::VectorXd grouped_long_period;
+  fes::Vector<fes::Quality> grouped_quality;
+  std::tie(grouped_tide, grouped_long_period, grouped_quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat, settings,
+                         1);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_NEAR(tide(ix), grouped_tide(ix), 1e-12);
+    EXPECT_NEAR(long_period(ix), grouped_long_period(ix), 1e-12);
+    EXPECT_EQ(quality(ix), grouped_quality(ix));
+  }
+}
+
+TEST(EvaluateTide, InternalLeapSeconds) {
+  auto model = make_model();
+  constexpr auto n = 4;
+
+  auto epoch = Eigen::VectorXd(n);
+  auto lon = Eigen::VectorXd(n);
+  auto lat = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+    lon(ix) = 1.0 + 0.5 * ix;
+    lat(ix) = 2.0;
+  }
+  // 37 leap seconds have elapsed at the epochs of the series.
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 37);
+
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide(model.get(), epoch, leap_seconds, lon, lat);
+
+  // The overload without leap seconds resolves the same values from the
+  // embedded IERS table.
+  Eigen::VectorXd resolved_tide;
+  Eigen::VectorXd resolved_long_period;
+  fes::Vector<fes::Quality> resolved_quality;
+  std::tie(resolved_tide, resolved_long_period, resolved_quality) =
+      fes::evaluate_tide(model.get(), epoch, lon, lat);
+
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_DOUBLE_EQ(tide(ix), resolved_tide(ix));
+    EXPECT_DOUBLE_EQ(long_period(ix), resolved_long_period(ix));
+    EXPECT_EQ(quality(ix), resolved_quality(ix));
+  }
+}
+
+TEST(EvaluateExtrema, AgainstDenseSampling) {
+  auto model = make_model();
+  // Three days starting on 2020-01-01T00:00:00Z.
+  const auto start = 1577836800.0;
+  const auto end = start + 3.0 * 86400.0;
+
+  Eigen::VectorXd times;
+  Eigen::VectorXd heights;
+  fes::Vector<fes::ExtremumType> types;
+  fes::Quality quality;
+  std::tie(times, heights, types, quality) =
+      fes::evaluate_extrema(model.get(), start, end, 2.0, 2.0);
+  ASSERT_EQ(quality, fes::kInterpolated);
+  ASSERT_GT(times.size(), 0);
+
+  // Dense reference: one-minute sampling of the prediction scanned for the
+  // local extrema of the total water level.
+  constexpr auto minute = 60.0;
+  const auto n = static_cast<Eigen::Index>((end - start) / minute) + 1;
+  auto epoch = Eigen::VectorXd(n);
+  for (Eigen::Index ix = 0; ix < n; ++ix) {
+    epoch(ix) = start + static_cast<double>(ix) * minute;
+  }
+  Eigen::VectorXd tide;
+  Eigen::VectorXd long_period;
+  fes::Vector<fes::Quality> tide_quality;
+  std::tie(tide, long_period, tide_quality) =
+      fes::evaluate_tide(model.get(), epoch, 2.0, 2.0);
+  auto h = Eigen::VectorXd(tide + long_period);
+
+  auto expected_times = std::vector<double>();
+  auto expected_types = std::vector<fes::ExtremumType>();
+  for (Eigen::Index ix = 1; ix < n - 1; ++ix) {
+    if (h(ix) > h(ix - 1) && h(ix) >= h(ix + 1)) {
+      expected_times.push_back(epoch(ix));
+      expected_types.push_back(fes::kHighWater);
+    } else if (h(ix) < h(ix - 1) && h(ix) <= h(ix + 1)) {
+      expected_times.push_back(epoch(ix));
+      expected_types.push_back(fes::kLowWater);
+    }
+  }
+
+  ASSERT_EQ(static_cast<size_t>(times.size()), expected_times.size());
+  for (Eigen::Index ix = 0; ix < times.size(); ++ix) {
+    EXPECT_EQ(types(ix), expected_types[static_cast<size_t>(ix)]);
+    // The dense scan resolves the times to one minute.
+    EXPECT_NEAR(times(ix), expected_times[static_cast<size_t>(ix)], minute);
+    // The height at the extremum matches the full prediction at the found
+    // time: only the drift of the nodal corrections, held constant within
+    // the resynchronization window, separates the two.
+    Eigen::VectorXd check_tide;
+    Eigen::VectorXd check_long_period;
+    fes::Vector<fes::Quality> check_quality;
+    std::tie(check_tide, check_long_period, check_quality) =
+        fes::evaluate_tide(model.get(), Eigen::VectorXd::Constant(1, times(ix)),
+                           2.0, 2.0);
+    EXPECT_NEAR(heights(ix), check_tide(0) + check_long_period(0), 1e-3);
+  }
+}
+
+TEST(EvaluateExtrema, Undefined) {
+  auto model = make_model();
+  const auto start = 1577836800.0;
+
+  Eigen::VectorXd times;
+  Eigen::VectorXd heights;
+  fes::Vector<fes::ExtremumType> types;
+  fes::Quality quality;
+  std::tie(times, heights, types, quality) =
+      fes::evaluate_extrema(model.get(), start, start + 86400.0, 30.0, 2.0);
+  EXPECT_EQ(quality, fes::kUndefined);
+  EXPECT_EQ(times.size(), 0);
+  EXPECT_EQ(heights.size(), 0);
+  EXPECT_EQ(types.size(), 0);
+}
+
+TEST(EvaluateExtrema, InvalidArguments) {
+  auto model = make_model();
+  const auto start = 1577836800.0;
+
+  EXPECT_THROW(fes::evaluate_extrema(model.get(), start, start - 1.0, 2.0, 2.0),
+               std::invalid_argument);
+  EXPECT_THROW(
+      fes::evaluate_extrema(model.get(), start, start + 86400.0, 2.0, 2.0, 0.0),
+      std::invalid_argument);
+  EXPECT_THROW(fes::evaluate_extrema(model.get(), start, start + 86400.0, 2.0,
+                                     2.0, 1800.0, 0.0),
+               std::invalid_argument);
+}
+
+TEST(EvaluateTide, Group) {
+  auto tide_model = make_model();
+  // Radial field defined on the same axes as the tide field.
+  auto points = Eigen::VectorXd(5);
+  points << 0, 1, 2, 3, 4;
+  auto axis = fes::Axis(points);
+  auto radial_model = std::unique_ptr<fes::tidal_model::Cartesian<double>>(
+      new fes::tidal_model::Cartesian<double>(axis, axis, fes::kRadial));
+  radial_model->add_constituent(
+      fes::kM2, Eigen::VectorXcd::Constant(25, std::complex<double>(3, 1)));
+  radial_model->add_constituent(
+      fes::kK1, Eigen::VectorXcd::Constant(25, std::complex<double>(-1, 2)));
+  ASSERT_TRUE(radial_model->shares_spatial_cache(*tide_model));
+
+  constexpr auto n = 24;
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  const auto models = std::vector<const fes::AbstractTidalModel<double>*>{
+      tide_model.get(), radial_model.get()};
+  Eigen::MatrixXd tide;
+  Eigen::MatrixXd long_period;
+  fes::Matrix<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide_group(models, epoch, leap_seconds, lon, lat);
+  ASSERT_EQ(tide.rows(), n);
+  ASSERT_EQ(tide.cols(), 2);
+
+  // Each column matches the independent evaluation of its model.
+  for (auto kx = 0; kx < 2; ++kx) {
+    Eigen::VectorXd expected_tide;
+    Eigen::VectorXd expected_long_period;
+    fes::Vector<fes::Quality> expected_quality;
+    std::tie(expected_tide, expected_long_period, expected_quality) =
+        fes::evaluate_tide(models[static_cast<size_t>(kx)], epoch,
+                           leap_seconds, lon, lat);
+    for (auto ix = 0; ix < n; ++ix) {
+      EXPECT_DOUBLE_EQ(tide(ix, kx), expected_tide(ix));
+      EXPECT_DOUBLE_EQ(long_period(ix, kx), expected_long_period(ix));
+      EXPECT_EQ(quality(ix, kx), expected_quality(ix));
+    }
+  }
+
+  // Both fields share the cell selected for the first one: the group pays a
+  // single axis search for the whole run.
+  fes::reset_perf_counters();
+  fes::evaluate_tide_group(models, epoch, leap_seconds, lon, lat,
+                           fes::Settings(), 1);
+  EXPECT_EQ(fes::perf_counters().searches, 1);
+
+  // The group must not be empty or contain null models.
+  EXPECT_THROW(fes::evaluate_tide_group(
+                   std::vector<const fes::AbstractTidalModel<double>*>(),
+                   epoch, leap_seconds, lon, lat),
+               std::invalid_argument);
+  EXPECT_THROW(fes::evaluate_tide_group(
+                   std::vector<const fes::AbstractTidalModel<double>*>{
+                       tide_model.get(), nullptr},
+                   epoch, leap_seconds, lon, lat),
+               std::invalid_argument);
+}
+
+TEST(EvaluateTide, GroupInternalLeapSeconds) {
+  auto model = make_model();
+  constexpr auto n = 8;
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto lon = Eigen::VectorXd::Constant(n, 2.0);
+  auto lat = Eigen::VectorXd::Constant(n, 2.0);
+
+  const auto models =
+      std::vector<const fes::AbstractTidalModel<double>*>{model.get()};
+  Eigen::MatrixXd tide;
+  Eigen::MatrixXd long_period;
+  fes::Matrix<fes::Quality> quality;
+  std::tie(tide, long_period, quality) =
+      fes::evaluate_tide_group(models, epoch, lon, lat);
+
+  Eigen::VectorXd expected_tide;
+  Eigen::VectorXd expected_long_period;
+  fes::Vector<fes::Quality> expected_quality;
+  std::tie(expected_tide, expected_long_period, expected_quality) =
+      fes::evaluate_tide(model.get(), epoch, lon, lat);
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_DOUBLE_EQ(tide(ix, 0), expected_tide(ix));
+    EXPECT_DOUBLE_EQ(long_period(ix, 0), expected_long_period(ix));
+    EXPECT_EQ(quality(ix, 0), expected_quality(ix));
+  }
+}
+
+TEST(EvaluateTide, FixedKernel) {
+  auto model = make_model();
+
+  // Restrict the active waves to the constituents provided by the model, so
+  // the table matches the set declared at compile time.
+  auto wave_table = fes::detail::build_wave_table(model.get(),
+                                                  std::vector<fes::Constituent>());
+  for (const auto& wave : wave_table) {
+    if (!wave->dynamic()) {
+      wave->admittance(false);
+    }
+  }
+  auto lpe = fes::wave::LongPeriodEquilibrium(wave_table);
+  auto dynamic_kernel = fes::detail::HarmonicSummationKernel(wave_table);
+  auto fixed_kernel =
+      fes::detail::FixedHarmonicSummationKernel<fes::kM2, fes::kK1, fes::kO1>(
+          wave_table);
+
+  // The fixed kernel matches the dynamic one epoch per epoch.
+  auto dynamic_acc = std::unique_ptr<fes::Accelerator>(
+      model->accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  auto fixed_acc = std::unique_ptr<fes::Accelerator>(
+      model->accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  for (auto ix = 0; ix < 48; ++ix) {
+    const auto epoch = 1577836800.0 + ix * 1800.0;
+    const auto expected = fes::detail::evaluate_tide(
+        model.get(), epoch, uint16_t{27}, 2.0, 2.0, wave_table, lpe,
+        dynamic_kernel, dynamic_acc.get());
+    const auto actual = fes::detail::evaluate_tide(
+        model.get(), epoch, uint16_t{27}, 2.0, 2.0, wave_table, lpe,
+        fixed_kernel, fixed_acc.get());
+    EXPECT_DOUBLE_EQ(std::get<0>(expected), std::get<0>(actual));
+    EXPECT_DOUBLE_EQ(std::get<1>(expected), std::get<1>(actual));
+    EXPECT_EQ(std::get<2>(expected), std::get<2>(actual));
+  }
+
+  // A declared set that does not match the active waves of the table is
+  // rejected, whether the count or the identifiers differ.
+  using WrongCount =
+      fes::detail::FixedHarmonicSummationKernel<fes::kM2, fes::kK1>;
+  using WrongSet =
+      fes::detail::FixedHarmonicSummationKernel<fes::kM2, fes::kK1, fes::kS2>;
+  EXPECT_THROW(WrongCount{wave_table}, std::invalid_argument);
+  EXPECT_THROW(WrongSet{wave_table}, std::invalid_argument);
+}
+
+TEST(EvaluateTide, BoundAccelerator) {
+  auto model = make_model();
+  auto wave_table = fes::detail::build_wave_table(model.get(),
+                                                  std::vector<fes::Constituent>());
+  auto acc = std::unique_ptr<fes::Accelerator>(
+      model->accelerator(fes::angle::Formulae::kMeeus, 0.0));
+
+  const fes::AbstractTidalModel<double>* base = model.get();
+
+  // A bound accelerator writes the interpolated values straight into the
+  // wave table slots: the intermediate buffer stays empty.
+  EXPECT_FALSE(acc->bound());
+  acc->bind(wave_table);
+  EXPECT_TRUE(acc->bound());
+  const auto quality = base->interpolate({2.0, 2.0}, wave_table, acc.get());
+  EXPECT_EQ(quality, fes::kInterpolated);
+  EXPECT_TRUE(acc->values().empty());
+  EXPECT_EQ(wave_table[fes::kM2]->tide(), std::complex<double>(10, 5));
+  EXPECT_EQ(wave_table[fes::kK1]->tide(), std::complex<double>(4, -2));
+  EXPECT_EQ(wave_table[fes::kO1]->tide(), std::complex<double>(1, 3));
+
+  // An unbound accelerator fills the table through the copy pass and both
+  // paths agree.
+  auto other_table = fes::detail::build_wave_table(model.get(),
+                                                   std::vector<fes::Constituent>());
+  auto unbound = std::unique_ptr<fes::Accelerator>(
+      model->accelerator(fes::angle::Formulae::kMeeus, 0.0));
+  const auto expected =
+      base->interpolate({2.0, 2.0}, other_table, unbound.get());
+  EXPECT_EQ(quality, expected);
+  EXPECT_EQ(wave_table[fes::kM2]->tide(), other_table[fes::kM2]->tide());
+}
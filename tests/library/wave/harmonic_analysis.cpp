@@ -0,0 +1,74 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/wave/harmonic_analysis.hpp"
+
+#include <gtest/gtest.h>
+
+#include "fes/wave/table.hpp"
+
+TEST(HarmonicAnalysis, Solve) {
+  auto table = fes::wave::Table({"O1", "K1", "M2"});
+  constexpr auto n_times = 240;
+  auto epoch = Eigen::VectorXd(n_times);
+  for (auto ix = 0; ix < n_times; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n_times, 27);
+
+  Eigen::MatrixXd f;
+  Eigen::MatrixXd vu;
+  std::tie(f, vu) = table.compute_nodal_modulations(
+      epoch, leap_seconds, fes::angle::Formulae::kSchuremanOrder3);
+
+  auto analysis = fes::wave::HarmonicAnalysis(f, vu);
+  EXPECT_EQ(analysis.size(), 3);
+
+  // Synthetic sea level series built from known tidal constants.
+  constexpr auto n_points = 5;
+  auto h = Eigen::MatrixXd(n_points, n_times);
+  for (auto ix = 0; ix < n_points; ++ix) {
+    for (auto jx = 0; jx < n_times; ++jx) {
+      h(ix, jx) = 0.0;
+      for (auto kx = 0; kx < 3; ++kx) {
+        h(ix, jx) += f(kx, jx) * ((1.0 + ix + kx) * std::cos(vu(kx, jx)) +
+                                  (2.0 - ix) * std::sin(vu(kx, jx)));
+      }
+    }
+  }
+  h(3, 7) = std::numeric_limits<double>::quiet_NaN();
+
+  // The context must match the one-shot entry points bit-for-bit: both run
+  // the same factorization and solves.
+  for (auto ix = 0; ix < n_points; ++ix) {
+    const auto expected =
+        fes::wave::Table::harmonic_analysis(h.row(ix).transpose(), f, vu);
+    const auto actual = analysis.solve(h.row(ix).transpose());
+    for (auto kx = 0; kx < 3; ++kx) {
+      if (ix == 3) {
+        EXPECT_TRUE(std::isnan(actual(kx).real()));
+        EXPECT_TRUE(std::isnan(actual(kx).imag()));
+        continue;
+      }
+      EXPECT_EQ(expected(kx), actual(kx));
+    }
+  }
+
+  const auto expected = fes::wave::Table::batched_harmonic_analysis(h, f, vu);
+  const auto actual = analysis.batched_solve(h);
+  for (auto ix = 0; ix < n_points; ++ix) {
+    if (ix == 3) {
+      continue;
+    }
+    for (auto kx = 0; kx < 3; ++kx) {
+      EXPECT_EQ(expected(kx, ix), actual(kx, ix));
+    }
+  }
+
+  // A series sampled on another time base is rejected.
+  EXPECT_THROW(analysis.solve(Eigen::VectorXd::Zero(n_times - 1)),
+               std::invalid_argument);
+  EXPECT_THROW(analysis.batched_solve(Eigen::MatrixXd::Zero(2, n_times - 1)),
+               std::invalid_argument);
+}
@@ -85,3 +85,43 @@ TEST(WaveOrder2, LpeMinus5WavesAvisoFES) {
   EXPECT_NEAR(lpe.lpe_minus_n_waves(AstronomicAngle(true), 1),
               -0.63411272420708709, 1e-6);
 }
+
+TEST(WaveOrder2, LpeMinusNWavesBatched) {
+  auto table = fes::wave::Table();
+  auto lpe = fes::wave::LongPeriodEquilibrium(table);
+
+  // Consecutive points sharing an epoch reuse the spectral summation, so the
+  // batched evaluation must match the scalar one exactly.
+  constexpr auto n = 12;
+  auto epoch = Eigen::VectorXd(n);
+  auto lat = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + (ix / 3) * 3600.0;
+    lat(ix) = -60.0 + ix * 10.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+
+  const auto batched = lpe.lpe_minus_n_waves(
+      epoch, leap_seconds, lat, fes::angle::Formulae::kSchuremanOrder3);
+  ASSERT_EQ(batched.size(), n);
+  for (auto ix = 0; ix < n; ++ix) {
+    const auto angles = fes::angle::Astronomic(
+        fes::angle::Formulae::kSchuremanOrder3, epoch(ix), 27);
+    EXPECT_EQ(batched(ix), lpe.lpe_minus_n_waves(angles, lat(ix)));
+  }
+
+  // A size-1 date is broadcast against the positions.
+  const auto broadcast = lpe.lpe_minus_n_waves(
+      epoch.head(1), leap_seconds.head(1), lat,
+      fes::angle::Formulae::kSchuremanOrder3);
+  for (auto ix = 0; ix < n; ++ix) {
+    const auto angles = fes::angle::Astronomic(
+        fes::angle::Formulae::kSchuremanOrder3, epoch(0), 27);
+    EXPECT_EQ(broadcast(ix), lpe.lpe_minus_n_waves(angles, lat(ix)));
+  }
+
+  // Mismatched sizes are rejected.
+  EXPECT_THROW(lpe.lpe_minus_n_waves(epoch, leap_seconds.head(2), lat,
+                                     fes::angle::Formulae::kSchuremanOrder3),
+               std::invalid_argument);
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2024 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "fes/wave/soa_table.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(SoaTable, Partition) {
+  auto table = fes::wave::Table();
+  for (auto&& item : table) {
+    item->admittance(item->ident() == fes::kM2 || item->ident() == fes::kMf);
+    item->dynamic(item->ident() == fes::kO1);
+  }
+  auto soa = fes::wave::SoaTable(table);
+
+  // The active waves are partitioned with the short period constituents
+  // first.
+  ASSERT_EQ(soa.size(), 3);
+  EXPECT_EQ(soa.n_short(), 2);
+  for (Eigen::Index ix = 0; ix < soa.size(); ++ix) {
+    const auto* wave = soa.waves()[static_cast<size_t>(ix)];
+    EXPECT_EQ(wave->type(), ix < soa.n_short() ? fes::Wave::kShortPeriod
+                                               : fes::Wave::kLongPeriod);
+    EXPECT_EQ(soa.freq()(ix), wave->freq());
+  }
+}
+
+TEST(SoaTable, Mirror) {
+  auto table = fes::wave::Table();
+  for (auto&& item : table) {
+    item->admittance(item->ident() == fes::kM2 || item->ident() == fes::kMf);
+    item->dynamic(false);
+  }
+  auto soa = fes::wave::SoaTable(table);
+
+  const auto angles = fes::angle::Astronomic(
+      fes::angle::Formulae::kSchuremanOrder1, 1577836800.0, 27);
+  // The data-driven evaluation must match the per-wave virtual one.
+  soa.update_nodal_corrections(angles);
+  table.compute_nodal_corrections(angles);
+  table[fes::kM2]->tide({1.0, 2.0});
+  table[fes::kMf]->tide({3.0, 4.0});
+  soa.update_tide();
+
+  for (Eigen::Index ix = 0; ix < soa.size(); ++ix) {
+    const auto* wave = soa.waves()[static_cast<size_t>(ix)];
+    EXPECT_EQ(soa.f()(ix), wave->f());
+    EXPECT_EQ(soa.vu()(ix), wave->vu());
+    EXPECT_EQ(soa.real()(ix), wave->tide().real());
+    EXPECT_EQ(soa.imag()(ix), wave->tide().imag());
+  }
+}
+
+TEST(SoaTable, PhaseCorrections) {
+  // M13 and L2 add a phase term that is not a linear combination of the
+  // astronomic angles; the data-driven evaluation must reproduce their
+  // nodal_g overrides.
+  auto table = fes::wave::Table();
+  for (auto&& item : table) {
+    item->admittance(item->ident() == fes::kM13 || item->ident() == fes::kL2);
+    item->dynamic(false);
+  }
+  auto soa = fes::wave::SoaTable(table);
+
+  const auto angles = fes::angle::Astronomic(
+      fes::angle::Formulae::kSchuremanOrder1, 1577836800.0, 27);
+  soa.update_nodal_corrections(angles);
+  table.compute_nodal_corrections(angles);
+
+  for (Eigen::Index ix = 0; ix < soa.size(); ++ix) {
+    const auto* wave = soa.waves()[static_cast<size_t>(ix)];
+    EXPECT_EQ(soa.f()(ix), wave->f());
+    EXPECT_EQ(soa.vu()(ix), wave->vu());
+  }
+}
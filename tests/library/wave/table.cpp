@@ -480,3 +480,207 @@ TEST(WaveTable, Sparse) {
   EXPECT_EQ(table.find("Mf"), nullptr);
   EXPECT_EQ(table.find("O1")->ident(), fes::kO1);
 }
+
+TEST(WaveTable, Clone) {
+  auto table = fes::wave::Table();
+  table[fes::kM2]->dynamic(true);
+  table[fes::kM2]->admittance(false);
+  table[fes::kM2]->tide({1, 2});
+  const auto angles = fes::angle::Astronomic(
+      fes::angle::Formulae::kSchuremanOrder1, 1577836800.0, 27);
+  table.compute_nodal_corrections(angles);
+
+  auto clone = table.clone();
+  ASSERT_EQ(clone.size(), table.size());
+  for (size_t ix = 0; ix < table.size(); ++ix) {
+    const auto& source = table[ix];
+    const auto& copy = clone[ix];
+    // The clone holds its own copies of the wave objects, with the same
+    // state.
+    EXPECT_NE(source.get(), copy.get());
+    EXPECT_EQ(source->ident(), copy->ident());
+    EXPECT_EQ(source->admittance(), copy->admittance());
+    EXPECT_EQ(source->dynamic(), copy->dynamic());
+    EXPECT_EQ(source->f(), copy->f());
+    EXPECT_EQ(source->vu(), copy->vu());
+    EXPECT_EQ(source->tide(), copy->tide());
+  }
+
+  // Mutating the clone does not affect the source table.
+  clone[fes::kM2]->tide({3, 4});
+  EXPECT_EQ(table[fes::kM2]->tide(), std::complex<double>(1, 2));
+
+  // The nodal corrections of the two special constituents keep their
+  // concrete class behaviour.
+  const auto other = fes::angle::Astronomic(
+      fes::angle::Formulae::kSchuremanOrder1, 1609459200.0, 27);
+  clone.compute_nodal_corrections(other);
+  table.compute_nodal_corrections(other);
+  EXPECT_EQ(clone[fes::kM13]->vu(), table[fes::kM13]->vu());
+  EXPECT_EQ(clone[fes::kL2]->vu(), table[fes::kL2]->vu());
+
+  // A sparse table can be cloned too.
+  auto sparse = fes::wave::Table({"O1", "K1", "M2"});
+  auto sparse_clone = sparse.clone();
+  EXPECT_EQ(sparse_clone.size(), 3);
+  EXPECT_THROW(sparse_clone[fes::kP1], std::out_of_range);
+}
+
+TEST(WaveTable, BatchedHarmonicAnalysis) {
+  auto table = fes::wave::Table({"O1", "K1", "M2"});
+  constexpr auto n_times = 240;
+  constexpr auto n_points = 17;
+  auto epoch = Eigen::VectorXd(n_times);
+  for (auto ix = 0; ix < n_times; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n_times, 27);
+
+  Eigen::MatrixXd f;
+  Eigen::MatrixXd vu;
+  std::tie(f, vu) = table.compute_nodal_modulations(
+      epoch, leap_seconds, fes::angle::Formulae::kSchuremanOrder3);
+
+  // Synthetic sea level series built from known tidal constants.
+  auto h = Eigen::MatrixXd(n_points, n_times);
+  for (auto ix = 0; ix < n_points; ++ix) {
+    for (auto jx = 0; jx < n_times; ++jx) {
+      h(ix, jx) = 0.0;
+      for (auto kx = 0; kx < 3; ++kx) {
+        h(ix, jx) += f(kx, jx) * ((1.0 + ix + kx) * std::cos(vu(kx, jx)) +
+                                  (2.0 - ix) * std::sin(vu(kx, jx)));
+      }
+    }
+  }
+  // The 4th point is undefined.
+  h(3, 7) = std::numeric_limits<double>::quiet_NaN();
+
+  const auto batched = fes::wave::Table::batched_harmonic_analysis(h, f, vu, 1);
+  ASSERT_EQ(batched.rows(), 3);
+  ASSERT_EQ(batched.cols(), n_points);
+
+  // Each column must match the per-point analysis.
+  for (auto ix = 0; ix < n_points; ++ix) {
+    const auto reference =
+        fes::wave::Table::harmonic_analysis(h.row(ix).transpose(), f, vu);
+    for (auto kx = 0; kx < 3; ++kx) {
+      if (ix == 3) {
+        EXPECT_TRUE(std::isnan(batched(kx, ix).real()));
+        EXPECT_TRUE(std::isnan(batched(kx, ix).imag()));
+        continue;
+      }
+      EXPECT_NEAR(batched(kx, ix).real(), reference(kx).real(), 1e-9);
+      EXPECT_NEAR(batched(kx, ix).imag(), reference(kx).imag(), 1e-9);
+      EXPECT_NEAR(batched(kx, ix).real(), 1.0 + ix + kx, 1e-6);
+      EXPECT_NEAR(batched(kx, ix).imag(), 2.0 - ix, 1e-6);
+    }
+  }
+
+  // The workers only change how the points are distributed, not the result.
+  const auto parallel = fes::wave::Table::batched_harmonic_analysis(h, f, vu, 4);
+  for (auto ix = 0; ix < n_points; ++ix) {
+    if (ix == 3) {
+      continue;
+    }
+    for (auto kx = 0; kx < 3; ++kx) {
+      EXPECT_EQ(batched(kx, ix), parallel(kx, ix));
+    }
+  }
+
+  auto mismatched = Eigen::MatrixXd(n_points, n_times - 1);
+  EXPECT_THROW(fes::wave::Table::batched_harmonic_analysis(mismatched, f, vu),
+               std::invalid_argument);
+}
+
+TEST(WaveTable, TideFromTideSeries) {
+  auto table = fes::wave::Table({"O1", "K1", "M2"});
+  auto wave = Eigen::VectorXcd(3);
+  wave << std::complex<double>(1.0, 2.0), std::complex<double>(4.0, -2.0),
+      std::complex<double>(10.0, 5.0);
+
+  constexpr auto n = 48;
+  auto epoch = Eigen::VectorXd(n);
+  for (auto ix = 0; ix < n; ++ix) {
+    epoch(ix) = 1577836800.0 + ix * 3600.0;
+  }
+  auto leap_seconds = fes::Vector<uint16_t>::Constant(n, 27);
+
+  const auto serial = table.tide_from_tide_series(
+      epoch, leap_seconds, wave, fes::angle::Formulae::kSchuremanOrder3, 0.0,
+      1);
+  // The workers only change how the epochs are distributed, not the result.
+  const auto parallel = table.tide_from_tide_series(
+      epoch, leap_seconds, wave, fes::angle::Formulae::kSchuremanOrder3, 0.0,
+      4);
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_EQ(serial(ix), parallel(ix));
+  }
+
+  // A tolerance smaller than the sampling step never serves the angles from
+  // the cache.
+  const auto exact = table.tide_from_tide_series(
+      epoch, leap_seconds, wave, fes::angle::Formulae::kSchuremanOrder3,
+      1800.0, 1);
+  for (auto ix = 0; ix < n; ++ix) {
+    EXPECT_EQ(serial(ix), exact(ix));
+  }
+
+  // Within the tolerance the angles are considered constant, so the epochs
+  // of a window share the value of its first epoch.
+  const auto tolerant = table.tide_from_tide_series(
+      epoch, leap_seconds, wave, fes::angle::Formulae::kSchuremanOrder3,
+      7200.0, 1);
+  for (auto ix = 0; ix < n; ix += 3) {
+    EXPECT_EQ(tolerant(ix), serial(ix));
+    for (auto jx = ix + 1; jx < std::min(ix + 3, n); ++jx) {
+      EXPECT_EQ(tolerant(jx), tolerant(ix));
+    }
+  }
+}
+
+TEST(WaveTable, TideFromMapping) {
+  auto table = fes::wave::Table({"O1", "K1", "M2"});
+  constexpr auto n_positions = 23;
+  auto mapping = Eigen::MatrixXcd(3, n_positions);
+  for (auto ix = 0; ix < n_positions; ++ix) {
+    mapping(0, ix) = std::complex<double>(1.0 + ix, 2.0);
+    mapping(1, ix) = std::complex<double>(4.0, -2.0 + ix);
+    mapping(2, ix) = std::complex<double>(10.0 - ix, 5.0);
+  }
+
+  const auto reference = table.tide_from_mapping(1577836800.0, 27, mapping);
+  ASSERT_EQ(reference.rows(), n_positions);
+  ASSERT_EQ(reference.cols(), 3);
+
+  // The scalar evaluation must match the tiled sweep.
+  auto wt = table.clone();
+  wt.compute_nodal_corrections(fes::angle::Astronomic(
+      fes::angle::Formulae::kSchuremanOrder3, 1577836800.0, 27));
+  for (auto ix = 0; ix < n_positions; ++ix) {
+    for (size_t jx = 0; jx < wt.size(); ++jx) {
+      const auto& item = wt[jx];
+      const auto phi = item->vu();
+      const auto expected =
+          item->f() * (mapping(jx, ix).real() * std::cos(phi) +
+                       mapping(jx, ix).imag() * std::sin(phi));
+      EXPECT_NEAR(reference(ix, jx), expected, 1e-12);
+    }
+  }
+
+  // The tile size only changes the sweep order, not the result.
+  for (const auto tile_size : {1, 2, 7}) {
+    const auto tiled = table.tide_from_mapping(
+        1577836800.0, 27, mapping, fes::angle::Formulae::kSchuremanOrder3, 1,
+        tile_size);
+    for (auto ix = 0; ix < n_positions; ++ix) {
+      for (auto jx = 0; jx < 3; ++jx) {
+        EXPECT_EQ(reference(ix, jx), tiled(ix, jx));
+      }
+    }
+  }
+
+  EXPECT_THROW(table.tide_from_mapping(1577836800.0, 27, mapping,
+                                       fes::angle::Formulae::kSchuremanOrder3,
+                                       1, 0),
+               std::invalid_argument);
+}
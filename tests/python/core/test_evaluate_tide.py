@@ -189,3 +189,88 @@ def test_tide():
                                 lats,
                                 num_threads=1)
     check_tide(tide, radial)
+
+
+def test_datetime64_units_and_strides():
+    """The datetime64 conversion must not depend on the unit or on the
+    memory layout of the date array."""
+    axis = core.Axis(numpy.arange(0, 5, dtype=numpy.float64))
+    model = core.tidal_model.CartesianComplex128(axis, axis)
+    model.add_constituent('M2', numpy.full((25, ), 10 + 5j))
+    model.add_constituent('K1', numpy.full((25, ), 4 - 2j))
+
+    dates = numpy.arange('2020-01-01', '2020-01-02', numpy.timedelta64(1, 'h'),
+                         dtype='M8[us]')
+    size = dates.size
+    leap_seconds = numpy.full((size, ), 27, dtype=numpy.uint16)
+    lons = numpy.full((size, ), 2.0)
+    lats = numpy.full((size, ), 2.0)
+
+    reference = core.evaluate_tide(model, dates, leap_seconds, lons, lats,
+                                   num_threads=1)
+
+    for unit in ('M8[ns]', 'M8[us]', 'M8[ms]', 'M8[s]'):
+        tide = core.evaluate_tide(model, dates.astype(unit), leap_seconds,
+                                  lons, lats, num_threads=1)
+        assert tide[0] == pytest.approx(reference[0])
+        assert tide[1] == pytest.approx(reference[1])
+
+    # A reversed view is read through its strides, without an intermediate
+    # copy.
+    tide = core.evaluate_tide(model, dates[::-1], leap_seconds, lons, lats,
+                              num_threads=1)
+    assert tide[0] == pytest.approx(reference[0][::-1])
+    assert tide[1] == pytest.approx(reference[1][::-1])
+
+
+def test_out_parameter():
+    """Preallocated result arrays are written in place and returned."""
+    axis = core.Axis(numpy.arange(0, 5, dtype=numpy.float64))
+    model = core.tidal_model.CartesianComplex128(axis, axis)
+    model.add_constituent('M2', numpy.full((25, ), 10 + 5j))
+    model.add_constituent('K1', numpy.full((25, ), 4 - 2j))
+
+    dates = numpy.arange('2020-01-01', '2020-01-02', numpy.timedelta64(1, 'h'),
+                         dtype='M8[us]')
+    size = dates.size
+    lons = numpy.full((size, ), 2.0)
+    lats = numpy.full((size, ), 2.0)
+
+    reference = core.evaluate_tide(model, dates, None, lons, lats,
+                                   num_threads=1)
+
+    tide = numpy.empty((size, ), dtype=numpy.float64)
+    long_period = numpy.empty((size, ), dtype=numpy.float64)
+    quality = numpy.empty((size, ), dtype=numpy.uint8)
+    result = core.evaluate_tide(model,
+                                dates,
+                                None,
+                                lons,
+                                lats,
+                                out=(tide, long_period, quality),
+                                num_threads=1)
+
+    # The provided arrays are returned, not copies.
+    assert result[0] is tide
+    assert result[1] is long_period
+    assert result[2] is quality
+    assert tide == pytest.approx(reference[0])
+    assert long_period == pytest.approx(reference[1])
+    assert numpy.all(quality == reference[2])
+
+    # Mis-sized or mistyped arrays are rejected.
+    with pytest.raises(ValueError):
+        core.evaluate_tide(model,
+                           dates,
+                           None,
+                           lons,
+                           lats,
+                           out=(tide[:1], long_period[:1], quality[:1]))
+    with pytest.raises(ValueError):
+        core.evaluate_tide(model,
+                           dates,
+                           None,
+                           lons,
+                           lats,
+                           out=(tide.astype(numpy.float32), long_period,
+                                quality))